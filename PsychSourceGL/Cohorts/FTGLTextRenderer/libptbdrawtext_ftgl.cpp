@@ -5,7 +5,9 @@
  * Features:
  *
  * - Texture mapped renderer.
- * - Fast due to texture object and display list caching for fast glyph recycling.
+ * - Fast due to a per-font glyph atlas texture, which is filled on-demand, and batched
+ *   rendering of each text string as one vertex array. Falls back to OGLFT's texture
+ *   object and display list caching if a string doesn't fit into the atlas.
  * - Good text layouting.
  * - Supports all Freetype-2 supported fonts, e.g., vectorgraphics TrueType fonts.
  * - Anti-Aliased drawing via Alpha-Blending.
@@ -88,6 +90,10 @@
 // 10 fullscreen onscreen windows, so guaranteeing for 10 onscreen windows should be good enough.
 #define MIN_GUARANTEED_CONTEXTS 10
 
+// Minimum and maximum size of the glyph atlas texture of a font, in texels per side:
+#define MIN_ATLAS_SIZE 256
+#define MAX_ATLAS_SIZE 4096
+
 unsigned int nowtime = 0;
 unsigned int hitcount = 0;
 unsigned int _verbosity = 2;
@@ -106,6 +112,45 @@ FT_Vector _vector;
 double _xp;
 double _yp;
 
+// Glyph atlas statistics, for diagnostics at higher verbosity levels:
+unsigned int atlasHits = 0;
+unsigned int atlasMisses = 0;
+unsigned int atlasResets = 0;
+double atlasUploadBytes = 0;
+
+// Location and metrics of a glyph in the glyph atlas:
+typedef struct atlasGlyph_t {
+    int valid;              // Zero if font has no glyph for the character.
+    int x, y;               // Bottom-left corner in atlas texture, in texels.
+    int width, height;      // Size of glyph bitmap in texels. Zero for empty glyphs, e.g., space.
+    int left, bottom;       // Offset of bitmap from pen position, y-axis pointing up.
+    GLfloat advanceX;       // Pen advance after glyph, in pixels.
+    GLfloat advanceY;
+} atlasGlyph;
+
+// Glyph atlas of one font cache slot: A single texture, filled on-demand with glyph
+// bitmaps via shelf packing. Texel (0,0) - (1,1) is reserved as opaque for drawing
+// underlines. If the atlas is full, it is reset and refilled. A pinned atlas is referenced
+// by recorded command lists, so it gets a new texture instead of overwriting the old one:
+typedef struct glyphAtlas_t {
+    GLuint texture;
+    int size;
+    int penX, penY, rowHeight;
+    bool pinned;
+    std::map<unsigned int, atlasGlyph> glyphs;
+} glyphAtlas;
+
+// Set while Screen records a command list, see PsychLockGlyphAtlas(). No glyph uploads allowed then:
+bool _atlasLocked = false;
+
+// Textures of pinned glyph atlases which got replaced, with their contextId. Kept until context shutdown:
+std::vector<std::pair<int, GLuint> > _retiredAtlasTextures;
+
+// Vertex, texture coordinate and color arrays for batched drawing, recycled across calls:
+std::vector<GLfloat> _atlasVertices;
+std::vector<GLfloat> _atlasTexCoords;
+std::vector<GLfloat> _atlasColors;
+
 typedef struct fontCacheItem_t {
     int contextId;
     unsigned int timestamp;
@@ -119,6 +164,7 @@ typedef struct fontCacheItem_t {
     OGLFT::TranslucentTexture    *faceT;
     OGLFT::MonochromeTexture    *faceM;
     FT_Face ft_face;
+    glyphAtlas *atlas;
 } fontCacheItem;
 fontCacheItem cache[MAX_CACHE_SLOTS];
 
@@ -146,11 +192,13 @@ OGLFT_API void PsychSetTextBGColor(int context, double* color);
 OGLFT_API void PsychSetTextUseFontmapper(unsigned int useMapper, unsigned int mapperFlags);
 OGLFT_API void PsychSetTextViewPort(int context, double xs, double ys, double w, double h);
 OGLFT_API int PsychDrawText(int context, double xStart, double yStart, int textLen, double* text);
+OGLFT_API int PsychDrawTexts(int context, int numStrings, int* textLens, double** texts, double* xStarts, double* yStarts, int yPositionIsBaseline, double* fgColors, float* bboxes);
 OGLFT_API int PsychMeasureText(int context, int textLen, double* text, float* xmin, float* ymin, float* xmax, float* ymax, float* xadvance);
 OGLFT_API void PsychSetTextVerbosity(unsigned int verbosity);
 OGLFT_API void PsychSetTextAntiAliasing(int context, int antiAliasing);
 OGLFT_API void PsychSetAffineTransformMatrix(int context, double matrix[2][3]);
 OGLFT_API void PsychGetTextCursor(int context, double* xp, double* yp, double* height);
+OGLFT_API int PsychLockGlyphAtlas(int context, int numStrings, int* textLens, double** texts);
 
 fontCacheItem* getForContext(int contextId)
 {
@@ -242,6 +290,305 @@ fontCacheItem* getForContext(int contextId)
     return(fi);
 }
 
+// Reset glyph atlas to empty state. Texels (0,0) to (1,1) stay reserved as opaque block:
+static void PsychResetGlyphAtlas(glyphAtlas* atlas)
+{
+    atlas->glyphs.clear();
+    atlas->penX = 3;
+    atlas->penY = 0;
+    atlas->rowHeight = 2;
+}
+
+static glyphAtlas* PsychCreateGlyphAtlas(fontCacheItem* fi)
+{
+    GLubyte opaque[4] = { 0xff, 0xff, 0xff, 0xff };
+    GLint maxTexSize = 0;
+    double scale, cellSize;
+    int size;
+
+    // Size the atlas to hold roughly 256 glyphs, taking scaling by the affine text transform into account:
+    scale = fabs((double) fi->matrix.xx);
+    if (fabs((double) fi->matrix.xy) > scale) scale = fabs((double) fi->matrix.xy);
+    if (fabs((double) fi->matrix.yx) > scale) scale = fabs((double) fi->matrix.yx);
+    if (fabs((double) fi->matrix.yy) > scale) scale = fabs((double) fi->matrix.yy);
+    scale /= 65536.0;
+    if (scale < 1) scale = 1;
+
+    cellSize = (double) fi->ft_face->size->metrics.height / 64.0 * scale + 2;
+    for (size = MIN_ATLAS_SIZE; (size < MAX_ATLAS_SIZE) && (size < 16 * cellSize); size *= 2);
+
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTexSize);
+    if ((maxTexSize > 0) && (size > maxTexSize)) size = maxTexSize;
+
+    glyphAtlas* atlas = new glyphAtlas;
+    atlas->size = size;
+    atlas->pinned = false;
+
+    glGenTextures(1, &atlas->texture);
+    glBindTexture(GL_TEXTURE_2D, atlas->texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA8, size, size, 0, GL_ALPHA, GL_UNSIGNED_BYTE, NULL);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 2, 2, GL_ALPHA, GL_UNSIGNED_BYTE, opaque);
+    atlasUploadBytes += 4;
+
+    PsychResetGlyphAtlas(atlas);
+
+    if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: Created glyph atlas of %i x %i texels for font %s, size %f.\n", size, size, fi->fontRealName, (float) fi->fontSize);
+
+    return(atlas);
+}
+
+static void PsychDeleteGlyphAtlas(fontCacheItem* fi)
+{
+    if (!fi->atlas) return;
+
+    if (fi->atlas->pinned) {
+        _retiredAtlasTextures.push_back(std::make_pair(fi->contextId, fi->atlas->texture));
+    }
+    else if (fi->atlas->texture) {
+        glDeleteTextures(1, &fi->atlas->texture);
+    }
+
+    delete(fi->atlas);
+    fi->atlas = NULL;
+}
+
+// Empty the full glyph atlas of font 'fi' for refilling. A pinned atlas gets a new texture:
+static void PsychRecycleGlyphAtlas(fontCacheItem* fi)
+{
+    atlasResets++;
+    if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: Glyph atlas for font %s, size %f full. Resetting it.\n", fi->fontRealName, (float) fi->fontSize);
+
+    if (fi->atlas->pinned) {
+        PsychDeleteGlyphAtlas(fi);
+        fi->atlas = PsychCreateGlyphAtlas(fi);
+    }
+    else {
+        PsychResetGlyphAtlas(fi->atlas);
+    }
+}
+
+// Lookup glyph for unicode character 'unicode' in atlas of font 'fi', rasterize and upload it on a miss.
+// Returns 0 on success, 1 if the atlas is full, 2 if the glyph can't be handled by the atlas at all:
+static int PsychGetAtlasGlyph(fontCacheItem* fi, unsigned int unicode, atlasGlyph** glyph)
+{
+    glyphAtlas* atlas = fi->atlas;
+    std::map<unsigned int, atlasGlyph>::iterator it = atlas->glyphs.find(unicode);
+    atlasGlyph g;
+
+    if (it != atlas->glyphs.end()) {
+        atlasHits++;
+        *glyph = &(it->second);
+        return(0);
+    }
+
+    // Glyph uploads would get recorded into a command list while the atlas is locked:
+    if (_atlasLocked) return(2);
+
+    atlasMisses++;
+    memset(&g, 0, sizeof(g));
+
+    // Characters without glyph in the font are skipped without advancing the pen, like OGLFT does:
+    FT_UInt glyph_index = FT_Get_Char_Index(fi->ft_face, unicode);
+    if (glyph_index == 0) {
+        atlas->glyphs[unicode] = g;
+        *glyph = &(atlas->glyphs[unicode]);
+        return(0);
+    }
+
+    if (FT_Load_Glyph(fi->ft_face, glyph_index, FT_LOAD_DEFAULT) ||
+        FT_Render_Glyph(fi->ft_face->glyph, (fi->faceT) ? ft_render_mode_normal : ft_render_mode_mono))
+        return(2);
+
+    FT_GlyphSlot slot = fi->ft_face->glyph;
+
+    // Non-anti-aliased fonts need 1 bpp glyph bitmaps. Let OGLFT handle the error reporting otherwise:
+    if (!fi->faceT && (slot->bitmap.pixel_mode != FT_PIXEL_MODE_MONO)) return(2);
+
+    g.valid = 1;
+    g.width = slot->bitmap.width;
+    g.height = slot->bitmap.rows;
+    g.left = slot->bitmap_left;
+    g.bottom = -(int) (slot->bitmap.rows - slot->bitmap_top);
+    g.advanceX = slot->advance.x / 64.f;
+    g.advanceY = slot->advance.y / 64.f;
+
+    if ((g.width > 0) && (g.height > 0)) {
+        if ((g.width + 1 > atlas->size) || (g.height + 1 > atlas->size)) return(2);
+
+        // Start a new shelf if the glyph doesn't fit into the current one:
+        if (atlas->penX + g.width + 1 > atlas->size) {
+            atlas->penY += atlas->rowHeight + 1;
+            atlas->penX = 0;
+            atlas->rowHeight = 0;
+        }
+
+        if (atlas->penY + g.height + 1 > atlas->size) return(1);
+
+        g.x = atlas->penX;
+        g.y = atlas->penY;
+
+        // Convert bitmap into 8 bpp alpha coverage, with the bottom row first, as
+        // OGLFT does, so texture t coordinates point in the same direction as y:
+        FT_Bitmap bitmap;
+        FT_Bitmap_New(&bitmap);
+        if (FT_Bitmap_Convert(OGLFT::Library::instance(), &(slot->bitmap), &bitmap, 1)) {
+            FT_Bitmap_Done(OGLFT::Library::instance(), &bitmap);
+            return(2);
+        }
+
+        int maxval = (bitmap.num_grays > 1) ? bitmap.num_grays - 1 : 1;
+        GLubyte* pixels = new GLubyte[g.width * g.height];
+        for (int r = 0; r < g.height; r++) {
+            GLubyte* src = &bitmap.buffer[bitmap.pitch * (g.height - r - 1)];
+            for (int p = 0; p < g.width; p++) pixels[r * g.width + p] = (GLubyte) ((src[p] * 255) / maxval);
+        }
+
+        glBindTexture(GL_TEXTURE_2D, atlas->texture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, g.x, g.y, g.width, g.height, GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+        atlasUploadBytes += g.width * g.height;
+
+        delete[] pixels;
+        FT_Bitmap_Done(OGLFT::Library::instance(), &bitmap);
+
+        atlas->penX += g.width + 1;
+        if (g.height > atlas->rowHeight) atlas->rowHeight = g.height;
+    }
+
+    atlas->glyphs[unicode] = g;
+    *glyph = &(atlas->glyphs[unicode]);
+
+    return(0);
+}
+
+// Draw all pending glyph quads of the atlas of font 'fi' as one batch:
+static void PsychFlushAtlasBatch(fontCacheItem* fi)
+{
+    if (_atlasVertices.empty()) return;
+
+    glBindTexture(GL_TEXTURE_2D, fi->atlas->texture);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, &(_atlasVertices[0]));
+    glTexCoordPointer(2, GL_FLOAT, 0, &(_atlasTexCoords[0]));
+    glColorPointer(4, GL_FLOAT, 0, &(_atlasColors[0]));
+    glDrawArrays(GL_QUADS, 0, (GLsizei) (_atlasVertices.size() / 2));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    _atlasVertices.clear();
+    _atlasTexCoords.clear();
+    _atlasColors.clear();
+
+    if (_verbosity > 15) fprintf(stdout, "libptbdrawtext_ftgl: Glyph atlas hit ratio is %f%%, %i resets, %f bytes uploaded.\n",
+                                 (double) atlasHits / (double) (atlasHits + atlasMisses) * 100, atlasResets, atlasUploadBytes);
+}
+
+// Append quads for text string at pen start position (xStart, yStart) in color 'color' to the pending
+// glyph atlas batch of font 'fi'. Returns the final pen position in (penX, penY). Returns false, without
+// appending anything, if the atlas can't handle the string, so the caller can fall back to OGLFT:
+static bool PsychAddTextToAtlasBatch(fontCacheItem* fi, double xStart, double yStart, int textLen, double* text, const GLfloat* color, GLfloat* penX, GLfloat* penY)
+{
+    static std::vector<atlasGlyph*> glyphs;
+    OGLFT::Face* face = (fi->faceT) ? (OGLFT::Face*) fi->faceT : (OGLFT::Face*) fi->faceM;
+    atlasGlyph *g;
+    int i, j, rc, pass;
+    GLfloat px, py, x0, y0, x1, y1, s0, t0, s1, t1, inv, undPos = 0, undThicc = 0;
+    bool doUnderline = (_fontStyle & 4) ? true : false;
+
+    if (!fi->atlas) {
+        if (_atlasLocked) return(false);
+        fi->atlas = PsychCreateGlyphAtlas(fi);
+    }
+
+    // Make sure all glyphs of the string are in the atlas. If the atlas runs full, draw
+    // what is pending for the old atlas content, then reset and retry once, as the string
+    // alone may fit:
+    glyphs.resize(textLen);
+    for (pass = 0; pass < 2; pass++) {
+        rc = 0;
+        for (i = 0; (i < textLen) && (rc == 0); i++) rc = PsychGetAtlasGlyph(fi, (unsigned int) text[i], &glyphs[i]);
+
+        if (rc != 1) break;
+
+        PsychFlushAtlasBatch(fi);
+        PsychRecycleGlyphAtlas(fi);
+    }
+
+    if (rc != 0) return(false);
+
+    if (doUnderline) {
+        undPos = (GLfloat) face->underline_position();
+        undThicc = (GLfloat) face->underline_thickness();
+    }
+
+    // Build quads for glyphs and underlines. Underlines use the opaque texel block:
+    inv = 1.f / (GLfloat) fi->atlas->size;
+    px = (GLfloat) xStart;
+    py = (GLfloat) yStart;
+
+    for (i = 0; i < textLen; i++) {
+        g = glyphs[i];
+        if (!g->valid) continue;
+
+        if ((g->width > 0) && (g->height > 0)) {
+            x0 = px + g->left;
+            y0 = py + g->bottom;
+            x1 = x0 + g->width;
+            y1 = y0 + g->height;
+            s0 = g->x * inv;
+            t0 = g->y * inv;
+            s1 = (g->x + g->width) * inv;
+            t1 = (g->y + g->height) * inv;
+
+            GLfloat v[8] = { x0, y0, x1, y0, x1, y1, x0, y1 };
+            GLfloat t[8] = { s0, t0, s1, t0, s1, t1, s0, t1 };
+            _atlasVertices.insert(_atlasVertices.end(), v, v + 8);
+            _atlasTexCoords.insert(_atlasTexCoords.end(), t, t + 8);
+            for (j = 0; j < 4; j++) _atlasColors.insert(_atlasColors.end(), color, color + 4);
+        }
+
+        if (doUnderline) {
+            GLfloat v[8] = { px, py + undPos - undThicc, px + g->advanceX, py + undPos - undThicc, px + g->advanceX, py + undPos, px, py + undPos };
+            GLfloat t[8] = { inv, inv, inv, inv, inv, inv, inv, inv };
+            _atlasVertices.insert(_atlasVertices.end(), v, v + 8);
+            _atlasTexCoords.insert(_atlasTexCoords.end(), t, t + 8);
+            for (j = 0; j < 4; j++) _atlasColors.insert(_atlasColors.end(), color, color + 4);
+        }
+
+        px += g->advanceX;
+        py += g->advanceY;
+    }
+
+    *penX = px;
+    *penY = py;
+
+    return(true);
+}
+
+// Draw text string via the glyph atlas of font 'fi' as one batch of textured quads. Leaves the
+// MODELVIEW matrix translated to the final pen position, just as OGLFT's draw() with advance
+// enabled. Returns false if the atlas can't handle the string, so the caller can fall back to OGLFT:
+static bool PsychDrawTextAtlas(fontCacheItem* fi, double xStart, double yStart, int textLen, double* text)
+{
+    GLfloat px, py;
+
+    if (!PsychAddTextToAtlasBatch(fi, xStart, yStart, textLen, text, &(_fgcolor[0]), &px, &py))
+        return(false);
+
+    PsychFlushAtlasBatch(fi);
+
+    // Advance MODELVIEW to final pen position, so caller can read out the text cursor:
+    glTranslatef(px, py, 0);
+
+    return(true);
+}
+
 void PsychSetTextVerbosity(unsigned int verbosity)
 {
     _verbosity = verbosity;
@@ -259,6 +606,9 @@ int PsychRebuildFont(fontCacheItem* fi)
     int faceIndex = 0;
     char fontFileName[FILENAME_MAX] = { 0 };
 
+    // Destroy old glyph atlas, if any:
+    PsychDeleteGlyphAtlas(fi);
+
     // Destroy old font object, if any:
     if (fi->faceT || fi->faceM) {
         // Delete OGLFT face object:
@@ -537,7 +887,7 @@ const char* PsychGetTextFont(int context)
 
 int PsychDrawText(int context, double xStart, double yStart, int textLen, double* text)
 {
-    int i;
+    int i, rc = 0;
     GLuint ti;
     QChar* myUniChars;
     GLdouble modelview[4][4];
@@ -610,13 +960,19 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
     glEnable(GL_ALPHA_TEST);
     glAlphaFunc(GL_GREATER, 0);
 
-    // Draw the text at selected start location:
+    // Draw the text at selected start location, via the glyph atlas if possible:
+    // OGLFT can't be used while the atlas is locked, as it creates textures on demand:
     glPushMatrix();
-    if (fi->faceT) {
-        fi->faceT->draw(xStart, yStart, uniCodeText);
-    }
-    else {
-        fi->faceM->draw(xStart, yStart, uniCodeText);
+    if (!PsychDrawTextAtlas(fi, xStart, yStart, textLen, text)) {
+        if (_atlasLocked) {
+            rc = 1;
+        }
+        else if (fi->faceT) {
+            fi->faceT->draw(xStart, yStart, uniCodeText);
+        }
+        else {
+            fi->faceM->draw(xStart, yStart, uniCodeText);
+        }
     }
 
     // Extract final text cursor position from GL_MODELVIEW matrix:
@@ -637,6 +993,181 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
     glPopClientAttrib();
 
     // Ready!
+    return(rc);
+}
+
+// Draw 'numStrings' text strings in one go. String i has length textLens[i], unicode characters texts[i]
+// and start position (xStarts[i], yStarts[i]), with yStarts[i] being the baseline if yPositionIsBaseline,
+// otherwise the top of the text bounding box. fgColors optionally provides one RGBA color per string,
+// otherwise the current foreground color is used. bboxes optionally provides the xmin, ymin, xmax, ymax bounding
+// box of each string, as returned by PsychMeasureText(), otherwise strings get measured as needed. All strings
+// which can be handled by the glyph atlas get drawn as one batch. The text cursor is left at the end of the last string:
+int PsychDrawTexts(int context, int numStrings, int* textLens, double** texts, double* xStarts, double* yStarts, int yPositionIsBaseline, double* fgColors, float* bboxes)
+{
+    int i, j, rc = 0;
+    GLuint ti;
+    QChar* myUniChars;
+    GLdouble modelview[4][4];
+    GLfloat color[4];
+    GLfloat px, py;
+    double x, y;
+    float xmin, ymin, xmax, ymax, xadvance;
+
+    if (_firstCall) {
+        _firstCall = false;
+        glGenTextures(1, &ti);
+    }
+
+    fontCacheItem *fi = getForContext(context);
+    if (!fi) return(1);
+
+    glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1);
+    glEnable( GL_TEXTURE_2D );
+    glTexEnvf( GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE );
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    gluOrtho2D(_vxs, _vxs + _vw, _vys + _vh, _vys);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+
+    // FTGL assumes bottom-left origin, our projection matrix has top-left origin. Flip all text
+    // vertically in one go, so a string at pen position (x, y) gets drawn at (x, -y):
+    glScaled(1., -1., 1.);
+
+    if (fi->faceT) {
+        fi->faceT->setDoUnderLine(!!(_fontStyle & 4));
+    }
+    else if (fi->faceM) {
+        fi->faceM->setDoUnderLine(!!(_fontStyle & 4));
+    }
+
+    glEnable(GL_ALPHA_TEST);
+    glAlphaFunc(GL_GREATER, 0);
+
+    for (i = 0; i < numStrings; i++) {
+        for (j = 0; j < 4; j++) color[j] = (fgColors) ? (GLfloat) fgColors[i * 4 + j] : _fgcolor[j];
+
+        x = xStarts[i];
+        y = yStarts[i];
+
+        // Need bounding box for positioning relative to top of text, or for the background quad:
+        if (!yPositionIsBaseline || (_bgcolor[3] > 0)) {
+            if (bboxes) {
+                xmin = bboxes[i * 4];
+                ymin = bboxes[i * 4 + 1];
+                xmax = bboxes[i * 4 + 2];
+                ymax = bboxes[i * 4 + 3];
+            }
+            else {
+                PsychMeasureText(context, textLens[i], texts[i], &xmin, &ymin, &xmax, &ymax, &xadvance);
+            }
+
+            if (!yPositionIsBaseline) y += ymax;
+        }
+
+        // Background quad must be drawn after all previous text, but before this string:
+        if (_bgcolor[3] > 0) {
+            if (fi->atlas) PsychFlushAtlasBatch(fi);
+            glColor4fv(&(_bgcolor[0]));
+            glRectf(xmin + x, ymin - y, xmax + x, ymax - y);
+        }
+
+        if (PsychAddTextToAtlasBatch(fi, x, -y, textLens[i], texts[i], color, &px, &py)) {
+            // Track text cursor of last string:
+            if (i == numStrings - 1) {
+                glPushMatrix();
+                glTranslatef(px, py, 0);
+                glGetDoublev(GL_MODELVIEW_MATRIX, &(modelview[0][0]));
+                glPopMatrix();
+            }
+        }
+        else if (_atlasLocked) {
+            // OGLFT can't be used while the atlas is locked, as it creates textures on demand:
+            rc = 1;
+        }
+        else {
+            // Atlas can't handle this one. Draw pending batch to preserve drawing order, then use OGLFT:
+            PsychFlushAtlasBatch(fi);
+
+            myUniChars = new QChar[textLens[i]];
+            for (j = 0; j < textLens[i]; j++) myUniChars[j] = QChar((unsigned int) texts[i][j]);
+            QString uniCodeText = QString(myUniChars, textLens[i]);
+            delete [] myUniChars;
+
+            glPushMatrix();
+            if (fi->faceT) {
+                fi->faceT->setForegroundColor(color[0], color[1], color[2], color[3]);
+                fi->faceT->draw(x, -y, uniCodeText);
+            }
+            else {
+                fi->faceM->setForegroundColor(color[0], color[1], color[2], color[3]);
+                fi->faceM->draw(x, -y, uniCodeText);
+            }
+
+            if (i == numStrings - 1) glGetDoublev(GL_MODELVIEW_MATRIX, &(modelview[0][0]));
+            glPopMatrix();
+        }
+    }
+
+    // Draw remaining batch:
+    if (fi->atlas) PsychFlushAtlasBatch(fi);
+
+    if (numStrings > 0) {
+        _xp = modelview[3][0];
+        _yp = modelview[3][1];
+    }
+
+    glDisable(GL_ALPHA_TEST);
+
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    glDisable( GL_TEXTURE_2D );
+    glPopAttrib();
+    glPopClientAttrib();
+
+    return(rc);
+}
+
+// Prepare drawing of 'numStrings' text strings while Screen records a command list: Upload all their glyphs
+// into the glyph atlas of the current font of 'context', then lock all atlases until called again with
+// numStrings == 0, so drawing only references already resident glyphs. The atlas gets pinned, as recorded
+// command lists reference its texture. Returns non-zero if the strings can't be drawn via the atlas:
+int PsychLockGlyphAtlas(int context, int numStrings, int* textLens, double** texts)
+{
+    atlasGlyph *g;
+    int i, j, rc, pass;
+
+    _atlasLocked = false;
+    if (numStrings == 0) return(0);
+
+    fontCacheItem *fi = getForContext(context);
+    if (!fi) return(1);
+
+    if (!fi->atlas) fi->atlas = PsychCreateGlyphAtlas(fi);
+
+    // All strings must fit into the atlas at the same time. Retry once with an empty atlas if it runs full:
+    for (pass = 0; pass < 2; pass++) {
+        rc = 0;
+        for (i = 0; (i < numStrings) && (rc == 0); i++) {
+            for (j = 0; (j < textLens[i]) && (rc == 0); j++) rc = PsychGetAtlasGlyph(fi, (unsigned int) texts[i][j], &g);
+        }
+
+        if (rc != 1) break;
+
+        PsychRecycleGlyphAtlas(fi);
+    }
+
+    if (rc != 0) return(1);
+
+    fi->atlas->pinned = true;
+    _atlasLocked = true;
+
     return(0);
 }
 
@@ -746,6 +1277,10 @@ int PsychShutdownText(int context)
                 fontCacheItem *fi = &(cache[i]);
                 fi->contextId = -1;
 
+                // Delete glyph atlas texture. Command lists which reference it die with the context:
+                if (fi->atlas) fi->atlas->pinned = false;
+                PsychDeleteGlyphAtlas(fi);
+
                 if (fi->faceT || fi->faceM) {
                     if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: In shutdown for context %i, slot %i:  faceT = %p faceM = %p\n", context, i, fi->faceT, fi->faceM);
 
@@ -763,12 +1298,24 @@ int PsychShutdownText(int context)
             }
         }
 
+        // Delete retired glyph atlas textures of this context:
+        for (size_t i = 0; i < _retiredAtlasTextures.size(); i++) {
+            if (_retiredAtlasTextures[i].first == context) {
+                glDeleteTextures(1, &(_retiredAtlasTextures[i].second));
+                _retiredAtlasTextures.erase(_retiredAtlasTextures.begin() + i--);
+            }
+        }
+
         return(0);
     }
 
     // Complete shutdown for the plugin:
     if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: Shutting down. Overall cache hit ratio was %f%%\n", (double) hitcount / (double) nowtime * 100);
+    if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: Glyph atlas hit ratio was %f%%, with %i atlas resets and %f bytes of glyph uploads.\n",
+                                (atlasHits + atlasMisses > 0) ? (double) atlasHits / (double) (atlasHits + atlasMisses) * 100 : 0.0, atlasResets, atlasUploadBytes);
     _firstCall = false;
+    _atlasLocked = false;
+    _retiredAtlasTextures.clear();
 
     // Shutdown fontmapper library:
     // Actually, don't! Some versions of octave also use fontconfig internally, and there is only
@@ -93,6 +93,50 @@ void PsychSetCellVectorStringElement(int index,
 }
 
 
+/*
+ *    PsychAllocInCellVectorStringElements()
+ *
+ *    Get a cell array of char strings from argument 'position'. Returns the number of cells in
+ *    'numElements' and a vector of null-terminated strings in 'strings', all allocated in temporary
+ *    memory. Empty cells are returned as empty strings. Any other type of cell content is an error.
+ */
+psych_bool PsychAllocInCellVectorStringElements(int position, PsychArgRequirementType isRequired, int *numElements, char ***strings)
+{
+    const mxArray   *cellVector, *mxElement;
+    psych_uint64    strLen;
+    PsychError      matchError;
+    psych_bool      acceptArg;
+    int             i;
+
+    PsychSetReceivedArgDescriptor(position, FALSE, PsychArgIn);
+    PsychSetSpecifiedArgDescriptor(position, PsychArgIn, PsychArgType_cellArray, isRequired, 0, kPsychUnboundedArraySize, 0, kPsychUnboundedArraySize, 0, 1);
+    matchError = PsychMatchDescriptors();
+    acceptArg = PsychAcceptInputArgumentDecider(isRequired, matchError);
+    if (acceptArg) {
+        cellVector = PsychGetInArgMxPtr(position);
+        *numElements = (int) mxGetNumberOfElements(cellVector);
+        *strings = (char**) PsychMallocTemp((*numElements + 1) * sizeof(char*));
+        for (i = 0; i < *numElements; i++) {
+            mxElement = mxGetCell(cellVector, (mwIndex) i);
+            if (!mxElement || (mxGetNumberOfElements(mxElement) == 0)) {
+                (*strings)[i] = "";
+                continue;
+            }
+
+            if (!mxIsChar(mxElement))
+                PsychErrorExitMsg(PsychError_user, "Cell array argument must only contain char() strings!");
+
+            strLen = ((psych_uint64) mxGetNumberOfElements(mxElement) * (psych_uint64) sizeof(mxChar)) + 1;
+            if (strLen >= INT_MAX) PsychErrorExitMsg(PsychError_user, "Tried to pass in a string with more than 2^31 - 1 characters. Unsupported!");
+            (*strings)[i] = (char*) PsychCallocTemp((size_t) strLen, sizeof(char));
+            if (mxGetString(mxElement, (*strings)[i], (mwSize) strLen))
+                PsychErrorExitMsg(PsychError_internal, "mxGetString failed to get the string");
+        }
+    }
+    return(acceptArg);
+}
+
+
 /*
  *    PsychSetCellVectorDoubleElement() - UNUSED
  *
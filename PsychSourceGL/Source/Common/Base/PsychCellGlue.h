@@ -29,6 +29,7 @@
 
 psych_bool PsychAllocOutCellVector(int position, PsychArgRequirementType isRequired, int numElements,  PsychGenericScriptType **pCell);
 void PsychSetCellVectorStringElement(int index, const char *text, PsychGenericScriptType *cellVector);
+psych_bool PsychAllocInCellVectorStringElements(int position, PsychArgRequirementType isRequired, int *numElements, char ***strings);
 //void PsychSetCellVectorDoubleElement(int index, double value, PsychGenericScriptType *cellVector);
 //void PsychSetCellVectorNativeElement(int index, PsychGenericScriptType *pNativeElement,  PsychGenericScriptType *cellVector);
 //psych_bool PsychAllocInNativeCellVector(int position, PsychArgRequirementType isRequired, const PsychGenericScriptType **cellVector);
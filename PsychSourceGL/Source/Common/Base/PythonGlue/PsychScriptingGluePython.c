@@ -3422,5 +3422,50 @@ void PsychSetCellVectorStringElement(int index,
     PyTuple_SetItem(cellVector, index, mxFieldValue);
 }
 
+/*
+ *    PsychAllocInCellVectorStringElements()
+ *
+ *    Get a cell array of char strings from argument 'position'. Returns the number of cells in
+ *    'numElements' and a vector of null-terminated strings in 'strings', all allocated in temporary
+ *    memory. Empty cells are returned as empty strings. Any other type of cell content is an error.
+ */
+psych_bool PsychAllocInCellVectorStringElements(int position, PsychArgRequirementType isRequired, int *numElements, char ***strings)
+{
+    PyObject        *cellVector, *ppyElement;
+    psych_uint64    strLen;
+    PsychError      matchError;
+    psych_bool      acceptArg;
+    int             i;
+
+    PsychSetReceivedArgDescriptor(position, FALSE, PsychArgIn);
+    PsychSetSpecifiedArgDescriptor(position, PsychArgIn, PsychArgType_cellArray, isRequired, 0, kPsychUnboundedArraySize, 0, kPsychUnboundedArraySize, 0, 1);
+    matchError = PsychMatchDescriptors();
+    acceptArg = PsychAcceptInputArgumentDecider(isRequired, matchError);
+    if (acceptArg) {
+        cellVector = (PyObject*) PsychGetInArgPyPtr(position);
+        *numElements = (int) PyTuple_Size(cellVector);
+        *strings = (char**) PsychMallocTemp((*numElements + 1) * sizeof(char*));
+        for (i = 0; i < *numElements; i++) {
+            // Borrowed reference, no need to decref:
+            ppyElement = PyTuple_GetItem(cellVector, (Py_ssize_t) i);
+            if (!mxIsChar(ppyElement))
+                PsychErrorExitMsg(PsychError_user, "Cell array argument must only contain strings!");
+
+            if (PyUnicode_Check(ppyElement))
+                strLen = (psych_uint64) PyUnicode_GetLength(ppyElement) + 1;
+            else
+                strLen = (psych_uint64) PyBytes_Size(ppyElement) + 1;
+
+            if (strLen >= INT_MAX)
+                PsychErrorExitMsg(PsychError_user, "Tried to pass in a string with more than 2^31 - 1 characters. Unsupported!");
+
+            (*strings)[i] = (char*) PsychCallocTemp((size_t) strLen, sizeof(char));
+            if (mxGetString(ppyElement, (*strings)[i], (ptbSize) strLen))
+                PsychErrorExitMsg(PsychError_internal, "mxGetString failed to get the string");
+        }
+    }
+    return(acceptArg);
+}
+
 // End of Python only stuff.
 #endif
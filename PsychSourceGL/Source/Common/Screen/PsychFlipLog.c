@@ -0,0 +1,247 @@
+/*
+ *    PsychFlipLog.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Frame-level stimulus timing log of onscreen windows: A preallocated binary ring
+ *    buffer of flip records, filled on completion of each flip, and exported in bulk
+ *    via Screen('FlipLog').
+ *
+ *    NOTES:
+ *
+ *    The log gets enabled for a window via Screen('FlipLog', win, 'Start'), so it doesn't
+ *    cost anything for scripts which don't use it. Records are appended by
+ *    PsychFlipWindowBuffers() at the end of each flip, both for flips executed on the
+ *    master thread and on the async flipper thread, so all access is protected by a mutex.
+ *
+ *    Each record consists of kPsychFlipLogColumns double values:
+ *
+ *    1. Flip count of the window after this flip, a serial number.
+ *    2. Requested 'when' time of the flip.
+ *    3. VBLTimestamp, 4. StimulusOnsetTime, 5. FlipTimestamp, 6. Missed, 7. Beampos,
+ *       as returned by Screen('Flip').
+ *    8. Time when the swap was requested.
+ *    9. 1 if the flip was executed asynchronously by the flipper thread, 0 otherwise.
+ *
+ *    If the ring buffer is full, the oldest records get overwritten and counted as dropped.
+ *    Exported records are removed from the ring buffer.
+ */
+
+#include "Screen.h"
+
+// Number of records exported per locked chunk when streaming to a file:
+#define kPsychFlipLogChunk 512
+
+typedef struct PsychFlipLogType {
+    psych_mutex         mutex;          // Protects all other fields, as records are appended by the flipper thread as well.
+    psych_bool          enabled;        // Append new records on flip completion?
+    unsigned int        capacity;       // Maximum number of records in the ring buffer.
+    psych_uint64        writeCount;     // Total number of records appended.
+    psych_uint64        readCount;      // Total number of records exported or dropped.
+    psych_uint64        dropped;        // Total number of records overwritten before export.
+    double*             records;        // capacity records of kPsychFlipLogColumns values each.
+} PsychFlipLogType;
+
+/*
+ *    PsychFlipLogStart()
+ *
+ *    Enable the flip log of 'windowRecord' with a ring buffer of 'capacity' records,
+ *    or the current/default capacity if 'capacity' is zero. A change of capacity
+ *    discards all records not yet exported.
+ */
+void PsychFlipLogStart(PsychWindowRecordType *windowRecord, int capacity)
+{
+    PsychFlipLogType *flipLog = windowRecord->flipLog;
+
+    if (capacity < 0)
+        PsychErrorExitMsg(PsychError_user, "Invalid negative flip log capacity specified.");
+
+    if (!flipLog) {
+        flipLog = (PsychFlipLogType*) calloc(1, sizeof(PsychFlipLogType));
+        if (!flipLog) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while trying to allocate flip log!");
+
+        if (PsychInitMutex(&(flipLog->mutex))) {
+            free(flipLog);
+            PsychErrorExitMsg(PsychError_system, "Failed to initialize mutex for flip log!");
+        }
+
+        windowRecord->flipLog = flipLog;
+    }
+
+    if (capacity == 0)
+        capacity = (flipLog->capacity > 0) ? (int) flipLog->capacity : kPsychFlipLogDefaultCapacity;
+
+    PsychLockMutex(&(flipLog->mutex));
+
+    if ((unsigned int) capacity != flipLog->capacity) {
+        free(flipLog->records);
+        flipLog->records = (double*) malloc((size_t) capacity * kPsychFlipLogColumns * sizeof(double));
+        flipLog->capacity = (flipLog->records) ? (unsigned int) capacity : 0;
+        flipLog->writeCount = flipLog->readCount = flipLog->dropped = 0;
+    }
+
+    flipLog->enabled = (flipLog->records) ? TRUE : FALSE;
+
+    PsychUnlockMutex(&(flipLog->mutex));
+
+    if (!flipLog->records)
+        PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while trying to allocate flip log ring buffer! Try a smaller capacity.");
+}
+
+/*
+ *    PsychFlipLogStop()
+ *
+ *    Stop appending records to the flip log of 'windowRecord'. Records already
+ *    in the log are kept for export.
+ */
+void PsychFlipLogStop(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipLogType *flipLog = windowRecord->flipLog;
+
+    if (!flipLog) return;
+
+    PsychLockMutex(&(flipLog->mutex));
+    flipLog->enabled = FALSE;
+    PsychUnlockMutex(&(flipLog->mutex));
+}
+
+/*
+ *    PsychFlipLogShutdown()
+ *
+ *    Disable the flip log for 'windowRecord' and release all resources. Must only be
+ *    called after the flipper thread of the window has been stopped.
+ */
+void PsychFlipLogShutdown(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipLogType *flipLog = windowRecord->flipLog;
+
+    if (!flipLog) return;
+
+    PsychDestroyMutex(&(flipLog->mutex));
+    free(flipLog->records);
+    free(flipLog);
+    windowRecord->flipLog = NULL;
+}
+
+/*
+ *    PsychFlipLogAppend()
+ *
+ *    Append the record of a just completed flip to the flip log of 'windowRecord', if
+ *    enabled. Called by PsychFlipWindowBuffers() on the master or flipper thread.
+ */
+void PsychFlipLogAppend(PsychWindowRecordType *windowRecord, double flipwhen, double vbl_timestamp, double time_at_onset, double time_at_flipend,
+                        double miss_estimate, int beamPosAtFlip, double time_at_swaprequest)
+{
+    PsychFlipLogType *flipLog = windowRecord->flipLog;
+    double *record;
+
+    if (!flipLog || !flipLog->enabled) return;
+
+    PsychLockMutex(&(flipLog->mutex));
+
+    if (flipLog->enabled) {
+        // Ring buffer full? Drop oldest record:
+        if (flipLog->writeCount - flipLog->readCount >= flipLog->capacity) {
+            flipLog->readCount++;
+            flipLog->dropped++;
+        }
+
+        record = &(flipLog->records[(flipLog->writeCount % flipLog->capacity) * kPsychFlipLogColumns]);
+        record[0] = (double) windowRecord->flipCount;
+        record[1] = flipwhen;
+        record[2] = vbl_timestamp;
+        record[3] = time_at_onset;
+        record[4] = time_at_flipend;
+        record[5] = miss_estimate;
+        record[6] = (double) beamPosAtFlip;
+        record[7] = time_at_swaprequest;
+        record[8] = (PsychIsMasterThread()) ? 0 : 1;
+        flipLog->writeCount++;
+    }
+
+    PsychUnlockMutex(&(flipLog->mutex));
+}
+
+/*
+ *    PsychFlipLogExport()
+ *
+ *    Export up to 'maxCount' of the oldest records from the flip log of 'windowRecord'
+ *    and remove them from the log. Records are either copied into the column-major
+ *    count-by-kPsychFlipLogColumns 'matrix', or appended to 'file' as binary double
+ *    values, one record after the other. If both are NULL, only the number of records
+ *    available for export is returned, without removing any.
+ *
+ *    Returns the number of exported records, and the total number of records dropped
+ *    so far due to ring buffer overflow in 'dropped'. Returns -1 if writing to 'file'
+ *    failed.
+ */
+int PsychFlipLogExport(PsychWindowRecordType *windowRecord, int maxCount, double *matrix, FILE *file, double *dropped)
+{
+    PsychFlipLogType *flipLog = windowRecord->flipLog;
+    double chunk[kPsychFlipLogChunk * kPsychFlipLogColumns];
+    double *record;
+    int i, j, n, count;
+
+    *dropped = 0;
+    if (!flipLog) return(0);
+    if (maxCount < 0) maxCount = 0;
+
+    PsychLockMutex(&(flipLog->mutex));
+    count = (int) (flipLog->writeCount - flipLog->readCount);
+    if (count > maxCount) count = maxCount;
+    *dropped = (double) flipLog->dropped;
+
+    if (matrix) {
+        for (i = 0; i < count; i++) {
+            record = &(flipLog->records[((flipLog->readCount + i) % flipLog->capacity) * kPsychFlipLogColumns]);
+            for (j = 0; j < kPsychFlipLogColumns; j++)
+                matrix[j * count + i] = record[j];
+        }
+
+        flipLog->readCount += count;
+    }
+
+    PsychUnlockMutex(&(flipLog->mutex));
+
+    if (!file) return(count);
+
+    // Stream to file in chunks, so the lock is never held during file i/o, which
+    // could block the flipper thread while it appends records:
+    for (i = 0; i < count; i += n) {
+        n = (count - i > kPsychFlipLogChunk) ? kPsychFlipLogChunk : count - i;
+
+        PsychLockMutex(&(flipLog->mutex));
+
+        // Records may have been dropped meanwhile by appends to a full ring buffer:
+        if ((psych_uint64) n > flipLog->writeCount - flipLog->readCount)
+            n = (int) (flipLog->writeCount - flipLog->readCount);
+
+        for (j = 0; j < n; j++) {
+            record = &(flipLog->records[((flipLog->readCount + j) % flipLog->capacity) * kPsychFlipLogColumns]);
+            memcpy(&chunk[j * kPsychFlipLogColumns], record, kPsychFlipLogColumns * sizeof(double));
+        }
+
+        flipLog->readCount += n;
+        *dropped = (double) flipLog->dropped;
+
+        PsychUnlockMutex(&(flipLog->mutex));
+
+        if (n == 0) {
+            count = i;
+            break;
+        }
+
+        if (fwrite(chunk, sizeof(double) * kPsychFlipLogColumns, n, file) != (size_t) n)
+            return(-1);
+    }
+
+    return(count);
+}
@@ -0,0 +1,39 @@
+/*
+ *    PsychFlipLog.h
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Frame-level stimulus timing log of onscreen windows: A preallocated binary ring
+ *    buffer of flip records, filled on completion of each flip, and exported in bulk
+ *    via Screen('FlipLog').
+ */
+
+//include once
+#ifndef PSYCH_IS_INCLUDED_PsychFlipLog
+#define PSYCH_IS_INCLUDED_PsychFlipLog
+
+#include "Screen.h"
+
+// Number of values in one flip record, see PsychFlipLog.c for their meaning:
+#define kPsychFlipLogColumns 9
+
+// Default number of flip records in the ring buffer:
+#define kPsychFlipLogDefaultCapacity 100000
+
+void    PsychFlipLogStart(PsychWindowRecordType *windowRecord, int capacity);
+void    PsychFlipLogStop(PsychWindowRecordType *windowRecord);
+void    PsychFlipLogShutdown(PsychWindowRecordType *windowRecord);
+void    PsychFlipLogAppend(PsychWindowRecordType *windowRecord, double flipwhen, double vbl_timestamp, double time_at_onset, double time_at_flipend,
+                           double miss_estimate, int beamPosAtFlip, double time_at_swaprequest);
+int     PsychFlipLogExport(PsychWindowRecordType *windowRecord, int maxCount, double *matrix, FILE *file, double *dropped);
+
+//end include once
+#endif
@@ -0,0 +1,338 @@
+/*
+ *    PsychFlipScheduler.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Predictive flip scheduler for onscreen windows: Keeps running estimates of the cost
+ *    of preflip operations, of the gpu completion latency of a frame and of the swap
+ *    request submission. Predicts from them the latest time at which rendering of a
+ *    frame must be submitted via Screen('Flip') to hit a target stimulus onset, see
+ *    Screen('GetFlipDeadline'), and optionally throttles flips whose target can not be
+ *    met anymore to the next achievable video refresh.
+ *
+ *    NOTES:
+ *
+ *    The scheduler gets enabled for a window by the first call to Screen('GetFlipDeadline'),
+ *    so it doesn't cost anything for scripts which don't use it. The three cost estimates are:
+ *
+ *    1. Preflip: Cpu time spent in PsychPreFlipOperations(), e.g., for imaging pipeline processing.
+ *    2. Gpu: Time from the end of PsychPreFlipOperations() until the gpu has finished all rendering
+ *       for the frame, measured via a GL_TIMESTAMP query at the end of the preflip operations,
+ *       mapped from gpu time to cpu time. Zero if GL_ARB_timer_query is unsupported.
+ *    3. Swap: Cpu time for submission of the swap request.
+ *
+ *    Each estimate is an exponential moving average of the measured values, plus three times
+ *    the moving average of their absolute deviation from the mean, to protect against jitter.
+ *    Gpu timestamp query results arrive asynchronously, so they are collected without waiting
+ *    in one of a few in-flight slots at the start of the following preflip operations.
+ *
+ *    Only flips on the master thread are measured, so async flips only contribute preflip
+ *    and gpu costs.
+ */
+
+#include "Screen.h"
+
+// Number of gpu timestamp queries which can be pending at the same time:
+#define kPsychFlipSchedulerInFlight 4
+
+// Weight of a new sample in the moving averages:
+#define kPsychFlipSchedulerWeight 0.1
+
+typedef struct PsychFlipSchedulerStatType {
+    double              mean;
+    double              dev;
+    int                 count;
+} PsychFlipSchedulerStatType;
+
+typedef struct PsychFlipSchedulerType {
+    psych_bool          gpuTiming;      // GL_TIMESTAMP queries supported and used?
+    psych_bool          autoThrottle;   // Throttle flips which would miss their target to next achievable refresh?
+    double              safetyMargin;   // Extra safety margin in seconds, added to the predicted cost.
+    int                 throttledFlips; // Count of throttled flips.
+    double              tPreFlipStart;  // Cpu time at start of current preflip operations.
+    PsychFlipSchedulerStatType preflip;
+    PsychFlipSchedulerStatType gpu;
+    PsychFlipSchedulerStatType swap;
+    int                 nextQuery;
+    GLuint              queries[kPsychFlipSchedulerInFlight];
+    psych_bool          queryPending[kPsychFlipSchedulerInFlight];
+    double              queryCpuTime[kPsychFlipSchedulerInFlight];
+} PsychFlipSchedulerType;
+
+static void PsychFlipSchedulerAddSample(PsychFlipSchedulerStatType *stat, double value)
+{
+    if (value < 0) value = 0;
+
+    if (stat->count == 0) {
+        stat->mean = value;
+        stat->dev = 0;
+    }
+    else {
+        stat->dev += kPsychFlipSchedulerWeight * (fabs(value - stat->mean) - stat->dev);
+        stat->mean += kPsychFlipSchedulerWeight * (value - stat->mean);
+    }
+
+    stat->count++;
+}
+
+static double PsychFlipSchedulerEstimate(PsychFlipSchedulerStatType *stat)
+{
+    return((stat->count > 0) ? stat->mean + 3 * stat->dev : 0);
+}
+
+// Collect results of all finished gpu timestamp queries. If 'wait' is FALSE, only
+// queries whose results are already available are collected:
+static void PsychFlipSchedulerCollectQueries(PsychFlipSchedulerType *sched, psych_bool wait)
+{
+    GLuint64 gpuTime;
+    GLint64 gpuNow;
+    GLuint available;
+    double cpuNow, gpuToCpu;
+    int i, idx;
+
+    if (!sched->gpuTiming) return;
+
+    // Offset for mapping of gpu timestamps to cpu time:
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    PsychGetAdjustedPrecisionTimerSeconds(&cpuNow);
+    gpuToCpu = cpuNow - (double) gpuNow / 1e9;
+
+    // Results become available in submission order, oldest query first:
+    for (i = 0; i < kPsychFlipSchedulerInFlight; i++) {
+        idx = (sched->nextQuery + i) % kPsychFlipSchedulerInFlight;
+        if (!sched->queryPending[idx]) continue;
+
+        if (!wait) {
+            available = 0;
+            glGetQueryObjectuiv(sched->queries[idx], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) break;
+        }
+
+        glGetQueryObjectui64v(sched->queries[idx], GL_QUERY_RESULT, &gpuTime);
+        sched->queryPending[idx] = FALSE;
+
+        // Gpu completion latency after end of preflip operations:
+        PsychFlipSchedulerAddSample(&sched->gpu, (double) gpuTime / 1e9 + gpuToCpu - sched->queryCpuTime[idx]);
+    }
+}
+
+/*
+ *    PsychFlipSchedulerEnable()
+ *
+ *    Enable the predictive flip scheduler for onscreen window 'windowRecord'. No-Op if it
+ *    is already enabled.
+ */
+void PsychFlipSchedulerEnable(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipSchedulerType *sched;
+
+    if (windowRecord->flipScheduler) return;
+
+    sched = (PsychFlipSchedulerType*) calloc(1, sizeof(PsychFlipSchedulerType));
+    if (!sched) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while trying to allocate flip scheduler!");
+
+    sched->safetyMargin = 0.001;
+
+    PsychSetGLContext(windowRecord);
+    sched->gpuTiming = (!PsychIsGLES(windowRecord) && glewIsSupported("GL_ARB_timer_query")) ? TRUE : FALSE;
+    if (sched->gpuTiming) {
+        glGenQueries(kPsychFlipSchedulerInFlight, sched->queries);
+    }
+    else if (PsychPrefStateGet_Verbosity() > 2) {
+        printf("PTB-INFO: Flip scheduler: GPU timestamp queries unsupported on this GPU. Render deadlines will not account for gpu rendering time.\n");
+    }
+
+    windowRecord->flipScheduler = sched;
+}
+
+/*
+ *    PsychFlipSchedulerShutdown()
+ *
+ *    Disable the flip scheduler for 'windowRecord' and release all resources. Needs the
+ *    OpenGL context of the window, so must be called before it is destroyed.
+ */
+void PsychFlipSchedulerShutdown(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipSchedulerType *sched = windowRecord->flipScheduler;
+
+    if (!sched) return;
+
+    if (sched->gpuTiming) {
+        PsychSetGLContext(windowRecord);
+        glDeleteQueries(kPsychFlipSchedulerInFlight, sched->queries);
+    }
+
+    free(sched);
+    windowRecord->flipScheduler = NULL;
+}
+
+/*
+ *    PsychFlipSchedulerSetParameters()
+ *
+ *    Enable or disable auto-throttling if 'autoThrottle' is >= 0, and change the safety margin in
+ *    seconds if 'safetyMargin' is >= 0. Negative values leave the current setting untouched.
+ */
+void PsychFlipSchedulerSetParameters(PsychWindowRecordType *windowRecord, int autoThrottle, double safetyMargin)
+{
+    PsychFlipSchedulerType *sched = windowRecord->flipScheduler;
+
+    if (!sched) return;
+
+    if (autoThrottle >= 0) sched->autoThrottle = (autoThrottle > 0) ? TRUE : FALSE;
+    if (safetyMargin >= 0) sched->safetyMargin = safetyMargin;
+}
+
+/*
+ *    PsychFlipSchedulerPreFlipBegin() / PsychFlipSchedulerPreFlipEnd()
+ *
+ *    Mark begin and end of PsychPreFlipOperations() on the master thread. No-Op if the
+ *    scheduler is disabled. The OpenGL context of 'windowRecord' must be bound.
+ */
+void PsychFlipSchedulerPreFlipBegin(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipSchedulerType *sched = windowRecord->flipScheduler;
+
+    if (!sched) return;
+
+    PsychFlipSchedulerCollectQueries(sched, FALSE);
+    PsychGetAdjustedPrecisionTimerSeconds(&sched->tPreFlipStart);
+}
+
+void PsychFlipSchedulerPreFlipEnd(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipSchedulerType *sched = windowRecord->flipScheduler;
+    double tNow;
+
+    if (!sched) return;
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+    PsychFlipSchedulerAddSample(&sched->preflip, tNow - sched->tPreFlipStart);
+
+    if (sched->gpuTiming) {
+        // All query slots in flight? Then the oldest one must be finished by now:
+        if (sched->queryPending[sched->nextQuery])
+            PsychFlipSchedulerCollectQueries(sched, TRUE);
+
+        glQueryCounter(sched->queries[sched->nextQuery], GL_TIMESTAMP);
+        sched->queryCpuTime[sched->nextQuery] = tNow;
+        sched->queryPending[sched->nextQuery] = TRUE;
+        sched->nextQuery = (sched->nextQuery + 1) % kPsychFlipSchedulerInFlight;
+    }
+}
+
+/*
+ *    PsychFlipSchedulerSwapRequested()
+ *
+ *    Called by PsychFlipWindowBuffers() after the swap request got submitted.
+ */
+void PsychFlipSchedulerSwapRequested(PsychWindowRecordType *windowRecord, double time_at_swaprequest, double time_post_swaprequest)
+{
+    PsychFlipSchedulerType *sched = windowRecord->flipScheduler;
+
+    if (!sched || !PsychIsMasterThread()) return;
+
+    PsychFlipSchedulerAddSample(&sched->swap, time_post_swaprequest - time_at_swaprequest);
+}
+
+// Return the video refresh at which a flip for target time 'flipwhen' would happen, or zero if unknown:
+static double PsychFlipSchedulerTargetOnset(PsychWindowRecordType *windowRecord, double flipwhen, double tNow)
+{
+    double lastvbl = windowRecord->time_at_last_vbl;
+    double ifi = windowRecord->VideoRefreshInterval;
+
+    if ((lastvbl <= 0) || (ifi <= 0))
+        return(0);
+
+    // Flip happens at the first video refresh after 'flipwhen', or after now for asap flips:
+    if (flipwhen < tNow) flipwhen = tNow;
+
+    return(lastvbl + (floor((flipwhen - lastvbl) / ifi) + 1) * ifi);
+}
+
+/*
+ *    PsychFlipSchedulerThrottle()
+ *
+ *    Called by PsychFlipWindowBuffers() after the preflip operations. If auto-throttling is enabled and the
+ *    predicted remaining cost of the flip would make it miss the video refresh targeted by 'flipwhen', then
+ *    return a new 'flipwhen' which explicitely targets the next achievable video refresh. Otherwise return
+ *    'flipwhen' unmodified.
+ */
+double PsychFlipSchedulerThrottle(PsychWindowRecordType *windowRecord, double flipwhen, int vbl_synclevel, int multiflip)
+{
+    PsychFlipSchedulerType *sched = windowRecord->flipScheduler;
+    double tNow, onset, remaining, ifi = windowRecord->VideoRefreshInterval;
+
+    // Only for regular synchronous vsynced flips of fixed refresh rate displays:
+    if (!sched || !sched->autoThrottle || !PsychIsMasterThread() || (vbl_synclevel != 0) || (multiflip != 0) ||
+        (windowRecord->vrrMode != kPsychVRROff) || (windowRecord->specialflags & kPsychSkipSwapForFlipOnce))
+        return(flipwhen);
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+    onset = PsychFlipSchedulerTargetOnset(windowRecord, flipwhen, tNow);
+    if (onset <= 0)
+        return(flipwhen);
+
+    // Preflip operations are done, only gpu completion and swap submission remain:
+    remaining = PsychFlipSchedulerEstimate(&sched->gpu) + PsychFlipSchedulerEstimate(&sched->swap) + sched->safetyMargin;
+    if (tNow + remaining <= onset)
+        return(flipwhen);
+
+    // Would miss: Target first refresh which can be met, by setting 'flipwhen' half a refresh before it:
+    onset += ceil((tNow + remaining - onset) / ifi) * ifi;
+    sched->throttledFlips++;
+
+    if (PsychPrefStateGet_Verbosity() > 5)
+        printf("PTB-DEBUG: Flip scheduler: Throttling flip to next achievable video refresh at %f secs.\n", onset);
+
+    return(onset - 0.5 * ifi);
+}
+
+/*
+ *    PsychFlipSchedulerGetDeadline()
+ *
+ *    Return the latest time at which rendering of a frame must be submitted via Screen('Flip') to
+ *    present it at the video refresh targeted by 'flipwhen'. A 'flipwhen' of zero means the next video
+ *    refresh whose deadline is not yet over. Returns the predicted stimulus onset time in 'onset', the
+ *    current cost estimates [preflip, gpu, swap] in seconds in 'costs' and the number of throttled flips
+ *    in 'throttledFlips'. Returns zero for deadline and onset if the timing of video refresh is unknown,
+ *    e.g., after a non-vsynced flip.
+ */
+double PsychFlipSchedulerGetDeadline(PsychWindowRecordType *windowRecord, double flipwhen, double *onset, double *costs, int *throttledFlips)
+{
+    PsychFlipSchedulerType *sched;
+    double tNow, cost;
+
+    PsychFlipSchedulerEnable(windowRecord);
+    sched = windowRecord->flipScheduler;
+
+    // Update gpu estimate with all results which are available by now:
+    PsychSetGLContext(windowRecord);
+    PsychFlipSchedulerCollectQueries(sched, FALSE);
+
+    costs[0] = PsychFlipSchedulerEstimate(&sched->preflip);
+    costs[1] = PsychFlipSchedulerEstimate(&sched->gpu);
+    costs[2] = PsychFlipSchedulerEstimate(&sched->swap);
+    cost = costs[0] + costs[1] + costs[2] + sched->safetyMargin;
+    *throttledFlips = sched->throttledFlips;
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+    *onset = PsychFlipSchedulerTargetOnset(windowRecord, flipwhen, tNow);
+    if (*onset <= 0)
+        return(0);
+
+    // Asap flip requested? Then target the first refresh whose deadline is still ahead:
+    if (flipwhen <= 0) {
+        while (*onset - cost < tNow)
+            *onset += windowRecord->VideoRefreshInterval;
+    }
+
+    return(*onset - cost);
+}
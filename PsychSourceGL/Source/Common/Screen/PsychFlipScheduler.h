@@ -0,0 +1,38 @@
+/*
+ *    PsychFlipScheduler.h
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Predictive flip scheduler for onscreen windows: Keeps running estimates of the cost
+ *    of preflip operations, of the gpu completion latency of a frame and of the swap
+ *    request submission. Predicts from them the latest time at which rendering of a
+ *    frame must be submitted via Screen('Flip') to hit a target stimulus onset, see
+ *    Screen('GetFlipDeadline'), and optionally throttles flips whose target can not be
+ *    met anymore to the next achievable video refresh.
+ */
+
+//include once
+#ifndef PSYCH_IS_INCLUDED_PsychFlipScheduler
+#define PSYCH_IS_INCLUDED_PsychFlipScheduler
+
+#include "Screen.h"
+
+void    PsychFlipSchedulerEnable(PsychWindowRecordType *windowRecord);
+void    PsychFlipSchedulerShutdown(PsychWindowRecordType *windowRecord);
+void    PsychFlipSchedulerSetParameters(PsychWindowRecordType *windowRecord, int autoThrottle, double safetyMargin);
+void    PsychFlipSchedulerPreFlipBegin(PsychWindowRecordType *windowRecord);
+void    PsychFlipSchedulerPreFlipEnd(PsychWindowRecordType *windowRecord);
+void    PsychFlipSchedulerSwapRequested(PsychWindowRecordType *windowRecord, double time_at_swaprequest, double time_post_swaprequest);
+double  PsychFlipSchedulerThrottle(PsychWindowRecordType *windowRecord, double flipwhen, int vbl_synclevel, int multiflip);
+double  PsychFlipSchedulerGetDeadline(PsychWindowRecordType *windowRecord, double flipwhen, double *onset, double *costs, int *throttledFlips);
+
+//end include once
+#endif
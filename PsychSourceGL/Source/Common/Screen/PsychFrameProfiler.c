@@ -0,0 +1,328 @@
+/*
+ *    PsychFrameProfiler.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Per-frame profiler for onscreen windows: Measures cpu and gpu time spent in the
+ *    different phases of a frame - user drawing, preflip operations, each executed
+ *    imaging pipeline hook chain, swap and postflip operations. Results are stored
+ *    in a per-window ring buffer and returned by Screen('GetWindowInfo', win, 11).
+ *
+ *    NOTES:
+ *
+ *    Each begin or end of a phase is recorded as a marker with a cpu timestamp and, if
+ *    the GPU supports GL_ARB_timer_query, a GL_TIMESTAMP query. Using timestamps instead
+ *    of GL_TIME_ELAPSED queries allows nesting of phases, e.g., hook chains inside the
+ *    preflip phase, and does not interfere with GPU rendertime queries from
+ *    Screen('GetWindowInfo', win, 5). Query results arrive asynchronously, so the
+ *    markers of a frame are kept in one of a few in-flight slots until the gpu has
+ *    processed the frame, and only then converted into a result record.
+ *
+ *    Markers are only recorded on the master thread. For async flips, the frame gets
+ *    finished when the master thread finalizes the flip in Screen('AsyncFlipEnd') or a
+ *    successfull Screen('AsyncFlipCheckEnd'), so the swap phase spans the time until then,
+ *    and no postflip timing is reported, as postflip operations run on the flipper thread.
+ */
+
+#include "Screen.h"
+
+// Maximum number of markers per frame:
+#define kPsychProfileMaxMarkers 64
+
+// Number of frames whose gpu results can be pending at the same time:
+#define kPsychProfileInFlightFrames 4
+
+typedef struct PsychProfileMarkerType {
+    int                 phase;
+    psych_bool          isEnd;
+    psych_bool          hasQuery;
+    double              cpuTime;
+} PsychProfileMarkerType;
+
+typedef struct PsychProfileFrameSlotType {
+    psych_bool          pending;        // Frame is finished, but results not yet converted into a record.
+    int                 frameCount;     // Value of windowRecord->flipCount at end of frame.
+    double              startTime;      // Cpu time at start of frame.
+    int                 numMarkers;
+    PsychProfileMarkerType markers[kPsychProfileMaxMarkers];
+    GLuint              queries[kPsychProfileMaxMarkers];
+} PsychProfileFrameSlotType;
+
+typedef struct PsychProfileRecordType {
+    int                 frameCount;
+    double              startTime;
+    double              cpu[kPsychProfileNumPhases];
+    double              gpu[kPsychProfileNumPhases];
+} PsychProfileRecordType;
+
+typedef struct PsychFrameProfilerType {
+    psych_bool          gpuTiming;      // GL_TIMESTAMP queries supported and used?
+    int                 current;        // Index of slot of the currently open frame, -1 if none.
+    int                 next;           // Index of next slot to use for a new frame.
+    PsychProfileFrameSlotType slots[kPsychProfileInFlightFrames];
+    int                 numRecords;     // Capacity of result ring buffer.
+    int                 writeIdx;       // Next record to write.
+    int                 count;          // Number of valid records.
+    PsychProfileRecordType *records;
+} PsychFrameProfilerType;
+
+// Convert markers of finished frame in slot 'idx' into a new result record. Returns FALSE
+// without doing anything if 'wait' is FALSE and the gpu results are not yet available:
+static psych_bool PsychProfilerResolveSlot(PsychFrameProfilerType *prof, int idx, psych_bool wait)
+{
+    PsychProfileFrameSlotType *slot = &(prof->slots[idx]);
+    PsychProfileRecordType *record;
+    PsychProfileMarkerType *m;
+    double startCpu[kPsychProfileNumPhases];
+    GLuint64 startGpu[kPsychProfileNumPhases];
+    psych_bool isOpen[kPsychProfileNumPhases];
+    GLuint64 gpuTime = 0;
+    GLuint available;
+    int i, lastQuery;
+
+    if (!slot->pending) return(TRUE);
+
+    // Results of timestamp queries become available in submission order, so checking the
+    // last query of the frame is sufficient:
+    lastQuery = -1;
+    for (i = 0; i < slot->numMarkers; i++) if (slot->markers[i].hasQuery) lastQuery = i;
+
+    if (!wait && (lastQuery >= 0)) {
+        available = 0;
+        glGetQueryObjectuiv(slot->queries[lastQuery], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return(FALSE);
+    }
+
+    record = &(prof->records[prof->writeIdx]);
+    record->frameCount = slot->frameCount;
+    record->startTime = slot->startTime;
+    for (i = 0; i < kPsychProfileNumPhases; i++) {
+        record->cpu[i] = 0;
+        record->gpu[i] = (prof->gpuTiming && (i != kPsychProfilePhaseSwap)) ? 0 : -1;
+        isOpen[i] = FALSE;
+    }
+
+    // Accumulate the durations of all begin/end pairs per phase. Hook chains can execute
+    // multiple times per frame, e.g., once per stereo view:
+    for (i = 0; i < slot->numMarkers; i++) {
+        m = &(slot->markers[i]);
+        if (m->hasQuery) glGetQueryObjectui64v(slot->queries[i], GL_QUERY_RESULT, &gpuTime);
+
+        if (!m->isEnd) {
+            startCpu[m->phase] = m->cpuTime;
+            startGpu[m->phase] = gpuTime;
+            isOpen[m->phase] = TRUE;
+        }
+        else if (isOpen[m->phase]) {
+            record->cpu[m->phase] += m->cpuTime - startCpu[m->phase];
+            if (m->hasQuery) record->gpu[m->phase] += (double) (gpuTime - startGpu[m->phase]) / 1e9;
+            isOpen[m->phase] = FALSE;
+        }
+    }
+
+    prof->writeIdx = (prof->writeIdx + 1) % prof->numRecords;
+    if (prof->count < prof->numRecords) prof->count++;
+    slot->pending = FALSE;
+
+    return(TRUE);
+}
+
+// Convert all finished frames into result records, in order, as long as their results are available:
+static void PsychProfilerResolvePending(PsychFrameProfilerType *prof)
+{
+    int i;
+
+    for (i = 0; i < kPsychProfileInFlightFrames; i++) {
+        if (!PsychProfilerResolveSlot(prof, (prof->next + i) % kPsychProfileInFlightFrames, FALSE)) break;
+    }
+}
+
+static void PsychProfilerAddMarker(PsychWindowRecordType *windowRecord, int phase, psych_bool isEnd)
+{
+    PsychFrameProfilerType *prof = windowRecord->frameProfiler;
+    PsychProfileFrameSlotType *slot;
+    PsychProfileMarkerType *m;
+
+    if (!prof || !PsychIsMasterThread()) return;
+
+    // Open a new frame if none is open, e.g., for the first frame after enable:
+    if (prof->current < 0) {
+        if (isEnd) return;
+
+        // Reusing the slot of the oldest frame, whose gpu results must be complete by now:
+        PsychProfilerResolveSlot(prof, prof->next, TRUE);
+        slot = &(prof->slots[prof->next]);
+        slot->numMarkers = 0;
+        PsychGetAdjustedPrecisionTimerSeconds(&slot->startTime);
+        prof->current = prof->next;
+        prof->next = (prof->next + 1) % kPsychProfileInFlightFrames;
+    }
+
+    slot = &(prof->slots[prof->current]);
+    if (slot->numMarkers >= kPsychProfileMaxMarkers) return;
+
+    m = &(slot->markers[slot->numMarkers]);
+    m->phase = phase;
+    m->isEnd = isEnd;
+    m->hasQuery = (prof->gpuTiming && (phase != kPsychProfilePhaseSwap)) ? TRUE : FALSE;
+    PsychGetAdjustedPrecisionTimerSeconds(&m->cpuTime);
+    if (m->hasQuery) glQueryCounter(slot->queries[slot->numMarkers], GL_TIMESTAMP);
+
+    slot->numMarkers++;
+}
+
+/*
+ *    PsychProfilerEnable()
+ *
+ *    Enable profiling for onscreen window 'windowRecord' with a result ring buffer
+ *    of 'numRecords' frames, or disable it if 'numRecords' is zero. Enabling an
+ *    already enabled profiler discards all previous results.
+ */
+void PsychProfilerEnable(PsychWindowRecordType *windowRecord, int numRecords)
+{
+    PsychFrameProfilerType *prof;
+    int i;
+
+    PsychProfilerShutdown(windowRecord);
+    if (numRecords <= 0) return;
+
+    prof = (PsychFrameProfilerType*) calloc(1, sizeof(PsychFrameProfilerType));
+    if (prof) prof->records = (PsychProfileRecordType*) calloc(numRecords, sizeof(PsychProfileRecordType));
+    if (!prof || !prof->records) {
+        free(prof);
+        PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while trying to allocate frame profiler result buffer!");
+    }
+
+    prof->numRecords = numRecords;
+    prof->current = -1;
+
+    PsychSetGLContext(windowRecord);
+    prof->gpuTiming = (!PsychIsGLES(windowRecord) && glewIsSupported("GL_ARB_timer_query")) ? TRUE : FALSE;
+    if (prof->gpuTiming) {
+        for (i = 0; i < kPsychProfileInFlightFrames; i++) glGenQueries(kPsychProfileMaxMarkers, prof->slots[i].queries);
+    }
+    else if (PsychPrefStateGet_Verbosity() > 2) {
+        printf("PTB-INFO: Frame profiler: GPU timestamp queries unsupported on this GPU. Only cpu timing will be reported.\n");
+    }
+
+    windowRecord->frameProfiler = prof;
+}
+
+/*
+ *    PsychProfilerShutdown()
+ *
+ *    Disable profiling for 'windowRecord' and release all resources. Needs the OpenGL
+ *    context of the window, so must be called before it is destroyed.
+ */
+void PsychProfilerShutdown(PsychWindowRecordType *windowRecord)
+{
+    PsychFrameProfilerType *prof = windowRecord->frameProfiler;
+    int i;
+
+    if (!prof) return;
+
+    if (prof->gpuTiming) {
+        PsychSetGLContext(windowRecord);
+        for (i = 0; i < kPsychProfileInFlightFrames; i++) glDeleteQueries(kPsychProfileMaxMarkers, prof->slots[i].queries);
+    }
+
+    free(prof->records);
+    free(prof);
+    windowRecord->frameProfiler = NULL;
+}
+
+/*
+ *    PsychProfilerPhaseBegin() / PsychProfilerPhaseEnd()
+ *
+ *    Mark begin and end of 'phase' in the current frame. No-Op if profiling is disabled.
+ *    The OpenGL context of 'windowRecord' must be bound.
+ */
+void PsychProfilerPhaseBegin(PsychWindowRecordType *windowRecord, int phase)
+{
+    PsychProfilerAddMarker(windowRecord, phase, FALSE);
+}
+
+void PsychProfilerPhaseEnd(PsychWindowRecordType *windowRecord, int phase)
+{
+    PsychProfilerAddMarker(windowRecord, phase, TRUE);
+}
+
+/*
+ *    PsychProfilerFrameBoundary()
+ *
+ *    Called on the master thread after completion of a flip, or after finalization of an
+ *    async flip: Finishes the current frame and starts the user drawing phase of the next frame.
+ */
+void PsychProfilerFrameBoundary(PsychWindowRecordType *windowRecord)
+{
+    PsychFrameProfilerType *prof = windowRecord->frameProfiler;
+
+    if (!prof || !PsychIsMasterThread()) return;
+
+    if (prof->current >= 0) {
+        prof->slots[prof->current].frameCount = windowRecord->flipCount;
+        prof->slots[prof->current].pending = TRUE;
+        prof->current = -1;
+    }
+
+    PsychProfilerResolvePending(prof);
+    PsychProfilerPhaseBegin(windowRecord, kPsychProfilePhaseUserDrawing);
+}
+
+/*
+ *    PsychProfilerCopyOutResults()
+ *
+ *    Return all result records for frames whose results are available as struct array in
+ *    return argument 'position', oldest frame first, then remove them from the ring buffer.
+ */
+void PsychProfilerCopyOutResults(PsychWindowRecordType *windowRecord, int position)
+{
+    const char *FieldNames[] = { "FrameCount", "FrameStartTime", "UserDrawingCPU", "UserDrawingGPU", "PreFlipCPU", "PreFlipGPU",
+                                 "SwapCPU", "PostFlipCPU", "PostFlipGPU", "HookChainCPU", "HookChainGPU" };
+    const int fieldCount = 11;
+    PsychFrameProfilerType *prof = windowRecord->frameProfiler;
+    PsychGenericScriptType *s, *outMat;
+    PsychProfileRecordType *record;
+    double *v;
+    int i, j, count;
+
+    count = 0;
+    if (prof) {
+        PsychSetGLContext(windowRecord);
+        PsychProfilerResolvePending(prof);
+        count = prof->count;
+    }
+
+    PsychAllocOutStructArray(position, FALSE, count, fieldCount, FieldNames, &s);
+
+    for (i = 0; i < count; i++) {
+        record = &(prof->records[(prof->writeIdx - count + i + prof->numRecords) % prof->numRecords]);
+        PsychSetStructArrayDoubleElement("FrameCount", i, (double) record->frameCount, s);
+        PsychSetStructArrayDoubleElement("FrameStartTime", i, record->startTime, s);
+        PsychSetStructArrayDoubleElement("UserDrawingCPU", i, record->cpu[kPsychProfilePhaseUserDrawing], s);
+        PsychSetStructArrayDoubleElement("UserDrawingGPU", i, record->gpu[kPsychProfilePhaseUserDrawing], s);
+        PsychSetStructArrayDoubleElement("PreFlipCPU", i, record->cpu[kPsychProfilePhasePreFlip], s);
+        PsychSetStructArrayDoubleElement("PreFlipGPU", i, record->gpu[kPsychProfilePhasePreFlip], s);
+        PsychSetStructArrayDoubleElement("SwapCPU", i, record->cpu[kPsychProfilePhaseSwap], s);
+        PsychSetStructArrayDoubleElement("PostFlipCPU", i, record->cpu[kPsychProfilePhasePostFlip], s);
+        PsychSetStructArrayDoubleElement("PostFlipGPU", i, record->gpu[kPsychProfilePhasePostFlip], s);
+
+        PsychAllocateNativeDoubleMat(1, MAX_SCREEN_HOOKS, 1, &v, &outMat);
+        for (j = 0; j < MAX_SCREEN_HOOKS; j++) v[j] = record->cpu[kPsychProfilePhaseHookChain + j];
+        PsychSetStructArrayNativeElement("HookChainCPU", i, outMat, s);
+
+        PsychAllocateNativeDoubleMat(1, MAX_SCREEN_HOOKS, 1, &v, &outMat);
+        for (j = 0; j < MAX_SCREEN_HOOKS; j++) v[j] = record->gpu[kPsychProfilePhaseHookChain + j];
+        PsychSetStructArrayNativeElement("HookChainGPU", i, outMat, s);
+    }
+
+    if (prof) prof->count = 0;
+}
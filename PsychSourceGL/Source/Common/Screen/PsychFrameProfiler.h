@@ -0,0 +1,45 @@
+/*
+ *    PsychFrameProfiler.h
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Per-frame profiler for onscreen windows: Measures cpu and gpu time spent in the
+ *    different phases of a frame - user drawing, preflip operations, each executed
+ *    imaging pipeline hook chain, swap and postflip operations. Results are stored
+ *    in a per-window ring buffer and returned by Screen('GetWindowInfo', win, 11).
+ */
+
+//include once
+#ifndef PSYCH_IS_INCLUDED_PsychFrameProfiler
+#define PSYCH_IS_INCLUDED_PsychFrameProfiler
+
+#include "Screen.h"
+
+// Profiled phases of a frame. Hook chain 'hookId' is profiled as phase kPsychProfilePhaseHookChain + hookId:
+typedef enum {
+    kPsychProfilePhaseUserDrawing   = 0,    // From end of previous flip to start of preflip operations.
+    kPsychProfilePhasePreFlip       = 1,    // All of PsychPreFlipOperations(), including the hook chains executed in it.
+    kPsychProfilePhaseSwap          = 2,    // From end of preflip operations until swap completion. Cpu time only.
+    kPsychProfilePhasePostFlip      = 3,    // PsychPostFlipOperations(), e.g., backbuffer clear.
+    kPsychProfilePhaseHookChain     = 4     // First of MAX_SCREEN_HOOKS hook chain phases.
+} PsychProfilePhaseType;
+
+#define kPsychProfileNumPhases (kPsychProfilePhaseHookChain + MAX_SCREEN_HOOKS)
+
+void    PsychProfilerEnable(PsychWindowRecordType *windowRecord, int numRecords);
+void    PsychProfilerShutdown(PsychWindowRecordType *windowRecord);
+void    PsychProfilerPhaseBegin(PsychWindowRecordType *windowRecord, int phase);
+void    PsychProfilerPhaseEnd(PsychWindowRecordType *windowRecord, int phase);
+void    PsychProfilerFrameBoundary(PsychWindowRecordType *windowRecord);
+void    PsychProfilerCopyOutResults(PsychWindowRecordType *windowRecord, int position);
+
+//end include once
+#endif
@@ -28,6 +28,24 @@
 */
 
 #include "Screen.h"
+#include <ctype.h>
+#include <time.h>
+
+#if PSYCH_SYSTEM == PSYCH_WINDOWS
+#include <sys/utime.h>
+#define utime _utime
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <utime.h>
+#endif
+
+static void PsychPipelineReleaseFusedShaders(PsychWindowRecordType *windowRecord, int hookidx);
+
+// Statistics of the GLSL program binary cache, see PsychCreateGLSLProgram():
+static int glslCacheHits = 0;
+static int glslCacheMisses = 0;
+static double glslCacheSavedSecs = 0;
 
 static char texturePlanar1FragmentShaderSrc[] =
 "\n"
@@ -426,6 +444,7 @@ void PsychInitImagingPipelineDefaultsForWindowRecord(PsychWindowRecordType *wind
     windowRecord->finalizedFBO[0]=-1;
     windowRecord->finalizedFBO[1]=-1;
     windowRecord->fboCount = 0;
+    windowRecord->fboPooledBytes = 0;
 
     // NULL-out fboTable:
     for (i=0; i<MAX_FBOTABLE_SLOTS; i++) windowRecord->fboTable[i] = NULL;
@@ -436,6 +455,126 @@ void PsychInitImagingPipelineDefaultsForWindowRecord(PsychWindowRecordType *wind
     return;
 }
 
+/* Processing stages of the imaging pipeline during PsychPreFlipOperations(), in order of execution. Used as
+ * bitmasks to describe during which stages the content of an intermediate buffer must stay valid:
+ */
+#define kPsychPipelineStageResolve      1   // Multisample resolve / panel fitting: drawBufferFBO -> inputBufferFBO.
+#define kPsychPipelineStageProcessing   2   // Image processing: inputBufferFBO -> processedDrawBufferFBO.
+#define kPsychPipelineStageMerge        4   // Stereo merge: processedDrawBufferFBO -> preConversionFBO.
+#define kPsychPipelineStageOutput       8   // Output formatting: preConversionFBO -> finalizedFBO.
+
+/*  PsychGetFBOMemoryBytes()
+*
+*  Return the approximate amount of graphics memory in bytes which is allocated for the color-,
+*  depth- and stencil-buffers of the given PsychFBO. Pseudo-FBO's which represent the system
+*  framebuffer, and FBO's whose color buffer is backed by imported external memory, count as zero.
+*/
+static double PsychGetFBOMemoryBytes(PsychFBO *fbo)
+{
+    double bpp, bytes;
+
+    if ((fbo == NULL) || (fbo->fboid == 0) || (fbo->memoryObject != 0))
+        return(0);
+
+    switch (fbo->format) {
+        case GL_RGBA_FLOAT32_APPLE:
+            bpp = 16;
+        break;
+
+        case GL_RGBA16:
+        case GL_RGBA16_SNORM:
+        case GL_RGBA_FLOAT16_APPLE:
+            bpp = 8;
+        break;
+
+        default:
+            bpp = 4;
+    }
+
+    // Depth buffer, typically packed 24 bit depth + 8 bit stencil, and separate stencil buffer, if any:
+    if (fbo->ztexid) bpp += 4;
+    if (fbo->stexid) bpp += 1;
+
+    bytes = bpp * (double) fbo->width * (double) fbo->height;
+    if (fbo->multisample > 0) bytes *= (double) fbo->multisample;
+
+    return(bytes);
+}
+
+/*  PsychPipelineGetMemoryFootprint()
+*
+*  Return the total graphics memory in bytes allocated for the framebuffer objects of 'windowRecord', e.g.,
+*  for all buffers of its imaging pipeline. FBO's which are referenced by multiple fboTable slots are only
+*  counted once. If 'pooledBytes' is non-NULL, it returns the bytes saved by sharing pooled FBO's between
+*  pipeline stages, see PsychPipelineCreatePooledFBO().
+*/
+double PsychPipelineGetMemoryFootprint(PsychWindowRecordType *windowRecord, double *pooledBytes)
+{
+    double total = 0;
+    int i, j;
+
+    for (i = 0; i < windowRecord->fboCount; i++) {
+        for (j = 0; j < i; j++)
+            if (windowRecord->fboTable[j] == windowRecord->fboTable[i])
+                break;
+
+        if (j == i)
+            total += PsychGetFBOMemoryBytes(windowRecord->fboTable[i]);
+    }
+
+    if (pooledBytes)
+        *pooledBytes = windowRecord->fboPooledBytes;
+
+    return(total);
+}
+
+/*  PsychPipelineCreatePooledFBO()
+*
+*  Create or reuse an intermediate FBO of the imaging pipeline, whose content is only needed during the processing
+*  'stages' of a flip. All stages of a flip are executed in order, and intermediate buffers carry no content from
+*  one flip to the next, so buffers whose content is needed in disjoint sets of stages can share one FBO. This
+*  function searches all previously pooled FBO's for one with identical format and size whose content is not
+*  needed during any of the 'stages', and returns its fboTable slot for shared use. Otherwise it creates a new
+*  FBO without z-buffer and multisampling in the next free fboTable slot.
+*
+*  fbocount  = Pointer to the current count of FBO's in the fboTable. Incremented if a new FBO is created.
+*  fboStages = Per fboTable slot bitmask of stages during which a pooled FBO is in use. Zero for non-pooled FBO's.
+*
+*  Pooling can be disabled by setting the environment variable PSYCH_DISABLE_FBO_POOLING.
+*
+*  Returns the fboTable slot of the FBO, or -1 if a new FBO could not be created.
+*/
+static int PsychPipelineCreatePooledFBO(PsychWindowRecordType *windowRecord, int *fbocount, unsigned int *fboStages, GLenum fboInternalFormat,
+                                        int width, int height, unsigned int stages)
+{
+    PsychFBO *fbo;
+    int i;
+
+    if (!getenv("PSYCH_DISABLE_FBO_POOLING")) {
+        for (i = 0; i < *fbocount; i++) {
+            fbo = windowRecord->fboTable[i];
+            if ((fboStages[i] != 0) && !(fboStages[i] & stages) && (fbo->format == fboInternalFormat) &&
+                (fbo->width == width) && (fbo->height == height)) {
+                // Compatible FBO which is idle during all requested stages: Share it.
+                fboStages[i] |= stages;
+                windowRecord->fboPooledBytes += PsychGetFBOMemoryBytes(fbo);
+
+                if (PsychPrefStateGet_Verbosity() > 5)
+                    printf("PTB-DEBUG: Imaging pipeline: Sharing pooled FBO in fboTable slot %i with another pipeline stage.\n", i);
+
+                return(i);
+            }
+        }
+    }
+
+    if (!PsychCreateFBO(&(windowRecord->fboTable[*fbocount]), fboInternalFormat, FALSE, width, height, 0, 0))
+        return(-1);
+
+    fboStages[*fbocount] = stages;
+
+    return((*fbocount)++);
+}
+
 /*  PsychInitializeImagingPipeline()
 *
 *  Initialize imaging pipeline for windowRecord, applying the imagingmode flags. Called by Screen('OpenWindow').
@@ -456,10 +595,15 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
     int winwidth, winheight;
     int clientwidth, clientheight;
     psych_bool needzbuffer, needoutputconversion, needimageprocessing, needseparatestreams, needfastbackingstore, targetisfinalFB;
+    psych_bool needmergefbo, needconversionbouncefbo;
+    unsigned int fboStages[MAX_FBOTABLE_SLOTS];
+    unsigned int stages;
     GLuint glsl;
     GLint redbits;
     float rg, gg, bg;    // Gains for color channels and color masking for anaglyph shader setup.
     char blittercfg[1000];
+    int cacheHits = glslCacheHits, cacheMisses = glslCacheMisses;
+    double cacheSavedSecs = glslCacheSavedSecs;
 
     // Processing ends here after minimal "all off" setup, if pipeline is disabled:
     if (imagingmode<=0) {
@@ -668,9 +812,18 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
         needfastbackingstore = TRUE;
     }
 
+    // Do we need a real FBO as target for merging the two stereo views? Only if output conversion follows:
+    needmergefbo = ((windowRecord->stereomode > 0) && !needseparatestreams && needoutputconversion) ? TRUE : FALSE;
+
+    // Do we need bounce buffers for stereo merge and/or output conversion?
+    needconversionbouncefbo = (((windowRecord->stereomode > 0) && !needseparatestreams) || needoutputconversion) ? TRUE : FALSE;
+
     // Try to allocate and configure proper FBO's:
     fbocount = 0;
 
+    // No intermediate FBO's pooled yet:
+    memset(fboStages, 0, sizeof(fboStages));
+
     // Define final default output buffers as system framebuffers: We create some pseudo-FBO's for these
     // which describe the system framebuffer (backbuffer). This is done to simplify pipeline design:
 
@@ -912,16 +1065,18 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
         // c) No output conversion / final formatting needed.
         targetisfinalFB = ( !needimageprocessing && ((windowRecord->stereomode == kPsychMonoscopic) || needseparatestreams) && !needoutputconversion ) ? TRUE : FALSE;
 
+        // The inputBuffers are only needed until image processing is done. Without image processing they
+        // also act as processedDrawBuffers and are needed until the end of the pipeline:
+        stages = kPsychPipelineStageResolve | kPsychPipelineStageProcessing;
+        if (!needimageprocessing) stages |= kPsychPipelineStageMerge | kPsychPipelineStageOutput;
+
         if (!targetisfinalFB) {
-            // Yes. Setup real inputBuffers as multisample-resolve / scaler targets:
-            if (!PsychCreateFBO(&(windowRecord->fboTable[fbocount]), fboInternalFormat, FALSE, winwidth, winheight, 0, 0)) {
+            // Yes. Setup real inputBuffers as multisample-resolve / scaler targets, assign as inputBufferFBO for left-eye or mono channel:
+            windowRecord->inputBufferFBO[0] = PsychPipelineCreatePooledFBO(windowRecord, &fbocount, fboStages, fboInternalFormat, winwidth, winheight, stages);
+            if (windowRecord->inputBufferFBO[0] < 0) {
                 // Failed!
                 PsychErrorExitMsg(PsychError_system, "Imaging Pipeline setup: Could not setup stage 1 inputBufferFBO of imaging pipeline.");
             }
-
-            // Assign this FBO as inputBufferFBO for left-eye or mono channel:
-            windowRecord->inputBufferFBO[0] = fbocount;
-            fbocount++;
         }
         else {
             // Nothing further to do! Just set us as final framebuffer:
@@ -931,14 +1086,12 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
         // If we are in stereo mode, we'll need a 2nd buffer for the right-eye channel:
         if (windowRecord->stereomode > 0) {
             if (!targetisfinalFB) {
-                if (!PsychCreateFBO(&(windowRecord->fboTable[fbocount]), fboInternalFormat, FALSE, winwidth, winheight, 0, 0)) {
+                // Assign this FBO as inputBufferFBO for right-eye channel:
+                windowRecord->inputBufferFBO[1] = PsychPipelineCreatePooledFBO(windowRecord, &fbocount, fboStages, fboInternalFormat, winwidth, winheight, stages);
+                if (windowRecord->inputBufferFBO[1] < 0) {
                     // Failed!
                     PsychErrorExitMsg(PsychError_system, "Imaging Pipeline setup: Could not setup stage 1 inputBufferFBO of imaging pipeline.");
                 }
-
-                // Assign this FBO as drawBuffer for right-eye channel:
-                windowRecord->inputBufferFBO[1] = fbocount;
-                fbocount++;
             }
             else {
                 // Nothing further to do! Just set us as final framebuffer:
@@ -989,16 +1142,17 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
         // cannot switch between left- and right backbuffer of the system framebuffer...
         targetisfinalFB = ( !(imagingmode & kPsychNeedMultiPass) && (windowRecord->stereomode == kPsychMonoscopic) && !needoutputconversion ) ? TRUE : FALSE;
 
+        // The processedDrawBuffers are needed until stereo merge, or until output conversion if there isn't a merge FBO:
+        stages = kPsychPipelineStageProcessing | kPsychPipelineStageMerge;
+        if (!needmergefbo) stages |= kPsychPipelineStageOutput;
+
         if (!targetisfinalFB) {
-            // These FBO's don't need z- or stencil buffers anymore:
-            if (!PsychCreateFBO(&(windowRecord->fboTable[fbocount]), fboInternalFormat, FALSE, winwidth, winheight, 0, 0)) {
+            // These FBO's don't need z- or stencil buffers anymore. Assign as processedDrawBuffer for left-eye or mono channel:
+            windowRecord->processedDrawBufferFBO[0] = PsychPipelineCreatePooledFBO(windowRecord, &fbocount, fboStages, fboInternalFormat, winwidth, winheight, stages);
+            if (windowRecord->processedDrawBufferFBO[0] < 0) {
                 // Failed!
                 PsychErrorExitMsg(PsychError_system, "Imaging Pipeline setup: Could not setup stage 2 of imaging pipeline.");
             }
-
-            // Assign this FBO as processedDrawBuffer for left-eye or mono channel:
-            windowRecord->processedDrawBufferFBO[0] = fbocount;
-            fbocount++;
         }
         else {
             // Can assign final destination:
@@ -1008,15 +1162,12 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
         // If we are in stereo mode, we'll need a 2nd buffer for the right-eye channel:
         if (windowRecord->stereomode > 0) {
             if (!targetisfinalFB) {
-                // These FBO's don't need z- or stencil buffers anymore:
-                if (!PsychCreateFBO(&(windowRecord->fboTable[fbocount]), fboInternalFormat, FALSE, winwidth, winheight, 0, 0)) {
+                // These FBO's don't need z- or stencil buffers anymore. Assign as processedDrawBuffer for right-eye channel:
+                windowRecord->processedDrawBufferFBO[1] = PsychPipelineCreatePooledFBO(windowRecord, &fbocount, fboStages, fboInternalFormat, winwidth, winheight, stages);
+                if (windowRecord->processedDrawBufferFBO[1] < 0) {
                     // Failed!
                     PsychErrorExitMsg(PsychError_system, "Imaging Pipeline setup: Could not setup stage 2 of imaging pipeline.");
                 }
-
-                // Assign this FBO as processedDrawBuffer for right-eye channel:
-                windowRecord->processedDrawBufferFBO[1] = fbocount;
-                fbocount++;
             }
             else {
                 // Can assign final destination:
@@ -1030,14 +1181,16 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
 
         // Allocate a bounce-buffer as well if multi-pass rendering is requested:
         if (imagingmode & kPsychNeedDualPass || imagingmode & kPsychNeedMultiPass) {
-            if (!PsychCreateFBO(&(windowRecord->fboTable[fbocount]), fboInternalFormat, FALSE, winwidth, winheight, 0, 0)) {
+            // This bounce buffer gets reused below for stereo merge and output conversion, if those need one:
+            stages = kPsychPipelineStageProcessing;
+            if (needconversionbouncefbo) stages |= kPsychPipelineStageMerge | kPsychPipelineStageOutput;
+
+            // Assign this FBO as processedDrawBuffer for bounce buffer ops in multi-pass rendering:
+            windowRecord->processedDrawBufferFBO[2] = PsychPipelineCreatePooledFBO(windowRecord, &fbocount, fboStages, fboInternalFormat, winwidth, winheight, stages);
+            if (windowRecord->processedDrawBufferFBO[2] < 0) {
                 // Failed!
                 PsychErrorExitMsg(PsychError_system, "Imaging Pipeline setup: Could not setup stage 2 of imaging pipeline.");
             }
-
-            // Assign this FBO as processedDrawBuffer for bounce buffer ops in multi-pass rendering:
-            windowRecord->processedDrawBufferFBO[2] = fbocount;
-            fbocount++;
         }
         else {
             // No need for bounce-buffers, only single-pass processing requested.
@@ -1054,7 +1207,7 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
     // Stage 2 ready. Any need for real merged FBO's? We need a merged FBO if we are in stereo mode
     // and in need to merge output from the two views and to postprocess that output. In all other
     // cases there's no need for real merged FBO's and we do just a "pass-through" assignment.
-    if ((windowRecord->stereomode > 0) && (!needseparatestreams) && (needoutputconversion)) {
+    if (needmergefbo) {
         // Need real FBO's as targets for merger output.
 
         // Define dimensions of 3rd stage FBO:
@@ -1075,15 +1228,15 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
         }
 
         // These FBO's don't need z- or stencil buffers anymore:
-        if (!PsychCreateFBO(&(windowRecord->fboTable[fbocount]), fboInternalFormat, FALSE, winwidth, winheight, 0, 0)) {
+        windowRecord->preConversionFBO[0] = PsychPipelineCreatePooledFBO(windowRecord, &fbocount, fboStages, fboInternalFormat, winwidth, winheight,
+                                                                         kPsychPipelineStageMerge | kPsychPipelineStageOutput);
+        if (windowRecord->preConversionFBO[0] < 0) {
             // Failed!
             PsychErrorExitMsg(PsychError_system, "Imaging Pipeline setup: Could not setup stage 3 of imaging pipeline.");
         }
 
         // Assign this FBO for left-eye and right-eye channel: The FBO is shared accross channels...
-        windowRecord->preConversionFBO[0] = fbocount;
-        windowRecord->preConversionFBO[1] = fbocount;
-        fbocount++;
+        windowRecord->preConversionFBO[1] = windowRecord->preConversionFBO[0];
 
         // Request bounce buffer:
         windowRecord->preConversionFBO[2] = -1000;
@@ -1134,24 +1287,23 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
             windowRecord->preConversionFBO[2] = windowRecord->processedDrawBufferFBO[2];
         }
         else {
-            // We need a new, private bounce-buffer:
-            if (!PsychCreateFBO(&(windowRecord->fboTable[fbocount]), fboInternalFormat, FALSE, winwidth, winheight, 0, 0)) {
+            // We need a new bounce-buffer, private to the merge and conversion stages:
+            windowRecord->preConversionFBO[2] = PsychPipelineCreatePooledFBO(windowRecord, &fbocount, fboStages, fboInternalFormat, winwidth, winheight,
+                                                                             kPsychPipelineStageMerge | kPsychPipelineStageOutput);
+            if (windowRecord->preConversionFBO[2] < 0) {
                 // Failed!
                 PsychErrorExitMsg(PsychError_system, "Imaging Pipeline setup: Could not setup stage 3 of imaging pipeline [1st bounce buffer].");
             }
-
-            windowRecord->preConversionFBO[2] = fbocount;
-            fbocount++;
         }
 
-        // In any case, we need a new private 2nd bounce buffer for the special case of the final processing chain:
-        if (!PsychCreateFBO(&(windowRecord->fboTable[fbocount]), fboInternalFormat, FALSE, winwidth, winheight, 0, 0)) {
+        // In any case, we need a 2nd bounce buffer for the special case of the final processing chain. It is only
+        // used during output conversion, so it can share storage with buffers of earlier stages:
+        windowRecord->preConversionFBO[3] = PsychPipelineCreatePooledFBO(windowRecord, &fbocount, fboStages, fboInternalFormat, winwidth, winheight,
+                                                                         kPsychPipelineStageOutput);
+        if (windowRecord->preConversionFBO[3] < 0) {
             // Failed!
             PsychErrorExitMsg(PsychError_system, "Imaging Pipeline setup: Could not setup stage 3 of imaging pipeline [2nd bounce buffer].");
         }
-
-        windowRecord->preConversionFBO[3] = fbocount;
-        fbocount++;
     }
 
     // If dualwindow output is requested and preConversionFBO[1] isn't assigned yet, or is the system fb,
@@ -1387,6 +1539,15 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
     windowRecord->imagingMode = newimagingmode;
     windowRecord->fboCount = fbocount;
 
+    // Report graphics memory footprint of the pipelines framebuffers:
+    if (PsychPrefStateGet_Verbosity() > 3) {
+        double pooledBytes, totalBytes;
+
+        totalBytes = PsychPipelineGetMemoryFootprint(windowRecord, &pooledBytes);
+        printf("PTB-INFO: Imaging pipeline framebuffers use %.1f MB of graphics memory, %.1f MB saved by sharing buffers between pipeline stages.\n",
+               totalBytes / 1024 / 1024, pooledBytes / 1024 / 1024);
+    }
+
     // The pipelines buffers and information flow are configured now...
     if (PsychPrefStateGet_Verbosity()>4) {
         int i;
@@ -1598,10 +1759,264 @@ void PsychInitializeImagingPipeline(PsychWindowRecordType *windowRecord, int ima
     // framebuffer - important for all the timing tests and calibrations to work correctly.
     PsychSetDrawingTarget((PsychWindowRecordType*) 0x1);
 
+    // Report use of the GLSL program binary cache during pipeline setup:
+    if ((PsychPrefStateGet_Verbosity() > 3) && (glslCacheHits > cacheHits)) {
+        printf("PTB-INFO: Imaging pipeline setup: Loaded %i GLSL programs from the program binary cache, compiled %i. Saved %f msecs of shader compilation.\n",
+               glslCacheHits - cacheHits, glslCacheMisses - cacheMisses, 1000 * (glslCacheSavedSecs - cacheSavedSecs));
+    }
+
     // Well done.
     return;
 }
 
+/* On-disk cache of linked GLSL program binaries, to skip shader compilation on repeated window opens.
+ * Cache files are stored in the Psychtoolbox configuration folder, keyed by a hash of the shader source
+ * code, the Screen build and the OpenGL vendor, renderer and version strings, so a driver update or a
+ * change of shader code causes a cache miss and recompilation. Can be disabled by setting the environment
+ * variable PSYCH_DISABLE_GLSL_PROGRAM_CACHE. Cache files unused for more than PSYCH_GLSL_CACHE_MAXAGE_DAYS
+ * days, or beyond a total cache size of PSYCH_GLSL_CACHE_MAXBYTES, get deleted, least recently used first.
+ */
+#define PSYCH_GLSL_CACHE_MAXAGE_DAYS    30
+#define PSYCH_GLSL_CACHE_MAXBYTES       (64 * 1024 * 1024)
+#define PSYCH_GLSL_CACHE_MAXENTRIES     1024
+
+typedef struct PsychGLSLProgramCacheHeader {
+    char        magic[8];       // "PTBGLSL1"
+    GLenum      format;         // Binary format as reported by glGetProgramBinary().
+    GLint       length;         // Size of binary in bytes, following the header.
+    double      compileSecs;    // Duration of original compile and link.
+} PsychGLSLProgramCacheHeader;
+
+// FNV-1a hash of a string, including its terminating zero:
+static psych_uint64 PsychGLSLProgramCacheHash(psych_uint64 hash, const char* str)
+{
+    if (str == NULL) str = "";
+
+    do {
+        hash ^= (psych_uint64) (unsigned char) *str;
+        hash *= 1099511628211ULL;
+    } while (*str++);
+
+    return(hash);
+}
+
+// Build path of cache file for given shader sources into 'path'. Returns FALSE if caching is unavailable:
+static psych_bool PsychGLSLProgramCachePath(char* path, size_t pathSize, const char* fragmentsrc, const char* vertexsrc)
+{
+    psych_uint64 hash = 14695981039346656037ULL;
+    char build[16];
+
+    if (!glewIsSupported("GL_ARB_get_program_binary") || getenv("PSYCH_DISABLE_GLSL_PROGRAM_CACHE") ||
+        (strlen(PsychRuntimeGetPsychtoolboxRoot(TRUE)) == 0))
+        return(FALSE);
+
+    sprintf(build, "%i", PsychGetBuildNumber());
+    hash = PsychGLSLProgramCacheHash(hash, build);
+    hash = PsychGLSLProgramCacheHash(hash, (const char*) glGetString(GL_VENDOR));
+    hash = PsychGLSLProgramCacheHash(hash, (const char*) glGetString(GL_RENDERER));
+    hash = PsychGLSLProgramCacheHash(hash, (const char*) glGetString(GL_VERSION));
+    hash = PsychGLSLProgramCacheHash(hash, fragmentsrc);
+    hash = PsychGLSLProgramCacheHash(hash, vertexsrc);
+
+    snprintf(path, pathSize, "%sglslcache_%016llx.bin", PsychRuntimeGetPsychtoolboxRoot(TRUE), (unsigned long long) hash);
+
+    return(TRUE);
+}
+
+// Try to load linked program binary from cache file into program 'glsl'. Returns TRUE on cache hit:
+static psych_bool PsychGLSLProgramCacheLoad(GLuint glsl, const char* path)
+{
+    PsychGLSLProgramCacheHeader header;
+    void *binary;
+    FILE *fd;
+    GLint status = GL_FALSE;
+    double tStart, tEnd;
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+
+    if (NULL == (fd = fopen(path, "rb")))
+        return(FALSE);
+
+    if ((fread(&header, sizeof(header), 1, fd) != 1) || strncmp(header.magic, "PTBGLSL1", 8) || (header.length <= 0) ||
+        (NULL == (binary = malloc(header.length)))) {
+        fclose(fd);
+        return(FALSE);
+    }
+
+    if (fread(binary, header.length, 1, fd) == 1) {
+        glProgramBinary(glsl, header.format, binary, header.length);
+        glGetProgramiv(glsl, GL_LINK_STATUS, &status);
+    }
+
+    free(binary);
+    fclose(fd);
+
+    // Driver rejected the binary, e.g., after an update of the driver which did not change the version strings?
+    if (status != GL_TRUE) {
+        while (glGetError());
+        if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Rejected stale GLSL program binary cache file %s.\n", path);
+        return(FALSE);
+    }
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tEnd);
+    glslCacheHits++;
+    if (header.compileSecs > tEnd - tStart) glslCacheSavedSecs += header.compileSecs - (tEnd - tStart);
+
+    // Update modification time of the file to mark it as recently used for cache eviction:
+    utime(path, NULL);
+
+    return(TRUE);
+}
+
+typedef struct PsychGLSLProgramCacheEntry {
+    char        name[32];
+    double      mtime;
+    double      size;
+} PsychGLSLProgramCacheEntry;
+
+// Sort cache entries by modification time, most recently used first:
+static int PsychGLSLProgramCacheEntryCompare(const void* a, const void* b)
+{
+    double d = ((const PsychGLSLProgramCacheEntry*) b)->mtime - ((const PsychGLSLProgramCacheEntry*) a)->mtime;
+    return((d > 0) ? 1 : ((d < 0) ? -1 : 0));
+}
+
+// Delete stale cache files, and least recently used cache files beyond the size limit. Done once per session:
+static void PsychGLSLProgramCacheEvict(void)
+{
+    static psych_bool evicted = FALSE;
+    PsychGLSLProgramCacheEntry *entries;
+    const char *root = PsychRuntimeGetPsychtoolboxRoot(TRUE);
+    char path[FILENAME_MAX];
+    double now = (double) time(NULL);
+    double totalSize = 0;
+    int i, count = 0, removed = 0;
+
+    if (evicted || (NULL == (entries = (PsychGLSLProgramCacheEntry*) malloc(PSYCH_GLSL_CACHE_MAXENTRIES * sizeof(PsychGLSLProgramCacheEntry)))))
+        return;
+
+    evicted = TRUE;
+
+    // Enumerate all cache files with their modification time and size:
+    #if PSYCH_SYSTEM == PSYCH_WINDOWS
+    {
+        WIN32_FIND_DATAA findData;
+        HANDLE hFind;
+        ULARGE_INTEGER filetime;
+
+        snprintf(path, sizeof(path), "%sglslcache_*.bin", root);
+        if ((hFind = FindFirstFileA(path, &findData)) != INVALID_HANDLE_VALUE) {
+            do {
+                if (strlen(findData.cFileName) >= sizeof(entries[0].name))
+                    continue;
+
+                // FILETIME is in 100 nsecs units since 1.1.1601, convert to seconds since 1.1.1970:
+                filetime.LowPart = findData.ftLastWriteTime.dwLowDateTime;
+                filetime.HighPart = findData.ftLastWriteTime.dwHighDateTime;
+                entries[count].mtime = (double) filetime.QuadPart / 1e7 - 11644473600.0;
+                entries[count].size = (double) findData.nFileSizeHigh * 4294967296.0 + (double) findData.nFileSizeLow;
+                strcpy(entries[count].name, findData.cFileName);
+                count++;
+            } while ((count < PSYCH_GLSL_CACHE_MAXENTRIES) && FindNextFileA(hFind, &findData));
+
+            FindClose(hFind);
+        }
+    }
+    #else
+    {
+        DIR *dir;
+        struct dirent *dirEntry;
+        struct stat fileStat;
+        size_t len;
+
+        if (NULL != (dir = opendir(root))) {
+            while ((count < PSYCH_GLSL_CACHE_MAXENTRIES) && (NULL != (dirEntry = readdir(dir)))) {
+                len = strlen(dirEntry->d_name);
+                if ((len >= sizeof(entries[0].name)) || (len < 14) || strncmp(dirEntry->d_name, "glslcache_", 10) ||
+                    strcmp(dirEntry->d_name + len - 4, ".bin"))
+                    continue;
+
+                snprintf(path, sizeof(path), "%s%s", root, dirEntry->d_name);
+                if (stat(path, &fileStat))
+                    continue;
+
+                entries[count].mtime = (double) fileStat.st_mtime;
+                entries[count].size = (double) fileStat.st_size;
+                strcpy(entries[count].name, dirEntry->d_name);
+                count++;
+            }
+
+            closedir(dir);
+        }
+    }
+    #endif
+
+    // Keep the most recently used files up to the size limit, if they are not older than the age limit:
+    qsort(entries, count, sizeof(PsychGLSLProgramCacheEntry), PsychGLSLProgramCacheEntryCompare);
+    for (i = 0; i < count; i++) {
+        totalSize += entries[i].size;
+        if ((totalSize > PSYCH_GLSL_CACHE_MAXBYTES) || (now - entries[i].mtime > PSYCH_GLSL_CACHE_MAXAGE_DAYS * 86400.0)) {
+            snprintf(path, sizeof(path), "%s%s", root, entries[i].name);
+            if (!remove(path)) removed++;
+        }
+    }
+
+    free(entries);
+
+    if ((removed > 0) && (PsychPrefStateGet_Verbosity() > 4))
+        printf("PTB-DEBUG: Deleted %i stale or least recently used GLSL program binary cache files.\n", removed);
+}
+
+// Store binary of linked program 'glsl' into cache file:
+static void PsychGLSLProgramCacheStore(GLuint glsl, const char* path, double compileSecs)
+{
+    PsychGLSLProgramCacheHeader header;
+    void *binary;
+    FILE *fd;
+
+    // Keep size of the cache bounded before adding to it:
+    PsychGLSLProgramCacheEvict();
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "PTBGLSL1", 8);
+    header.compileSecs = compileSecs;
+
+    glGetProgramiv(glsl, GL_PROGRAM_BINARY_LENGTH, &header.length);
+    if ((header.length <= 0) || (NULL == (binary = malloc(header.length))))
+        return;
+
+    glGetProgramBinary(glsl, header.length, &header.length, &header.format, binary);
+
+    if ((header.length > 0) && (fd = fopen(path, "wb"))) {
+        if ((fwrite(&header, sizeof(header), 1, fd) != 1) || (fwrite(binary, header.length, 1, fd) != 1)) {
+            fclose(fd);
+            remove(path);
+        }
+        else {
+            fclose(fd);
+        }
+    }
+
+    free(binary);
+    while (glGetError());
+}
+
+// Attach an uncompiled shader object with source code 'src' of type 'type' to program 'glsl', which
+// got loaded from the cache, so its source code can be queried, e.g., for hook chain shader fusion:
+static void PsychGLSLProgramAttachSource(GLuint glsl, GLenum type, const char* src)
+{
+    GLuint shader;
+
+    if (NULL == src) return;
+
+    shader = glCreateShader(type);
+    glShaderSource(shader, 1, (const char**) &src, NULL);
+    glAttachShader(glsl, shader);
+
+    // Flag for deletion together with the program:
+    glDeleteShader(shader);
+}
+
 /* PsychCreateGLSLProgram()
  *  Try to create GLSL shader from source strings and return handle to new shader.
  *  Returns the shader handle if it worked, 0 otherwise.
@@ -1617,6 +2032,9 @@ GLuint PsychCreateGLSLProgram(const char* fragmentsrc, const char* vertexsrc, co
     GLuint shader;
     GLint status;
     char errtxt[10000];
+    char cachePath[FILENAME_MAX];
+    psych_bool useCache;
+    double tStart, tEnd;
 
     (void) primitivesrc;
 
@@ -1632,6 +2050,18 @@ GLuint PsychCreateGLSLProgram(const char* fragmentsrc, const char* vertexsrc, co
     // Create GLSL program object:
     glsl = glCreateProgram();
 
+    // Linked program binary available in the cache? Then we are done without any compilation:
+    useCache = PsychGLSLProgramCachePath(cachePath, sizeof(cachePath), fragmentsrc, vertexsrc);
+    if (useCache && PsychGLSLProgramCacheLoad(glsl, cachePath)) {
+        PsychGLSLProgramAttachSource(glsl, GL_FRAGMENT_SHADER, fragmentsrc);
+        PsychGLSLProgramAttachSource(glsl, GL_VERTEX_SHADER, vertexsrc);
+        while (glGetError());
+
+        return(glsl);
+    }
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+
     // Fragment shader wanted?
     if (fragmentsrc) {
         if (PsychPrefStateGet_Verbosity()>4)  printf("PTB-INFO: Creating the following fragment shader, GLSL source code follows:\n\n%s\n\n", fragmentsrc);
@@ -1710,6 +2140,9 @@ GLuint PsychCreateGLSLProgram(const char* fragmentsrc, const char* vertexsrc, co
         glAttachShader(glsl, shader);
     }
 
+    // Ask for a retrievable program binary for the cache:
+    if (useCache) glProgramParameteri(glsl, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     // Link into final program object:
     glLinkProgram(glsl);
 
@@ -1732,10 +2165,87 @@ GLuint PsychCreateGLSLProgram(const char* fragmentsrc, const char* vertexsrc, co
 
     while (glGetError());
 
+    // Store linked program in the cache for the next time:
+    if (useCache) {
+        PsychGetAdjustedPrecisionTimerSeconds(&tEnd);
+        glslCacheMisses++;
+        PsychGLSLProgramCacheStore(glsl, cachePath, tEnd - tStart);
+    }
+
     // Return new GLSL program object handle:
     return(glsl);
 }
 
+/* PsychLinkGLSLProgramCached()
+ *  Link GLSL program 'glsl' with its attached and already compiled shaders, like glLinkProgram() does,
+ *  but try to load the linked program binary from the GLSL program binary cache first, and store it
+ *  in the cache after a successful link. The cache is keyed by the source code of all attached shaders,
+ *  and by the optional string 'preLinkState', which must describe all state assigned before linking, e.g.,
+ *  attribute or fragment data locations, as OpenGL can't report that state before the link. Used by
+ *  Screen('LinkGLSLProgram') for the shaders of M-File functions, e.g., LoadGLSLProgramFromFiles().
+ *  Operates in the currently bound OpenGL context. Returns TRUE on a cache hit. Check GL_LINK_STATUS
+ *  of 'glsl' for success of the link operation.
+ */
+psych_bool PsychLinkGLSLProgramCached(GLuint glsl, const char* preLinkState)
+{
+    GLuint *shaders;
+    GLint i, count = 0, len, type;
+    size_t srcSize = 1;
+    char *src, *srcEnd;
+    char cachePath[FILENAME_MAX];
+    psych_bool useCache = FALSE;
+    double tStart, tEnd;
+    GLint status;
+
+    while (glGetError());
+
+    // Concatenate types and source code of all attached shaders as key for the cache:
+    glGetProgramiv(glsl, GL_ATTACHED_SHADERS, &count);
+    if (count > 0) {
+        shaders = (GLuint*) PsychMallocTemp(count * sizeof(GLuint));
+        glGetAttachedShaders(glsl, count, &count, shaders);
+
+        for (i = 0; i < count; i++) {
+            len = 0;
+            glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &len);
+            srcSize += len + 16;
+        }
+
+        src = srcEnd = (char*) PsychMallocTemp(srcSize);
+        *src = 0;
+        for (i = 0; i < count; i++) {
+            glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+            srcEnd += sprintf(srcEnd, "%08x\n", (unsigned int) type);
+            len = 0;
+            glGetShaderSource(shaders[i], (GLsizei) (srcSize - (srcEnd - src)), &len, srcEnd);
+            srcEnd += len;
+        }
+
+        useCache = PsychGLSLProgramCachePath(cachePath, sizeof(cachePath), src, preLinkState);
+    }
+
+    // Linked program binary available in the cache? Then we are done without linking:
+    if (useCache && PsychGLSLProgramCacheLoad(glsl, cachePath))
+        return(TRUE);
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+
+    // Ask for a retrievable program binary for the cache:
+    if (useCache) glProgramParameteri(glsl, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    glLinkProgram(glsl);
+
+    // Store successfully linked program in the cache for the next time:
+    glGetProgramiv(glsl, GL_LINK_STATUS, &status);
+    if (useCache && (status == GL_TRUE)) {
+        PsychGetAdjustedPrecisionTimerSeconds(&tEnd);
+        glslCacheMisses++;
+        PsychGLSLProgramCacheStore(glsl, cachePath, tEnd - tStart);
+    }
+
+    return(FALSE);
+}
+
 static psych_bool PsychUnshareFinalizedFBOIfNeeded(PsychWindowRecordType *windowRecord, int viewid, GLenum formatSpec, int width, int height)
 {
     if (windowRecord->finalizedFBO[viewid] == windowRecord->drawBufferFBO[viewid]) {
@@ -3108,6 +3618,9 @@ void PsychCreateShadowFBOForTexture(PsychWindowRecordType *textureRecord, psych_
 {
     GLenum fboInternalFormat;
 
+    // Textures with a FBO are not managed by the texture residency manager. Make sure it is resident:
+    PsychTextureResidencyPin(textureRecord);
+
     // Do we already have a framebuffer object for this texture? All textures start off without one,
     // because most textures are just used for drawing them, not drawing *into* them. Therefore we
     // only create a full blown FBO on demand here.
@@ -3191,6 +3704,9 @@ void PsychNormalizeTextureOrientation(PsychWindowRecordType *sourceRecord)
     // Is this a planar encoding texture?
     isplanar = (PsychIsTexture(sourceRecord) && (sourceRecord->specialflags & kPsychPlanarTexture)) ? TRUE : FALSE;
 
+    // Image processing needs the texture to stay resident. Exclude it from residency management:
+    if (PsychIsTexture(sourceRecord)) PsychTextureResidencyPin(sourceRecord);
+
     // The source texture sourceRecord could be in any of PTB's supported
     // internal texture orientations. It may be upright as an Offscreen window,
     // or flipped upside down as some textures from the video grabber,
@@ -3442,6 +3958,12 @@ void PsychShutdownImagingPipeline(PsychWindowRecordType *windowRecord, psych_boo
 
     // Do OpenGL specific cleanup:
     if (openglpart) {
+        // Release fused shaders of all hook chains while the OpenGL context still exists:
+        for (i = 0; i < MAX_SCREEN_HOOKS; i++) {
+            PsychPipelineReleaseFusedShaders(windowRecord, i);
+            windowRecord->HookChainFusion[i] = 0;
+        }
+
         // Yes. Mode specific cleanup:
         for (i = 0; i < windowRecord->fboCount; i++) {
             // Delete i'th FBO, if any:
@@ -3544,6 +4066,9 @@ PsychHookFunction* PsychAddNewHookFunction(PsychWindowRecordType *windowRecord,
     // Lookup hook-chain idx for this name, if any:
     if ((hookidx=PsychGetHookByName(hookString))==-1) PsychErrorExitMsg(PsychError_user, "AddHook: Unknown (non-existent) hook name provided.");
 
+    // Fused shaders need to be rebuilt for the modified chain:
+    PsychPipelineReleaseFusedShaders(windowRecord, hookidx);
+
     // Allocate a hook structure:
     hookfunc = (PtrPsychHookFunction) calloc(1, sizeof(PsychHookFunction));
     if (hookfunc==NULL) PsychErrorExitMsg(PsychError_outofMemory, "Failed to allocate memory for new hook function.");
@@ -3617,6 +4142,7 @@ void PsychPipelineResetHook(PsychWindowRecordType *windowRecord, const char* hoo
     PtrPsychHookFunction hookfunc, hookiter;
     int hookidx=PsychGetHookByName(hookString);
     if (hookidx==-1) PsychErrorExitMsg(PsychError_user, "ResetHook: Unknown (non-existent) hook name provided.");
+    PsychPipelineReleaseFusedShaders(windowRecord, hookidx);
     hookiter = windowRecord->HookChain[hookidx];
     while(hookiter) {
         hookfunc = hookiter;
@@ -3732,6 +4258,7 @@ void PsychPipelineDeleteHookSlot(PsychWindowRecordType *windowRecord, const char
     int idx;
     int hookidx=PsychGetHookByName(hookString);
     if (hookidx==-1) PsychErrorExitMsg(PsychError_user, "RemoveHook: Unknown (non-existent) hook name provided.");
+    PsychPipelineReleaseFusedShaders(windowRecord, hookidx);
 
     // Perform linear search until proper slot reached or proper name reached:
     idx=0;
@@ -3869,6 +4396,7 @@ void PsychPipelineDumpHook(PsychWindowRecordType *windowRecord, const char* hook
         switch(hookfunc->hookfunctype) {
             case kPsychShaderFunc:
                 printf("GLSL-Shader      : id=%i , luttex1=%i , blitter=%s\n", hookfunc->shaderid, hookfunc->luttexid1, hookfunc->pString1);
+                if (hookfunc->fused) printf("        Fused with the next %i slots into GLSL-Shader id=%i\n", hookfunc->fused->numSlots - 1, hookfunc->fused->slot.shaderid);
             break;
 
             case kPsychCFunc:
@@ -3907,6 +4435,750 @@ void PsychPipelineDumpAllHooks(PsychWindowRecordType *windowRecord)
     return;
 }
 
+/* Shader fusion for hook chains:
+ *
+ * A chain of shader slots, separated by Builtin:FlipFBOs ping-pongs, executes as one full framebuffer pass per slot.
+ * If shader fusion is enabled for a chain via PsychPipelineFuseHook(), runs of consecutive slots which only process
+ * single pixels get merged into one generated fragment program, which executes as a single pass. The GLSL source
+ * code of each slot gets retrieved from its program object, all identifiers get prefixed with a per slot prefix to
+ * avoid name clashes, the main() function of each slot gets called in order, and per-pixel reads of the input image
+ * by the 2nd and later slots get replaced by the output color of the previous slot. Uniforms of the original slot
+ * programs get copied into the fused program before each execution, so later changes of them still apply. Slots
+ * which sample the input image at other positions, need a vertex shader, a special blitter or conflicting texture
+ * units, or whose source doesn't compile after fusion, keep executing as separate passes.
+ */
+#define PSYCH_MAX_FUSED_SLOTS 16
+
+typedef struct PsychFusionString {
+    char*   buf;
+    size_t  len;
+    size_t  capacity;
+} PsychFusionString;
+
+// GLSL keywords, types, builtin functions and preprocessor words, which must not be renamed:
+static const char* psychGLSLReservedWords[] = {
+    "attribute", "const", "uniform", "varying", "in", "out", "inout", "centroid", "flat", "smooth", "noperspective",
+    "invariant", "precise", "highp", "mediump", "lowp", "precision", "layout", "struct", "if", "else", "for", "while",
+    "do", "break", "continue", "return", "discard", "switch", "case", "default", "true", "false", "void", "bool", "int",
+    "uint", "float", "double", "vec2", "vec3", "vec4", "bvec2", "bvec3", "bvec4", "ivec2", "ivec3", "ivec4", "uvec2",
+    "uvec3", "uvec4", "dvec2", "dvec3", "dvec4", "mat2", "mat3", "mat4", "mat2x2", "mat2x3", "mat2x4", "mat3x2", "mat3x3",
+    "mat3x4", "mat4x2", "mat4x3", "mat4x4", "sampler1D", "sampler2D", "sampler3D", "samplerCube", "sampler2DRect",
+    "sampler1DShadow", "sampler2DShadow", "sampler2DRectShadow", "sampler2DMS", "radians", "degrees", "sin", "cos", "tan",
+    "asin", "acos", "atan", "sinh", "cosh", "tanh", "asinh", "acosh", "atanh", "pow", "exp", "log", "exp2", "log2", "sqrt",
+    "inversesqrt", "abs", "sign", "floor", "trunc", "round", "roundEven", "ceil", "fract", "mod", "modf", "min", "max",
+    "clamp", "mix", "step", "smoothstep", "isnan", "isinf", "floatBitsToInt", "floatBitsToUint", "intBitsToFloat",
+    "uintBitsToFloat", "fma", "frexp", "ldexp", "length", "distance", "dot", "cross", "normalize", "faceforward", "reflect",
+    "refract", "matrixCompMult", "outerProduct", "transpose", "determinant", "inverse", "lessThan", "lessThanEqual",
+    "greaterThan", "greaterThanEqual", "equal", "notEqual", "any", "all", "not", "texture1D", "texture1DProj",
+    "texture1DLod", "texture2D", "texture2DProj", "texture2DLod", "texture3D", "texture3DProj", "texture3DLod",
+    "textureCube", "textureCubeLod", "shadow1D", "shadow2D", "texture2DRect", "texture2DRectProj", "shadow2DRect",
+    "texture", "textureSize", "texelFetch", "textureLod", "textureProj", "textureOffset", "texelFetchOffset", "textureGrad",
+    "dFdx", "dFdy", "fwidth", "noise1", "noise2", "noise3", "noise4", "define", "undef", "ifdef", "ifndef", "elif",
+    "endif", "error", "pragma", "line", "defined", "enable", "require", "warn", "disable", NULL
+};
+
+static void PsychFusionAppend(PsychFusionString* str, const char* txt, size_t n)
+{
+    if (str->len + n + 1 > str->capacity) {
+        str->capacity = (str->len + n + 1) * 2;
+        str->buf = (char*) realloc(str->buf, str->capacity);
+        if (NULL == str->buf) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while generating fused hook chain shader.");
+    }
+
+    memcpy(str->buf + str->len, txt, n);
+    str->len += n;
+    str->buf[str->len] = 0;
+}
+
+static void PsychFusionAppendString(PsychFusionString* str, const char* txt)
+{
+    PsychFusionAppend(str, txt, strlen(txt));
+}
+
+static psych_bool PsychFusionIsIdentChar(char c)
+{
+    return((isalnum((unsigned char) c) || (c == '_')) ? TRUE : FALSE);
+}
+
+static psych_bool PsychFusionIsReserved(const char* word, size_t len)
+{
+    int i;
+
+    // Extension names, builtin macros and reserved names:
+    if ((len > 3) && (!strncmp(word, "GL_", 3) || !strncmp(word, "__", 2)))
+        return(TRUE);
+
+    for (i = 0; psychGLSLReservedWords[i]; i++) {
+        if ((strlen(psychGLSLReservedWords[i]) == len) && !strncmp(psychGLSLReservedWords[i], word, len))
+            return(TRUE);
+    }
+
+    return(FALSE);
+}
+
+// Skip whitespace, then match 'token'. Returns position after the token, or NULL if no match:
+static const char* PsychFusionMatch(const char* p, const char* token)
+{
+    size_t n = strlen(token);
+
+    while (isspace((unsigned char) *p)) p++;
+    if (strncmp(p, token, n) || (PsychFusionIsIdentChar(token[n - 1]) && PsychFusionIsIdentChar(p[n])))
+        return(NULL);
+
+    return(p + n);
+}
+
+// Match a per-pixel read of the input image "(input, gl_TexCoord[0].st)" after a texture2DRect:
+static const char* PsychFusionMatchInputRead(const char* p, const char* input)
+{
+    const char* q;
+
+    if (!(p = PsychFusionMatch(p, "(")) || !(p = PsychFusionMatch(p, input)) || !(p = PsychFusionMatch(p, ",")) ||
+        !(p = PsychFusionMatch(p, "gl_TexCoord")) || !(p = PsychFusionMatch(p, "[")) || !(p = PsychFusionMatch(p, "0")) ||
+        !(p = PsychFusionMatch(p, "]")) || !(p = PsychFusionMatch(p, ".")))
+        return(NULL);
+
+    if (!(q = PsychFusionMatch(p, "st")) && !(q = PsychFusionMatch(p, "xy")))
+        return(NULL);
+
+    return(PsychFusionMatch(q, ")"));
+}
+
+/* Append GLSL source 'src' of slot number 'slot' of a fused shader to 'out'. All identifiers which are not reserved
+ * words get prefixed, writes to gl_FragColor get redirected to psych_fusedOut, and if 'input' is non-NULL, per-pixel
+ * reads from the input image sampler 'input' get replaced by psych_fusedIn. #version and #extension directives are
+ * collected in 'header' and 'version'. Returns FALSE if the source can't be fused.
+ */
+static psych_bool PsychFusionTranslateSource(PsychFusionString* out, PsychFusionString* header, int* version, const char* src, int slot, const char* input)
+{
+    PsychFusionString slotLine;
+    const char *p = src, *q;
+    char prefix[32];
+    char lastChar = 0;
+    psych_bool lineStart = TRUE;
+    int inputUses = 0;
+    size_t n;
+
+    sprintf(prefix, "psych_s%i_", slot);
+
+    while (*p) {
+        // Preprocessor directive?
+        if (lineStart) {
+            q = p;
+            while ((*q == ' ') || (*q == '\t')) q++;
+            if (*q == '#') {
+                q++;
+                while ((*q == ' ') || (*q == '\t')) q++;
+                if (!strncmp(q, "version", 7) || !strncmp(q, "extension", 9)) {
+                    n = strcspn(p, "\n");
+                    if (!strncmp(q, "version", 7)) {
+                        if (atoi(q + 7) > *version) *version = atoi(q + 7);
+                    }
+                    else {
+                        // Add extension directive, unless an identical one is already there:
+                        slotLine.buf = NULL; slotLine.len = 0; slotLine.capacity = 0;
+                        PsychFusionAppend(&slotLine, p, n);
+                        PsychFusionAppendString(&slotLine, "\n");
+                        if (!strstr(header->buf ? header->buf : "", slotLine.buf)) PsychFusionAppendString(header, slotLine.buf);
+                        free(slotLine.buf);
+                    }
+
+                    p += n;
+                    continue;
+                }
+
+                // Other directives are kept, with identifiers in them renamed:
+                while (PsychFusionIsIdentChar(q[0])) q++;
+                PsychFusionAppend(out, p, q - p);
+                p = q;
+            }
+
+            lineStart = FALSE;
+        }
+
+        if (*p == '\n') {
+            lineStart = TRUE;
+            PsychFusionAppend(out, p++, 1);
+            continue;
+        }
+
+        // Comments:
+        if ((p[0] == '/') && (p[1] == '/')) {
+            n = strcspn(p, "\n");
+            PsychFusionAppend(out, p, n);
+            p += n;
+            continue;
+        }
+
+        if ((p[0] == '/') && (p[1] == '*')) {
+            q = strstr(p + 2, "*/");
+            n = (q) ? (size_t) (q + 2 - p) : strlen(p);
+            PsychFusionAppend(out, p, n);
+            p += n;
+            continue;
+        }
+
+        // Numbers, including exponents and suffixes:
+        if (isdigit((unsigned char) p[0]) || ((p[0] == '.') && isdigit((unsigned char) p[1]))) {
+            q = p;
+            while (PsychFusionIsIdentChar(*q) || (*q == '.') || (((*q == '+') || (*q == '-')) && ((q[-1] == 'e') || (q[-1] == 'E')))) q++;
+            PsychFusionAppend(out, p, q - p);
+            lastChar = '0';
+            p = q;
+            continue;
+        }
+
+        // Identifiers:
+        if (PsychFusionIsIdentChar(*p)) {
+            q = p;
+            while (PsychFusionIsIdentChar(*q)) q++;
+            n = q - p;
+
+            if (lastChar == '.') {
+                // Struct member or swizzle:
+                PsychFusionAppend(out, p, n);
+            }
+            else if (!strncmp(p, "gl_", 3)) {
+                if ((n == 12) && !strncmp(p, "gl_FragColor", 12)) {
+                    PsychFusionAppendString(out, "psych_fusedOut");
+                }
+                else if ((n == 11) && !strncmp(p, "gl_FragData", 11)) {
+                    return(FALSE);
+                }
+                else {
+                    PsychFusionAppend(out, p, n);
+                }
+            }
+            else if (input && (n == 13) && !strncmp(p, "texture2DRect", 13) && PsychFusionMatchInputRead(q, input)) {
+                PsychFusionAppendString(out, "psych_fusedIn");
+                q = PsychFusionMatchInputRead(q, input);
+            }
+            else if (PsychFusionIsReserved(p, n)) {
+                PsychFusionAppend(out, p, n);
+            }
+            else {
+                // Any other use of the input sampler than its declaration means non per-pixel access:
+                if (input && (n == strlen(input)) && !strncmp(p, input, n)) inputUses++;
+
+                PsychFusionAppendString(out, prefix);
+                PsychFusionAppend(out, p, n);
+            }
+
+            lastChar = 'a';
+            p = q;
+            continue;
+        }
+
+        if (!isspace((unsigned char) *p)) lastChar = *p;
+        PsychFusionAppend(out, p++, 1);
+    }
+
+    PsychFusionAppendString(out, "\n");
+
+    return((inputUses <= 1) ? TRUE : FALSE);
+}
+
+// Return concatenated source code of all fragment shaders attached to 'program', or NULL if it has other or no shaders:
+static char* PsychFusionGetFragmentSource(GLuint program)
+{
+    GLuint shaders[16];
+    GLsizei count = 0;
+    GLint type, len;
+    PsychFusionString src = { NULL, 0, 0 };
+    char *buf;
+    int i;
+
+    glGetAttachedShaders(program, 16, &count, shaders);
+    for (i = 0; i < count; i++) {
+        glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+        glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &len);
+        if ((type != GL_FRAGMENT_SHADER) || (len <= 0)) {
+            free(src.buf);
+            return(NULL);
+        }
+
+        buf = (char*) malloc(len + 1);
+        if (NULL == buf) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while generating fused hook chain shader.");
+        glGetShaderSource(shaders[i], len + 1, NULL, buf);
+        PsychFusionAppendString(&src, buf);
+        PsychFusionAppendString(&src, "\n");
+        free(buf);
+    }
+
+    return(src.buf);
+}
+
+static psych_bool PsychFusionIsSupportedType(GLenum type)
+{
+    switch (type) {
+        case GL_FLOAT: case GL_FLOAT_VEC2: case GL_FLOAT_VEC3: case GL_FLOAT_VEC4:
+        case GL_INT: case GL_INT_VEC2: case GL_INT_VEC3: case GL_INT_VEC4:
+        case GL_BOOL: case GL_BOOL_VEC2: case GL_BOOL_VEC3: case GL_BOOL_VEC4:
+        case GL_FLOAT_MAT2: case GL_FLOAT_MAT3: case GL_FLOAT_MAT4:
+        case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_RECT_ARB: case GL_SAMPLER_1D_SHADOW: case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_2D_RECT_SHADOW_ARB:
+            return(TRUE);
+    }
+
+    return(FALSE);
+}
+
+static psych_bool PsychFusionIsSampler(GLenum type)
+{
+    switch (type) {
+        case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_RECT_ARB: case GL_SAMPLER_1D_SHADOW: case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_2D_RECT_SHADOW_ARB:
+            return(TRUE);
+    }
+
+    return(FALSE);
+}
+
+/* Check the samplers of 'program': Find name of the sampler2DRect which reads the input image on texture unit 0,
+ * and collect the other texture units in 'units'. Returns FALSE if unit 0 gets sampled by something else.
+ */
+static psych_bool PsychFusionGetSamplers(GLuint program, char* input, size_t inputSize, unsigned int* units)
+{
+    GLint count, size, unit;
+    GLenum type;
+    char name[256];
+    int i;
+
+    input[0] = 0;
+    *units = 0;
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    for (i = 0; i < count; i++) {
+        glGetActiveUniform(program, i, sizeof(name), NULL, &size, &type, name);
+        if (!PsychFusionIsSampler(type))
+            continue;
+
+        glGetUniformiv(program, glGetUniformLocation(program, name), &unit);
+        if ((unit < 0) || (unit > 31) || (size > 1))
+            return(FALSE);
+
+        if (unit > 0) {
+            *units |= 1 << unit;
+        }
+        else {
+            if ((type != GL_SAMPLER_2D_RECT_ARB) || input[0] || (strlen(name) >= inputSize))
+                return(FALSE);
+
+            strcpy(input, name);
+        }
+    }
+
+    return(TRUE);
+}
+
+/* Check if the blitter config string 'cfg' of a shader slot only binds textures, and collect their units in 'units': */
+static psych_bool PsychFusionParseSlotConfig(const char* cfg, unsigned int* units)
+{
+    const char* p = cfg;
+    int unit, texid;
+
+    *units = 0;
+    while (*p) {
+        if (!strncmp(p, "TEXTURE", 7)) {
+            p += 7;
+            while (isalnum((unsigned char) *p)) p++;
+            if ((2 != sscanf(p, "(%i)=%i", &unit, &texid)) || (unit < 0) || (unit > 31))
+                return(FALSE);
+
+            *units |= 1 << unit;
+            p = strchr(p, '=') + 1;
+            while (isdigit((unsigned char) *p)) p++;
+        }
+        else if (!strncmp(p, "Blitter:IdentityBlit", 20)) {
+            p += 20;
+        }
+        else if (isspace((unsigned char) *p) || (*p == ';') || (*p == ',')) {
+            p++;
+        }
+        else {
+            return(FALSE);
+        }
+    }
+
+    return(TRUE);
+}
+
+static psych_bool PsychFusionIsFlip(PtrPsychHookFunction hookfunc)
+{
+    return((hookfunc && (hookfunc->hookfunctype == kPsychBuiltinFunc) && !strcmp(hookfunc->idString, "Builtin:FlipFBOs")) ? TRUE : FALSE);
+}
+
+/* Add uniforms of the program of slot number 'slot' to the uniform copy list of 'fused'. Returns FALSE if a uniform
+ * has an unsupported type:
+ */
+static psych_bool PsychFusionMapUniforms(PsychFusedShader* fused, GLuint program, int slot, GLuint fusedProgram)
+{
+    GLint count, size, srcLoc, dstLoc;
+    GLenum type;
+    char name[256], srcName[300], dstName[320];
+    char *bracket;
+    int i, j;
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    for (i = 0; i < count; i++) {
+        glGetActiveUniform(program, i, sizeof(name), NULL, &size, &type, name);
+        if (!strncmp(name, "gl_", 3))
+            continue;
+
+        if (!PsychFusionIsSupportedType(type))
+            return(FALSE);
+
+        // Array uniforms get copied element by element:
+        if ((bracket = strstr(name, "[0]")) && (bracket[3] == 0)) *bracket = 0;
+
+        for (j = 0; j < size; j++) {
+            if (size > 1)
+                sprintf(srcName, "%s[%i]", name, j);
+            else
+                sprintf(srcName, "%s", name);
+
+            sprintf(dstName, "psych_s%i_%s", slot, srcName);
+            srcLoc = glGetUniformLocation(program, srcName);
+            dstLoc = glGetUniformLocation(fusedProgram, dstName);
+            if ((srcLoc < 0) || (dstLoc < 0))
+                continue;
+
+            fused->uniforms = (PsychFusedUniform*) realloc(fused->uniforms, (fused->numUniforms + 1) * sizeof(PsychFusedUniform));
+            if (NULL == fused->uniforms) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while generating fused hook chain shader.");
+
+            fused->uniforms[fused->numUniforms].srcProgram = program;
+            fused->uniforms[fused->numUniforms].srcLocation = srcLoc;
+            fused->uniforms[fused->numUniforms].dstLocation = dstLoc;
+            fused->uniforms[fused->numUniforms].type = type;
+            fused->numUniforms++;
+        }
+    }
+
+    return(TRUE);
+}
+
+/* Copy current values of all uniforms from the original slot programs into the bound fused program: */
+static void PsychFusionCopyUniforms(PsychFusedShader* fused)
+{
+    PsychFusedUniform *u;
+    GLfloat fv[16];
+    GLint iv[4];
+    int i;
+
+    for (i = 0; i < fused->numUniforms; i++) {
+        u = &fused->uniforms[i];
+        switch (u->type) {
+            case GL_FLOAT:
+                glGetUniformfv(u->srcProgram, u->srcLocation, fv);
+                glUniform1fv(u->dstLocation, 1, fv);
+            break;
+
+            case GL_FLOAT_VEC2:
+                glGetUniformfv(u->srcProgram, u->srcLocation, fv);
+                glUniform2fv(u->dstLocation, 1, fv);
+            break;
+
+            case GL_FLOAT_VEC3:
+                glGetUniformfv(u->srcProgram, u->srcLocation, fv);
+                glUniform3fv(u->dstLocation, 1, fv);
+            break;
+
+            case GL_FLOAT_VEC4:
+                glGetUniformfv(u->srcProgram, u->srcLocation, fv);
+                glUniform4fv(u->dstLocation, 1, fv);
+            break;
+
+            case GL_FLOAT_MAT2:
+                glGetUniformfv(u->srcProgram, u->srcLocation, fv);
+                glUniformMatrix2fv(u->dstLocation, 1, GL_FALSE, fv);
+            break;
+
+            case GL_FLOAT_MAT3:
+                glGetUniformfv(u->srcProgram, u->srcLocation, fv);
+                glUniformMatrix3fv(u->dstLocation, 1, GL_FALSE, fv);
+            break;
+
+            case GL_FLOAT_MAT4:
+                glGetUniformfv(u->srcProgram, u->srcLocation, fv);
+                glUniformMatrix4fv(u->dstLocation, 1, GL_FALSE, fv);
+            break;
+
+            case GL_INT_VEC2:
+            case GL_BOOL_VEC2:
+                glGetUniformiv(u->srcProgram, u->srcLocation, iv);
+                glUniform2iv(u->dstLocation, 1, iv);
+            break;
+
+            case GL_INT_VEC3:
+            case GL_BOOL_VEC3:
+                glGetUniformiv(u->srcProgram, u->srcLocation, iv);
+                glUniform3iv(u->dstLocation, 1, iv);
+            break;
+
+            case GL_INT_VEC4:
+            case GL_BOOL_VEC4:
+                glGetUniformiv(u->srcProgram, u->srcLocation, iv);
+                glUniform4iv(u->dstLocation, 1, iv);
+            break;
+
+            default:
+                // Scalar int, bool and samplers:
+                glGetUniformiv(u->srcProgram, u->srcLocation, iv);
+                glUniform1iv(u->dstLocation, 1, iv);
+            break;
+        }
+    }
+}
+
+/* Compile and link fused fragment shader source 'src'. Returns 0 on failure, which is not an error, as the group of
+ * slots then just executes unfused:
+ */
+static GLuint PsychFusionCreateProgram(const char* src)
+{
+    GLuint glsl, shader;
+    GLint status;
+
+    shader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(shader, 1, (const char**) &src, NULL);
+    glCompileShader(shader);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        glDeleteShader(shader);
+        while (glGetError());
+        return(0);
+    }
+
+    glsl = glCreateProgram();
+    glAttachShader(glsl, shader);
+    glLinkProgram(glsl);
+    glDeleteShader(shader);
+    glGetProgramiv(glsl, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        glDeleteProgram(glsl);
+        while (glGetError());
+        return(0);
+    }
+
+    return(glsl);
+}
+
+/* Check if 'hookfunc' is a shader slot which can be part of a fused group, and return its texture units in 'units': */
+static psych_bool PsychFusionIsCandidate(PtrPsychHookFunction hookfunc, unsigned int* units)
+{
+    return((hookfunc && (hookfunc->hookfunctype == kPsychShaderFunc) && (hookfunc->shaderid > 0) && (hookfunc->luttexid1 == 0) &&
+            glIsProgram(hookfunc->shaderid) && PsychFusionParseSlotConfig(hookfunc->pString1, units)) ? TRUE : FALSE);
+}
+
+/* Try to fuse the longest possible run of shader slots starting at 'first' into one program. Returns the fused
+ * group, or NULL if less than two slots can be fused:
+ */
+static PsychFusedShader* PsychFusionBuildGroup(PtrPsychHookFunction first)
+{
+    PsychFusionString header = { NULL, 0, 0 }, body = { NULL, 0, 0 }, slotSrc, fused = { NULL, 0, 0 };
+    PtrPsychHookFunction members[PSYCH_MAX_FUSED_SLOTS], hookfunc;
+    PsychFusedShader *group;
+    unsigned int units, samplerUnits, usedUnits = 0;
+    char input[256];
+    char *src, line[64];
+    int version = 0, count = 0, i;
+    GLuint glsl;
+
+    hookfunc = first;
+    while ((count < PSYCH_MAX_FUSED_SLOTS) && PsychFusionIsCandidate(hookfunc, &units)) {
+        // Units bound by the slot config or referenced by samplers must not collide with other slots. Only the
+        // first slot may sample the input image other than per pixel at unit 0:
+        if (!PsychFusionGetSamplers(hookfunc->shaderid, input, sizeof(input), &samplerUnits) || (samplerUnits & ~units & ~2) ||
+            ((units | samplerUnits) & usedUnits) || ((count > 0) && (units & 1)))
+            break;
+
+        if (NULL == (src = PsychFusionGetFragmentSource(hookfunc->shaderid)))
+            break;
+
+        slotSrc.buf = NULL; slotSrc.len = 0; slotSrc.capacity = 0;
+        if (!PsychFusionTranslateSource(&slotSrc, &header, &version, src, count, (count > 0 && input[0]) ? input : NULL)) {
+            free(src);
+            free(slotSrc.buf);
+            break;
+        }
+
+        free(src);
+        PsychFusionAppendString(&body, slotSrc.buf);
+        free(slotSrc.buf);
+
+        usedUnits |= units | samplerUnits;
+        members[count++] = hookfunc;
+
+        // Next slot must follow after a ping-pong:
+        if (!PsychFusionIsFlip(hookfunc->next))
+            break;
+
+        hookfunc = hookfunc->next->next;
+    }
+
+    if (count < 2) {
+        free(header.buf);
+        free(body.buf);
+        return(NULL);
+    }
+
+    // Assemble fused program: Slots after the last one which translated fine are not part of the group.
+    if (version > 0) {
+        sprintf(line, "#version %i\n", version);
+        PsychFusionAppendString(&fused, line);
+    }
+
+    if (header.buf) PsychFusionAppendString(&fused, header.buf);
+    PsychFusionAppendString(&fused, "vec4 psych_fusedIn;\nvec4 psych_fusedOut;\n");
+    PsychFusionAppendString(&fused, body.buf);
+    PsychFusionAppendString(&fused, "void main()\n{\n");
+    for (i = 0; i < count; i++) {
+        sprintf(line, "%s    psych_s%i_main();\n", (i > 0) ? "    psych_fusedIn = psych_fusedOut;\n" : "", i);
+        PsychFusionAppendString(&fused, line);
+    }
+    PsychFusionAppendString(&fused, "    gl_FragColor = psych_fusedOut;\n}\n");
+
+    free(header.buf);
+    free(body.buf);
+
+    glsl = PsychFusionCreateProgram(fused.buf);
+    if (glsl == 0) {
+        if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Failed to compile fused shader for %i slots starting at slot '%s'. Using separate passes. Source:\n%s\n", count, first->idString, fused.buf);
+        free(fused.buf);
+        return(NULL);
+    }
+
+    free(fused.buf);
+
+    group = (PsychFusedShader*) calloc(1, sizeof(PsychFusedShader));
+    if (NULL == group) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while generating fused hook chain shader.");
+
+    for (i = 0; i < count; i++) {
+        if (!PsychFusionMapUniforms(group, members[i]->shaderid, i, glsl)) {
+            free(group->uniforms);
+            free(group);
+            glDeleteProgram(glsl);
+            return(NULL);
+        }
+    }
+
+    // Shader slot which executes the fused program, with the texture bindings of all slots:
+    body.buf = NULL; body.len = 0; body.capacity = 0;
+    for (i = 0; i < count; i++) {
+        PsychFusionAppendString(&body, members[i]->pString1);
+        PsychFusionAppendString(&body, " ");
+    }
+
+    group->slot.idString = strdup("Builtin:FusedShader");
+    group->slot.hookfunctype = kPsychShaderFunc;
+    group->slot.pString1 = body.buf;
+    group->slot.shaderid = glsl;
+    group->last = members[count - 1];
+    group->numSlots = 2 * count - 1;
+    group->flips = count - 1;
+
+    if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Fused %i shader slots starting at slot '%s' into one shader pass.\n", count, first->idString);
+
+    return(group);
+}
+
+/* PsychPipelineReleaseFusedShaders() - Release all fused shaders of hook chain 'hookidx', e.g., because the chain
+ * gets modified. They get rebuilt on next execution of the chain, if shader fusion is still enabled.
+ */
+static void PsychPipelineReleaseFusedShaders(PsychWindowRecordType *windowRecord, int hookidx)
+{
+    PtrPsychHookFunction hookfunc;
+
+    for (hookfunc = windowRecord->HookChain[hookidx]; hookfunc; hookfunc = hookfunc->next) {
+        if (hookfunc->fused) {
+            PsychSetGLContext(windowRecord);
+            glDeleteProgram(hookfunc->fused->slot.shaderid);
+            free(hookfunc->fused->slot.idString);
+            free(hookfunc->fused->slot.pString1);
+            free(hookfunc->fused->uniforms);
+            free(hookfunc->fused);
+            hookfunc->fused = NULL;
+        }
+    }
+
+    if (windowRecord->HookChainFusion[hookidx]) windowRecord->HookChainFusion[hookidx] = 1;
+}
+
+/* PsychPipelineBuildFusedShaders() - Fuse all suitable groups of shader slots of hook chain 'hookidx'. */
+static void PsychPipelineBuildFusedShaders(PsychWindowRecordType *windowRecord, int hookidx)
+{
+    PtrPsychHookFunction hookfunc;
+    int groups = 0, flips = 0;
+
+    PsychPipelineReleaseFusedShaders(windowRecord, hookidx);
+    PsychSetGLContext(windowRecord);
+
+    hookfunc = windowRecord->HookChain[hookidx];
+    while (hookfunc) {
+        if ((hookfunc->fused = PsychFusionBuildGroup(hookfunc))) {
+            groups++;
+            flips += hookfunc->fused->flips;
+            hookfunc = hookfunc->fused->last;
+        }
+
+        hookfunc = hookfunc->next;
+    }
+
+    windowRecord->HookChainFusion[hookidx] = 2;
+
+    if ((PsychPrefStateGet_Verbosity() > 3) && (groups > 0))
+        printf("PTB-INFO: Hook chain '%s': Fused %i groups of shader slots, saving %i of %i processing passes.\n",
+               PsychHookPointNames[hookidx], groups, flips, PsychPipelineCountHookPasses(windowRecord, hookidx, FALSE));
+}
+
+/* PsychPipelineCountHookPasses() - Number of image processing passes of hook chain 'hookidx', ie. number of
+ * Builtin:FlipFBOs ping-pongs + 1, with or without the savings of fused shaders.
+ */
+int PsychPipelineCountHookPasses(PsychWindowRecordType *windowRecord, int hookidx, psych_bool fused)
+{
+    PtrPsychHookFunction hookfunc;
+    int passes = 1;
+
+    for (hookfunc = windowRecord->HookChain[hookidx]; hookfunc; hookfunc = hookfunc->next) {
+        if (PsychFusionIsFlip(hookfunc)) passes++;
+        if (fused && hookfunc->fused) passes -= hookfunc->fused->flips;
+    }
+
+    return(passes);
+}
+
+/* PsychPipelineFuseHook() - Enable or disable shader fusion for named hook chain.
+ * windowRecord - Onscreen window.
+ * hookString   - Name string of hook chain.
+ * enable       - TRUE = Fuse suitable shader slots now, and after each change of the chain. FALSE = Execute all slots separately.
+ *
+ * Returns the number of image processing passes of the chain.
+ */
+int PsychPipelineFuseHook(PsychWindowRecordType *windowRecord, const char* hookString, psych_bool enable)
+{
+    int hookidx = PsychGetHookByName(hookString);
+    if (hookidx == -1) PsychErrorExitMsg(PsychError_user, "FuseShaders: Unknown (non-existent) hook name provided.");
+
+    if (!PsychIsOnscreenWindow(windowRecord)) PsychErrorExitMsg(PsychError_user, "FuseShaders: Shader fusion is only supported for onscreen windows.");
+
+    // Building and deleting fused GLSL programs needs our OpenGL context:
+    PsychSetGLContext(windowRecord);
+
+    PsychPipelineReleaseFusedShaders(windowRecord, hookidx);
+    windowRecord->HookChainFusion[hookidx] = 0;
+
+    if (enable) {
+        if (!glewIsSupported("GL_ARB_shader_objects") || !glewIsSupported("GL_ARB_fragment_shader") || !PsychIsGLClassic(windowRecord)) {
+            if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: FuseShaders: Shader fusion not supported on this system. Ignored.\n");
+        }
+        else {
+            windowRecord->HookChainFusion[hookidx] = 1;
+            PsychPipelineBuildFusedShaders(windowRecord, hookidx);
+        }
+    }
+
+    return(PsychPipelineCountHookPasses(windowRecord, hookidx, TRUE));
+}
+
 psych_bool PsychIsHookChainOperational(PsychWindowRecordType *windowRecord, int hookid)
 {
     // Child protection:
@@ -3939,6 +5211,8 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
     GLint restorefboid = 0;
     psych_bool scissor_ignore = FALSE;
     psych_bool scissor_enabled = FALSE;
+    psych_bool profiled;
+    psych_bool useFusion;
     int sciss_x, sciss_y, sciss_w, sciss_h;
 
     // Child protection:
@@ -3953,6 +5227,17 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
     // Is this an image processing hook?
     gfxprocessing = (dstfbo!=NULL) ? TRUE : FALSE;
 
+    // Time execution of this chain with the frame profiler, unless it is a chain which
+    // must not use OpenGL or executes outside of a frame:
+    profiled = (hookId != kPsychCloseWindowPreGLShutdown && hookId != kPsychCloseWindowPostGLShutdown && hookId != kPsychPreSwapbuffersOperations) ? TRUE : FALSE;
+    if (profiled) PsychProfilerPhaseBegin(windowRecord, kPsychProfilePhaseHookChain + hookId);
+
+    // Shader fusion enabled? Build fused shaders after changes of the chain. Fused shaders can only be used with the
+    // identity blitter and without override parameters, as the blitter executes only once for the whole group:
+    if (gfxprocessing && (windowRecord->HookChainFusion[hookId] == 1)) PsychPipelineBuildFusedShaders(windowRecord, hookId);
+    useFusion = (gfxprocessing && (windowRecord->HookChainFusion[hookId] == 2) && (hookUserData == NULL) &&
+                 ((hookBlitterFunction == NULL) || (hookBlitterFunction == (void*) &PsychBlitterIdentity))) ? TRUE : FALSE;
+
     // Get start of enabled chain:
     hookfunc = windowRecord->HookChain[hookId];
 
@@ -3960,6 +5245,8 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
     while(hookfunc) {
         // Pingpong command?
         if (hookfunc->hookfunctype == kPsychBuiltinFunc && strcmp(hookfunc->idString, "Builtin:FlipFBOs")==0) pendingFBOpingpongs++;
+        // Fused group of slots? Its ping-pongs don't happen:
+        if (useFusion && hookfunc->fused) hookfunc = hookfunc->fused->last;
         // Process next hookfunc slot in chain, if any:
         hookfunc = hookfunc->next;
     }
@@ -4111,6 +5398,22 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
                 // Enable associated GL context with no other side effects:
                 PsychSetGLContext(windowRecord);
             }
+            else if (useFusion && hookfunc->fused) {
+                // First slot of a group of fused shader slots: Execute the fused shader with the current uniform
+                // values of all slot shaders in one pass, then skip the rest of the group:
+                glUseProgram(hookfunc->fused->slot.shaderid);
+                PsychFusionCopyUniforms(hookfunc->fused);
+
+                if (!PsychPipelineExecuteHookSlot(windowRecord, hookId, &hookfunc->fused->slot, hookUserData, hookBlitterFunction, srcIsReadonly, allowFBOSwizzle, &mysrcfbo1, &mysrcfbo2, &mydstfbo, &mynxtfbo)) {
+                    if (PsychPrefStateGet_Verbosity()>0) {
+                        printf("PTB-ERROR: Failed in processing of Hookchain '%s' : Fused slots %i to %i --> Aborting chain processing. Set verbosity to 5 for extended debug output.\n", PsychHookPointNames[hookId], i, i + hookfunc->fused->numSlots - 1);
+                    }
+                    return(FALSE);
+                }
+
+                i += hookfunc->fused->numSlots - 1;
+                hookfunc = hookfunc->fused->last;
+            }
             else {
                 // Normal hook function - Process this hook function:
                 if (!PsychPipelineExecuteHookSlot(windowRecord, hookId, hookfunc, hookUserData, hookBlitterFunction, srcIsReadonly, allowFBOSwizzle, &mysrcfbo1, &mysrcfbo2, &mydstfbo, &mynxtfbo)) {
@@ -4152,6 +5455,8 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
         }
     }
 
+    if (profiled) PsychProfilerPhaseEnd(windowRecord, kPsychProfilePhaseHookChain + hookId);
+
     // Done.
     return(TRUE);
 }
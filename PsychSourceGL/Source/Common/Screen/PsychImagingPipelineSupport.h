@@ -64,6 +64,8 @@ void    PsychPipelineDumpHook(PsychWindowRecordType *windowRecord, const char* h
 void    PsychPipelineDisableHook(PsychWindowRecordType *windowRecord, const char* hookString);
 void    PsychPipelineEnableHook(PsychWindowRecordType *windowRecord, const char* hookString);
 void    PsychPipelineResetHook(PsychWindowRecordType *windowRecord, const char* hookString);
+int     PsychPipelineFuseHook(PsychWindowRecordType *windowRecord, const char* hookString, psych_bool enable);
+int     PsychPipelineCountHookPasses(PsychWindowRecordType *windowRecord, int hookidx, psych_bool fused);
 int     PsychPipelineQueryHookSlot(PsychWindowRecordType *windowRecord, const char* hookString, char** insertString, char** idString, char** blitterString, double* doubleptr, double* shaderid, double* luttexid1);
 void    PsychPipelineDeleteHookSlot(PsychWindowRecordType *windowRecord, const char* hookString, int slotid);
 void    PsychPipelineAddBuiltinFunctionToHook(PsychWindowRecordType *windowRecord, const char* hookString, const char* idString, int where, const char* configString);
@@ -89,6 +91,9 @@ psych_bool PsychCreateFBO(PsychFBO** fbo, GLenum fboInternalFormat, psych_bool n
 // Delete PsychFBO struct with all attached OpenGL resources:
 void PsychDeleteFBO(PsychFBO* fboptr);
 
+// Return graphics memory allocated for all FBO's of a window, and optionally the memory saved by FBO pooling:
+double PsychPipelineGetMemoryFootprint(PsychWindowRecordType *windowRecord, double *pooledBytes);
+
 // MSAA resolve given PsychFBO into a new single-sampled PsychFBO, if it is multi-sampled:
 PsychFBO* PsychMSAAResolveToTemp(PsychFBO* msaaFBO);
 
@@ -114,6 +119,7 @@ psych_bool PsychPipelineExecuteBlitter(PsychWindowRecordType *windowRecord, Psyc
 
 // Try to create GLSL shader from source strings and return handle to new shader.
 GLuint PsychCreateGLSLProgram(const char* fragmentsrc, const char* vertexsrc, const char* primitivesrc);
+psych_bool PsychLinkGLSLProgramCached(GLuint glsl, const char* preLinkState);
 
 // Assign special filter/lookup shaders to textures, e.g., in HDR mode, for float textures, etc...
 psych_bool PsychAssignHighPrecisionTextureShaders(PsychWindowRecordType* textureRecord, PsychWindowRecordType* windowRecord, int usefloatformat, int userRequest);
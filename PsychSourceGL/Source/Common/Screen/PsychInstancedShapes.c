@@ -0,0 +1,260 @@
+/*
+ *    PsychInstancedShapes.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Instanced drawing of batches of filled rects, framed rects and filled ovals
+ *    with one draw call, for Screen('FillRect'), Screen('FrameRect') and Screen('FillOval').
+ *
+ *    NOTES:
+ *
+ *    The batch drawing functions set up their input via PsychPrepareRenderBatch() as usual,
+ *    then call PsychDrawInstancedShapes(). It packs the bounding rect, RGBA color and pen
+ *    width of each shape into a vertex buffer object and draws a unit quad per shape via
+ *    glDrawArraysInstancedARB(), using the per-instance data as generic vertex attributes
+ *    with a divisor of 1. A GLSL shader places each quad and shapes it: Ovals are computed
+ *    analytically per fragment and get anti-aliased borders if the caller asks for it,
+ *    framed rects discard all fragments inside the frame.
+ *
+ *    If the window or gpu doesn't support this, PsychDrawInstancedShapes() returns FALSE
+ *    without drawing anything, and the caller must use its regular per-item drawing loop.
+ *    This is also the case if Screen('Preference', 'ConserveVRAM') contains the flag
+ *    kPsychDontUseInstancedShapes.
+ */
+
+#include "Screen.h"
+
+// Number of float values per shape instance in the vertex buffer: Bounding rect, RGBA color, pen width.
+#define kPsychInstanceFloats 9
+
+static char InstancedShapesVertexShaderSrc[] =
+"/* Vertex shader for instanced shape drawing: gl_Vertex is a corner of the unit  */\n"
+"/* quad. The per-instance attributes define bounding rect, color and pen width.  */\n"
+"/* In HDR color mode, a common color is passed in gl_MultiTexCoord0, as for our  */\n"
+"/* other shader based unclamped drawing.                                          */\n"
+"\n"
+"attribute vec4 instanceRect;\n"
+"attribute vec4 instanceColor;\n"
+"attribute float instancePenWidth;\n"
+"uniform int colorSource;\n"
+"uniform int useUnclampedFragColor;\n"
+"uniform float margin;\n"
+"varying vec4 unclampedFragColor;\n"
+"varying vec4 shapeRect;\n"
+"varying vec2 shapePos;\n"
+"varying float penWidth;\n"
+"\n"
+"void main()\n"
+"{\n"
+"    /* Color: 0 = Common regular color, 1 = common unclamped color, 2 = per instance color: */\n"
+"    if (colorSource == 2)\n"
+"        unclampedFragColor = (useUnclampedFragColor > 0) ? instanceColor : clamp(instanceColor, 0.0, 1.0);\n"
+"    else if (colorSource == 1)\n"
+"        unclampedFragColor = gl_MultiTexCoord0;\n"
+"    else\n"
+"        unclampedFragColor = gl_Color;\n"
+"\n"
+"    /* Stretch unit quad to bounding rect, expanded by margin pixels for oval borders: */\n"
+"    shapePos = mix(instanceRect.xy - margin, instanceRect.zw + margin, gl_Vertex.xy);\n"
+"    shapeRect = instanceRect;\n"
+"    penWidth = instancePenWidth;\n"
+"    gl_Position = gl_ModelViewProjectionMatrix * vec4(shapePos, 0.0, 1.0);\n"
+"}\n\0";
+
+static char InstancedShapesFragmentShaderSrc[] =
+"\n"
+"uniform int shapeType;\n"
+"uniform int antiAliased;\n"
+"varying vec4 unclampedFragColor;\n"
+"varying vec4 shapeRect;\n"
+"varying vec2 shapePos;\n"
+"varying float penWidth;\n"
+"\n"
+"void main()\n"
+"{\n"
+"    gl_FragColor = unclampedFragColor;\n"
+"\n"
+"    if (shapeType == 1) {\n"
+"        /* Framed rect: Discard fragments inside the rect inset by penWidth: */\n"
+"        if (all(greaterThan(shapePos, shapeRect.xy + penWidth)) && all(lessThan(shapePos, shapeRect.zw - penWidth)))\n"
+"            discard;\n"
+"    }\n"
+"    else if (shapeType == 2) {\n"
+"        /* Filled oval: Approximate signed distance of the fragment to the border of the */\n"
+"        /* ellipse in pixels, negative inside, from the implicit ellipse equation and    */\n"
+"        /* its gradient:                                                                 */\n"
+"        vec2 radius = 0.5 * (shapeRect.zw - shapeRect.xy);\n"
+"        vec2 p = (shapePos - 0.5 * (shapeRect.xy + shapeRect.zw)) / radius;\n"
+"        float d = (dot(p, p) - 1.0) / max(length(2.0 * p / radius), 1e-6);\n"
+"\n"
+"        /* Coverage of the pixel by the oval: Ramp over one pixel for anti-aliasing, or */\n"
+"        /* pixel center test as for regular polygons without anti-aliasing:             */\n"
+"        float coverage = (antiAliased > 0) ? clamp(0.5 - d, 0.0, 1.0) : step(d, 0.0);\n"
+"        if (coverage <= 0.0)\n"
+"            discard;\n"
+"\n"
+"        gl_FragColor.a = unclampedFragColor.a * coverage;\n"
+"    }\n"
+"}\n\0";
+
+// Corners of the unit quad, drawn as triangle strip for each instance:
+static const float unitQuad[8] = { 0, 0, 1, 0, 0, 1, 1, 1 };
+
+// Shader creation failed, or instancing unsupported? Then don't retry:
+static psych_bool nocando = FALSE;
+
+/*
+ *    PsychDrawInstancedShapes()
+ *
+ *    Draw 'numRects' shapes of type 'shapeType' with bounding rects 'xy' with one instanced
+ *    draw call. The other arguments are as returned by PsychPrepareRenderBatch(): If 'nc' > 1,
+ *    'colors' or 'bytecolors' contain one color with 'mc' components per shape, otherwise the
+ *    common color is already set up. 'penSizes' contains 'nrsize' pen widths for framed rects,
+ *    or is NULL. Empty rects are skipped. If 'antiAliased' is TRUE, ovals get anti-aliased borders
+ *    via their alpha channel, which needs alpha blending to be enabled to have an effect.
+ *
+ *    Returns TRUE if the shapes were drawn, FALSE if the caller must draw them itself.
+ */
+psych_bool PsychDrawInstancedShapes(PsychWindowRecordType *windowRecord, int shapeType, int numRects, double *xy, int nc, int mc,
+                                    double *colors, unsigned char *bytecolors, int nrsize, double *penSizes, psych_bool antiAliased)
+{
+    PsychWindowRecordType   *parentWindowRecord;
+    GLuint                  shader;
+    GLint                   rectLoc, colorLoc, penWidthLoc;
+    size_t                  size;
+    float                   *data, *instance;
+    int                     i, j, count, oldverbosity;
+
+    // Only desktop OpenGL with shaders, vertex buffers and instancing is supported. Don't bypass
+    // any special default draw shader, only the one for unclamped color drawing. Vertex buffer uploads
+    // are not recorded into display lists, and instanced draws are invalid in them, so the shapes
+    // can't be drawn this way while Screen('CommandList') recording is active:
+    if (nocando || (numRects < 1) || PsychGetCommandListRecordingWindow() || !PsychIsGLClassic(windowRecord) || !glUseProgram || !GLEW_ARB_vertex_buffer_object ||
+        !GLEW_ARB_instanced_arrays || !GLEW_ARB_draw_instanced || (PsychPrefStateGet_ConserveVRAM() & kPsychDontUseInstancedShapes) ||
+        ((windowRecord->defaultDrawShader != 0) && (windowRecord->defaultDrawShader != windowRecord->unclampedDrawShader)))
+        return(FALSE);
+
+    // Shared shader and vertex buffer live in the parent onscreen window, like other cached objects:
+    parentWindowRecord = PsychGetParentWindow(windowRecord);
+
+    if (!windowRecord->instancedShapesShader) {
+        if (!parentWindowRecord->instancedShapesShader) {
+            // Build and assign shader to parent window, but allow this to silently fail:
+            oldverbosity = PsychPrefStateGet_Verbosity();
+            PsychPrefStateSet_Verbosity(0);
+            parentWindowRecord->instancedShapesShader = PsychCreateGLSLProgram(InstancedShapesFragmentShaderSrc, InstancedShapesVertexShaderSrc, NULL);
+            PsychPrefStateSet_Verbosity(oldverbosity);
+        }
+
+        if (!parentWindowRecord->instancedShapesShader) {
+            // Failed. Record this failure so we can avoid retrying, and use the per-item fallback:
+            if (PsychPrefStateGet_Verbosity() > 3)
+                printf("PTB-INFO: Failed to create shader for instanced shape drawing. Using slower fallback path.\n");
+
+            nocando = TRUE;
+            return(FALSE);
+        }
+
+        windowRecord->instancedShapesShader = parentWindowRecord->instancedShapesShader;
+    }
+
+    shader = windowRecord->instancedShapesShader;
+    rectLoc = glGetAttribLocation(shader, "instanceRect");
+    colorLoc = glGetAttribLocation(shader, "instanceColor");
+    penWidthLoc = glGetAttribLocation(shader, "instancePenWidth");
+    if ((rectLoc < 0) || (colorLoc < 0) || (penWidthLoc < 0)) {
+        nocando = TRUE;
+        return(FALSE);
+    }
+
+    // Pack per-instance data of all non-empty shapes:
+    data = (float*) PsychMallocTemp(numRects * kPsychInstanceFloats * sizeof(float));
+    for (i = 0, count = 0; i < numRects; i++) {
+        if (IsPsychRectEmpty(&xy[i*4])) continue;
+
+        instance = &data[count * kPsychInstanceFloats];
+        count++;
+
+        for (j = 0; j < 4; j++)
+            instance[j] = (float) xy[i*4 + j];
+
+        // Per shape color, already normalized to 0-1 range by PsychPrepareRenderBatch() for double colors:
+        for (j = 0; j < 4; j++)
+            instance[4 + j] = 1;
+
+        if (nc > 1) {
+            for (j = 0; j < mc; j++)
+                instance[4 + j] = (colors) ? (float) colors[i*mc + j] : (float) bytecolors[i*mc + j] / 255.0f;
+        }
+
+        instance[8] = (penSizes) ? (float) penSizes[(nrsize > 1) ? i : 0] : 1;
+    }
+
+    // All shapes empty? Done:
+    if (count == 0)
+        return(TRUE);
+
+    // Upload unit quad and instance data. Reallocating the buffer storage each time avoids a
+    // stall on drawing which may still be pending from the previous batch:
+    size = sizeof(unitQuad) + count * kPsychInstanceFloats * sizeof(float);
+    if (!parentWindowRecord->instancedShapesVBO)
+        glGenBuffersARB(1, &(parentWindowRecord->instancedShapesVBO));
+
+    if (size > parentWindowRecord->instancedShapesVBOSize)
+        parentWindowRecord->instancedShapesVBOSize = size;
+
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, parentWindowRecord->instancedShapesVBO);
+    glBufferDataARB(GL_ARRAY_BUFFER_ARB, (GLsizeiptrARB) parentWindowRecord->instancedShapesVBOSize, NULL, GL_STREAM_DRAW_ARB);
+    glBufferSubDataARB(GL_ARRAY_BUFFER_ARB, 0, (GLsizeiptrARB) sizeof(unitQuad), unitQuad);
+    glBufferSubDataARB(GL_ARRAY_BUFFER_ARB, (GLintptrARB) sizeof(unitQuad), (GLsizeiptrARB) (size - sizeof(unitQuad)), data);
+
+    // Setup shader:
+    PsychSetShader(windowRecord, shader);
+    glUniform1i(glGetUniformLocation(shader, "shapeType"), shapeType);
+    glUniform1i(glGetUniformLocation(shader, "colorSource"), (nc > 1) ? 2 : ((windowRecord->defaultDrawShader) ? 1 : 0));
+    glUniform1i(glGetUniformLocation(shader, "useUnclampedFragColor"), (windowRecord->defaultDrawShader) ? 1 : 0);
+    glUniform1i(glGetUniformLocation(shader, "antiAliased"), (antiAliased) ? 1 : 0);
+    glUniform1f(glGetUniformLocation(shader, "margin"), (shapeType == kPsychInstancedFillOval) ? 1.0f : 0.0f);
+
+    // Unit quad as regular vertex array, instance data as generic attributes advancing once per instance:
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, (const GLvoid*) 0);
+
+    glEnableVertexAttribArray(rectLoc);
+    glVertexAttribPointer(rectLoc, 4, GL_FLOAT, GL_FALSE, kPsychInstanceFloats * sizeof(float), (const GLvoid*) (sizeof(unitQuad)));
+    glVertexAttribDivisorARB(rectLoc, 1);
+
+    glEnableVertexAttribArray(colorLoc);
+    glVertexAttribPointer(colorLoc, 4, GL_FLOAT, GL_FALSE, kPsychInstanceFloats * sizeof(float), (const GLvoid*) (sizeof(unitQuad) + 4 * sizeof(float)));
+    glVertexAttribDivisorARB(colorLoc, 1);
+
+    glEnableVertexAttribArray(penWidthLoc);
+    glVertexAttribPointer(penWidthLoc, 1, GL_FLOAT, GL_FALSE, kPsychInstanceFloats * sizeof(float), (const GLvoid*) (sizeof(unitQuad) + 8 * sizeof(float)));
+    glVertexAttribDivisorARB(penWidthLoc, 1);
+
+    // Draw all shapes:
+    glDrawArraysInstancedARB(GL_TRIANGLE_STRIP, 0, 4, count);
+
+    // Restore default state:
+    glVertexAttribDivisorARB(rectLoc, 0);
+    glVertexAttribDivisorARB(colorLoc, 0);
+    glVertexAttribDivisorARB(penWidthLoc, 0);
+    glDisableVertexAttribArray(rectLoc);
+    glDisableVertexAttribArray(colorLoc);
+    glDisableVertexAttribArray(penWidthLoc);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0);
+    glVertexPointer(2, GL_FLOAT, 0, NULL);
+
+    PsychSetShader(windowRecord, 0);
+
+    return(TRUE);
+}
@@ -0,0 +1,33 @@
+/*
+ *    PsychInstancedShapes.h
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Instanced drawing of batches of filled rects, framed rects and filled ovals
+ *    with one draw call, for Screen('FillRect'), Screen('FrameRect') and Screen('FillOval').
+ */
+
+//include once
+#ifndef PSYCH_IS_INCLUDED_PsychInstancedShapes
+#define PSYCH_IS_INCLUDED_PsychInstancedShapes
+
+#include "Screen.h"
+
+// Shape types for PsychDrawInstancedShapes():
+#define kPsychInstancedFillRect     0
+#define kPsychInstancedFrameRect    1
+#define kPsychInstancedFillOval     2
+
+psych_bool PsychDrawInstancedShapes(PsychWindowRecordType *windowRecord, int shapeType, int numRects, double *xy, int nc, int mc,
+                                    double *colors, unsigned char *bytecolors, int nrsize, double *penSizes, psych_bool antiAliased);
+
+//end include once
+#endif
@@ -220,6 +220,17 @@ int PsychPlaybackRate(int moviehandle, double playbackrate, int loop, double sou
     return(0);
 }
 
+void PsychPlaybackGroup(int numMovies, int* moviehandles, double playbackrate, int loop, double soundvolume, double when,
+                        double* droppedframes, double* meanLag, double* maxLag)
+{
+    #ifdef PTB_USE_GSTREAMER
+    PsychGSPlaybackGroup(numMovies, moviehandles, playbackrate, loop, soundvolume, when, droppedframes, meanLag, maxLag);
+    return;
+    #endif
+
+    PsychErrorExitMsg(PsychError_unimplemented, "Sorry, Movie playback support not supported on your configuration.");
+}
+
 /*
  *  void PsychExitMovies() - Shutdown handler.
  *
@@ -263,6 +274,19 @@ double PsychSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool inde
     return(0.0);
 }
 
+/*
+ *  PsychGetMovieFrameTimeIndex()  -- Return presentation time of video frame 'frameIndex' of movie.
+ */
+double PsychGetMovieFrameTimeIndex(int moviehandle, int frameIndex)
+{
+    #ifdef PTB_USE_GSTREAMER
+    return(PsychGSGetMovieFrameTimeIndex(moviehandle, frameIndex));
+    #endif
+
+    PsychErrorExitMsg(PsychError_unimplemented, "Sorry, Movie playback support not supported on your configuration.");
+    return(0.0);
+}
+
 /*
  *  PsychCopyOutMovieHDRMetaData() -- Return a struct with HDR static metadata about this movie to scripting environment.
  */
@@ -275,3 +299,16 @@ void PsychCopyOutMovieHDRMetaData(int moviehandle, int argPosition)
 
     PsychErrorExitMsg(PsychError_unimplemented, "Sorry, Movie playback support not supported on your configuration.");
 }
+
+/*
+ *  PsychCopyOutMovieStats() -- Return a struct with playback statistics of this movie to scripting environment.
+ */
+void PsychCopyOutMovieStats(int moviehandle, int argPosition)
+{
+    #ifdef PTB_USE_GSTREAMER
+    PsychGSCopyOutMovieStats(moviehandle, argPosition);
+    return;
+    #endif
+
+    PsychErrorExitMsg(PsychError_unimplemented, "Sorry, Movie playback support not supported on your configuration.");
+}
@@ -44,9 +44,13 @@ void PsychDeleteAllMovies(void);
 void PsychFreeMovieTexture(PsychWindowRecordType *win);
 int PsychGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int checkForImage, double timeindex, PsychWindowRecordType *out_texture, double *presentation_timestamp);
 int PsychPlaybackRate(int moviehandle, double playbackrate, int loop, double soundvolume);
+void PsychPlaybackGroup(int numMovies, int* moviehandles, double playbackrate, int loop, double soundvolume, double when,
+                        double* droppedframes, double* meanLag, double* maxLag);
 void PsychExitMovies(void);
 double PsychGetMovieTimeIndex(int moviehandle);
 double PsychSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames);
+double PsychGetMovieFrameTimeIndex(int moviehandle, int frameIndex);
 void PsychCopyOutMovieHDRMetaData(int moviehandle, int argPosition);
+void PsychCopyOutMovieStats(int moviehandle, int argPosition);
 //end include once
 #endif
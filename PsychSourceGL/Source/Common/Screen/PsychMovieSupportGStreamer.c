@@ -38,6 +38,7 @@
 #include <gst/app/gstappsink.h>
 #include <gst/video/video.h>
 #include <gst/pbutils/pbutils.h>
+#include <glib/gstdio.h>
 
 // When building against < GStreamer 1.18.0, define some missing video formats:
 #ifndef GST_VIDEO_FORMAT_Y444_16LE
@@ -66,6 +67,9 @@ typedef enum {
 
 #define PSYCH_MAX_MOVIES 100
 
+// Number of pixel buffer objects in the per-movie texture upload ring:
+#define PSYCH_MOVIE_UPLOADRING_SIZE 3
+
 typedef struct {
     psych_bool valid;
     int type;
@@ -79,6 +83,18 @@ typedef struct {
     double maxContentLightLevel;
 } PsychMovieHDRMetaData;
 
+typedef struct {
+    gint64              pts;            // Presentation timestamp of frame in nanoseconds.
+    int                 keyframe;       // Non-zero if frame is a keyframe, ie. decoding can start at it.
+} PsychMovieIndexEntry;
+
+typedef struct {
+    unsigned char       *data;          // Decoded frame data.
+    size_t              size;
+    unsigned int        strideBytes;
+    double              pts;            // Presentation timestamp of frame in seconds.
+} PsychMovieCachedFrame;
+
 typedef struct {
     psych_mutex         mutex;
     psych_condition     condition;
@@ -114,6 +130,34 @@ typedef struct {
     GstVideoInfo        codecVideoInfo;
     GstVideoInfo        sinkVideoInfo;
     GLuint              texturePlanarHDRDecodeShader;
+    GLuint              uploadRingBuffer[PSYCH_MOVIE_UPLOADRING_SIZE];
+    GLsync              uploadRingFence[PSYCH_MOVIE_UPLOADRING_SIZE];
+    void                *uploadRingMapping[PSYCH_MOVIE_UPLOADRING_SIZE];
+    size_t              uploadRingBufferSize;
+    int                 uploadRingSlot;
+    int                 uploadRingFrames;
+    int                 uploadRingStalls;
+    double              uploadCopyTimeTotal;
+    double              uploadCopyTimeMax;
+    PsychMovieIndexEntry *frameIndex;
+    int                 frameIndexCount;
+    int                 frameIndexCurrent;
+    PsychMovieCachedFrame *frameCache;
+    int                 frameCacheCount;
+    int                 frameCacheCapacity;
+    size_t              frameCacheBytes;
+    size_t              frameCacheBudget;
+    int                 frameCacheState;        // 0 = Off, 1 = Filling, 2 = Complete, serving playback.
+    int                 frameCacheLastFrame;
+    psych_bool          frameCachePending;
+    double              frameCacheStartPos;
+    double              frameCacheStartTime;
+    double              frameCacheDuration;
+    double              groupStartTime;         // Start time of playback group in GetSecs time, 0 if not in a group.
+    double              groupStartPos;
+    double              groupLagSum;
+    double              groupLagMax;
+    int                 groupLagCount;
 } PsychMovieRecordType;
 
 static PsychMovieRecordType movieRecordBANK[PSYCH_MAX_MOVIES];
@@ -1618,6 +1662,586 @@ hwPluginEnableOut:
     return(rc);
 }
 
+/*
+ *  Decoded frame cache:
+ *
+ *  For short clips which get played many times, the decoded video frames of the first complete forward playback
+ *  pass can be kept in system memory, within a memory budget set via the 'FrameCache=budgetMB' movieOptions keyword.
+ *  Once the cache contains all frames of the movie, the GStreamer pipeline is paused, and all following playback,
+ *  looping and seeking is served from the cache, timed by the system clock, without any decoding or startup latency.
+ */
+
+/*
+ *  PsychMovieFreeFrameCache() -- Release all cached frames.
+ */
+static void PsychMovieFreeFrameCache(PsychMovieRecordType* movie)
+{
+    int i;
+
+    for (i = 0; i < movie->frameCacheCount; i++)
+        free(movie->frameCache[i].data);
+
+    free(movie->frameCache);
+    movie->frameCache = NULL;
+    movie->frameCacheCount = 0;
+    movie->frameCacheCapacity = 0;
+    movie->frameCacheBytes = 0;
+}
+
+/*
+ *  PsychMovieCacheFrameForTime() -- Return index of the cached frame which is displayed at movie time 'timeindex'.
+ */
+static int PsychMovieCacheFrameForTime(PsychMovieRecordType* movie, double timeindex)
+{
+    int lo = 0, hi = movie->frameCacheCount - 1, mid;
+
+    // Binary search for the last frame with pts <= timeindex, with a small tolerance for rounding errors:
+    while (lo < hi) {
+        mid = (lo + hi + 1) / 2;
+        if (movie->frameCache[mid].pts <= timeindex + 0.0001)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    return(lo);
+}
+
+/*
+ *  PsychMovieCacheTime() -- Return current movie time of playback from the frame cache.
+ */
+static double PsychMovieCacheTime(PsychMovieRecordType* movie)
+{
+    double tNow, t;
+
+    if (movie->rate == 0)
+        return(movie->frameCacheStartPos);
+
+    // Scheduled start of playback in the future, e.g., by a playback group, is not reached yet?
+    PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+    if (tNow < movie->frameCacheStartTime)
+        return(movie->frameCacheStartPos);
+
+    t = movie->frameCacheStartPos + (tNow - movie->frameCacheStartTime) * movie->rate;
+
+    // Looped playback wraps around at the end of the movie, in both playback directions:
+    if (movie->loopflag) {
+        t = fmod(t, movie->frameCacheDuration);
+        if (t < 0) t += movie->frameCacheDuration;
+    }
+
+    return(t);
+}
+
+/*
+ *  PsychMovieCompleteFrameCache() -- Switch to playback from the frame cache, once it contains all frames.
+ *
+ *  pts = Current movie time, from which cached playback continues.
+ */
+static void PsychMovieCompleteFrameCache(PsychMovieRecordType* movie, double pts)
+{
+    movie->frameCacheState = 2;
+    movie->frameCacheStartPos = pts;
+    PsychGetAdjustedPrecisionTimerSeconds(&movie->frameCacheStartTime);
+    movie->frameCacheLastFrame = PsychMovieCacheFrameForTime(movie, pts);
+    movie->frameCachePending = FALSE;
+
+    // The decoder is no longer needed:
+    movie->startPending = 0;
+    PsychMoviePipelineSetState(movie->theMovie, GST_STATE_PAUSED, 10.0);
+    PsychGSProcessMovieContext(movie, FALSE);
+
+    if (PsychPrefStateGet_Verbosity() > 3)
+        printf("PTB-INFO: Movie '%s': All %i frames cached in %f MB of memory. Serving further playback from frame cache.\n",
+               movie->movieName, movie->frameCacheCount, (double) movie->frameCacheBytes / 1024 / 1024);
+}
+
+/*
+ *  PsychMovieCacheAddFrame() -- Add a decoded video frame to the frame cache while it is being filled.
+ *
+ *  Only called during forward playback. The cache must start with the first frame of the movie and must not skip
+ *  any frames. If playback wraps around to the start of the movie, the cache is complete.
+ */
+static void PsychMovieCacheAddFrame(PsychMovieRecordType* movie, const unsigned char* data, size_t size, unsigned int strideBytes, double pts, double duration)
+{
+    PsychMovieCachedFrame *frame;
+    double frameDuration = (duration > 0) ? duration : ((movie->fps > 0) ? 1.0 / movie->fps : 0);
+
+    if (movie->frameCacheCount == 0) {
+        // Wait for start of movie, e.g., after the next loop iteration:
+        if (pts > 0.5 * frameDuration)
+            return;
+    }
+    else {
+        frame = &movie->frameCache[movie->frameCacheCount - 1];
+
+        // Playback wrapped around to the start of the movie? Then the cache contains all frames:
+        if (pts < frame->pts) {
+            PsychMovieCompleteFrameCache(movie, pts);
+            return;
+        }
+
+        // Frames skipped, e.g., dropped during playback? Start over with the next playback pass:
+        if (pts - frame->pts > 1.5 * frameDuration) {
+            if (PsychPrefStateGet_Verbosity() > 4)
+                printf("PTB-DEBUG: Movie '%s': Frame cache missed frames after pts %f secs. Restarting caching at next playback pass.\n", movie->movieName, frame->pts);
+
+            PsychMovieFreeFrameCache(movie);
+            return;
+        }
+
+        // Same frame fetched repeatedly?
+        if (pts == frame->pts)
+            return;
+    }
+
+    if (movie->frameCacheBytes + size > movie->frameCacheBudget) {
+        if (PsychPrefStateGet_Verbosity() > 2)
+            printf("PTB-INFO: Movie '%s': Decoded frames exceed the frame cache memory budget of %f MB. Frame cache disabled.\n",
+                   movie->movieName, (double) movie->frameCacheBudget / 1024 / 1024);
+
+        PsychMovieFreeFrameCache(movie);
+        movie->frameCacheState = 0;
+        return;
+    }
+
+    if (movie->frameCacheCount >= movie->frameCacheCapacity) {
+        movie->frameCacheCapacity = (movie->frameCacheCapacity > 0) ? movie->frameCacheCapacity * 2 : 256;
+        movie->frameCache = (PsychMovieCachedFrame*) realloc(movie->frameCache, movie->frameCacheCapacity * sizeof(PsychMovieCachedFrame));
+        if (NULL == movie->frameCache) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while caching decoded movie frames!");
+    }
+
+    frame = &movie->frameCache[movie->frameCacheCount];
+    frame->data = (unsigned char*) malloc(size);
+    if (NULL == frame->data) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while caching decoded movie frames!");
+
+    memcpy(frame->data, data, size);
+    frame->size = size;
+    frame->strideBytes = strideBytes;
+    frame->pts = pts;
+
+    movie->frameCacheCount++;
+    movie->frameCacheBytes += size;
+    movie->frameCacheDuration = pts + frameDuration;
+}
+
+/*
+ *  PsychMovieCachePoll() -- Check for, or select, the next frame to return from the frame cache.
+ *
+ *  Mirrors the semantics of PsychGSGetTextureFromMovie(): Returns TRUE and the frame to return in *frame
+ *  if a new frame is available, FALSE if none is available yet, -1 if none will be available in the future.
+ */
+static int PsychMovieCachePoll(PsychMovieRecordType* movie, int checkForImage, double timeindex, int *frame)
+{
+    double t, waitSecs;
+
+    if (movie->rate == 0) {
+        // Manual fetch mode: A 'timeindex' seeks, otherwise frames are returned one after another:
+        if (checkForImage && (timeindex >= 0)) {
+            movie->frameCacheStartPos = timeindex;
+            movie->frameCachePending = TRUE;
+        }
+
+        if (!movie->frameCachePending) {
+            if (movie->endOfFetch) {
+                movie->endOfFetch = 0;
+                return(-1);
+            }
+
+            return(FALSE);
+        }
+
+        *frame = PsychMovieCacheFrameForTime(movie, movie->frameCacheStartPos);
+
+        // Fetch advances to the next frame, if any:
+        if (!checkForImage) {
+            if (*frame < movie->frameCacheCount - 1) {
+                movie->frameCacheStartPos = movie->frameCache[*frame + 1].pts;
+            }
+            else {
+                movie->frameCachePending = FALSE;
+                movie->endOfFetch = 1;
+            }
+        }
+
+        return(TRUE);
+    }
+
+    // Active playback: End of non-looped playback reached?
+    t = PsychMovieCacheTime(movie);
+    if ((t >= movie->frameCacheDuration) || (t < 0))
+        return(-1);
+
+    *frame = PsychMovieCacheFrameForTime(movie, t);
+
+    // Blocking check and no new frame yet? Wait until the next frame is due, but at most 0.5 seconds:
+    if ((*frame == movie->frameCacheLastFrame) && (checkForImage == 2)) {
+        if (movie->rate > 0)
+            waitSecs = (((*frame < movie->frameCacheCount - 1) ? movie->frameCache[*frame + 1].pts : movie->frameCacheDuration) - t) / movie->rate;
+        else
+            waitSecs = (t - movie->frameCache[*frame].pts) / -movie->rate;
+
+        PsychWaitIntervalSeconds((waitSecs < 0.5) ? waitSecs + 0.0001 : 0.5);
+
+        t = PsychMovieCacheTime(movie);
+        if ((t >= movie->frameCacheDuration) || (t < 0))
+            return(-1);
+
+        *frame = PsychMovieCacheFrameForTime(movie, t);
+    }
+
+    // A fetch always returns the current frame:
+    if (!checkForImage) {
+        movie->frameCacheLastFrame = *frame;
+        return(TRUE);
+    }
+
+    return((*frame != movie->frameCacheLastFrame) ? TRUE : FALSE);
+}
+
+/*
+ *      Frame index support:
+ *
+ *      A frame index is a table of the exact presentation timestamps of all video frames of a movie, sorted
+ *      by presentation time, with a flag for each frame if it is a keyframe. It is built by demuxing and parsing
+ *      the video stream without decoding it, which is much faster than decoding. Only local movie files get indexed,
+ *      and the index is stored in a sidecar file next to the movie, so it only needs to be built once. The index allows exact
+ *      seeks to a given frame number, and to advance by a few frames via frame stepping, instead of a flushing
+ *      seek which would restart decoding from the previous keyframe.
+ */
+#define PSYCH_MOVIE_INDEX_MAGIC "PTBMOVIEINDEX2"
+
+// Sidecar file layout after the magic string, all integers in little-endian byte order, independent of the
+// padding and byte order of our in-memory structs: Header with movie file size (64 bit), modification time
+// (64 bit) and number of entries (32 bit), followed by the entries, each with the presentation timestamp
+// (64 bit) and keyframe flag (8 bit):
+#define PSYCH_MOVIE_INDEX_HEADERSIZE    20
+#define PSYCH_MOVIE_INDEX_ENTRYSIZE     9
+
+// Give up on building a frame index if the parser doesn't deliver a new video frame for this many seconds:
+#define PSYCH_MOVIE_INDEX_STALLTIMEOUT  10.0
+
+static void PsychMovieIndexPutUInt(unsigned char *p, guint64 value, int nbytes)
+{
+    int i;
+
+    for (i = 0; i < nbytes; i++) p[i] = (unsigned char) (value >> (8 * i));
+}
+
+static guint64 PsychMovieIndexGetUInt(const unsigned char *p, int nbytes)
+{
+    guint64 value = 0;
+    int i;
+
+    for (i = 0; i < nbytes; i++) value |= ((guint64) p[i]) << (8 * i);
+
+    return(value);
+}
+
+// Callback for linking the output pad of urisourcebin to parsebin:
+static void PsychMovieIndexSourcePadAdded(GstElement *source, GstPad *pad, gpointer user_data)
+{
+    GstElement *parser = (GstElement*) user_data;
+    GstPad *sinkpad;
+    (void) source;
+
+    sinkpad = gst_element_get_static_pad(parser, "sink");
+    if (!gst_pad_is_linked(sinkpad)) gst_pad_link(pad, sinkpad);
+    gst_object_unref(sinkpad);
+}
+
+// Callback for detection of parsebin having exposed all its output pads:
+static void PsychMovieIndexNoMorePads(GstElement *parser, gpointer user_data)
+{
+    (void) parser;
+    *((psych_bool*) user_data) = TRUE;
+}
+
+// Callback for linking the video output pad of parsebin to our appsink:
+static void PsychMovieIndexPadAdded(GstElement *parser, GstPad *pad, gpointer user_data)
+{
+    GstElement *appsink = (GstElement*) user_data;
+    GstPad *sinkpad;
+    GstCaps *caps;
+    (void) parser;
+
+    caps = gst_pad_query_caps(pad, NULL);
+    if (caps && (gst_caps_get_size(caps) > 0) && g_str_has_prefix(gst_structure_get_name(gst_caps_get_structure(caps, 0)), "video/")) {
+        sinkpad = gst_element_get_static_pad(appsink, "sink");
+        if (!gst_pad_is_linked(sinkpad)) gst_pad_link(pad, sinkpad);
+        gst_object_unref(sinkpad);
+    }
+
+    if (caps) gst_caps_unref(caps);
+}
+
+static int PsychMovieIndexCompare(const void *a, const void *b)
+{
+    gint64 ptsA = ((const PsychMovieIndexEntry*) a)->pts;
+    gint64 ptsB = ((const PsychMovieIndexEntry*) b)->pts;
+
+    return((ptsA < ptsB) ? -1 : ((ptsA > ptsB) ? 1 : 0));
+}
+
+/*
+ *      PsychMovieBuildFrameIndex() -- Build frame index by parsing the video stream of a movie.
+ */
+static psych_bool PsychMovieBuildFrameIndex(PsychMovieRecordType* movie)
+{
+    GstElement      *pipeline, *source, *parser, *appsink;
+    GstSample       *sample;
+    GstBuffer       *buffer;
+    GstBus          *bus;
+    GstMessage      *msg;
+    GstPad          *sinkpad;
+    GError          *error = NULL;
+    PsychMovieIndexEntry *entries = NULL, *newEntries;
+    int             count = 0, capacity = 0, numKeyframes = 0, i;
+    psych_bool      rc = FALSE, noMorePads = FALSE, linked;
+    double          tStart, tNow, tLastFrame;
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+
+    // Source for the movie, which feeds parsebin to demux and parse the streams, and an appsink for the video
+    // stream, which receives parsed, but not decoded, video frames:
+    pipeline = gst_pipeline_new("ptbindexpipeline");
+    source = gst_element_factory_make("urisourcebin", "ptbindexsource");
+    parser = gst_element_factory_make("parsebin", "ptbindexparser");
+    appsink = gst_element_factory_make("appsink", "ptbindexsink");
+    if (!pipeline || !source || !parser || !appsink) {
+        if (PsychPrefStateGet_Verbosity() > 1)
+            printf("PTB-WARNING: Could not create parser for frame index of movie '%s'. GStreamer urisourcebin or parsebin plugins missing?\n", movie->movieName);
+        if (pipeline) gst_object_unref(pipeline);
+        if (source) gst_object_unref(source);
+        if (parser) gst_object_unref(parser);
+        if (appsink) gst_object_unref(appsink);
+        return(FALSE);
+    }
+
+    g_object_set(G_OBJECT(source), "uri", movie->movieLocation, NULL);
+    gst_app_sink_set_emit_signals(GST_APP_SINK(appsink), FALSE);
+    g_object_set(G_OBJECT(appsink), "sync", FALSE, NULL);
+    gst_bin_add_many(GST_BIN(pipeline), source, parser, appsink, NULL);
+
+    g_signal_connect(source, "pad-added", G_CALLBACK(PsychMovieIndexSourcePadAdded), parser);
+    g_signal_connect(parser, "pad-added", G_CALLBACK(PsychMovieIndexPadAdded), appsink);
+    g_signal_connect(parser, "no-more-pads", G_CALLBACK(PsychMovieIndexNoMorePads), &noMorePads);
+
+    bus = gst_element_get_bus(pipeline);
+    gst_element_set_state(pipeline, GST_STATE_PLAYING);
+    tLastFrame = tStart;
+
+    // Collect timestamps and keyframe flags of all video frames until end of stream or error:
+    while (TRUE) {
+        sample = gst_app_sink_try_pull_sample(GST_APP_SINK(appsink), GST_SECOND / 10);
+        if (sample) {
+            PsychGetAdjustedPrecisionTimerSeconds(&tLastFrame);
+            buffer = gst_sample_get_buffer(sample);
+            if (!GST_BUFFER_PTS_IS_VALID(buffer)) {
+                // Without valid timestamps for all frames, an index is useless:
+                gst_sample_unref(sample);
+                if (PsychPrefStateGet_Verbosity() > 2)
+                    printf("PTB-INFO: Movie '%s' does not provide presentation timestamps for all frames. Can't build a frame index.\n", movie->movieName);
+                goto indexBuildOut;
+            }
+
+            if (count >= capacity) {
+                capacity = (capacity > 0) ? capacity * 2 : 1024;
+                newEntries = (PsychMovieIndexEntry*) realloc(entries, capacity * sizeof(PsychMovieIndexEntry));
+                if (NULL == newEntries) {
+                    gst_sample_unref(sample);
+                    goto indexBuildOut;
+                }
+                entries = newEntries;
+            }
+
+            entries[count].pts = (gint64) GST_BUFFER_PTS(buffer);
+            entries[count].keyframe = !GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+            count++;
+
+            gst_sample_unref(sample);
+            continue;
+        }
+
+        if (gst_app_sink_is_eos(GST_APP_SINK(appsink)))
+            break;
+
+        msg = gst_bus_pop_filtered(bus, GST_MESSAGE_ERROR);
+        if (msg) {
+            gst_message_parse_error(msg, &error, NULL);
+            if (PsychPrefStateGet_Verbosity() > 1)
+                printf("PTB-WARNING: Failed to build frame index of movie '%s': %s\n", movie->movieName, (error) ? error->message : "Unknown error");
+            if (error) g_error_free(error);
+            gst_message_unref(msg);
+            goto indexBuildOut;
+        }
+
+        // Movies without video stream, e.g., audio-only files, never deliver a frame:
+        sinkpad = gst_element_get_static_pad(appsink, "sink");
+        linked = gst_pad_is_linked(sinkpad);
+        gst_object_unref(sinkpad);
+        if (noMorePads && !linked) {
+            if (PsychPrefStateGet_Verbosity() > 2)
+                printf("PTB-INFO: Movie '%s' has no video stream. Can't build a frame index.\n", movie->movieName);
+            goto indexBuildOut;
+        }
+
+        // Don't wait forever for a stalled parser:
+        PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+        if (tNow - tLastFrame > PSYCH_MOVIE_INDEX_STALLTIMEOUT) {
+            if (PsychPrefStateGet_Verbosity() > 1)
+                printf("PTB-WARNING: Parser for frame index of movie '%s' stalled for more than %f seconds. Giving up on frame index.\n", movie->movieName, PSYCH_MOVIE_INDEX_STALLTIMEOUT);
+            goto indexBuildOut;
+        }
+    }
+
+    if (count == 0) {
+        if (PsychPrefStateGet_Verbosity() > 2)
+            printf("PTB-INFO: Movie '%s' has no parseable video frames. Can't build a frame index.\n", movie->movieName);
+        goto indexBuildOut;
+    }
+
+    // Frames arrive in decode order, but the index is in presentation order:
+    qsort(entries, count, sizeof(PsychMovieIndexEntry), PsychMovieIndexCompare);
+
+    // First frame always needs to start decoding somewhere, so treat it as keyframe:
+    entries[0].keyframe = 1;
+
+    movie->frameIndex = entries;
+    movie->frameIndexCount = count;
+    entries = NULL;
+    rc = TRUE;
+
+    if (PsychPrefStateGet_Verbosity() > 3) {
+        PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+        for (i = 0; i < count; i++) numKeyframes += movie->frameIndex[i].keyframe;
+        printf("PTB-INFO: Built frame index for movie '%s': %i frames, %i keyframes, in %f seconds.\n", movie->movieName, count, numKeyframes, tNow - tStart);
+    }
+
+indexBuildOut:
+
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    gst_object_unref(bus);
+    gst_object_unref(pipeline);
+    free(entries);
+
+    return(rc);
+}
+
+/*
+ *      PsychMovieSetupFrameIndex() -- Load frame index of a movie from its sidecar file, or build and store it.
+ */
+static void PsychMovieSetupFrameIndex(PsychMovieRecordType* movie)
+{
+    char                        indexFileName[FILENAME_MAX];
+    char                        magic[sizeof(PSYCH_MOVIE_INDEX_MAGIC)];
+    unsigned char               header[PSYCH_MOVIE_INDEX_HEADERSIZE];
+    unsigned char               *entries;
+    guint64                     count;
+    GStatBuf                    movieStat;
+    FILE                        *fd;
+    psych_bool                  isLocal, rc;
+    int                         i;
+
+    // Sidecar files only for local movie files with known size and modification time:
+    isLocal = !strstr(movie->movieName, "://") && (g_stat(movie->movieName, &movieStat) == 0);
+    if (isLocal) {
+        snprintf(indexFileName, sizeof(indexFileName), "%s.ptbindex", movie->movieName);
+
+        fd = g_fopen(indexFileName, "rb");
+        if (fd) {
+            // Only use the stored index if it belongs to the current version of the movie file:
+            count = 0;
+            if ((fread(magic, sizeof(magic), 1, fd) == 1) && !memcmp(magic, PSYCH_MOVIE_INDEX_MAGIC, sizeof(magic)) &&
+                (fread(header, sizeof(header), 1, fd) == 1) && (PsychMovieIndexGetUInt(&header[0], 8) == (guint64) movieStat.st_size) &&
+                (PsychMovieIndexGetUInt(&header[8], 8) == (guint64) movieStat.st_mtime))
+                count = PsychMovieIndexGetUInt(&header[16], 4);
+
+            if ((count > 0) && (count < INT_MAX / PSYCH_MOVIE_INDEX_ENTRYSIZE)) {
+                entries = (unsigned char*) malloc(count * PSYCH_MOVIE_INDEX_ENTRYSIZE);
+                movie->frameIndex = (PsychMovieIndexEntry*) malloc(count * sizeof(PsychMovieIndexEntry));
+                if (entries && movie->frameIndex && (fread(entries, PSYCH_MOVIE_INDEX_ENTRYSIZE, count, fd) == (size_t) count)) {
+                    for (i = 0; i < (int) count; i++) {
+                        movie->frameIndex[i].pts = (gint64) PsychMovieIndexGetUInt(&entries[i * PSYCH_MOVIE_INDEX_ENTRYSIZE], 8);
+                        movie->frameIndex[i].keyframe = (int) entries[i * PSYCH_MOVIE_INDEX_ENTRYSIZE + 8];
+                    }
+                    movie->frameIndexCount = (int) count;
+                }
+                else {
+                    free(movie->frameIndex);
+                    movie->frameIndex = NULL;
+                }
+                free(entries);
+            }
+            fclose(fd);
+
+            if (movie->frameIndex) {
+                if (PsychPrefStateGet_Verbosity() > 3)
+                    printf("PTB-INFO: Loaded frame index for movie '%s' with %i frames from file '%s'.\n", movie->movieName, movie->frameIndexCount, indexFileName);
+                return;
+            }
+
+            if (PsychPrefStateGet_Verbosity() > 3)
+                printf("PTB-INFO: Frame index file '%s' is invalid or outdated. Rebuilding it.\n", indexFileName);
+        }
+    }
+
+    // Parsing remote or live streams may take arbitrarily long or never end, so only index local movie files:
+    if (!isLocal || !PsychMovieBuildFrameIndex(movie))
+        return;
+
+    // Store index in sidecar file for use by future sessions. Failure is not fatal, e.g., if the movie is
+    // stored on a read-only filesystem, we just use the index for this session:
+    PsychMovieIndexPutUInt(&header[0], (guint64) movieStat.st_size, 8);
+    PsychMovieIndexPutUInt(&header[8], (guint64) movieStat.st_mtime, 8);
+    PsychMovieIndexPutUInt(&header[16], (guint64) movie->frameIndexCount, 4);
+
+    entries = (unsigned char*) malloc(movie->frameIndexCount * PSYCH_MOVIE_INDEX_ENTRYSIZE);
+    if (entries) {
+        for (i = 0; i < movie->frameIndexCount; i++) {
+            PsychMovieIndexPutUInt(&entries[i * PSYCH_MOVIE_INDEX_ENTRYSIZE], (guint64) movie->frameIndex[i].pts, 8);
+            entries[i * PSYCH_MOVIE_INDEX_ENTRYSIZE + 8] = (movie->frameIndex[i].keyframe) ? 1 : 0;
+        }
+    }
+
+    fd = (entries) ? g_fopen(indexFileName, "wb") : NULL;
+    rc = (fd && (fwrite(PSYCH_MOVIE_INDEX_MAGIC, sizeof(magic), 1, fd) == 1) && (fwrite(header, sizeof(header), 1, fd) == 1) &&
+          (fwrite(entries, PSYCH_MOVIE_INDEX_ENTRYSIZE, movie->frameIndexCount, fd) == (size_t) movie->frameIndexCount)) ? TRUE : FALSE;
+    if (fd) fclose(fd);
+    free(entries);
+
+    // Remove partially written file, so it doesn't get rejected on each future session:
+    if (!rc) {
+        if (fd) g_remove(indexFileName);
+        if (PsychPrefStateGet_Verbosity() > 2)
+            printf("PTB-INFO: Could not store frame index of movie '%s' in file '%s'. Index will be rebuilt next time.\n", movie->movieName, indexFileName);
+    }
+}
+
+/*
+ *      PsychMovieFrameForTime() -- Return index of the video frame which is displayed at movie time 'timeindex' seconds.
+ */
+static int PsychMovieFrameForTime(PsychMovieRecordType* movie, double timeindex)
+{
+    // Small tolerance for rounding errors of timestamps computed by usercode:
+    gint64 t = (gint64) ((timeindex + 0.0001) * (double) 1e9);
+    int lo = 0, hi = movie->frameIndexCount - 1, mid;
+
+    // Binary search for the last frame with pts <= t:
+    if (movie->frameIndex[0].pts > t)
+        return(0);
+
+    while (lo < hi) {
+        mid = (lo + hi + 1) / 2;
+        if (movie->frameIndex[mid].pts <= t)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    return(lo);
+}
+
 /*
  *      PsychGSCreateMovie() -- Create a movie object.
  *
@@ -1700,6 +2324,14 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
         // is playing, it will switch to it at the end of the current playback iteration:
         g_object_set(G_OBJECT(theMovie), "uri", movieLocation, NULL);
 
+        // Frame index and frame cache of the old movie, if any, don't apply to the new one:
+        PsychMovieFreeFrameCache(&movieRecordBANK[*moviehandle]);
+        movieRecordBANK[*moviehandle].frameCacheState = 0;
+        free(movieRecordBANK[*moviehandle].frameIndex);
+        movieRecordBANK[*moviehandle].frameIndex = NULL;
+        movieRecordBANK[*moviehandle].frameIndexCount = 0;
+        movieRecordBANK[*moviehandle].frameIndexCurrent = -1;
+
         // Ready.
         return;
     }
@@ -2554,10 +3186,227 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
         GST_DEBUG_BIN_TO_DOT_FILE_WITH_TS(GST_BIN(movieRecordBANK[slotid].theMovie), GST_DEBUG_GRAPH_SHOW_ALL, "PsychMoviePlaybackGraph");
     }
 
+    // Optional 'movieOptions' parameter 'FrameIndex=1' specified to use a frame index for frame accurate random access?
+    movieRecordBANK[slotid].frameIndexCurrent = -1;
+    if ((pstring = strstr((char*) movieOptions, "FrameIndex=")) && (atoi(pstring + strlen("FrameIndex=")) > 0) &&
+        (movieRecordBANK[slotid].nrVideoTracks > 0) && !strstr(moviename, "v4l2:")) {
+        PsychMovieSetupFrameIndex(&movieRecordBANK[slotid]);
+
+        // Index provides the exact number of frames:
+        if (movieRecordBANK[slotid].frameIndex)
+            movieRecordBANK[slotid].nrframes = movieRecordBANK[slotid].frameIndexCount;
+    }
+
+    // Optional 'movieOptions' parameter 'FrameCache=budgetMB' specified to cache decoded frames for replay without decoding?
+    if ((pstring = strstr((char*) movieOptions, "FrameCache=")) && (atof(pstring + strlen("FrameCache=")) > 0) && (movieRecordBANK[slotid].nrVideoTracks > 0)) {
+        if ((movieRecordBANK[slotid].nrAudioTracks > 0) && !(specialFlags1 & 2)) {
+            // Cached playback is timed by the system clock and can't play sound:
+            if (PsychPrefStateGet_Verbosity() > 2)
+                printf("PTB-INFO: Frame cache for movie '%s' disabled, as it is not supported for movies with sound. Use 'specialFlags1' setting 2 to disable sound.\n", moviename);
+        }
+        else {
+            movieRecordBANK[slotid].frameCacheBudget = (size_t) (atof(pstring + strlen("FrameCache=")) * 1024 * 1024);
+            movieRecordBANK[slotid].frameCacheState = 1;
+        }
+    }
+
     // Ready to rock!
     return;
 }
 
+/*
+ *  PsychMovieDeleteUploadRing() -- Release the pixel buffer objects and fences of the texture upload ring.
+ *
+ *  The OpenGL context of the window which owns the ring must be bound by the caller.
+ */
+static void PsychMovieDeleteUploadRing(PsychMovieRecordType* movie)
+{
+    int i;
+
+    for (i = 0; i < PSYCH_MOVIE_UPLOADRING_SIZE; i++) {
+        if (movie->uploadRingFence[i]) glDeleteSync(movie->uploadRingFence[i]);
+        movie->uploadRingFence[i] = NULL;
+
+        if (movie->uploadRingBuffer[i]) {
+            // Persistently mapped buffers must be unmapped before deletion:
+            if (movie->uploadRingMapping[i]) {
+                glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, movie->uploadRingBuffer[i]);
+                glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB);
+                glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+            }
+
+            glDeleteBuffersARB(1, &movie->uploadRingBuffer[i]);
+        }
+
+        movie->uploadRingBuffer[i] = 0;
+        movie->uploadRingMapping[i] = NULL;
+    }
+
+    movie->uploadRingBufferSize = 0;
+    movie->uploadRingSlot = 0;
+}
+
+/*
+ *  PsychMovieStageFrameInUploadRing() -- Copy a decoded video frame into the next buffer of the upload ring.
+ *
+ *  Instead of uploading a video frame from GStreamer owned memory, which forces the driver to make a synchronous
+ *  copy of the frame inside glTexImage2D/glTexSubImage2D, the frame is copied into one of a small ring of pixel
+ *  unpack buffer objects. If GL_ARB_buffer_storage is supported, these are persistently mapped into our address
+ *  space, so this copy is the only one done by the cpu, straight into memory the gpu can DMA from. The following
+ *  texture upload sources from that buffer asynchronously, while the next frames go into the other ring buffers.
+ *
+ *  On success, out_texture->textureMemory is set to NULL, ie. offset zero into the buffer, and the texture must
+ *  get created via PsychMovieCreateTexture(), so it sources from the buffer. Returns FALSE if the ring can't be
+ *  used, leaving everything untouched.
+ */
+static psych_bool PsychMovieStageFrameInUploadRing(PsychMovieRecordType* movie, PsychWindowRecordType *win,
+                                                   PsychWindowRecordType *out_texture, size_t framesize)
+{
+    int i;
+    GLenum result;
+    double tStart, tEnd;
+    psych_bool persistent;
+
+    // Only for desktop OpenGL with PBO's and fences, and not for power-of-two emulation textures, whose initial
+    // glTexImage2D must not source any data. Frames which need cpu post-processing, ie. Bayer filtering or
+    // component swizzling of 16 bpc RGBA frames, are excluded as well:
+    if (!PsychIsGLClassic(win) || !glewIsSupported("GL_ARB_pixel_buffer_object") || !glewIsSupported("GL_ARB_sync") ||
+        ((PsychGetTextureTarget(win) == GL_TEXTURE_2D) && !(win->gfxcaps & kPsychGfxCapNPOTTex)) ||
+        (movie->specialFlags1 & (1024 | 2048)) || ((movie->bitdepth > 8) && (movie->pixelFormat == 4)) ||
+        (out_texture->textureMemory == NULL) || (framesize == 0))
+        return(FALSE);
+
+    persistent = glewIsSupported("GL_ARB_buffer_storage");
+
+    // (Re-)Create ring if this frame doesn't fit into the current ring buffers:
+    if (framesize > movie->uploadRingBufferSize) {
+        PsychMovieDeleteUploadRing(movie);
+
+        glGenBuffersARB(PSYCH_MOVIE_UPLOADRING_SIZE, movie->uploadRingBuffer);
+        for (i = 0; i < PSYCH_MOVIE_UPLOADRING_SIZE; i++) {
+            glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, movie->uploadRingBuffer[i]);
+            if (persistent) {
+                glBufferStorage(GL_PIXEL_UNPACK_BUFFER_ARB, (GLsizeiptr) framesize, NULL, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+                movie->uploadRingMapping[i] = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER_ARB, 0, (GLsizeiptr) framesize, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+            }
+            else {
+                glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, (GLsizeiptrARB) framesize, NULL, GL_STREAM_DRAW_ARB);
+            }
+        }
+        glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+
+        if ((glGetError() != GL_NO_ERROR) || (persistent && !movie->uploadRingMapping[PSYCH_MOVIE_UPLOADRING_SIZE - 1])) {
+            while (glGetError());
+            PsychMovieDeleteUploadRing(movie);
+
+            // Disable the ring for this movie, so we don't retry on each frame:
+            movie->specialFlags1 |= 2048;
+            if (PsychPrefStateGet_Verbosity() > 2)
+                printf("PTB-INFO: Failed to create texture upload ring buffers for movie '%s'. Using standard texture upload.\n", movie->movieName);
+
+            return(FALSE);
+        }
+
+        movie->uploadRingBufferSize = framesize;
+
+        if (PsychPrefStateGet_Verbosity() > 4)
+            printf("PTB-INFO: Movie '%s' uses a ring of %i %s texture upload buffers of %i bytes each.\n", movie->movieName,
+                   PSYCH_MOVIE_UPLOADRING_SIZE, (persistent) ? "persistently mapped" : "streaming", (int) framesize);
+    }
+
+    // Advance to next ring buffer. Wait for completion of the texture upload which last sourced from it, if
+    // any. With a ring of multiple buffers this almost never needs to wait:
+    movie->uploadRingSlot = (movie->uploadRingSlot + 1) % PSYCH_MOVIE_UPLOADRING_SIZE;
+    if (movie->uploadRingFence[movie->uploadRingSlot]) {
+        result = glClientWaitSync(movie->uploadRingFence[movie->uploadRingSlot], GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED)) {
+            movie->uploadRingStalls++;
+            glClientWaitSync(movie->uploadRingFence[movie->uploadRingSlot], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        }
+
+        glDeleteSync(movie->uploadRingFence[movie->uploadRingSlot]);
+        movie->uploadRingFence[movie->uploadRingSlot] = NULL;
+    }
+
+    // Copy the frame into the ring buffer:
+    PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+
+    glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, movie->uploadRingBuffer[movie->uploadRingSlot]);
+    if (movie->uploadRingMapping[movie->uploadRingSlot]) {
+        memcpy(movie->uploadRingMapping[movie->uploadRingSlot], out_texture->textureMemory, framesize);
+    }
+    else {
+        // Orphan the old buffer storage, so we don't wait for the gpu, and fill the fresh storage:
+        glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, (GLsizeiptrARB) movie->uploadRingBufferSize, NULL, GL_STREAM_DRAW_ARB);
+        glBufferSubDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0, (GLsizeiptrARB) framesize, out_texture->textureMemory);
+    }
+    glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tEnd);
+
+    movie->uploadRingFrames++;
+    movie->uploadCopyTimeTotal += tEnd - tStart;
+    if (tEnd - tStart > movie->uploadCopyTimeMax) movie->uploadCopyTimeMax = tEnd - tStart;
+
+    if (PsychPrefStateGet_Verbosity() > 5)
+        printf("PTB-DEBUG: Staged %i bytes of video frame in upload ring buffer %i: %f msecs.\n", (int) framesize, movie->uploadRingSlot, (tEnd - tStart) * 1000.0);
+
+    // With a bound pixel unpack buffer, the data pointer for texture upload is an offset into that buffer:
+    out_texture->textureMemory = NULL;
+
+    return(TRUE);
+}
+
+/*
+ *  PsychMovieCreateTexture() -- PsychCreateTexture() for a video frame, optionally staged in the upload ring.
+ *
+ *  If the frame was staged via PsychMovieStageFrameInUploadRing(), the texture upload sources from the current
+ *  ring buffer, and a fence is inserted after it, so we know when the buffer can be refilled with a new frame.
+ */
+static void PsychMovieCreateTexture(PsychMovieRecordType* movie, PsychWindowRecordType *out_texture, psych_bool usedUploadRing)
+{
+    if (usedUploadRing) glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, movie->uploadRingBuffer[movie->uploadRingSlot]);
+
+    PsychCreateTexture(out_texture);
+
+    if (usedUploadRing) {
+        glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        movie->uploadRingFence[movie->uploadRingSlot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        // Kick off processing of the upload without waiting for it:
+        glFlush();
+    }
+}
+
+/*
+ *  PsychMovieGroupTrackLag() -- Track lag of the last fetched frame behind the shared clock of a playback group.
+ */
+static void PsychMovieGroupTrackLag(PsychMovieRecordType* movie)
+{
+    double tNow, expected, lag;
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+    if (tNow < movie->groupStartTime)
+        return;
+
+    // Movie time which should be displayed now according to the group clock:
+    expected = movie->groupStartPos + (tNow - movie->groupStartTime) * movie->rate;
+    if (movie->loopflag && (movie->movieduration > 0)) {
+        expected = fmod(expected, movie->movieduration);
+        if (expected < 0) expected += movie->movieduration;
+    }
+
+    lag = (movie->rate > 0) ? expected - movie->pts : movie->pts - expected;
+
+    // Skip bogus values at the wrap-around of looped playback:
+    if (movie->loopflag && (fabs(lag) > 0.5 * movie->movieduration))
+        return;
+
+    movie->groupLagSum += lag;
+    movie->groupLagCount++;
+    if (lag > movie->groupLagMax) movie->groupLagMax = lag;
+}
+
 /*
  *  PsychGSGetMovieInfos() - Return basic information about a movie.
  *
@@ -2623,6 +3472,13 @@ void PsychGSDeleteMovie(int moviehandle)
     movieRecordBANK[moviehandle].imageBuffer = NULL;
     movieRecordBANK[moviehandle].videosink = NULL;
 
+    free(movieRecordBANK[moviehandle].frameIndex);
+    movieRecordBANK[moviehandle].frameIndex = NULL;
+    movieRecordBANK[moviehandle].frameIndexCount = 0;
+
+    PsychMovieFreeFrameCache(&movieRecordBANK[moviehandle]);
+    movieRecordBANK[moviehandle].frameCacheState = 0;
+
     // Recycled texture in texture cache?
     if ((movieRecordBANK[moviehandle].parentRecord) && (movieRecordBANK[moviehandle].cached_texture > 0)) {
         // Yes. Release it.
@@ -2631,6 +3487,20 @@ void PsychGSDeleteMovie(int moviehandle)
         movieRecordBANK[moviehandle].cached_texture = 0;
     }
 
+    // Texture upload ring in use? Report its stats and release it:
+    if (movieRecordBANK[moviehandle].uploadRingFrames > 0) {
+        if (PsychPrefStateGet_Verbosity() > 3)
+            printf("PTB-INFO: Movie '%s': %i frames uploaded via upload ring. Frame copy time avg %f msecs, max %f msecs. %i stalls waiting for a free ring buffer.\n",
+                   movieRecordBANK[moviehandle].movieName, movieRecordBANK[moviehandle].uploadRingFrames,
+                   movieRecordBANK[moviehandle].uploadCopyTimeTotal * 1000.0 / movieRecordBANK[moviehandle].uploadRingFrames,
+                   movieRecordBANK[moviehandle].uploadCopyTimeMax * 1000.0, movieRecordBANK[moviehandle].uploadRingStalls);
+    }
+
+    if ((movieRecordBANK[moviehandle].parentRecord) && (movieRecordBANK[moviehandle].uploadRingBuffer[0] > 0)) {
+        PsychSetGLContext(movieRecordBANK[moviehandle].parentRecord);
+        PsychMovieDeleteUploadRing(&movieRecordBANK[moviehandle]);
+    }
+
     if (movieRecordBANK[moviehandle].texturePlanarHDRDecodeShader)
         PsychSetShader(movieRecordBANK[moviehandle].parentRecord, 0);
 
@@ -2704,6 +3574,9 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     double          preT, postT;
     unsigned char*  releaseMemPtr = NULL;
     unsigned int    strideBytes = 0;
+    psych_bool      usedUploadRing = FALSE;
+    int             cacheStatus, cachedFrame;
+    PsychMovieCachedFrame *cachedFrameRec = NULL;
 #if PSYCH_SYSTEM == PSYCH_WINDOWS
     #pragma warning( disable : 4068 )
 #endif
@@ -2730,6 +3603,20 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle.");
     }
 
+    // All frames of the movie in the frame cache? Then serve frames from the cache, without any involvement of GStreamer:
+    if (movieRecordBANK[moviehandle].frameCacheState == 2) {
+        cacheStatus = PsychMovieCachePoll(&movieRecordBANK[moviehandle], checkForImage, timeindex, &cachedFrame);
+        if (checkForImage || (cacheStatus != TRUE))
+            return((checkForImage) ? cacheStatus : FALSE);
+
+        rate = movieRecordBANK[moviehandle].rate;
+        cachedFrameRec = &movieRecordBANK[moviehandle].frameCache[cachedFrame];
+        movieRecordBANK[moviehandle].pts = cachedFrameRec->pts;
+        if (out_texture) out_texture->textureMemory = (GLuint*) cachedFrameRec->data;
+
+        goto frameReady;
+    }
+
     // Deferred start of movie playback requested? This so if movie is supposed to be
     // actively playing (rate != 0) and the startPending flag marks a pending deferred start:
     if ((movieRecordBANK[moviehandle].rate != 0) && movieRecordBANK[moviehandle].startPending) {
@@ -2801,6 +3688,10 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
             // movie that has reached its end.
             movieRecordBANK[moviehandle].endOfFetch = 0;
             PsychUnlockMutex(&movieRecordBANK[moviehandle].mutex);
+
+            // End of a complete forward playback pass? Then the frame cache contains all frames now:
+            if ((movieRecordBANK[moviehandle].frameCacheState == 1) && (rate > 0) && (movieRecordBANK[moviehandle].frameCacheCount > 0))
+                PsychMovieCompleteFrameCache(&movieRecordBANK[moviehandle], movieRecordBANK[moviehandle].frameCacheDuration);
             return(-1);
         }
         else {
@@ -2957,6 +3848,8 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     }
     if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: ...done.\n");
 
+frameReady:
+
     PsychGetAdjustedPrecisionTimerSeconds(&tNow);
     if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: Start of frame query to decode completion: %f msecs.\n", (tNow - tStart) * 1000.0);
     tStart = tNow;
@@ -2975,8 +3868,11 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         glPixelStorei(GL_UNPACK_CLIENT_STORAGE_APPLE, GL_FALSE);
         #endif
 
+        // Copy the frame into our texture upload ring, if possible, so the texture upload can happen asynchronously:
+        usedUploadRing = PsychMovieStageFrameInUploadRing(&movieRecordBANK[moviehandle], win, out_texture, (cachedFrameRec) ? cachedFrameRec->size : mapinfo.size);
+
         // Movie frames width or height still undefined, because could not determine size in open movie?
-        if (!movieRecordBANK[moviehandle].width || !movieRecordBANK[moviehandle].height) {
+        if (videoSample && (!movieRecordBANK[moviehandle].width || !movieRecordBANK[moviehandle].height)) {
             // Yes. Parse and assign it from this individual frame:
             int width, height;
 
@@ -2994,7 +3890,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         }
 
         // Get video metadata for this frame and parse it, if any:
-        videoMetaData = (GstVideoMeta *) gst_buffer_get_meta(videoBuffer, GST_VIDEO_META_API_TYPE);
+        videoMetaData = (videoBuffer) ? (GstVideoMeta *) gst_buffer_get_meta(videoBuffer, GST_VIDEO_META_API_TYPE) : NULL;
         if (videoMetaData) {
             if (PsychPrefStateGet_Verbosity() > 6)
                 printf("PTB-DEBUG: Frame reported n_planes %i stride %i\n", videoMetaData->n_planes, videoMetaData->stride[0]);
@@ -3002,6 +3898,11 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
 
         // Assign pixel row stride of 1st plane if valid, zero for "invalid" otherwise:
         strideBytes = (videoMetaData && videoMetaData->stride[0]) ? videoMetaData->stride[0] : 0;
+        if (cachedFrameRec) strideBytes = cachedFrameRec->strideBytes;
+
+        // Keep a copy of the decoded frame while the frame cache is being filled during forward playback:
+        if (videoBuffer && (movieRecordBANK[moviehandle].frameCacheState == 1) && (rate > 0))
+            PsychMovieCacheAddFrame(&movieRecordBANK[moviehandle], mapinfo.data, mapinfo.size, strideBytes, movieRecordBANK[moviehandle].pts, deltaT);
 
         // Build a standard PTB texture record:
         PsychMakeRect(out_texture->rect, 0, 0, movieRecordBANK[moviehandle].width, movieRecordBANK[moviehandle].height);
@@ -3028,8 +3929,10 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
 
                 // Return failure if Debayering did not work:
                 if (out_texture->textureMemory == NULL) {
-                    gst_buffer_unmap(videoBuffer, &mapinfo);
-                    gst_sample_unref(videoSample);
+                    if (videoSample) {
+                        gst_buffer_unmap(videoBuffer, &mapinfo);
+                        gst_sample_unref(videoSample);
+                    }
                     videoBuffer = NULL;
                     return(FALSE);
                 }
@@ -3154,7 +4057,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
             out_texture->textureByteAligned = 1;
 
             // Create planar "I420 inside L8" texture:
-            PsychCreateTexture(out_texture);
+            PsychMovieCreateTexture(&movieRecordBANK[moviehandle], out_texture, usedUploadRing);
 
             // Restore rect and clientrect of texture to effective size of video frame:
             PsychMakeRect(out_texture->rect, 0, 0, movieRecordBANK[moviehandle].width, movieRecordBANK[moviehandle].height);
@@ -3286,7 +4189,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
                 PsychErrorExitMsg(PsychError_user, "Videoframe size too big for this graphics card with pixelFormat 11! Can not handle content of this resolution on this graphics card!");
 
             // Create "planar content inside single-plane luminance" texture:
-            PsychCreateTexture(out_texture);
+            PsychMovieCreateTexture(&movieRecordBANK[moviehandle], out_texture, usedUploadRing);
 
             // Restore rect and clientrect of texture to effective size of video frame:
             PsychMakeRect(out_texture->rect, 0, 0, movieRecordBANK[moviehandle].width, movieRecordBANK[moviehandle].height);
@@ -3393,7 +4296,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
 
             // Let PsychCreateTexture() do the rest of the job of creating, setting up and
             // filling an OpenGL texture with content:
-            PsychCreateTexture(out_texture);
+            PsychMovieCreateTexture(&movieRecordBANK[moviehandle], out_texture, usedUploadRing);
 
             // Undo scaling:
             glPixelTransferi(GL_RED_SCALE, 1);
@@ -3403,7 +4306,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         else {
             // Let PsychCreateTexture() do the rest of the job of creating, setting up and
             // filling an OpenGL texture with content:
-            PsychCreateTexture(out_texture);
+            PsychMovieCreateTexture(&movieRecordBANK[moviehandle], out_texture, usedUploadRing);
         }
 
         // Release buffer for target RGB debayered image, if any:
@@ -3467,13 +4370,19 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         movieRecordBANK[moviehandle].last_pts = *presentation_timestamp;
     }
 
+    // Member of a playback group? Track lag of this frame behind the groups shared clock:
+    if (rate && (movieRecordBANK[moviehandle].groupStartTime > 0))
+        PsychMovieGroupTrackLag(&movieRecordBANK[moviehandle]);
+
     // Unlock.
-    gst_buffer_unmap(videoBuffer, &mapinfo);
-    gst_sample_unref(videoSample);
+    if (videoSample) {
+        gst_buffer_unmap(videoBuffer, &mapinfo);
+        gst_sample_unref(videoSample);
+    }
     videoBuffer = NULL;
 
-    // Manually advance movie time, if in fetch mode:
-    if (0 == rate) {
+    // Manually advance movie time, if in fetch mode and not playing from the frame cache:
+    if ((0 == rate) && !cachedFrameRec) {
         // We are in manual fetch mode: Need to manually advance movie to next
         // media sample:
         movieRecordBANK[moviehandle].endOfFetch = 0;
@@ -3494,6 +4403,11 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
 
         // Signal end-of-fetch if time no longer progresses signficiantly:
         if (postT - preT < 0.001) movieRecordBANK[moviehandle].endOfFetch = 1;
+
+        // Keep track of the current frame for the frame index:
+        if ((movieRecordBANK[moviehandle].frameIndexCurrent >= 0) && !movieRecordBANK[moviehandle].endOfFetch &&
+            (movieRecordBANK[moviehandle].frameIndexCurrent < movieRecordBANK[moviehandle].frameIndexCount - 1))
+            movieRecordBANK[moviehandle].frameIndexCurrent++;
     }
 
     PsychGetAdjustedPrecisionTimerSeconds(&tNow);
@@ -3563,6 +4477,34 @@ int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double s
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
     }
 
+    // Playback from frame cache? Then only the playback clock of the cache is controlled, the pipeline stays paused:
+    if (movieRecordBANK[moviehandle].frameCacheState == 2) {
+        PsychMovieRecordType *movie = &movieRecordBANK[moviehandle];
+
+        // Continue from the current position, clamped to the movie duration for stopped non-looped playback:
+        timeindex = PsychMovieCacheTime(movie);
+        if (timeindex > movie->frameCacheDuration) timeindex = movie->frameCacheDuration;
+        if (timeindex < 0) timeindex = 0;
+        movie->frameCacheStartPos = timeindex;
+        PsychGetAdjustedPrecisionTimerSeconds(&movie->frameCacheStartTime);
+
+        if ((playbackrate != 0) && (movie->rate == 0)) {
+            movie->last_pts = -1.0;
+            movie->nr_droppedframes = 0;
+            movie->frameCacheLastFrame = -1;
+        }
+
+        movie->rate = playbackrate;
+        movie->loopflag = ((playbackrate != 0) && (loop > 0)) ? loop : 0;
+        movie->frameCachePending = FALSE;
+        movie->endOfFetch = 0;
+
+        if ((playbackrate == 0) && ((dropped = movie->nr_droppedframes) > 0) && (PsychPrefStateGet_Verbosity() > 2))
+            printf("PTB-INFO: Movie playback had to drop %i frames of movie %i to keep playback in sync.\n", dropped, moviehandle);
+
+        return(dropped);
+    }
+
     // Try to set movie playback rate to value identical to current value?
     if (playbackrate == movieRecordBANK[moviehandle].rate) {
         // Yes: This would be a no-op, except we allow to change the sound output volume
@@ -3576,6 +4518,9 @@ int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double s
         return(0);
     }
 
+    // Start or stop of playback changes the current frame in untracked ways:
+    movieRecordBANK[moviehandle].frameIndexCurrent = -1;
+
     if (playbackrate != 0) {
         // Start playback of movie:
 
@@ -3711,6 +4656,111 @@ int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double s
     return(dropped);
 }
 
+/*
+ *  PsychGSPlaybackGroup() -- Start or stop synchronized playback of a group of movies.
+ *
+ *  All movies of the group use the same GstClock and base time, so they play in lockstep without drift, and start
+ *  together at time 'when' in GetSecs time, or as soon as possible if 'when' is in the past. The per movie count of
+ *  dropped frames, and the mean and maximum lag in seconds of fetched frames behind the shared clock, are returned
+ *  in 'droppedframes', 'meanLag' and 'maxLag'. Stopping the group returns the final values for the last playback.
+ */
+void PsychGSPlaybackGroup(int numMovies, int* moviehandles, double playbackrate, int loop, double soundvolume, double when,
+                          double* droppedframes, double* meanLag, double* maxLag)
+{
+    PsychMovieRecordType    *movie;
+    GstClock                *clock;
+    GstClockTime            baseTime;
+    double                  tNow;
+    int                     i;
+
+    for (i = 0; i < numMovies; i++) {
+        if ((moviehandles[i] < 0) || (moviehandles[i] >= PSYCH_MAX_MOVIES) || (movieRecordBANK[moviehandles[i]].theMovie == NULL)) {
+            PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
+        }
+    }
+
+    // Report statistics collected so far:
+    for (i = 0; i < numMovies; i++) {
+        movie = &movieRecordBANK[moviehandles[i]];
+        droppedframes[i] = (double) movie->nr_droppedframes;
+        meanLag[i] = (movie->groupLagCount > 0) ? movie->groupLagSum / movie->groupLagCount : 0;
+        maxLag[i] = movie->groupLagMax;
+    }
+
+    if (playbackrate == 0) {
+        // Stop playback of all members, and detach them from the shared clock, so future playback uses
+        // automatic clock selection and base time again:
+        for (i = 0; i < numMovies; i++) {
+            movie = &movieRecordBANK[moviehandles[i]];
+            droppedframes[i] = (double) PsychGSPlaybackRate(moviehandles[i], 0, 0, soundvolume);
+
+            if ((movie->groupStartTime > 0) && (movie->frameCacheState != 2)) {
+                gst_pipeline_auto_clock(GST_PIPELINE(movie->theMovie));
+                gst_element_set_start_time(movie->theMovie, 0);
+            }
+
+            movie->groupStartTime = 0;
+        }
+
+        return;
+    }
+
+    // Setup playback of all members, but don't start it yet:
+    for (i = 0; i < numMovies; i++) {
+        movie = &movieRecordBANK[moviehandles[i]];
+        PsychGSPlaybackRate(moviehandles[i], playbackrate, loop, soundvolume);
+
+        if (movie->frameCacheState != 2) {
+            movie->startPending = 0;
+            PsychMoviePipelineSetState(movie->theMovie, GST_STATE_PAUSED, 10.0);
+        }
+    }
+
+    // Base time is the clock time at which playback starts. Leave a safety margin for the state changes
+    // of all pipelines, if the requested start time is already too close or in the past:
+    clock = gst_system_clock_obtain();
+    PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+    if (when < tNow + 0.05) when = tNow + 0.05;
+    baseTime = gst_clock_get_time(clock) + (GstClockTime) ((when - tNow) * 1e9);
+
+    for (i = 0; i < numMovies; i++) {
+        movie = &movieRecordBANK[moviehandles[i]];
+        movie->groupStartTime = when;
+        movie->groupStartPos = PsychGSGetMovieTimeIndex(moviehandles[i]);
+        movie->groupLagSum = 0;
+        movie->groupLagMax = 0;
+        movie->groupLagCount = 0;
+
+        if (movie->frameCacheState == 2) {
+            // Playback from frame cache only needs its clock to start at the same time:
+            movie->frameCacheStartTime = when;
+        }
+        else {
+            gst_pipeline_use_clock(GST_PIPELINE(movie->theMovie), clock);
+            gst_element_set_start_time(movie->theMovie, GST_CLOCK_TIME_NONE);
+            gst_element_set_base_time(movie->theMovie, baseTime);
+        }
+    }
+
+    gst_object_unref(clock);
+
+    // Go: The state changes are asynchronous, playback starts when the clock reaches the shared base time:
+    for (i = 0; i < numMovies; i++) {
+        movie = &movieRecordBANK[moviehandles[i]];
+        if (movie->frameCacheState != 2)
+            gst_element_set_state(movie->theMovie, GST_STATE_PLAYING);
+    }
+
+    for (i = 0; i < numMovies; i++) {
+        movie = &movieRecordBANK[moviehandles[i]];
+        if (movie->frameCacheState != 2)
+            PsychGSProcessMovieContext(movie, FALSE);
+    }
+
+    if (PsychPrefStateGet_Verbosity() > 3)
+        printf("PTB-INFO: Starting synchronized playback of %i movies in %f seconds.\n", numMovies, when - tNow);
+}
+
 /*
  *  void PsychGSExitMovies() - Shutdown handler.
  *
@@ -3745,6 +4795,10 @@ double PsychGSGetMovieTimeIndex(int moviehandle)
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
     }
 
+    // Playback from frame cache?
+    if (movieRecordBANK[moviehandle].frameCacheState == 2)
+        return(PsychMovieCacheTime(&movieRecordBANK[moviehandle]));
+
     if (!gst_element_query_position(theMovie, GST_FORMAT_TIME, &pos_nsecs)) {
         if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Could not query position in movie %i in seconds. Returning zero.\n", moviehandle);
         pos_nsecs = 0;
@@ -3760,9 +4814,12 @@ double PsychGSGetMovieTimeIndex(int moviehandle)
 double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames)
 {
     GstElement      *theMovie;
+    PsychMovieRecordType *movie;
     double          oldtime;
     gint64          targetIndex;
     GstSeekFlags    flags;
+    int             targetFrame, i;
+    psych_bool      doStep;
 
     if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIES) {
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided!");
@@ -3777,6 +4834,25 @@ double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool in
     // Retrieve current timeindex:
     oldtime = PsychGSGetMovieTimeIndex(moviehandle);
 
+    // Playback from frame cache? Then just reposition the playback clock of the cache:
+    movie = &movieRecordBANK[moviehandle];
+    if (movie->frameCacheState == 2) {
+        if (indexIsFrames) {
+            targetFrame = (int) (timeindex + 0.5);
+            if (targetFrame < 0) targetFrame = 0;
+            if (targetFrame >= movie->frameCacheCount) targetFrame = movie->frameCacheCount - 1;
+            timeindex = movie->frameCache[targetFrame].pts;
+        }
+
+        movie->frameCacheStartPos = timeindex;
+        PsychGetAdjustedPrecisionTimerSeconds(&movie->frameCacheStartTime);
+        movie->frameCacheLastFrame = -1;
+        movie->frameCachePending = TRUE;
+        movie->endOfFetch = 0;
+
+        return(oldtime);
+    }
+
     // NOTE: We could use GST_SEEK_FLAG_SKIP to allow framedropping on fast forward/reverse playback...
     flags = GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE;
 
@@ -3785,8 +4861,45 @@ double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool in
         flags |= GST_SEEK_FLAG_SEGMENT;
     }
 
-    // Index based or target time based seeking?
-    if (indexIsFrames) {
+    // Frame index available? Then map target to its exact frame and presentation timestamp:
+    if (movie->frameIndex) {
+        targetFrame = (indexIsFrames) ? (int) (timeindex + 0.5) : PsychMovieFrameForTime(movie, timeindex);
+        if (targetFrame < 0) targetFrame = 0;
+        if (targetFrame >= movie->frameIndexCount) targetFrame = movie->frameIndexCount - 1;
+
+        // If playback is stopped and the target frame is ahead of the current frame, without a keyframe in between, then
+        // stepping forward from the current frame needs less decoding than a seek, which would restart decoding at the
+        // last keyframe before the target frame:
+        doStep = FALSE;
+        if ((movie->rate == 0) && (movie->frameIndexCurrent >= 0) && (targetFrame > movie->frameIndexCurrent)) {
+            for (i = targetFrame; (i > movie->frameIndexCurrent) && !movie->frameIndex[i].keyframe; i--);
+            doStep = (i == movie->frameIndexCurrent);
+        }
+
+        if (doStep) {
+            // Send the step event *only* to the videosink, for the same reasons as for single-stepping in
+            // PsychGSGetTextureFromMovie(), then block until step completed, failed, or timeout of 10 seconds reached:
+            doStep = gst_element_send_event(movie->videosink, gst_event_new_step(GST_FORMAT_BUFFERS, (guint64) (targetFrame - movie->frameIndexCurrent), 1.0, TRUE, FALSE));
+            if (doStep && (GST_STATE_CHANGE_SUCCESS != gst_element_get_state(theMovie, NULL, NULL, (GstClockTime) (10 * 1e9)))) {
+                if (PsychPrefStateGet_Verbosity() > 1)
+                    printf("PTB-WARNING: Stepping to frame index %i in movie %i failed. Seeking to it instead.\n", targetFrame, moviehandle);
+                doStep = FALSE;
+            }
+        }
+
+        // Accurate seek to exact presentation timestamp of target frame otherwise:
+        if (!doStep && !gst_element_seek_simple(theMovie, GST_FORMAT_TIME, flags, movie->frameIndex[targetFrame].pts) && (PsychPrefStateGet_Verbosity() > 1)) {
+            printf("PTB-WARNING: Seek to frame index %i in movie %i failed. Something is wrong with this movie or the target frame.\n", targetFrame, moviehandle);
+        }
+
+        if (PsychPrefStateGet_Verbosity() > 5)
+            printf("PTB-DEBUG: %s to frame %i at pts %f secs in movie %i via frame index.\n", (doStep) ? "Stepped" : "Seeked", targetFrame,
+                   (double) movie->frameIndex[targetFrame].pts / (double) 1e9, moviehandle);
+
+        // Only track the current frame for stopped playback:
+        movie->frameIndexCurrent = (movie->rate == 0) ? targetFrame : -1;
+    }
+    else if (indexIsFrames) {
         // Index based seeking:
         targetIndex = (gint64) (timeindex + 0.5);
 
@@ -3837,6 +4950,34 @@ double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool in
     return(oldtime);
 }
 
+/*
+ *  PsychGSGetMovieFrameTimeIndex() -- Return presentation time in seconds of video frame 'frameIndex'.
+ *
+ *  Exact if the movie has a frame index, otherwise estimated from the framerate of the movie.
+ */
+double PsychGSGetMovieFrameTimeIndex(int moviehandle, int frameIndex)
+{
+    PsychMovieRecordType *movie;
+
+    if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIES) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided!");
+    }
+
+    movie = &movieRecordBANK[moviehandle];
+    if (movie->theMovie == NULL) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
+    }
+
+    if (frameIndex < 0) frameIndex = 0;
+
+    if (movie->frameIndex) {
+        if (frameIndex >= movie->frameIndexCount) frameIndex = movie->frameIndexCount - 1;
+        return((double) movie->frameIndex[frameIndex].pts / (double) 1e9);
+    }
+
+    return((movie->fps > 0) ? (double) frameIndex / movie->fps : 0.0);
+}
+
 /*
  *  PsychCopyOutMovieHDRMetaData() -- Return a struct with HDR static metadata about this movie to scripting environment.
  */
@@ -3900,6 +5041,41 @@ void PsychGSCopyOutMovieHDRMetaData(int moviehandle, int argPosition)
     }
 }
 
+/*
+ *  PsychGSCopyOutMovieStats() -- Return a struct with playback statistics of this movie to scripting environment.
+ */
+void PsychGSCopyOutMovieStats(int moviehandle, int argPosition)
+{
+    PsychGenericScriptType *s;
+    PsychMovieRecordType *movie;
+    const char *fieldNames[] = { "DroppedFrames", "UploadRingFrames", "UploadRingStalls", "UploadCopyTimeAvg", "UploadCopyTimeMax" };
+    const int fieldCount = 5;
+
+    if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIES) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided!");
+    }
+
+    movie = &movieRecordBANK[moviehandle];
+    if (movie->theMovie == NULL) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
+    }
+
+    // Userscript wants this info?
+    if (PsychIsArgPresent(PsychArgOut, argPosition)) {
+        PsychAllocOutStructArray(argPosition, kPsychArgOptional, -1, fieldCount, fieldNames, &s);
+
+        // Frames dropped during current or last playback to stay in sync with the clock:
+        PsychSetStructArrayDoubleElement("DroppedFrames", 0, (double) movie->nr_droppedframes, s);
+
+        // Frames uploaded via the texture upload ring, stalls waiting for a free ring buffer, and
+        // average and maximum time for copying a frame into the ring, in seconds:
+        PsychSetStructArrayDoubleElement("UploadRingFrames", 0, (double) movie->uploadRingFrames, s);
+        PsychSetStructArrayDoubleElement("UploadRingStalls", 0, (double) movie->uploadRingStalls, s);
+        PsychSetStructArrayDoubleElement("UploadCopyTimeAvg", 0, (movie->uploadRingFrames > 0) ? movie->uploadCopyTimeTotal / movie->uploadRingFrames : 0, s);
+        PsychSetStructArrayDoubleElement("UploadCopyTimeMax", 0, movie->uploadCopyTimeMax, s);
+    }
+}
+
 // #if GST_CHECK_VERSION(1,0,0)
 #endif
 // #ifdef PTB_USE_GSTREAMER
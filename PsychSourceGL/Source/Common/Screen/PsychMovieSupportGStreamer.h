@@ -33,10 +33,14 @@ void PsychGSDeleteAllMovies(void);
 void PsychGSFreeMovieTexture(PsychWindowRecordType *win);
 int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int checkForImage, double timeindex, PsychWindowRecordType *out_texture, double *presentation_timestamp);
 int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double soundvolume);
+void PsychGSPlaybackGroup(int numMovies, int* moviehandles, double playbackrate, int loop, double soundvolume, double when,
+                          double* droppedframes, double* meanLag, double* maxLag);
 void PsychGSExitMovies(void);
 double PsychGSGetMovieTimeIndex(int moviehandle);
 double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames);
+double PsychGSGetMovieFrameTimeIndex(int moviehandle, int frameIndex);
 void PsychGSCopyOutMovieHDRMetaData(int moviehandle, int argPosition);
+void PsychGSCopyOutMovieStats(int moviehandle, int argPosition);
 //end include once
 #endif
 
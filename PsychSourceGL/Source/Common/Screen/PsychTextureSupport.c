@@ -127,6 +127,721 @@ void PsychInitWindowRecordTextureFields(PsychWindowRecordType *win)
     // setting will be used for the GL_UNPACK_ALIGNMENT setting in PsychCreateTexture() and friends
     // to optimize texture upload:
     win->textureByteAligned=0;
+
+    // No asynchronous texture upload pending by default:
+    win->textureUploadFence=NULL;
+
+    // Not managed by the texture residency manager by default:
+    win->textureLastUsed=0;
+    win->textureResidentBytes=0;
+    win->textureEvictedData=NULL;
+}
+
+// Return the size in bytes of one texel of the textures input data in win->textureMemory, or zero if unknown:
+static size_t PsychGetTextureUploadTexelSize(PsychWindowRecordType *win)
+{
+    size_t components, typesize;
+
+    // Standard path: Texel size derives from requested pixeldepth:
+    if (win->textureinternalformat == 0) return((size_t) win->depth / 8);
+
+    // Explicit external format and type. Map to texel size:
+    switch (win->textureexternalformat) {
+        case GL_LUMINANCE:
+        case GL_RED:
+        case GL_ALPHA:
+            components = 1;
+            break;
+
+        case GL_LUMINANCE_ALPHA:
+        case GL_RG:
+            components = 2;
+            break;
+
+        case GL_RGB:
+        case GL_BGR:
+            components = 3;
+            break;
+
+        case GL_RGBA:
+        case GL_BGRA:
+            components = 4;
+            break;
+
+        default:
+            return(0);
+    }
+
+    switch (win->textureexternaltype) {
+        case GL_UNSIGNED_BYTE:
+        case GL_BYTE:
+            typesize = 1;
+            break;
+
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT_ARB:
+            typesize = 2;
+            break;
+
+        case GL_UNSIGNED_INT:
+        case GL_INT:
+        case GL_FLOAT:
+            typesize = 4;
+            break;
+
+        case GL_UNSIGNED_INT_8_8_8_8_REV:
+        case GL_UNSIGNED_INT_8_8_8_8:
+            // Packed formats: One 32 bit word per texel:
+            return((components == 4) ? 4 : 0);
+
+        default:
+            return(0);
+    }
+
+    return(components * typesize);
+}
+
+/*
+ *    PsychCheckAsyncTextureUpload()
+ *
+ *    Check if the asynchronous upload of texture content into texture 'win', as started
+ *    by PsychCreateTexture() for textures with the kPsychAsyncTextureUpload flag, has
+ *    finished. Returns TRUE if the upload is complete, or if there never was an async
+ *    upload pending, FALSE if the upload is still in progress.
+ *
+ *    If 'waitForCompletion' is TRUE, wait for the upload to complete, so the function
+ *    always returns TRUE.
+ *
+ *    The draw path doesn't need to call this: All drawing of the texture happens in the
+ *    OpenGL context in which the upload was submitted, so the GPU automatically orders the
+ *    draw after the upload, without any blocking on the cpu side. Only if a texture gets
+ *    used by external code, e.g., via Screen('GetOpenGLTexture'), do we need to wait.
+ */
+psych_bool PsychCheckAsyncTextureUpload(PsychWindowRecordType *win, psych_bool waitForCompletion)
+{
+    GLenum result;
+
+    // Nothing pending? Then we are done:
+    if (win->textureUploadFence == NULL) return(TRUE);
+
+    PsychSetGLContext(win);
+
+    // Poll or wait for the fence to signal. The flush bit makes sure the fence actually gets submitted to the gpu:
+    result = glClientWaitSync(win->textureUploadFence, GL_SYNC_FLUSH_COMMANDS_BIT, (waitForCompletion) ? GL_TIMEOUT_IGNORED : 0);
+
+    // Treat a waiting failure as completion, as there isn't anything sensible we could do about it:
+    if (result == GL_WAIT_FAILED) {
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Waiting for completion of asynchronous texture upload for texture %i failed!\n", win->windowIndex);
+        result = GL_ALREADY_SIGNALED;
+    }
+
+    if (result == GL_TIMEOUT_EXPIRED) return(FALSE);
+
+    // Upload complete: Release fence:
+    glDeleteSync(win->textureUploadFence);
+    win->textureUploadFence = NULL;
+
+    return(TRUE);
+}
+
+/*
+ *    Texture residency manager:
+ *
+ *    Textures created via Screen('MakeTexture') get registered with the manager. The manager
+ *    tracks when each texture was last used for drawing and how much VRAM it consumes. If a
+ *    non-zero budget is set via Screen('Preference', 'TextureMemoryBudget', bytes), and the sum
+ *    of VRAM consumed by all resident managed textures exceeds the budget, the least recently
+ *    used textures get evicted: Their content gets read back into system RAM and stored there
+ *    in compressed form, then the OpenGL texture gets deleted. On the next draw of an evicted
+ *    texture, its content gets decompressed and uploaded again.
+ *
+ *    Textures whose OpenGL texture handle gets exposed to external code, or which get used as
+ *    rendertarget or image processing source, get "pinned", ie., removed from management and
+ *    therefore never get evicted. We rely on all our OpenGL contexts sharing their texture
+ *    objects, so eviction and re-upload can happen in whatever context is current.
+ */
+
+// Budget for resident managed textures in bytes. Zero means unlimited, ie. no eviction:
+static size_t texresidencybudget = 0;
+
+// Global use counter for least recently used tracking, and the statistics:
+static psych_uint64 texusecounter = 0;
+static PsychTextureResidencyStatsType texresidencystats;
+
+// Header of the system memory copy of an evicted texture, followed by the texel data:
+typedef struct PsychEvictedTextureHeaderType {
+    GLint       width;
+    GLint       height;
+    GLint       internalFormat;
+    GLenum      format;
+    GLenum      type;
+    size_t      texelSize;
+    size_t      rawBytes;
+    size_t      packedBytes;    // Zero if stored uncompressed, because compression didn't save any space.
+} PsychEvictedTextureHeaderType;
+
+static void PsychTextureResidencyEnforceBudget(PsychWindowRecordType *keep);
+
+// Return external format, type and texel size to use for readback and re-upload of texture 'win', or FALSE if unsupported:
+static psych_bool PsychGetTextureResidencyFormat(PsychWindowRecordType *win, GLenum *format, GLenum *type, size_t *texelsize)
+{
+    if (win->textureinternalformat != 0) {
+        *format = win->textureexternalformat;
+        *type = win->textureexternaltype;
+        *texelsize = PsychGetTextureUploadTexelSize(win);
+        return((*texelsize > 0) ? TRUE : FALSE);
+    }
+
+    *type = GL_UNSIGNED_BYTE;
+    *texelsize = (size_t) win->depth / 8;
+    switch (win->depth) {
+        case 8:
+            *format = GL_LUMINANCE;
+            break;
+
+        case 16:
+            *format = GL_LUMINANCE_ALPHA;
+            break;
+
+        case 24:
+            *format = GL_RGB;
+            break;
+
+        case 32:
+            *format = GL_RGBA;
+            break;
+
+        default:
+            return(FALSE);
+    }
+
+    return(TRUE);
+}
+
+// Compress 'n' bytes from 'src' into 'dst' with a PackBits style run-length encoding. Returns
+// compressed size, or zero if the compressed data would not fit into 'dstmax' bytes:
+static size_t PsychTextureResidencyPack(const unsigned char *src, size_t n, unsigned char *dst, size_t dstmax)
+{
+    size_t i = 0, j, start, len, out = 0;
+
+    while (i < n) {
+        // Length of run of identical bytes at i, up to 128:
+        for (j = i + 1; (j < n) && (src[j] == src[i]) && (j - i < 128); j++);
+
+        if (j - i >= 3) {
+            // Run: Encode as negative count and the repeated byte:
+            if (out + 2 > dstmax) return(0);
+            dst[out++] = (unsigned char) (257 - (j - i));
+            dst[out++] = src[i];
+            i = j;
+            continue;
+        }
+
+        // Literals: Collect up to 128 bytes, until the start of the next run of at least 3 bytes:
+        start = i;
+        while ((i < n) && (i - start < 128)) {
+            if ((i + 2 < n) && (src[i] == src[i + 1]) && (src[i] == src[i + 2])) break;
+            i++;
+        }
+
+        len = i - start;
+        if (out + 1 + len > dstmax) return(0);
+        dst[out++] = (unsigned char) (len - 1);
+        memcpy(&dst[out], &src[start], len);
+        out += len;
+    }
+
+    return(out);
+}
+
+// Decompress PackBits style data of 'n' bytes from 'src' into 'dst':
+static void PsychTextureResidencyUnpack(const unsigned char *src, size_t n, unsigned char *dst)
+{
+    size_t i = 0, len;
+
+    while (i < n) {
+        if (src[i] < 128) {
+            len = (size_t) src[i] + 1;
+            memcpy(dst, &src[i + 1], len);
+            i += len + 1;
+        }
+        else {
+            len = 257 - (size_t) src[i];
+            memset(dst, src[i + 1], len);
+            i += 2;
+        }
+
+        dst += len;
+    }
+}
+
+/*
+ *    PsychTextureResidencyRegister()
+ *
+ *    Register a freshly created texture 'win' with the residency manager, if it is suitable
+ *    for management: Only uncompressed textures with data in a known external format, on desktop
+ *    OpenGL with readback support, and not in power-of-two emulation. Called by Screen('MakeTexture')
+ *    after texture creation.
+ */
+void PsychTextureResidencyRegister(PsychWindowRecordType *win)
+{
+    GLenum format, type;
+    size_t texelsize;
+
+    if ((win->specialflags & (kPsychPlanarTexture | kPsychTextureResidencyManaged | kPsychCompressedTexture)) || (win->textureNumber == 0) ||
+        PsychIsGLES(win) || ((PsychGetTextureTarget(win) == GL_TEXTURE_2D) && !(win->gfxcaps & kPsychGfxCapNPOTTex)) ||
+        (win->drawBufferFBO[0] != -1) || !PsychGetTextureResidencyFormat(win, &format, &type, &texelsize))
+        return;
+
+    win->specialflags |= kPsychTextureResidencyManaged;
+    win->textureResidentBytes = texelsize * (size_t) PsychGetWidthFromRect(win->rect) * (size_t) PsychGetHeightFromRect(win->rect);
+    win->textureLastUsed = ++texusecounter;
+    win->textureEvictedData = NULL;
+
+    // Account for the initial upload:
+    texresidencystats.residentBytes += win->textureResidentBytes;
+    texresidencystats.numResident++;
+    texresidencystats.bytesUploadedTotal += win->textureResidentBytes;
+    texresidencystats.bytesUploadedThisFrame += win->textureResidentBytes;
+
+    // Make room if we are over budget now:
+    PsychTextureResidencyEnforceBudget(win);
+}
+
+// Unregister texture 'win' from the residency manager, releasing its cached copy if it is evicted:
+static void PsychTextureResidencyUnregister(PsychWindowRecordType *win)
+{
+    PsychEvictedTextureHeaderType *header = (PsychEvictedTextureHeaderType*) win->textureEvictedData;
+
+    if (!(win->specialflags & kPsychTextureResidencyManaged)) return;
+
+    if (header) {
+        texresidencystats.evictedBytes -= sizeof(PsychEvictedTextureHeaderType) + ((header->packedBytes > 0) ? header->packedBytes : header->rawBytes);
+        texresidencystats.numEvicted--;
+        free(header);
+        win->textureEvictedData = NULL;
+    }
+    else {
+        texresidencystats.residentBytes -= win->textureResidentBytes;
+        texresidencystats.numResident--;
+    }
+
+    win->textureResidentBytes = 0;
+    win->specialflags &= ~kPsychTextureResidencyManaged;
+}
+
+// Evict texture 'win' from VRAM into a compressed copy in system RAM:
+static void PsychTextureResidencyEvict(PsychWindowRecordType *win)
+{
+    PsychEvictedTextureHeaderType *header;
+    GLenum format, type, target;
+    GLint width, height, internalFormat;
+    size_t texelsize, rawbytes, t, i;
+    unsigned char *rawdata, *planes;
+
+    if (!PsychGetTextureResidencyFormat(win, &format, &type, &texelsize)) return;
+
+    target = PsychGetTextureTarget(win);
+    glBindTexture(target, win->textureNumber);
+    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_WIDTH, &width);
+    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_HEIGHT, &height);
+    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+
+    // Read back texture content:
+    rawbytes = texelsize * (size_t) width * (size_t) height;
+    rawdata = (unsigned char*) malloc(rawbytes);
+    header = (PsychEvictedTextureHeaderType*) malloc(sizeof(PsychEvictedTextureHeaderType) + rawbytes);
+    if ((rawdata == NULL) || (header == NULL)) {
+        // Out of system memory: Leave the texture resident.
+        free(rawdata);
+        free(header);
+        glBindTexture(target, 0);
+        return;
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glGetTexImage(target, 0, format, type, rawdata);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindTexture(target, 0);
+
+    header->width = width;
+    header->height = height;
+    header->internalFormat = internalFormat;
+    header->format = format;
+    header->type = type;
+    header->texelSize = texelsize;
+    header->rawBytes = rawbytes;
+
+    // Separate the bytes of each texel into planes, as runs of identical values within one channel are
+    // much more common than runs of identical bytes in interleaved texels, then compress the planes:
+    planes = (unsigned char*) malloc(rawbytes);
+    header->packedBytes = 0;
+    if (planes) {
+        for (t = 0; t < texelsize; t++)
+            for (i = 0; i < (size_t) width * (size_t) height; i++)
+                planes[t * (size_t) width * (size_t) height + i] = rawdata[i * texelsize + t];
+
+        header->packedBytes = PsychTextureResidencyPack(planes, rawbytes, (unsigned char*) (header + 1), rawbytes - 1);
+        free(planes);
+    }
+
+    // Store uncompressed if compression wasn't possible or didn't help:
+    if (header->packedBytes == 0) memcpy(header + 1, rawdata, rawbytes);
+    free(rawdata);
+
+    // Shrink cache buffer to its real size:
+    if (header->packedBytes > 0) {
+        planes = (unsigned char*) realloc(header, sizeof(PsychEvictedTextureHeaderType) + header->packedBytes);
+        if (planes) header = (PsychEvictedTextureHeaderType*) planes;
+    }
+
+    // Delete the OpenGL texture:
+    glDeleteTextures(1, &win->textureNumber);
+    win->textureNumber = 0;
+    texmemguesstimate -= win->surfaceSizeBytes;
+
+    win->textureEvictedData = header;
+    texresidencystats.residentBytes -= win->textureResidentBytes;
+    texresidencystats.numResident--;
+    texresidencystats.evictedBytes += sizeof(PsychEvictedTextureHeaderType) + ((header->packedBytes > 0) ? header->packedBytes : header->rawBytes);
+    texresidencystats.numEvicted++;
+    texresidencystats.evictions++;
+
+    if (PsychPrefStateGet_Verbosity() > 6)
+        printf("PTB-DEBUG: Texture residency manager: Evicted texture %i: %i bytes VRAM -> %i bytes RAM.\n", win->windowIndex,
+               (int) win->textureResidentBytes, (int) ((header->packedBytes > 0) ? header->packedBytes : header->rawBytes));
+}
+
+// Restore texture 'win' from its compressed copy in system RAM:
+static void PsychTextureResidencyRestore(PsychWindowRecordType *win)
+{
+    PsychEvictedTextureHeaderType *header = (PsychEvictedTextureHeaderType*) win->textureEvictedData;
+    GLenum target;
+    size_t t, i, numtexels;
+    unsigned char *rawdata, *planes;
+
+    numtexels = (size_t) header->width * (size_t) header->height;
+    rawdata = (unsigned char*) malloc(header->rawBytes);
+    if (rawdata == NULL) PsychErrorExitMsg(PsychError_outofMemory, "Out of system memory while trying to restore evicted texture.");
+
+    if (header->packedBytes > 0) {
+        planes = (unsigned char*) malloc(header->rawBytes);
+        if (planes == NULL) {
+            free(rawdata);
+            PsychErrorExitMsg(PsychError_outofMemory, "Out of system memory while trying to restore evicted texture.");
+        }
+
+        PsychTextureResidencyUnpack((unsigned char*) (header + 1), header->packedBytes, planes);
+        for (t = 0; t < header->texelSize; t++)
+            for (i = 0; i < numtexels; i++)
+                rawdata[i * header->texelSize + t] = planes[t * numtexels + i];
+
+        free(planes);
+    }
+    else {
+        memcpy(rawdata, header + 1, header->rawBytes);
+    }
+
+    // Recreate and fill the OpenGL texture:
+    target = PsychGetTextureTarget(win);
+    glGenTextures(1, &win->textureNumber);
+    glBindTexture(target, win->textureNumber);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(target, 0, header->internalFormat, header->width, header->height, 0, header->format, header->type, rawdata);
+    glBindTexture(target, 0);
+    free(rawdata);
+
+    texmemguesstimate += win->surfaceSizeBytes;
+    texresidencystats.evictedBytes -= sizeof(PsychEvictedTextureHeaderType) + ((header->packedBytes > 0) ? header->packedBytes : header->rawBytes);
+    texresidencystats.numEvicted--;
+    texresidencystats.residentBytes += win->textureResidentBytes;
+    texresidencystats.numResident++;
+    texresidencystats.bytesUploadedTotal += header->rawBytes;
+    texresidencystats.bytesUploadedThisFrame += header->rawBytes;
+
+    free(header);
+    win->textureEvictedData = NULL;
+}
+
+// Evict least recently used managed textures, except 'keep', until we are within budget:
+static void PsychTextureResidencyEnforceBudget(PsychWindowRecordType *keep)
+{
+    PsychWindowRecordType **windowRecordArray, *victim;
+    int i, numWindows;
+
+    if ((texresidencybudget == 0) || (texresidencystats.residentBytes <= texresidencybudget)) return;
+
+    PsychCreateVolatileWindowRecordPointerList(&numWindows, &windowRecordArray);
+    while (texresidencystats.residentBytes > texresidencybudget) {
+        victim = NULL;
+        for (i = 0; i < numWindows; i++) {
+            if ((windowRecordArray[i] != keep) && (windowRecordArray[i]->windowType == kPsychTexture) &&
+                (windowRecordArray[i]->specialflags & kPsychTextureResidencyManaged) && !windowRecordArray[i]->textureEvictedData &&
+                (!victim || (windowRecordArray[i]->textureLastUsed < victim->textureLastUsed)))
+                victim = windowRecordArray[i];
+        }
+
+        if (!victim) break;
+        PsychTextureResidencyEvict(victim);
+
+        // Eviction failed due to lack of system memory? Give up for now:
+        if (!victim->textureEvictedData) break;
+    }
+    PsychDestroyVolatileWindowRecordPointerList(windowRecordArray);
+}
+
+/*
+ *    PsychTextureResidencyTouch()
+ *
+ *    Mark texture 'win' as just used. Must be called before drawing from the texture.
+ *    Restores the texture into VRAM if it was evicted, then evicts least recently used
+ *    other textures if the manager is over budget. No-op for unmanaged textures.
+ */
+void PsychTextureResidencyTouch(PsychWindowRecordType *win)
+{
+    if (!(win->specialflags & kPsychTextureResidencyManaged)) return;
+
+    // Textures used in a Screen('CommandList') recording get referenced by their OpenGL
+    // handle from the recorded list, so they must stay resident from now on. A restore
+    // would get compiled into the list, so evicted textures are not allowed here:
+    if (PsychGetCommandListRecordingWindow()) {
+        if (win->textureEvictedData)
+            PsychErrorExitMsg(PsychError_user, "Tried to draw an evicted texture while Screen('CommandList') recording is active. Use Screen('PreloadTextures') before 'Begin'!");
+
+        PsychTextureResidencyPin(win);
+        return;
+    }
+
+    win->textureLastUsed = ++texusecounter;
+
+    if (win->textureEvictedData) {
+        texresidencystats.misses++;
+        PsychTextureResidencyRestore(win);
+    }
+    else {
+        texresidencystats.hits++;
+    }
+
+    PsychTextureResidencyEnforceBudget(win);
+}
+
+/*
+ *    PsychTextureResidencyPin()
+ *
+ *    Restore texture 'win' if it is evicted and remove it from management, so it will
+ *    stay resident and keep its OpenGL texture handle. Needed before exposing the texture
+ *    to external code, or using it as rendertarget or image processing source.
+ */
+void PsychTextureResidencyPin(PsychWindowRecordType *win)
+{
+    if (!(win->specialflags & kPsychTextureResidencyManaged)) return;
+
+    if (win->textureEvictedData) {
+        PsychSetGLContext(win);
+        PsychTextureResidencyRestore(win);
+    }
+
+    PsychTextureResidencyUnregister(win);
+}
+
+// Set a new budget in bytes for resident managed textures. Zero = Unlimited:
+void PsychTextureResidencySetBudget(size_t budget)
+{
+    texresidencybudget = budget;
+    texresidencystats.budget = budget;
+}
+
+// Called once per flip to update the per-frame upload statistics. The statistics are global, like
+// the budget, so with multiple onscreen windows the flip of any window starts a new frame. LRU age
+// is independent of flips: It counts texture draws in all windows via texusecounter.
+void PsychTextureResidencyNewFrame(void)
+{
+    texresidencystats.bytesUploadedLastFrame = texresidencystats.bytesUploadedThisFrame;
+    texresidencystats.bytesUploadedThisFrame = 0;
+}
+
+void PsychTextureResidencyGetStats(PsychTextureResidencyStatsType *stats)
+{
+    *stats = texresidencystats;
+}
+
+/*
+ *    Compressed texture support:
+ *
+ *    PsychCreateTexture() can store textures in S3TC/BC block compressed formats, which need
+ *    only 1/8th (BC1 for RGB) or 1/4th (BC3 for RGBA) of the memory and upload bandwidth of
+ *    uncompressed 8 bpc textures. Either external code provides precompressed image data in a
+ *    compressed 'textureinternalformat', e.g., BC1/BC3/BC7 from DDS or ETC2 from KTX files, or
+ *    the kPsychCompressedTexture flag requests compression of 8 bpc RGB/RGBA data by our own
+ *    fast block encoder below. The encoder picks color endpoints from the bounding box of each
+ *    4x4 block, which is fast and good enough for natural images, but not optimal quality.
+ */
+
+// Return size in bytes of one 4x4 texel block of a compressed internal format, or zero if 'internalformat' is not compressed:
+size_t PsychGetCompressedTextureBlockSize(GLint internalformat)
+{
+    switch (internalformat) {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_SRGB8_ETC2:
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            return(8);
+
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+            return(16);
+
+        default:
+            return(0);
+    }
+}
+
+// Convert 8 bpc color to RGB565 and back:
+static unsigned short PsychColorToRGB565(const unsigned char *c)
+{
+    return((unsigned short) (((c[0] >> 3) << 11) | ((c[1] >> 2) << 5) | (c[2] >> 3)));
+}
+
+static void PsychRGB565ToColor(unsigned short v, int *c)
+{
+    c[0] = ((v >> 11) & 0x1f) * 255 / 31;
+    c[1] = ((v >> 5) & 0x3f) * 255 / 63;
+    c[2] = (v & 0x1f) * 255 / 31;
+}
+
+// Encode the RGB channels of a 4x4 block of RGBA8 texels into a 8 byte BC1 color block:
+static void PsychEncodeBC1ColorBlock(unsigned char block[16][4], unsigned char *dst)
+{
+    unsigned char cmin[3] = { 255, 255, 255 }, cmax[3] = { 0, 0, 0 };
+    unsigned short c0, c1, t;
+    int palette[4][3], i, j, k, inset, d, bestd, best;
+    unsigned int indices = 0;
+
+    // Bounding box of the colors in the block, inset a bit to reduce the error for the majority of texels:
+    for (i = 0; i < 16; i++) {
+        for (k = 0; k < 3; k++) {
+            if (block[i][k] < cmin[k]) cmin[k] = block[i][k];
+            if (block[i][k] > cmax[k]) cmax[k] = block[i][k];
+        }
+    }
+
+    for (k = 0; k < 3; k++) {
+        inset = (cmax[k] - cmin[k]) >> 4;
+        cmin[k] += inset;
+        cmax[k] -= inset;
+    }
+
+    c0 = PsychColorToRGB565(cmax);
+    c1 = PsychColorToRGB565(cmin);
+
+    // Need c0 > c1 to select the four color mode:
+    if (c0 < c1) { t = c0; c0 = c1; c1 = t; }
+
+    if (c0 != c1) {
+        PsychRGB565ToColor(c0, palette[0]);
+        PsychRGB565ToColor(c1, palette[1]);
+        for (k = 0; k < 3; k++) {
+            palette[2][k] = (2 * palette[0][k] + palette[1][k]) / 3;
+            palette[3][k] = (palette[0][k] + 2 * palette[1][k]) / 3;
+        }
+
+        // Assign each texel the index of the closest palette color:
+        for (i = 0; i < 16; i++) {
+            bestd = 0x7fffffff;
+            best = 0;
+            for (j = 0; j < 4; j++) {
+                d = 0;
+                for (k = 0; k < 3; k++) d += (block[i][k] - palette[j][k]) * (block[i][k] - palette[j][k]);
+                if (d < bestd) { bestd = d; best = j; }
+            }
+            indices |= ((unsigned int) best) << (2 * i);
+        }
+    }
+
+    dst[0] = (unsigned char) (c0 & 0xff);
+    dst[1] = (unsigned char) (c0 >> 8);
+    dst[2] = (unsigned char) (c1 & 0xff);
+    dst[3] = (unsigned char) (c1 >> 8);
+    dst[4] = (unsigned char) (indices & 0xff);
+    dst[5] = (unsigned char) ((indices >> 8) & 0xff);
+    dst[6] = (unsigned char) ((indices >> 16) & 0xff);
+    dst[7] = (unsigned char) ((indices >> 24) & 0xff);
+}
+
+// Encode the alpha channel of a 4x4 block of RGBA8 texels into a 8 byte BC3 alpha block:
+static void PsychEncodeBC3AlphaBlock(unsigned char block[16][4], unsigned char *dst)
+{
+    int a0 = 0, a1 = 255, palette[8], i, j, d, bestd, best;
+    psych_uint64 indices = 0;
+
+    for (i = 0; i < 16; i++) {
+        if (block[i][3] > a0) a0 = block[i][3];
+        if (block[i][3] < a1) a1 = block[i][3];
+    }
+
+    // a0 > a1 selects the mode with 6 interpolated alpha values:
+    if (a0 > a1) {
+        palette[0] = a0;
+        palette[1] = a1;
+        for (j = 1; j < 7; j++) palette[j + 1] = ((7 - j) * a0 + j * a1) / 7;
+
+        for (i = 0; i < 16; i++) {
+            bestd = 256;
+            best = 0;
+            for (j = 0; j < 8; j++) {
+                d = abs(block[i][3] - palette[j]);
+                if (d < bestd) { bestd = d; best = j; }
+            }
+            indices |= ((psych_uint64) best) << (3 * i);
+        }
+    }
+
+    dst[0] = (unsigned char) a0;
+    dst[1] = (unsigned char) a1;
+    for (i = 0; i < 6; i++) dst[2 + i] = (unsigned char) ((indices >> (8 * i)) & 0xff);
+}
+
+// Compress 8 bpc RGB (depth 24) or RGBA (depth 32) image data 'src' of 'width' x 'height' texels and 'rowbytes' bytes per row
+// into BC1 (depth 24) or BC3 (depth 32) format in 'dst'. 'rgbaoffsets' defines the byte offsets of the R, G, B, A components of
+// one texel in the input. Returns size of the compressed data in bytes:
+static size_t PsychCompressTextureS3TC(const unsigned char *src, int width, int height, size_t rowbytes, int depth, const int *rgbaoffsets, unsigned char *dst)
+{
+    unsigned char block[16][4];
+    const unsigned char *texel;
+    unsigned char *out = dst;
+    int bx, by, x, y, k, tx, ty, texelsize = depth / 8;
+
+    for (by = 0; by < height; by += 4) {
+        for (bx = 0; bx < width; bx += 4) {
+            // Fetch 4x4 block, replicating the last row/column for partial blocks at the image border:
+            for (y = 0; y < 4; y++) {
+                for (x = 0; x < 4; x++) {
+                    tx = (bx + x < width) ? bx + x : width - 1;
+                    ty = (by + y < height) ? by + y : height - 1;
+                    texel = src + (size_t) ty * rowbytes + (size_t) tx * (size_t) texelsize;
+                    for (k = 0; k < 3; k++) block[y * 4 + x][k] = texel[rgbaoffsets[k]];
+                    block[y * 4 + x][3] = (depth == 32) ? texel[rgbaoffsets[3]] : 255;
+                }
+            }
+
+            if (depth == 32) {
+                PsychEncodeBC3AlphaBlock(block, out);
+                out += 8;
+            }
+
+            PsychEncodeBC1ColorBlock(block, out);
+            out += 8;
+        }
+    }
+
+    return((size_t) (out - dst));
 }
 
 void PsychCreateTexture(PsychWindowRecordType *win)
@@ -138,12 +853,24 @@ void PsychCreateTexture(PsychWindowRecordType *win)
     GLint gl_rbits=0, gl_gbits=0, gl_bbits=0, gl_abits=0, gl_lbits=0;
     int twidth, theight, pass, texcount;
     void* texmemptr;
+    void* texdataptr;
     psych_bool recycle = FALSE, avoidCPUGPUSync;
     GLenum glerr;
     int verbosity;
+    GLuint uploadbuffer = 0;
+    size_t uploadsize, rowsize;
+    GLint compressedformat = 0;
+    size_t compressedsize = 0;
+    unsigned char *compresseddata = NULL;
+    int rgbaoffsets[4];
+    unsigned int endiantest = 1;
 
     verbosity = PsychPrefStateGet_Verbosity();
 
+    // Texture uploads would get compiled into an active Screen('CommandList') recording:
+    if (PsychGetCommandListRecordingWindow())
+        PsychErrorExitMsg(PsychError_user, "Tried to create or update a texture while Screen('CommandList') recording is active. Create all textures before 'Begin'!");
+
     // Check if any calls that can cause a CPU<->GPU sync should be avoided at (nearly all) costs.
     // Avoiding CPU<->GPU sync is a robustness vs. performance tradeoff: Performance is potentially
     // significantly increased, but the amount of error checking and error handling is drastically
@@ -244,8 +971,105 @@ void PsychCreateTexture(PsychWindowRecordType *win)
         texmemptr=win->textureMemory;
     }
 
-    // We only execute this pass for really new textures, not for recycled ones:
-    if (!recycle) {
+    // Compressed texture storage? Either the input data is already compressed in the requested compressed internal
+    // format, or compression of 8 bpc RGB(A) data by our own encoder is requested. Compressed formats need desktop
+    // OpenGL and GL_TEXTURE_2D textures, so power-of-two emulation textures and rectangle textures are excluded:
+    if ((win->textureinternalformat != 0) && (PsychGetCompressedTextureBlockSize(win->textureinternalformat) > 0)) {
+        if (!texmemptr || (texturetarget != GL_TEXTURE_2D) || PsychIsGLES(win)) {
+            glBindTexture(texturetarget, 0);
+            if (!recycle) glDeleteTextures(1, &win->textureNumber);
+            win->textureNumber = 0;
+            PsychErrorExitMsg(PsychError_user, "Precompressed texture data requires a GL_TEXTURE_2D texture target and non-power-of-two texture support on desktop OpenGL!");
+        }
+
+        // Precompressed input data: Upload as is.
+        compressedformat = win->textureinternalformat;
+        compressedsize = (size_t) ((twidth + 3) / 4) * (size_t) ((theight + 3) / 4) * PsychGetCompressedTextureBlockSize(compressedformat);
+        compresseddata = (unsigned char*) texmemptr;
+    }
+    else if ((win->specialflags & kPsychCompressedTexture) && texmemptr && (texturetarget == GL_TEXTURE_2D) && !PsychIsGLES(win) &&
+             (win->textureinternalformat == 0) && (win->depth == 24 || win->depth == 32) && glewIsSupported("GL_EXT_texture_compression_s3tc")) {
+        // Compression of 8 bpc RGB into BC1 or RGBA into BC3 by our own encoder. RGB input data is in R,G,B byte order.
+        // RGBA input is BGRA as GL_UNSIGNED_INT_8_8_8_8_REV, ie. B,G,R,A bytes on little-endian, A,R,G,B on big-endian:
+        compressedformat = (win->depth == 24) ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        if (win->depth == 24) {
+            rgbaoffsets[0] = 0; rgbaoffsets[1] = 1; rgbaoffsets[2] = 2; rgbaoffsets[3] = 0;
+        }
+        else if (*((unsigned char*) &endiantest)) {
+            rgbaoffsets[0] = 2; rgbaoffsets[1] = 1; rgbaoffsets[2] = 0; rgbaoffsets[3] = 3;
+        }
+        else {
+            rgbaoffsets[0] = 1; rgbaoffsets[1] = 2; rgbaoffsets[2] = 3; rgbaoffsets[3] = 0;
+        }
+
+        // Compute size of input rows in bytes, taking row length and alignment into account:
+        rowsize = (size_t) (win->depth / 8) * (size_t) ((win->textureStridePixels > 0) ? win->textureStridePixels : (int) sourceWidth);
+        if (win->textureByteAligned > 1) rowsize = ((rowsize + win->textureByteAligned - 1) / win->textureByteAligned) * win->textureByteAligned;
+
+        compresseddata = (unsigned char*) malloc((size_t) ((twidth + 3) / 4) * (size_t) ((theight + 3) / 4) * ((win->depth == 24) ? 8 : 16));
+        if (compresseddata == NULL) PsychErrorExitMsg(PsychError_outofMemory, "Out of system memory while trying to compress texture.");
+        compressedsize = PsychCompressTextureS3TC((const unsigned char*) texmemptr, twidth, theight, rowsize, win->depth, rgbaoffsets, compresseddata);
+
+        if (verbosity > 6) printf("PTB-DEBUG: PsychCreateTexture: Compressed %i x %i texels into %i bytes of %s.\n", twidth, theight, (int) compressedsize, (win->depth == 24) ? "BC1" : "BC3");
+    }
+    else if ((win->specialflags & kPsychCompressedTexture) && (verbosity > 1)) {
+        printf("PTB-WARNING: Texture compression requested but unsupported for this texture format, texture type or graphics driver. Using uncompressed texture.\n");
+    }
+
+    // Compressed texture storage? Then the texture gets created and filled in one go:
+    if (compressedformat) {
+        if (!recycle) {
+            glCompressedTexImage2D(texturetarget, 0, compressedformat, twidth, theight, 0, (GLsizei) compressedsize, compresseddata);
+
+            // Accounting... ...this is only a rough guesstimate:
+            win->surfaceSizeBytes = compressedsize;
+            texmemguesstimate += win->surfaceSizeBytes;
+        }
+        else {
+            glCompressedTexSubImage2D(texturetarget, 0, 0, 0, twidth, theight, compressedformat, (GLsizei) compressedsize, compresseddata);
+        }
+
+        if (compresseddata != (unsigned char*) texmemptr) free(compresseddata);
+        win->specialflags |= kPsychCompressedTexture;
+        glinternalFormat = compressedformat;
+        win->bpc = 8;
+
+        if ((glerr = glGetError()) != GL_NO_ERROR) {
+            glBindTexture(texturetarget, 0);
+            glDeleteTextures(1, &win->textureNumber);
+            win->textureNumber = 0;
+            while (glGetError());
+            if (verbosity > 0) printf("PTB-ERROR: Creation of compressed texture failed! OpenGL reported the following error condition: %s.\n", gluErrorString(glerr));
+            PsychErrorExitMsg(PsychError_user, "Compressed texture creation failed, most likely due to an unsupported compressed format or wrong size of compressed data.");
+        }
+    }
+
+    // Asynchronous texture upload via a pixel unpack buffer object requested for this texture? This
+    // needs desktop OpenGL with PBO and fence sync object support, and a texel format of known size.
+    // Power-of-two emulation textures are excluded, as their initial glTexImage2D must not source any data:
+    if ((win->specialflags & kPsychAsyncTextureUpload) && texmemptr && !compressedformat && !PsychIsGLES(win) &&
+        glewIsSupported("GL_ARB_pixel_buffer_object") && glewIsSupported("GL_ARB_sync") &&
+        ((rowsize = PsychGetTextureUploadTexelSize(win)) > 0)) {
+        // Compute size of input image in bytes, taking row length and alignment into account:
+        rowsize *= (size_t) ((win->textureStridePixels > 0) ? win->textureStridePixels : (int) sourceWidth);
+        if (win->textureByteAligned > 1) rowsize = ((rowsize + win->textureByteAligned - 1) / win->textureByteAligned) * win->textureByteAligned;
+        uploadsize = rowsize * (size_t) sourceHeight;
+
+        // Copy the image into a driver owned buffer object. This is the only copy which happens synchronously.
+        // All later upload calls source from that buffer, so they don't need to wait for the texture transfer to
+        // finish and the driver can do the actual upload into VRAM at its own pace, e.g., via DMA:
+        glGenBuffersARB(1, &uploadbuffer);
+        glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, uploadbuffer);
+        glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, (GLsizeiptrARB) uploadsize, win->textureMemory, GL_STREAM_DRAW_ARB);
+
+        // With a bound unpack buffer, data pointers are offsets into that buffer:
+        texmemptr = (void*) 0;
+
+        if (verbosity > 6) printf("PTB-DEBUG: PsychCreateTexture: Asynchronous upload of %i x %i texels, %i bytes, via PBO %i.\n", (int) sourceWidth, (int) sourceHeight, (int) uploadsize, uploadbuffer);
+    }
+
+    // We only execute this pass for really new textures, not for recycled ones, and not for compressed ones:
+    if (!recycle && !compressedformat) {
         // This is a two-pass procedure. First we check with a proxy-texture if texture
         // creation will succeed without trouble, then we either fail in case of error,
         // or we do the real thing and create the texture:
@@ -393,6 +1217,11 @@ void PsychCreateTexture(PsychWindowRecordType *win)
                     while(glGetError());
 
                     // Free all ressources already allocated for this failed texture creation request:
+                    if (uploadbuffer) {
+                        glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+                        glDeleteBuffersARB(1, &uploadbuffer);
+                    }
+
                     glBindTexture(texturetarget, 0);
                     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
                     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -487,46 +1316,48 @@ void PsychCreateTexture(PsychWindowRecordType *win)
     }  // End of new texture creation.
 
     // Stage 2: If it is a 2D texture or a recycled texture, fill it with content via glTexSubImage2D:
-    if (texturetarget == GL_TEXTURE_2D || recycle) {
+    if ((texturetarget == GL_TEXTURE_2D || recycle) && !compressedformat) {
         // Special setup code for pot2 textures: Fill the empty power of two texture object with content:
         // We only fill a subrectangle (of sourceWidth x sourceHeight size) with our images content. The
         // unused border contains all zero == black.
-        // The same path is used for efficient refilling existing textures that are to be recycled:
+        // The same path is used for efficient refilling existing textures that are to be recycled.
+        // Source the data from our pixel unpack buffer instead of system memory, if async upload is active:
+        texdataptr = (uploadbuffer) ? (void*) 0 : (void*) win->textureMemory;
         if (win->textureinternalformat==0) {
             // Standard path: Derive texture format and such from requested pixeldepth:
             switch(win->depth) {
                 case 8:
-                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_LUMINANCE, GL_UNSIGNED_BYTE, win->textureMemory);
+                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_LUMINANCE, GL_UNSIGNED_BYTE, texdataptr);
                     break;
 
                 case 16:
-                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, win->textureMemory);
+                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, texdataptr);
                     break;
 
                 case 24:
-                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_RGB, GL_UNSIGNED_BYTE, win->textureMemory);
+                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_RGB, GL_UNSIGNED_BYTE, texdataptr);
                     break;
 
                 case 32:
                     if (PsychIsGLES(win)) {
                         // GLES is much more restricted:
                         if (strstr((const char*) glGetString(GL_EXTENSIONS), "GL_EXT_texture_format_BGRA8888")) {
-                            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_BGRA_EXT, GL_UNSIGNED_BYTE, win->textureMemory);
+                            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_BGRA_EXT, GL_UNSIGNED_BYTE, texdataptr);
                         }
                         else {
-                            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_RGBA, GL_UNSIGNED_BYTE, win->textureMemory);
+                            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_RGBA, GL_UNSIGNED_BYTE, texdataptr);
                         }
                     }
                     else {
                         // Classic path:
-                        glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_BGRA, ((win->gfxcaps & kPsychGfxCapNeedsUnsignedByteRGBATextureUpload) ? GL_UNSIGNED_BYTE : GL_UNSIGNED_INT_8_8_8_8_REV), win->textureMemory);
+                        glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_BGRA, ((win->gfxcaps & kPsychGfxCapNeedsUnsignedByteRGBATextureUpload) ? GL_UNSIGNED_BYTE : GL_UNSIGNED_INT_8_8_8_8_REV), texdataptr);
                     }
                     break;
             }
         }
         else {
             // Requested internal format and external data representation are explicitely requested: Use it.
-            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, win->textureexternalformat, win->textureexternaltype, win->textureMemory);
+            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, win->textureexternalformat, win->textureexternaltype, texdataptr);
             glinternalFormat = win->textureinternalformat;
         }
     }
@@ -550,6 +1381,20 @@ void PsychCreateTexture(PsychWindowRecordType *win)
         }
     }
 
+    // Asynchronous upload in progress? Then we are done with the pixel unpack buffer. Deletion of the
+    // buffer object is deferred by the driver until the pending upload from it has completed. Insert a
+    // fence to allow tracking of upload completion via PsychCheckAsyncTextureUpload():
+    if (uploadbuffer) {
+        glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        glDeleteBuffersARB(1, &uploadbuffer);
+
+        if (win->textureUploadFence) glDeleteSync(win->textureUploadFence);
+        win->textureUploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        // Kick off processing of the upload without waiting for it:
+        glFlush();
+    }
+
     // Free system RAM backing memory buffer:
     if (win->textureMemory && (win->textureMemorySizeBytes > 0)) free(win->textureMemory);
     win->textureMemory=NULL;
@@ -599,6 +1444,15 @@ void PsychFreeTextureForWindowRecord(PsychWindowRecordType *win)
         // work for some strange reason :(
         if ((win->textureMemory) && (win->textureNumber > 0)) glFinish(); // FinishObjectAPPLE(GL_TEXTURE_2D, win->textureNumber);
 
+        // Remove from texture residency manager, releasing the cached copy if texture is evicted:
+        PsychTextureResidencyUnregister(win);
+
+        // Release fence of a still pending asynchronous texture upload, if any:
+        if (win->textureUploadFence) {
+            glDeleteSync(win->textureUploadFence);
+            win->textureUploadFence = NULL;
+        }
+
         // Perform standard OpenGL texture cleanup if needed:
         if (win->textureNumber != 0) {
             glDeleteTextures(1, &win->textureNumber);
@@ -733,6 +1587,9 @@ void PsychBlitTextureToDisplay(PsychWindowRecordType *source, PsychWindowRecordT
     // because SCREENDrawText glDisable'd GL_TEXTURE_RECTANGLE_EXT, without this routine reenabling it.
     glDisable(GL_TEXTURE_2D);
 
+    // Mark texture as used for the residency manager, reupload it if it got evicted:
+    PsychTextureResidencyTouch(source);
+
     // Only enable actual texture hardware if a real texture is provided.
     // In the case of no real texture, we don't bind a real texture, don't
     // enable texture mapping and just blit the quad, with interpolated
@@ -1459,6 +2316,9 @@ void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, Ps
             }
         }
 
+        // Mark texture as used for the residency manager, reupload it if it got evicted:
+        PsychTextureResidencyTouch(source);
+
         // Only enable actual texture hardware if a real texture is provided.
         // In the case of no real texture, we don't bind a real texture, don't
         // enable texture mapping and just blit the quad, with interpolated
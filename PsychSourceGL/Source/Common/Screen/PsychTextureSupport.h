@@ -21,8 +21,31 @@ HISTORY:
 
 #include "Screen.h"
 
+// Statistics of the texture residency manager, as returned by PsychTextureResidencyGetStats():
+typedef struct PsychTextureResidencyStatsType {
+    size_t          budget;                 // Budget in bytes for resident managed textures. Zero = Unlimited, ie. no eviction.
+    size_t          residentBytes;          // Bytes of VRAM consumed by all resident managed textures.
+    size_t          evictedBytes;           // Bytes of system RAM consumed by the caches of all evicted managed textures.
+    int             numResident;            // Number of resident managed textures.
+    int             numEvicted;             // Number of evicted managed textures.
+    psych_uint64    hits;                   // Number of draws of a managed texture which was resident.
+    psych_uint64    misses;                 // Number of draws of a managed texture which needed re-upload from the cache.
+    psych_uint64    evictions;              // Number of evictions of managed textures.
+    psych_uint64    bytesUploadedTotal;     // Total bytes uploaded into managed textures, including initial creation.
+    size_t          bytesUploadedThisFrame; // Bytes uploaded since the last flip.
+    size_t          bytesUploadedLastFrame; // Bytes uploaded between the last two flips.
+} PsychTextureResidencyStatsType;
+
 void PsychInitWindowRecordTextureFields(PsychWindowRecordType *winRec);
 void PsychCreateTexture(PsychWindowRecordType *win);
+size_t PsychGetCompressedTextureBlockSize(GLint internalformat);
+psych_bool PsychCheckAsyncTextureUpload(PsychWindowRecordType *win, psych_bool waitForCompletion);
+void PsychTextureResidencyRegister(PsychWindowRecordType *win);
+void PsychTextureResidencyTouch(PsychWindowRecordType *win);
+void PsychTextureResidencyPin(PsychWindowRecordType *win);
+void PsychTextureResidencySetBudget(size_t budget);
+void PsychTextureResidencyNewFrame(void);
+void PsychTextureResidencyGetStats(PsychTextureResidencyStatsType *stats);
 void PsychFreeTextureForWindowRecord(PsychWindowRecordType *win);
 void PsychBlitTextureToDisplay(PsychWindowRecordType *source, PsychWindowRecordType *target, double *sourceRect, double *targetRect,
                                double rotationAngle, int filterMode, double globalAlpha);
@@ -288,6 +288,33 @@ int PsychVideoCaptureRate(int capturehandle, double capturerate, int dropframes,
 	return(0);
 }
 
+/*
+ *  PsychAlignCaptureGroup() - Align the next captured frames of a group of capture devices by timestamp.
+ *
+ *  Returns Number of dropped frames, or -1 if no aligned frame set is available yet, -2 if none will
+ *  become available because capture has been stopped.
+ */
+int PsychAlignCaptureGroup(int numDevices, int* capturehandles, int waitForSet, double tolerance)
+{
+	int i;
+
+	for (i = 0; i < numDevices; i++) {
+		if (capturehandles[i] < 0 || capturehandles[i] >= PSYCH_MAX_CAPTUREDEVICES || mastervidcapRecordBANK[capturehandles[i]].engineId == -1) {
+			PsychErrorExitMsg(PsychError_user, "Invalid capturehandle provided!");
+		}
+
+		if (mastervidcapRecordBANK[capturehandles[i]].engineId != 3) {
+			PsychErrorExitMsg(PsychError_user, "Synchronized frame sets are only supported by the GStreamer video capture engine!");
+		}
+	}
+
+	#ifdef PTB_USE_GSTREAMER
+	return(PsychGSAlignCaptureGroup(numDevices, capturehandles, waitForSet, tolerance));
+	#endif
+
+	return(-2);
+}
+
 /* Set capture device specific parameters:
  * On OS-X and Windows (and therefore in this implementation) this is currently a no-op, until
  * we find out how to do this with the Sequence-Grabber API.
@@ -44,6 +44,7 @@ psych_bool PsychOpenVideoCaptureDevice(int engineId, PsychWindowRecordType *win,
 void PsychCloseVideoCaptureDevice(int capturehandle);
 int PsychGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle, int checkForImage, double timeindex, PsychWindowRecordType *out_texture, double *presentation_timestamp, double* summed_intensity, rawcapimgdata* outrawbuffer);
 int PsychVideoCaptureRate(int capturehandle, double capturerate, int dropframes, double* startattime);
+int PsychAlignCaptureGroup(int numDevices, int* capturehandles, int waitForSet, double tolerance);
 double PsychVideoCaptureSetParameter(int capturehandle, const char* pname, double value);
 void PsychEnumerateVideoSources(int engineId, int outPos);
 void PsychExitVideoCapture(void);
@@ -89,6 +90,7 @@ psych_bool PsychGSOpenVideoCaptureDevice(int slotid, PsychWindowRecordType *win,
 void PsychGSCloseVideoCaptureDevice(int capturehandle);
 int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle, int checkForImage, double timeindex, PsychWindowRecordType *out_texture, double *presentation_timestamp, double* summed_intensity, rawcapimgdata* outrawbuffer);
 int PsychGSVideoCaptureRate(int capturehandle, double capturerate, int dropframes, double* startattime);
+int PsychGSAlignCaptureGroup(int numDevices, int* capturehandles, int waitForSet, double tolerance);
 double PsychGSVideoCaptureSetParameter(int capturehandle, const char* pname, double value);
 PsychVideosourceRecordType* PsychGSEnumerateVideoSources(int outPos, int deviceIndex, GstElement **videocaptureplugin, GstElement **videocapturebin);
 void PsychGSExitVideoCapture(void);
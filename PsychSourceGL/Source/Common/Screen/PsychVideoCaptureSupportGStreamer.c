@@ -76,6 +76,7 @@
 #if GST_CHECK_VERSION(1,0,0)
 
 #include <gst/app/gstappsink.h>
+#include <gst/base/gstbasesrc.h>
 #include <gst/video/colorbalance.h>
 #include <gst/pbutils/encoding-profile.h>
 
@@ -92,6 +93,28 @@ char gstlaunchbinsrc[8192] = { 0 };
 PsychVideosourceRecordType *devices = NULL;
 int ntotal = 0;
 
+// Sync modes and sync roles for multi-camera synchronization, same as for the libdc1394 engine.
+// Only soft-sync is supported by the GStreamer engine:
+#define kPsychIsSyncMaster  1
+#define kPsychIsSyncSlave   2
+#define kPsychIsSoftSynced  4
+#define kPsychIsBusSynced   8
+#define kPsychIsHwSynced   16
+
+// Maximum capacity of the lock-free frame queue of a capture device:
+#define PSYCH_CAPTURE_QUEUE_SIZE 64
+
+// Default capacity of the frame queue if 'numbuffers' is not specified. Each queued frame holds on to
+// a buffer of the video source, so this must stay small to not drain the buffer pool of the source:
+#define PSYCH_CAPTURE_QUEUE_DEFAULT 4
+
+// Entry of the frame queue: A video sample, already mapped for reading by the streaming thread:
+typedef struct {
+    GstSample *sample;
+    GstMapInfo mapinfo;
+    double arrivalTime;               // GetSecs time when the sample was received from the videosink.
+} PsychCaptureQueueEntry;
+
 // Record which defines all state for a capture device:
 typedef struct {
     int valid;                        // Is this a valid device record? zero == Invalid.
@@ -138,6 +161,33 @@ typedef struct {
     char* cameraFriendlyName;         // Camera friendly device name.
     char videosourcename[100];        // Plugin name of the videosource plugin.
     void* markerTrackerPlugin;        // Opaque pointer to instance handle of a markerTrackerPlugin.
+    int queueActive;                  // 1 == Frames are handed to the main thread via the lock-free frame queue.
+    int queueLimit;                   // Maximum number of queued frames before new frames get dropped.
+    volatile gint queueHead;          // Number of frames ever enqueued. Only written by the streaming thread.
+    volatile gint queueTail;          // Number of frames ever dequeued. Only written by the main thread.
+    volatile gint queueWaiters;       // 1 == Main thread waits on condition for a new frame.
+    volatile gint queueDrops;         // Number of frames dropped due to a full queue.
+    int queueMaxDepth;                // Maximum observed queue depth.
+    PsychCaptureQueueEntry queue[PSYCH_CAPTURE_QUEUE_SIZE];
+    double latencySum;                // Sum and maximum of latency from capture timestamp to texture ready.
+    double latencyMax;
+    int latencyCount;
+    GLuint uploadBuffer;              // Pixel buffer object for texture uploads, or 0 if none.
+    size_t uploadBufferSize;
+    PsychWindowRecordType* parentRecord; // Onscreen window which owns uploadBuffer.
+    int preprocActive;                // 1 == Frames get cropped, binned and/or converted on the cpu before use.
+    int preprocRoi[4];                // Crop rectangle [x, y, w, h] within the video frame.
+    int preprocBinning;               // Binning factor 1, 2 or 4.
+    int preprocLuminance;             // 1 == Convert to luminance.
+    int preprocWidth;                 // Width x height x channels of preprocessed frames.
+    int preprocHeight;
+    int preprocChannels;
+    unsigned char* preprocBuffer;     // Output buffer for preprocessed frames.
+    double preprocTime;               // Total time spent in preprocessing and count of preprocessed frames.
+    int preprocFrames;
+    int syncmode;                     // 0 = free-running. 1 = sync-master, 2 = sync-slave, 4 = soft-sync.
+    int syncPending;                  // 1 == Sync slave waits for start of capture by its sync master.
+    int syncGroup;                    // Id of capture group. A sync master only starts the sync slaves of its own group.
 } PsychVidcapRecordType;
 
 static PsychVidcapRecordType vidcapRecordBANK[PSYCH_MAX_CAPTUREDEVICES];
@@ -666,14 +716,270 @@ static GstFlowReturn PsychNewPrerollCallback(GstAppSink *sink, gpointer user_dat
     return(GST_FLOW_OK);
 }
 
+/* Lock-free frame queue:
+ *
+ * If enabled via recordingflags 16384, PsychNewBufferCallback() pulls each new sample from the
+ * videosink itself, maps it for reading and hands it to the main thread via a single-producer,
+ * single-consumer ringbuffer. The streaming thread only writes queueHead, the main thread only
+ * writes queueTail, so no mutex is needed, except for waking up a main thread which is blocked
+ * in a wait for a new frame. If the queue is full, new frames get dropped.
+ */
+static int PsychCaptureQueueDepth(PsychVidcapRecordType* capdev)
+{
+    return((int) ((guint) g_atomic_int_get(&capdev->queueHead) - (guint) g_atomic_int_get(&capdev->queueTail)));
+}
+
+// Maximum number of queued frames: 'numbuffers' if specified, otherwise a small default:
+static int PsychCaptureQueueDefaultLimit(PsychVidcapRecordType* capdev)
+{
+    if (capdev->num_dmabuffers > 0)
+        return((capdev->num_dmabuffers < PSYCH_CAPTURE_QUEUE_SIZE) ? capdev->num_dmabuffers : PSYCH_CAPTURE_QUEUE_SIZE);
+
+    return(PSYCH_CAPTURE_QUEUE_DEFAULT);
+}
+
+// Limit the queue to one less than the size of the buffer pool of the video source, if the pool size is
+// known after the source started streaming. Otherwise a source, e.g., v4l2src, would run out of buffers
+// to capture into while we hold all of them in the queue:
+static void PsychCaptureQueueLimitToSourcePool(PsychVidcapRecordType* capdev)
+{
+    GstBufferPool *pool;
+    GstStructure *config;
+    guint minBuffers = 0, maxBuffers = 0, poolSize;
+
+    if (!capdev->queueActive || (capdev->num_dmabuffers > 0) || !capdev->videosource || !GST_IS_BASE_SRC(capdev->videosource))
+        return;
+
+    pool = gst_base_src_get_buffer_pool(GST_BASE_SRC(capdev->videosource));
+    if (!pool)
+        return;
+
+    config = gst_buffer_pool_get_config(pool);
+    gst_buffer_pool_config_get_params(config, NULL, NULL, &minBuffers, &maxBuffers);
+    gst_structure_free(config);
+    gst_object_unref(pool);
+
+    poolSize = (maxBuffers > 0) ? maxBuffers : minBuffers;
+    if ((poolSize > 1) && (capdev->queueLimit > (int) poolSize - 1)) {
+        capdev->queueLimit = (int) poolSize - 1;
+        if (PsychPrefStateGet_Verbosity() > 4)
+            printf("PTB-INFO: Limiting frame queue to %i frames, as the video source only has %i buffers.\n", capdev->queueLimit, (int) poolSize);
+    }
+}
+
+static psych_bool PsychCaptureQueuePush(PsychVidcapRecordType* capdev, GstSample *videoSample)
+{
+    PsychCaptureQueueEntry *entry;
+    guint head = (guint) g_atomic_int_get(&capdev->queueHead);
+    int depth = PsychCaptureQueueDepth(capdev);
+
+    if (depth >= capdev->queueLimit)
+        return(FALSE);
+
+    entry = &capdev->queue[head % PSYCH_CAPTURE_QUEUE_SIZE];
+    if (!gst_buffer_map(gst_sample_get_buffer(videoSample), &entry->mapinfo, GST_MAP_READ))
+        return(FALSE);
+
+    entry->sample = videoSample;
+    PsychGetAdjustedPrecisionTimerSeconds(&entry->arrivalTime);
+
+    // Publish the entry. This is a full memory barrier, so the entry is complete before it becomes visible:
+    g_atomic_int_set(&capdev->queueHead, (gint) (head + 1));
+    if (depth + 1 > capdev->queueMaxDepth) capdev->queueMaxDepth = depth + 1;
+
+    return(TRUE);
+}
+
+static PsychCaptureQueueEntry* PsychCaptureQueuePeek(PsychVidcapRecordType* capdev)
+{
+    if (PsychCaptureQueueDepth(capdev) <= 0)
+        return(NULL);
+
+    return(&capdev->queue[((guint) g_atomic_int_get(&capdev->queueTail)) % PSYCH_CAPTURE_QUEUE_SIZE]);
+}
+
+static void PsychCaptureQueuePop(PsychVidcapRecordType* capdev)
+{
+    PsychCaptureQueueEntry *entry = PsychCaptureQueuePeek(capdev);
+
+    if (entry) {
+        gst_buffer_unmap(gst_sample_get_buffer(entry->sample), &entry->mapinfo);
+        gst_sample_unref(entry->sample);
+        entry->sample = NULL;
+        g_atomic_int_set(&capdev->queueTail, (gint) ((guint) g_atomic_int_get(&capdev->queueTail) + 1));
+    }
+}
+
+/* Wait up to 'timeoutSecs' seconds for a frame in the queue, while the grabber is active.
+ * Returns TRUE if a frame is available.
+ */
+static psych_bool PsychCaptureQueueWait(PsychVidcapRecordType* capdev, double timeoutSecs)
+{
+    PsychLockMutex(&capdev->mutex);
+    g_atomic_int_set(&capdev->queueWaiters, 1);
+    if ((PsychCaptureQueueDepth(capdev) == 0) && capdev->grabber_active)
+        PsychTimedWaitCondition(&capdev->condition, &capdev->mutex, timeoutSecs);
+    g_atomic_int_set(&capdev->queueWaiters, 0);
+    PsychUnlockMutex(&capdev->mutex);
+
+    return(PsychCaptureQueueDepth(capdev) > 0);
+}
+
+/* Create texture 'out_texture' from its textureMemory. If enabled via recordingflags 32768, the
+ * frame is copied into a freshly orphaned pixel buffer object first, so the texture upload is an
+ * asynchronous DMA transfer and the capture buffer can be returned to the engine immediately.
+ * 'size' is the size of the frame in bytes, or zero to force a regular upload.
+ */
+static void PsychCaptureCreateTexture(PsychVidcapRecordType* capdev, PsychWindowRecordType *win, PsychWindowRecordType *out_texture, size_t size)
+{
+    void *pbomem;
+
+    if (!(capdev->recordingflags & 32768) || (size == 0) || !PsychIsGLClassic(win) || !glewIsSupported("GL_ARB_pixel_buffer_object") ||
+        ((PsychGetTextureTarget(win) == GL_TEXTURE_2D) && !(win->gfxcaps & kPsychGfxCapNPOTTex))) {
+        PsychCreateTexture(out_texture);
+        return;
+    }
+
+    if (capdev->uploadBuffer == 0) {
+        glGenBuffersARB(1, &capdev->uploadBuffer);
+        capdev->parentRecord = win;
+    }
+
+    // Orphan the old buffer storage, so we don't have to wait for completion of the previous upload:
+    glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, capdev->uploadBuffer);
+    glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, (GLsizeiptrARB) size, NULL, GL_STREAM_DRAW_ARB);
+
+    pbomem = glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB);
+    if (pbomem) {
+        memcpy(pbomem, out_texture->textureMemory, size);
+        glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB);
+
+        // Texture data is now sourced from offset zero of the bound buffer:
+        out_texture->textureMemory = NULL;
+    }
+    else {
+        glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+    }
+
+    PsychCreateTexture(out_texture);
+    glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+}
+
+/* Preprocessing stage for captured frames:
+ *
+ * Crops the region 'preprocRoi' out of a 8 bpc video frame of 'frame_width' pixels width, bins it
+ * by averaging 'preprocBinning' x 'preprocBinning' pixel blocks and optionally converts it to
+ * luminance, so only the much smaller result has to be uploaded into a texture or returned.
+ * Source frames are tightly packed L8, RGB8 or RGBA8, or I420 or UYVY YCbCr, in which case only
+ * the Y luminance channel is used. Returns a pointer to the preprocessed frame.
+ */
+static unsigned char* PsychCapturePreprocessFrame(PsychVidcapRecordType* capdev, const unsigned char* src)
+{
+    const int b = capdev->preprocBinning;
+    const int outw = capdev->preprocWidth;
+    const int outh = capdev->preprocHeight;
+    const int outc = capdev->preprocChannels;
+    int x, y, i, j, c, step, offset, rgbToLum;
+    unsigned int sum;
+    const unsigned char *row, *p;
+    unsigned char *dst = capdev->preprocBuffer;
+    double tStart, tEnd;
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tStart);
+
+    // Bytes per source pixel and offset of first used component within a pixel:
+    if (capdev->reqpixeldepth == 2) {
+        // YCbCr: I420 has a 1 Byte per pixel Y plane, UYVY the Y samples at odd Bytes:
+        step = (capdev->pixeldepth == 12) ? 1 : 2;
+        offset = (capdev->pixeldepth == 12) ? 0 : 1;
+        rgbToLum = 0;
+    }
+    else {
+        step = capdev->reqpixeldepth;
+        offset = 0;
+        rgbToLum = (capdev->preprocLuminance && (step >= 3)) ? 1 : 0;
+    }
+
+    for (y = 0; y < outh; y++) {
+        row = src + ((size_t) (capdev->preprocRoi[1] + y * b) * capdev->frame_width + capdev->preprocRoi[0]) * step + offset;
+
+        if ((b == 1) && !rgbToLum && (outc == step)) {
+            // Pure crop: Copy whole row.
+            memcpy(dst, row, (size_t) outw * outc);
+            dst += outw * outc;
+            continue;
+        }
+
+        for (x = 0; x < outw; x++) {
+            for (c = 0; c < outc; c++) {
+                sum = 0;
+                for (j = 0; j < b; j++) {
+                    p = row + ((size_t) j * capdev->frame_width + x * b) * step;
+                    for (i = 0; i < b; i++, p += step) {
+                        // Rec. 601 luma weights in 8 bit fixed point:
+                        sum += (rgbToLum) ? ((77 * p[0] + 150 * p[1] + 29 * p[2]) >> 8) : p[c];
+                    }
+                }
+
+                *(dst++) = (unsigned char) (sum / (b * b));
+            }
+        }
+    }
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tEnd);
+    capdev->preprocTime += tEnd - tStart;
+    capdev->preprocFrames++;
+
+    return(capdev->preprocBuffer);
+}
+
+/* Return capture timestamp of 'videoBuffer' in seconds, in GetSecs time, or in
+ * pipeline running time if requested via recordingflags 64:
+ */
+static double PsychGSCaptureTimestamp(PsychVidcapRecordType* capdev, GstBuffer* videoBuffer)
+{
+    GstClockTime baseTime;
+
+    // Retrieve raw buffer timestamp - pipeline running time:
+    if (capdev->recordingflags & 64)
+        return((double) GST_BUFFER_PTS(videoBuffer) / (double) 1e9);
+
+    // Add base time to convert running time buffer timestamp into absolute time:
+    baseTime = gst_element_get_base_time(capdev->camera);
+    if (baseTime == 0) baseTime = capdev->lastSavedBaseTime;
+
+    // Apply corrective offset for GStreamer clock base zero point:
+    return((double) (GST_BUFFER_PTS(videoBuffer) + baseTime) / (double) 1e9 + gs_startupTime);
+}
+
 /* Called whenever pipeline is in active playback and a new video frame arrives.
  * Used to detect/signal when new videobuffers are available in playback mode.
  */
 static GstFlowReturn PsychNewBufferCallback(GstAppSink *sink, gpointer user_data)
 {
+    GstSample *videoSample;
     PsychVidcapRecordType* capdev = (PsychVidcapRecordType*) user_data;
     (void) sink;
 
+    if (capdev->queueActive) {
+        videoSample = gst_app_sink_pull_sample(GST_APP_SINK(capdev->videosink));
+        if (videoSample && !PsychCaptureQueuePush(capdev, videoSample)) {
+            // Queue full: Drop the new frame.
+            gst_sample_unref(videoSample);
+            g_atomic_int_inc(&capdev->queueDrops);
+            if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: Frame queue full. Dropped new buffer.\n");
+        }
+
+        // Only take the lock if the main thread needs a wakeup:
+        if (g_atomic_int_get(&capdev->queueWaiters)) {
+            PsychLockMutex(&capdev->mutex);
+            PsychSignalCondition(&capdev->condition);
+            PsychUnlockMutex(&capdev->mutex);
+        }
+
+        return(GST_FLOW_OK);
+    }
+
     PsychLockMutex(&capdev->mutex);
     capdev->frameAvail++;
     if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: New Buffer received. %i\n", capdev->frameAvail);
@@ -737,6 +1043,9 @@ void PsychGSCloseVideoCaptureDevice(int capturehandle)
         // Stop video capture immediately:
         PsychVideoPipelineSetState(capdev->camera, GST_STATE_NULL, 20.0);
 
+        // Release frames which got queued after the drain, before the streaming thread stopped:
+        if (capdev->queueActive) PsychGSDrainBufferQueue(capdev, INT_MAX, 0);
+
         // Delete camera for this handle:
         gst_object_unref(GST_OBJECT(capdev->camera));
         capdev->camera=NULL;
@@ -765,6 +1074,16 @@ void PsychGSCloseVideoCaptureDevice(int capturehandle)
     if (capdev->cameraFriendlyName) free(capdev->cameraFriendlyName);
     capdev->cameraFriendlyName = NULL;
 
+    if (capdev->preprocBuffer) free(capdev->preprocBuffer);
+    capdev->preprocBuffer = NULL;
+
+    // Release pixel buffer object for texture uploads:
+    if (capdev->uploadBuffer && capdev->parentRecord) {
+        PsychSetGLContext(capdev->parentRecord);
+        glDeleteBuffersARB(1, &capdev->uploadBuffer);
+        capdev->uploadBuffer = 0;
+    }
+
 #if PSYCH_SYSTEM != PSYCH_WINDOWS
 
     // Shutdown and release an assigned markerTrackerPlugin:
@@ -3134,6 +3453,12 @@ psych_bool PsychGSOpenVideoCaptureDevice(int slotid, PsychWindowRecordType *win,
     // Assign number of dma buffers to use:
     capdev->num_dmabuffers = num_dmabuffers;
 
+    // Lock-free frame queue requested for live capture? Its length is limited by num_dmabuffers if given:
+    if ((recordingflags & 16384) && !(recordingflags & 4)) {
+        capdev->queueActive = 1;
+        capdev->queueLimit = PsychCaptureQueueDefaultLimit(capdev);
+    }
+
     PsychInitMutex(&vidcapRecordBANK[slotid].mutex);
     PsychInitCondition(&vidcapRecordBANK[slotid].condition, NULL);
 
@@ -4243,6 +4568,16 @@ int PsychGSDrainBufferQueue(PsychVidcapRecordType* capdev, int numFramesToDrain,
     GstSample *videoSample = NULL;
     int drainedCount = 0;
 
+    // Frame queue in use? Drain it instead of the videosink, which is always empty then:
+    if (capdev->queueActive) {
+        while ((PsychCaptureQueueDepth(capdev) > 0) && (numFramesToDrain > drainedCount)) {
+            PsychCaptureQueuePop(capdev);
+            drainedCount++;
+        }
+
+        return(drainedCount);
+    }
+
     if ((capdev->frameAvail > (int) gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink))) &&
         (gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink)) > 0))
         capdev->frameAvail = gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink));
@@ -4260,6 +4595,67 @@ int PsychGSDrainBufferQueue(PsychVidcapRecordType* capdev, int numFramesToDrain,
     return(drainedCount);
 }
 
+/* Start video recording on a started capture device, if recording is requested: */
+static void PsychGSStartRecording(PsychVidcapRecordType* capdev)
+{
+    if (capdev->recording_active) {
+        if (PsychPrefStateGet_Verbosity()>5) printf("PTB-DEBUG: Starting recording...\n");
+        g_object_set(G_OBJECT(capdev->camera), "mode", 2, NULL);
+        if (PsychPrefStateGet_Verbosity()>5) printf("PTB-DEBUG: Recording 1 started...\n");
+        g_object_set(G_OBJECT(capdev->camera), "location", capdev->targetmoviefilename, NULL);
+        if (PsychPrefStateGet_Verbosity()>5) printf("PTB-DEBUG: Recording 2 started...\n");
+        g_signal_emit_by_name (capdev->camera, "start-capture", 0, 0);
+        if (PsychPrefStateGet_Verbosity()>5) printf("PTB-DEBUG: Recording started...\n");
+    }
+}
+
+/* Start of capture on sync master 'master': Assign one shared clock and base time to the master and
+ * all sync slaves of its capture group which wait for the start of capture, then start the slaves. The master gets started
+ * by our caller. All pipelines of the group then timestamp their frames in the same time base, which
+ * allows to pair frames across devices via PsychGSAlignCaptureGroup().
+ */
+static void PsychGSStartCaptureGroup(PsychVidcapRecordType* master)
+{
+    PsychVidcapRecordType *dev;
+    GstClock *clock;
+    GstClockTime baseTime;
+    int i, count = 0;
+
+    clock = gst_system_clock_obtain();
+
+    // Start of the shared running time, with some slack for the state changes of all pipelines:
+    baseTime = gst_clock_get_time(clock) + 100 * GST_MSECOND;
+
+    for (i = 0; i < PSYCH_MAX_CAPTUREDEVICES; i++) {
+        dev = &vidcapRecordBANK[i];
+        if (!dev->valid || ((dev != master) && (!dev->syncPending || (dev->syncGroup != master->syncGroup)))) continue;
+
+        gst_pipeline_use_clock(GST_PIPELINE(dev->camera), clock);
+        gst_element_set_start_time(dev->camera, GST_CLOCK_TIME_NONE);
+        gst_element_set_base_time(dev->camera, baseTime);
+    }
+
+    gst_object_unref(clock);
+
+    for (i = 0; i < PSYCH_MAX_CAPTUREDEVICES; i++) {
+        dev = &vidcapRecordBANK[i];
+        if (!dev->valid || (dev == master) || !dev->syncPending || (dev->syncGroup != master->syncGroup)) continue;
+
+        dev->syncPending = 0;
+        if (!PsychVideoPipelineSetState(dev->camera, GST_STATE_PLAYING, 10.0)) {
+            PsychGSProcessVideoContext(dev, FALSE);
+            if (PsychPrefStateGet_Verbosity() > 0) printf("PTB-ERROR: Failed to start capture on sync slave %i! Prepare for trouble!\n", i);
+            continue;
+        }
+
+        PsychGSStartRecording(dev);
+        count++;
+    }
+
+    if (PsychPrefStateGet_Verbosity() > 3)
+        printf("PTB-INFO: Starting synchronized capture of sync master %i and %i sync slaves of capture group %i on a shared clock.\n", master->capturehandle, count, master->syncGroup);
+}
+
 /*
  *  PsychGSVideoCaptureRate() - Start- and stop video capture.
  *
@@ -4306,6 +4702,11 @@ int PsychGSVideoCaptureRate(int capturehandle, double capturerate, int dropframe
         capdev->last_pts = -1.0;
         capdev->nr_droppedframes = 0;
         capdev->lastSavedBaseTime = 0;
+        capdev->queueMaxDepth = 0;
+        capdev->latencySum = 0;
+        capdev->latencyMax = 0;
+        capdev->latencyCount = 0;
+        g_atomic_int_set(&capdev->queueDrops, 0);
 
         // Framedropping in the sense we define it is not supported by libGStreamer, so we implement it ourselves.
         // Store the 'dropframes' flag in our capdev struct, so the PsychGSGetTextureFromCapture()
@@ -4449,9 +4850,27 @@ int PsychGSVideoCaptureRate(int capturehandle, double capturerate, int dropframe
         capdev->frameAvail = 0;
         capdev->preRollAvail = 0;
 
+        // Sync slave of a capture group? Then its capture gets started together with its
+        // sync master, in PsychGSStartCaptureGroup():
+        if (capdev->syncmode & kPsychIsSyncSlave) {
+            if (capdev->fps <= 0) capdev->fps = capturerate;
+            capdev->syncPending = 1;
+            capdev->grabber_active = 1;
+            capdev->nrframes = 0;
+            capdev->avg_decompresstime = 0;
+            capdev->nrgfxframes = 0;
+            capdev->avg_gfxtime = 0;
+
+            if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Sync slave %i ready. Capture will start with start of the sync master.\n", capturehandle);
+            return((int) (capdev->fps + 0.5));
+        }
+
         // Wait until start deadline reached:
         if (*startattime != 0) PsychWaitUntilSeconds(*startattime);
 
+        // Sync master of a capture group? Start all waiting sync slaves on a shared clock:
+        if (capdev->syncmode & kPsychIsSyncMaster) PsychGSStartCaptureGroup(capdev);
+
         // Start actual video capture and/or recording:
         if (PsychPrefStateGet_Verbosity()>5) printf("PTB-DEBUG: Starting capture...\n");
 
@@ -4475,15 +4894,7 @@ int PsychGSVideoCaptureRate(int capturehandle, double capturerate, int dropframe
         }
 
         // Start video recording if requested:
-        if (capdev->recording_active) {
-            if (PsychPrefStateGet_Verbosity()>5) printf("PTB-DEBUG: Starting recording...\n");
-            g_object_set(G_OBJECT(camera), "mode", 2, NULL);
-            if (PsychPrefStateGet_Verbosity()>5) printf("PTB-DEBUG: Recording 1 started...\n");
-            g_object_set(G_OBJECT(camera), "location", capdev->targetmoviefilename, NULL);
-            if (PsychPrefStateGet_Verbosity()>5) printf("PTB-DEBUG: Recording 2 started...\n");
-            g_signal_emit_by_name (camera, "start-capture", 0, 0);
-            if (PsychPrefStateGet_Verbosity()>5) printf("PTB-DEBUG: Recording started...\n");
-        }
+        PsychGSStartRecording(capdev);
 
         // Wait for real start of capture, i.e., arrival of 1st captured
         // video buffer:
@@ -4493,14 +4904,20 @@ int PsychGSVideoCaptureRate(int capturehandle, double capturerate, int dropframe
         // MS-Windows. Therefore only wait for 1.1 msecs at most:
         PsychTimedWaitCondition(&capdev->condition, &capdev->mutex, 0.0011);
 
-        // Wait for first frame to become available:
-        while (capdev->frameAvail == 0) {
+        // Wait for first frame to become available. In frame queue mode, the streaming thread
+        // only signals the condition if we announce our wait:
+        g_atomic_int_set(&capdev->queueWaiters, 1);
+        while (((capdev->queueActive) ? PsychCaptureQueueDepth(capdev) : capdev->frameAvail) == 0) {
             if (PsychPrefStateGet_Verbosity() > 5) {
                 printf("PTB-DEBUG: Waiting for real start: fA = %i pA = %i fps=%f\n", capdev->frameAvail, capdev->preRollAvail, capdev->fps);
                 fflush(NULL);
             }
             PsychTimedWaitCondition(&capdev->condition, &capdev->mutex, 10.0);
         }
+        g_atomic_int_set(&capdev->queueWaiters, 0);
+
+        // Buffer pool of the source is negotiated now, so we can limit the frame queue to it:
+        PsychCaptureQueueLimitToSourcePool(capdev);
 
         // Assign a plausible framerate if none assigned properly:
         if (capdev->fps <= 0) capdev->fps = capturerate;
@@ -4580,6 +4997,12 @@ int PsychGSVideoCaptureRate(int capturehandle, double capturerate, int dropframe
                 PsychGSProcessVideoContext(capdev, FALSE);
                 if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: StopVideoCapture: Stopped.\n");
 
+                // Detach member of a capture group from the shared clock:
+                if (capdev->syncmode) {
+                    gst_pipeline_auto_clock(GST_PIPELINE(camera));
+                    gst_element_set_start_time(camera, 0);
+                }
+
                 // Drain any queued buffers, if requested:
                 if (dropframes) {
                     drainedCount = PsychGSDrainBufferQueue(capdev, INT_MAX, 0);
@@ -4589,6 +5012,7 @@ int PsychGSVideoCaptureRate(int capturehandle, double capturerate, int dropframe
 
             // Ok, capture is now stopped.
             capdev->grabber_active = 0;
+            capdev->syncPending = 0;
 
             if (capdev->scratchbuffer) {
                 // Release scratch-buffer:
@@ -4613,6 +5037,16 @@ int PsychGSVideoCaptureRate(int capturehandle, double capturerate, int dropframe
 
                 if (capdev->nrgfxframes>0) capdev->avg_gfxtime/= (double) capdev->nrgfxframes;
                 printf("PTB-INFO: Average time spent in GetCapturedImage (intensity calculation Video->OpenGL texture conversion) was %f milliseconds.\n",  (float) capdev->avg_gfxtime * 1000.0f);
+
+                if (capdev->queueActive) {
+                    printf("PTB-INFO: Frame queue reached a maximum depth of %i frames. %i frames were dropped due to a full queue.\n",
+                           capdev->queueMaxDepth, (int) g_atomic_int_get(&capdev->queueDrops));
+                }
+
+                if (capdev->latencyCount > 0) {
+                    printf("PTB-INFO: Latency from capture timestamp to texture ready was %f msecs on average, %f msecs maximum.\n",
+                           capdev->latencySum * 1000.0 / capdev->latencyCount, capdev->latencyMax * 1000.0);
+                }
             }
         }
     }
@@ -4650,10 +5084,9 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
     GstBuffer *videoBuffer = NULL;
     GstSample *videoSample = NULL;
     double deltaT = 0;
-    GstClockTime baseTime;
 
     int waitforframe;
-    int w, h;
+    int w, h, channels;
     psych_uint64 intensity = 0;
     unsigned int count, i;
     unsigned char* pixptr;
@@ -4661,6 +5094,8 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
     double tstart, tend;
     int nrdropped = 0;
     unsigned char* input_image = NULL;
+    PsychCaptureQueueEntry *queueEntry = NULL;
+    size_t uploadSize;
 
     // Disable warning about missing field initializer in calls
     // like GstMapInfo mapinfo = = GST_MAP_INFO_INIT;
@@ -4699,13 +5134,21 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
     // so we can return the values for raw data retrieval:
     w = capdev->frame_width;
     h = capdev->frame_height;
+    channels = (capdev->reqpixeldepth != 2) ? capdev->reqpixeldepth : 1;
+
+    // Preprocessing stage active? Then returned images have the size and format of its output:
+    if (capdev->preprocActive) {
+        w = capdev->preprocWidth;
+        h = capdev->preprocHeight;
+        channels = capdev->preprocChannels;
+    }
 
     // If a outrawbuffer struct is provided, we fill it with info needed to allocate a
     // sufficient memory buffer for returned raw image data later on:
     if (outrawbuffer) {
         outrawbuffer->w = w;
         outrawbuffer->h = h;
-        outrawbuffer->depth = (capdev->reqpixeldepth !=2) ? capdev->reqpixeldepth : 1;
+        outrawbuffer->depth = channels;
         outrawbuffer->bitdepth = (capdev->bitdepth > 8) ? 16 : 8;
     }
 
@@ -4718,6 +5161,30 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
     // relevant work in the background.
     if (checkForImage == 4) return(0);
 
+    // Frame queue in use? Then we check for, or drop, frames without any locking:
+    if (checkForImage && capdev->queueActive) {
+        capdev->current_dropped = 0;
+
+        if (PsychCaptureQueueDepth(capdev) == 0) {
+            // Grabber stopped. We'll never get a new image:
+            if (capdev->grabber_active == 0) return(-2);
+
+            // No blocking wait requested, or wait timed out?
+            if (!waitforframe || !PsychCaptureQueueWait(capdev, 10.0)) return(-1);
+        }
+
+        capdev->current_dropped = PsychCaptureQueueDepth(capdev) - 1;
+
+        // Drop all but the most recent frame in 'dropframes' mode:
+        while (capdev->dropframes && (PsychCaptureQueueDepth(capdev) > 1)) PsychCaptureQueuePop(capdev);
+
+        PsychGetAdjustedPrecisionTimerSeconds(&tend);
+        capdev->nrframes++;
+        capdev->avg_decompresstime+= (tend - tstart);
+
+        return(0);
+    }
+
     // Should we just check for new image?
     if (checkForImage) {
         // Reset current dropped count to zero:
@@ -4802,51 +5269,65 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
 
     // This point is only reached if checkForImage == FALSE, which only happens
     // if a new frame is available in our buffer:
-    PsychLockMutex(&capdev->mutex);
-
-    //printf("PTB-DEBUG: Blocking fetch start %d\n", capdev->frameAvail);
-    if (!capdev->frameAvail) {
-        // No new frame available but grabber active. Perform a blocking wait:
-        if (capdev->grabber_active) PsychTimedWaitCondition(&capdev->condition, &capdev->mutex, 10.0);
-
-        // Recheck:
-        if (!capdev->frameAvail) {
-            // Game over! Wait timed out after 10 secs.
-            PsychUnlockMutex(&capdev->mutex);
+    if (capdev->queueActive) {
+        // Frame queue in use: Get the oldest queued frame, already mapped by the streaming thread.
+        // It stays in the queue until we are done with it:
+        if ((PsychCaptureQueueDepth(capdev) == 0) && !PsychCaptureQueueWait(capdev, 10.0)) {
             if (PsychPrefStateGet_Verbosity()>4) printf("PTB-DEBUG: No new video frame received after timeout of 10 seconds! Something's wrong. Aborting fetch.\n");
             return(-1);
         }
 
-        // At this point we should have at least one frame available.
+        queueEntry = PsychCaptureQueuePeek(capdev);
+        videoSample = queueEntry->sample;
+        mapinfo = queueEntry->mapinfo;
     }
+    else {
+        PsychLockMutex(&capdev->mutex);
 
-    // We're here with at least one frame available and the mutex lock held.
-    if (PsychPrefStateGet_Verbosity()>6) printf("PTB-DEBUG: Pulling from videosink, %d buffers avail...\n", capdev->frameAvail);
+        //printf("PTB-DEBUG: Blocking fetch start %d\n", capdev->frameAvail);
+        if (!capdev->frameAvail) {
+            // No new frame available but grabber active. Perform a blocking wait:
+            if (capdev->grabber_active) PsychTimedWaitCondition(&capdev->condition, &capdev->mutex, 10.0);
 
-    // One less frame available after our fetch:
-    capdev->frameAvail--;
+            // Recheck:
+            if (!capdev->frameAvail) {
+                // Game over! Wait timed out after 10 secs.
+                PsychUnlockMutex(&capdev->mutex);
+                if (PsychPrefStateGet_Verbosity()>4) printf("PTB-DEBUG: No new video frame received after timeout of 10 seconds! Something's wrong. Aborting fetch.\n");
+                return(-1);
+            }
 
-    // Clamp frameAvail to queue lengths, unless queue length is set to zero, which means "unlimited":
-    if ((int) gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink)) < capdev->frameAvail) {
-        if (gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink)) > 0) {
-            capdev->frameAvail = gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink));
+            // At this point we should have at least one frame available.
         }
-    }
-    if (PsychPrefStateGet_Verbosity()>6) printf("PTB-DEBUG: Post-Pulling from videosink, %d buffers avail...\n", capdev->frameAvail);
 
-    // This will pull the oldest video buffer from the videosink. It would block if none were available,
-    // but that won't happen as we wouldn't reach this statement if none were available. It would return
-    // NULL if the stream would be EOS or the pipeline off, but that shouldn't ever happen:
-    videoSample = gst_app_sink_pull_sample(GST_APP_SINK(capdev->videosink));
+        // We're here with at least one frame available and the mutex lock held.
+        if (PsychPrefStateGet_Verbosity()>6) printf("PTB-DEBUG: Pulling from videosink, %d buffers avail...\n", capdev->frameAvail);
 
-    // We can unlock early, thanks to videosink's internal buffering:
-    PsychUnlockMutex(&capdev->mutex);
+        // One less frame available after our fetch:
+        capdev->frameAvail--;
+
+        // Clamp frameAvail to queue lengths, unless queue length is set to zero, which means "unlimited":
+        if ((int) gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink)) < capdev->frameAvail) {
+            if (gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink)) > 0) {
+                capdev->frameAvail = gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink));
+            }
+        }
+        if (PsychPrefStateGet_Verbosity()>6) printf("PTB-DEBUG: Post-Pulling from videosink, %d buffers avail...\n", capdev->frameAvail);
+
+        // This will pull the oldest video buffer from the videosink. It would block if none were available,
+        // but that won't happen as we wouldn't reach this statement if none were available. It would return
+        // NULL if the stream would be EOS or the pipeline off, but that shouldn't ever happen:
+        videoSample = gst_app_sink_pull_sample(GST_APP_SINK(capdev->videosink));
+
+        // We can unlock early, thanks to videosink's internal buffering:
+        PsychUnlockMutex(&capdev->mutex);
+    }
 
     if (videoSample) {
         videoBuffer = gst_sample_get_buffer(videoSample);
 
-        // Map the buffers memory for reading:
-        if (!gst_buffer_map(videoBuffer, &mapinfo, GST_MAP_READ)) {
+        // Map the buffers memory for reading, unless the streaming thread did this already for a queued frame:
+        if (!queueEntry && !gst_buffer_map(videoBuffer, &mapinfo, GST_MAP_READ)) {
             printf("PTB-ERROR: Failed to map video data of captured video frame! Something's wrong. Aborting fetch.\n");
             gst_buffer_unref(videoBuffer);
             videoBuffer = NULL;
@@ -4858,19 +5339,7 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         input_image = (unsigned char*) (GLuint*) mapinfo.data;
 
         // Assign pts presentation timestamp in pipeline stream time and convert to seconds:
-        if (capdev->recordingflags & 64) {
-            // Retrieve raw buffer timestamp - pipeline running time.
-            capdev->current_pts = (double) GST_BUFFER_PTS(videoBuffer) / (double) 1e9;
-        } else {
-            // Add base time to convert running time buffer timestamp into absolute time:
-            baseTime = gst_element_get_base_time(capdev->camera);
-            if (baseTime == 0) baseTime = capdev->lastSavedBaseTime;
-
-            capdev->current_pts = (double) (GST_BUFFER_PTS(videoBuffer) + baseTime) / (double) 1e9;
-
-            // Apply corrective offset for GStreamer clock base zero point:
-            capdev->current_pts+= gs_startupTime;
-        }
+        capdev->current_pts = PsychGSCaptureTimestamp(capdev, videoBuffer);
 
         deltaT = 0.0;
         if (GST_CLOCK_TIME_IS_VALID(GST_BUFFER_DURATION(videoBuffer)))
@@ -4908,6 +5377,11 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         input_image = (unsigned char*) capdev->scratchbuffer;
     }
 
+    // Crop, bin and convert on the cpu, so only the result needs to be uploaded or returned:
+    if (capdev->preprocActive && ((out_texture) || (summed_intensity) || (outrawbuffer))) {
+        input_image = PsychCapturePreprocessFrame(capdev, input_image);
+    }
+
     // Only setup if really a texture is requested (non-benchmarking mode):
     if (out_texture) {
         // Activate OpenGL context of target window:
@@ -4932,16 +5406,23 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         // Set default texture depth: Could be 8, 16, 24 or 32 bpp.
         out_texture->depth = capdev->reqpixeldepth * 8;
 
+        // Preprocessed frames are 8, 24 or 32 bpp:
+        if (capdev->preprocActive) out_texture->depth = channels * 8;
+
         // 4-channel textures are aligned on 4 Byte boundaries because texels are RGBA8. If they
         // have an even number of pixels (width) per row, they are even 8 Byte aligned. Otherwise
         // we play safe and assume no alignment, ie., 1 Byte alignment:
-        out_texture->textureByteAligned = (capdev->reqpixeldepth == 4) ? ((w % 2) ? 4 : 8) : 1;
+        out_texture->textureByteAligned = (channels == 4) ? ((w % 2) ? 4 : 8) : 1;
 
         // This will retrieve an OpenGL compatible pointer to the pixel data and assign it to our texmemptr:
         out_texture->textureMemory = (GLuint*) input_image;
 
+        // Size of the frame for optional upload via pixel buffer object. Only for unmodified frames:
+        uploadSize = (input_image == (unsigned char*) mapinfo.data) ? mapinfo.size : 0;
+        if (capdev->preprocActive) uploadSize = (size_t) w * h * channels;
+
         // Special case depths == 2, aka YCBCR texture?
-        if ((capdev->bitdepth <= 8) && (capdev->reqpixeldepth == 2) && (capdev->pixeldepth == 16) && (win->gfxcaps & kPsychGfxCapUYVYTexture)) {
+        if (!capdev->preprocActive && (capdev->bitdepth <= 8) && (capdev->reqpixeldepth == 2) && (capdev->pixeldepth == 16) && (win->gfxcaps & kPsychGfxCapUYVYTexture)) {
             // GPU supports UYVY textures and we get data in that YCbCr format. Tell
             // texture creation routine to use this optimized format:
             if (!glewIsSupported("GL_APPLE_ycbcr_422")) {
@@ -4969,7 +5450,7 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         }
 
         // YUV I420 planar pixel upload requested?
-        if ((capdev->bitdepth <= 8) && (capdev->reqpixeldepth == 2) && (capdev->pixeldepth == 12)) {
+        if (!capdev->preprocActive && (capdev->bitdepth <= 8) && (capdev->reqpixeldepth == 2) && (capdev->pixeldepth == 12)) {
             // We encode I420 planar data inside a 8 bit per pixel luminance texture of
             // 1.5x times the height of the video frame. First the "Y" luminance plane
             // is stored at full 1 sample per pixel resolution with 8 bits. Then a 0.25x
@@ -4995,7 +5476,7 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
             out_texture->textureByteAligned = 1;
 
             // Create planar "I420 inside L8" texture:
-            PsychCreateTexture(out_texture);
+            PsychCaptureCreateTexture(capdev, win, out_texture, uploadSize);
 
             // Restore rect and clientrect of texture to effective size of video frame:
             PsychMakeRect(out_texture->rect, 0, 0, w, h);
@@ -5069,7 +5550,7 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
 
             // Let PsychCreateTexture() do the rest of the job of creating, setting up and
             // filling an OpenGL texture with content:
-            PsychCreateTexture(out_texture);
+            PsychCaptureCreateTexture(capdev, win, out_texture, uploadSize);
 
             // Undo scaling:
             glPixelTransferi(GL_RED_SCALE, 1);
@@ -5079,7 +5560,7 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         else {
             // Simple case: Let PsychCreateTexture() do the rest of the job of creating, setting up and
             // filling an OpenGL texture with content:
-            PsychCreateTexture(out_texture);
+            PsychCaptureCreateTexture(capdev, win, out_texture, uploadSize);
         }
 
         // This NULL-out is not strictly needed (done already in PsychCreateTexture()), just for simpler code review:
@@ -5094,21 +5575,29 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
             PsychNormalizeTextureOrientation(out_texture);
         }
 
+        // Track latency from capture to texture ready, if timestamps are in GetSecs time:
+        if (!(capdev->recordingflags & 64)) {
+            PsychGetAdjustedPrecisionTimerSeconds(&tend);
+            capdev->latencySum += tend - capdev->current_pts;
+            if (tend - capdev->current_pts > capdev->latencyMax) capdev->latencyMax = tend - capdev->current_pts;
+            capdev->latencyCount++;
+        }
+
         // Ready to use the texture...
     }
 
     // Sum of pixel intensities requested? 8 bpc?
     if (summed_intensity && (capdev->bitdepth <= 8)) {
         pixptr = (unsigned char*) input_image;
-        count  = w * h * ((capdev->reqpixeldepth !=2) ? capdev->reqpixeldepth : 1);
+        count  = w * h * channels;
         for (i=0; i<count; i++) intensity+=(psych_uint64) pixptr[i];
-        *summed_intensity = ((double) intensity) / w / h / capdev->reqpixeldepth / 255;
+        *summed_intensity = ((double) intensity) / w / h / ((capdev->preprocActive) ? channels : capdev->reqpixeldepth) / 255;
     }
 
     // Sum of pixel intensities requested? 16 bpc?
     if (summed_intensity && (capdev->bitdepth > 8)) {
         pixptrs = (psych_uint16*) input_image;
-        count = w * h * ((capdev->reqpixeldepth !=2) ? capdev->reqpixeldepth : 1);
+        count = w * h * channels;
         for (i=0; i<count; i++) intensity+=(psych_uint64) pixptrs[i];
         *summed_intensity = ((double) intensity) / w / h / capdev->reqpixeldepth / ((1 << (capdev->bitdepth)) - 1);
     }
@@ -5118,7 +5607,7 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         // Copy it out:
         outrawbuffer->w = w;
         outrawbuffer->h = h;
-        outrawbuffer->depth = (capdev->reqpixeldepth !=2) ? capdev->reqpixeldepth : 1;
+        outrawbuffer->depth = channels;
         outrawbuffer->bitdepth = (capdev->bitdepth > 8) ? 16 : 8;
         count = (w * h * outrawbuffer->depth * (outrawbuffer->bitdepth / 8));
         // Either 8 bpc or 16 bpc data - A simple memcpy does the job efficiently:
@@ -5126,8 +5615,13 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
     }
 
     // Release the capture buffer. Return it to the DMA ringbuffer pool:
-    gst_buffer_unmap(videoBuffer, &mapinfo);
-    gst_sample_unref(videoSample);
+    if (queueEntry) {
+        PsychCaptureQueuePop(capdev);
+    }
+    else {
+        gst_buffer_unmap(videoBuffer, &mapinfo);
+        gst_sample_unref(videoSample);
+    }
     videoBuffer = NULL;
 
     // Update total count of dropped (or pending) frames:
@@ -5148,6 +5642,67 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
     return(nrdropped);
 }
 
+/*
+ *  PsychGSAlignCaptureGroup() -- Pair queued frames of a group of capture devices by capture timestamp.
+ *
+ *  Drops queued frames until the oldest queued frames of all devices in 'capturehandles' have capture
+ *  timestamps within 'tolerance' seconds of each other. These frames form a synchronized frame set, which
+ *  the following calls to PsychGSGetTextureFromCapture() for each of the devices will return.
+ *
+ *  waitForSet = 1 == Wait for frames to arrive, 0 == Just poll.
+ *  Returns Number of dropped frames (>= 0) if a frame set is ready, -1 if no frame set is available yet,
+ *  -2 if none will become available because capture is stopped on at least one device.
+ */
+int PsychGSAlignCaptureGroup(int numDevices, int* capturehandles, int waitForSet, double tolerance)
+{
+    PsychVidcapRecordType *capdev;
+    PsychCaptureQueueEntry *entry;
+    double t, tmax;
+    int i, changed, dropped = 0;
+
+    for (i = 0; i < numDevices; i++) {
+        capdev = PsychGetGSVidcapRecord(capturehandles[i]);
+        if (!capdev->queueActive || (capdev->nrVideoTracks == 0))
+            PsychErrorExitMsg(PsychError_user, "Frame sets can only be fetched from video devices with a 'SyncMode' setting or with 'recordingflags' 16384!");
+    }
+
+    do {
+        // Find the latest timestamp among the oldest queued frames of all devices:
+        tmax = -DBL_MAX;
+        for (i = 0; i < numDevices; i++) {
+            capdev = PsychGetGSVidcapRecord(capturehandles[i]);
+            PsychGSProcessVideoContext(capdev, FALSE);
+
+            if (PsychCaptureQueueDepth(capdev) == 0) {
+                // Capture stopped. We'll never get a new frame set:
+                if (!capdev->grabber_active) return(-2);
+
+                // No blocking wait requested, or wait timed out?
+                if (!waitForSet || !PsychCaptureQueueWait(capdev, 10.0)) return(-1);
+            }
+
+            entry = PsychCaptureQueuePeek(capdev);
+            t = PsychGSCaptureTimestamp(capdev, gst_sample_get_buffer(entry->sample));
+            if (t > tmax) tmax = t;
+        }
+
+        // Drop frames which are too old to pair with that frame, then retry:
+        changed = 0;
+        for (i = 0; i < numDevices; i++) {
+            capdev = PsychGetGSVidcapRecord(capturehandles[i]);
+            entry = PsychCaptureQueuePeek(capdev);
+            if (PsychGSCaptureTimestamp(capdev, gst_sample_get_buffer(entry->sample)) < tmax - tolerance) {
+                PsychCaptureQueuePop(capdev);
+                capdev->nr_droppedframes++;
+                dropped++;
+                changed = 1;
+            }
+        }
+    } while (changed);
+
+    return(dropped);
+}
+
 /* Set capture device specific parameters:
  * Currently, the named parameters are a subset of the parameters supported by the
  * IIDC specification, mapped to more convenient names.
@@ -5241,6 +5796,117 @@ double PsychGSVideoCaptureSetParameter(int capturehandle, const char* pname, dou
     }
 
     // Check parameter name pname and call the appropriate subroutine:
+    // Get/Set synchronization mode for multi-camera operation:
+    if (strcmp(pname, "SyncMode")==0) {
+        oldvalue = capdev->syncmode;
+        if (value != DBL_MAX) {
+            if (capdev->grabber_active)
+                PsychErrorExitMsg(PsychError_user, "Tried to change 'SyncMode' while capture is active! Stop capture first.");
+
+            if (intval != 0) {
+                if ((intval & kPsychIsSyncMaster) && (intval & kPsychIsSyncSlave)) {
+                    PsychErrorExitMsg(PsychError_user, "Invalid syncmode provided: Camera can't be master and slave at the same time!");
+                }
+
+                if (!(intval & kPsychIsSyncMaster) && !(intval & kPsychIsSyncSlave)) {
+                    PsychErrorExitMsg(PsychError_user, "Invalid syncmode provided: Camera must be either master or slave. Can't be none of both!");
+                }
+
+                if (intval & (kPsychIsBusSynced | kPsychIsHwSynced)) {
+                    if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Bus-sync and hw-sync are not supported by the GStreamer engine. Using soft-sync on device %i.\n", capturehandle);
+                }
+
+                intval = (intval & (kPsychIsSyncMaster | kPsychIsSyncSlave)) | kPsychIsSoftSynced;
+
+                // Frames of a capture group get paired via the frame queue. Enable it, after draining any
+                // frames left in the videosink from the old mode:
+                if (!capdev->queueActive && !(capdev->recordingflags & 4)) {
+                    PsychGSDrainBufferQueue(capdev, INT_MAX, 0);
+                    capdev->queueLimit = PsychCaptureQueueDefaultLimit(capdev);
+                    capdev->queueActive = 1;
+                }
+            }
+
+            capdev->syncmode = intval;
+        }
+
+        return(oldvalue);
+    }
+
+    // Get/Set id of capture group for synchronized multi-camera operation:
+    if (strcmp(pname, "SyncGroup")==0) {
+        oldvalue = capdev->syncGroup;
+        if (value != DBL_MAX) {
+            if (capdev->grabber_active)
+                PsychErrorExitMsg(PsychError_user, "Tried to change 'SyncGroup' while capture is active! Stop capture first.");
+
+            capdev->syncGroup = intval;
+        }
+
+        return(oldvalue);
+    }
+
+    if (strstr(pname, "SetPreprocessing=")) {
+        int roi[4], binning = 1, luminance = 0, n;
+
+        if (capdev->grabber_active)
+            PsychErrorExitMsg(PsychError_user, "Tried to change preprocessing settings while capture is active! Stop capture first.");
+
+        pname = strstr((char*) pname, "=");
+        pname++;
+
+        // Empty spec disables preprocessing:
+        n = sscanf(pname, "%i,%i,%i,%i,%i,%i", &roi[0], &roi[1], &roi[2], &roi[3], &binning, &luminance);
+        if (n <= 0) {
+            capdev->preprocActive = 0;
+            if (PsychPrefStateGet_Verbosity() > 2) printf("PTB-INFO: Preprocessing of video frames disabled on device %i.\n", capturehandle);
+            return(0);
+        }
+
+        if (n < 4)
+            PsychErrorExitMsg(PsychError_user, "Invalid 'SetPreprocessing=' spec. Must be 'SetPreprocessing=x,y,w,h[,binning][,luminance]'!");
+
+        if ((binning != 1) && (binning != 2) && (binning != 4))
+            PsychErrorExitMsg(PsychError_user, "Invalid binning factor in 'SetPreprocessing='. Must be 1, 2 or 4!");
+
+        if ((roi[0] < 0) || (roi[1] < 0) || (roi[2] < binning) || (roi[3] < binning) ||
+            (roi[0] + roi[2] > capdev->frame_width) || (roi[1] + roi[3] > capdev->frame_height))
+            PsychErrorExitMsg(PsychError_user, "Invalid region of interest in 'SetPreprocessing='. Must be non-empty and inside the video frame!");
+
+        if ((capdev->bitdepth > 8) || ((capdev->reqpixeldepth == 2) && (capdev->pixeldepth != 12) && (capdev->pixeldepth != 16)))
+            PsychErrorExitMsg(PsychError_user, "Preprocessing via 'SetPreprocessing=' is only supported for 8 bpc luminance, RGB, RGBA or YCbCr video frames!");
+
+        capdev->preprocRoi[0] = roi[0];
+        capdev->preprocRoi[1] = roi[1];
+        capdev->preprocRoi[2] = roi[2];
+        capdev->preprocRoi[3] = roi[3];
+        capdev->preprocBinning = binning;
+        capdev->preprocLuminance = luminance;
+        capdev->preprocWidth = roi[2] / binning;
+        capdev->preprocHeight = roi[3] / binning;
+
+        // YCbCr frames always get reduced to their luminance channel:
+        capdev->preprocChannels = (luminance || (capdev->reqpixeldepth == 2)) ? 1 : capdev->reqpixeldepth;
+
+        free(capdev->preprocBuffer);
+        capdev->preprocBuffer = (unsigned char*) malloc((size_t) capdev->preprocWidth * capdev->preprocHeight * capdev->preprocChannels);
+        if (NULL == capdev->preprocBuffer) {
+            capdev->preprocActive = 0;
+            PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while trying to allocate buffer for preprocessing of video frames!");
+        }
+
+        capdev->preprocActive = 1;
+        capdev->preprocTime = 0;
+        capdev->preprocFrames = 0;
+
+        if (PsychPrefStateGet_Verbosity() > 2) {
+            printf("PTB-INFO: Preprocessing video frames on device %i: ROI %i x %i at (%i, %i), binning %i x %i, returned images %i x %i pixels with %i channels.\n",
+                   capturehandle, roi[2], roi[3], roi[0], roi[1], binning, binning, capdev->preprocWidth, capdev->preprocHeight, capdev->preprocChannels);
+        }
+
+        return(0);
+    }
+
     if (strcmp(pname, "TriggerCount")==0 || strcmp(pname, "WaitTriggerCount")==0) {
         // Query of cameras internal trigger counter or waiting for a specific
         // value in the counter requested. Trigger counters are special features,
@@ -5384,6 +6050,29 @@ double PsychGSVideoCaptureSetParameter(int capturehandle, const char* pname, dou
         return(0);
     }
 
+    // Return statistics of the frame queue and capture latency:
+    if (strcmp(pname, "GetQueueStats")==0) {
+        double *stats;
+        PsychAllocOutDoubleMatArg(1, FALSE, 1, 5, 1, &stats);
+        stats[0] = (capdev->queueActive) ? (double) PsychCaptureQueueDepth(capdev) : (double) capdev->frameAvail;
+        stats[1] = (double) capdev->queueMaxDepth;
+        stats[2] = (double) g_atomic_int_get(&capdev->queueDrops);
+        stats[3] = (capdev->latencyCount > 0) ? capdev->latencySum / capdev->latencyCount : 0;
+        stats[4] = capdev->latencyMax;
+        return(0);
+    }
+
+    // Return statistics of the preprocessing stage:
+    if (strcmp(pname, "GetPreprocessingStats")==0) {
+        double *stats;
+        PsychAllocOutDoubleMatArg(1, FALSE, 1, 3, 1, &stats);
+        stats[0] = (capdev->preprocActive) ? (double) capdev->preprocWidth * capdev->preprocHeight * capdev->preprocChannels :
+                                             (double) capdev->frame_width * capdev->frame_height * ((capdev->reqpixeldepth != 2) ? capdev->reqpixeldepth : 1) * ((capdev->bitdepth > 8) ? 2 : 1);
+        stats[1] = (capdev->preprocFrames > 0) ? capdev->preprocTime / capdev->preprocFrames : 0;
+        stats[2] = (double) capdev->preprocFrames;
+        return(0);
+    }
+
     // Return current ROI of camera, as requested (and potentially modified during
     // PsychOpenCaptureDevice(). This is a read-only parameter, as the ROI can
     // only be set during Screen('OpenVideoCapture').
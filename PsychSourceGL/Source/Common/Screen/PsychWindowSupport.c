@@ -113,6 +113,28 @@ static PsychWindowRecordType *splashTextureRecord = NULL;
 /* Flag which defines if userspace rendering is active: */
 static psych_bool inGLUserspace = FALSE;
 
+/* Onscreen window into which a Screen('CommandList') command list is recorded, or NULL if none: */
+static PsychWindowRecordType *commandListRecordingWindow = NULL;
+
+/* A recording consists of one or more segments, each one an OpenGL display list. A new segment is
+ * started whenever the recording was suspended to execute OpenGL commands which must not be recorded,
+ * e.g., uploads of new glyphs into the glyph textures of the text renderer: */
+static GLuint *commandListSegments = NULL;
+static int commandListNumSegments = 0;
+static int commandListMaxSegments = 0;
+static psych_bool commandListRecordingSuspended = FALSE;
+
+/* Finished command lists which consist of multiple segments, so 'Delete' can delete their segments: */
+typedef struct PsychSegmentedCommandList {
+    PsychWindowRecordType   *windowRecord;
+    GLuint                  listHandle;
+    int                     numSegments;
+    GLuint                  *segments;
+} PsychSegmentedCommandList;
+
+static PsychSegmentedCommandList *segmentedCommandLists = NULL;
+static int numSegmentedCommandLists = 0;
+
 // We keep track of the current active rendertarget in order to
 // avoid needless state changes:
 static PsychWindowRecordType* currentRendertarget = NULL;
@@ -532,6 +554,10 @@ psych_bool PsychOpenOnscreenWindow(PsychScreenSettingsType *screenSettings, Psyc
     // Add all passed-in specialFlags to windows specialflags:
     (*windowRecord)->specialflags |= specialFlags;
 
+    // Nobody will ever see a splash screen on a headless window:
+    if ((specialFlags & kPsychHeadlessWindow) && (visual_debuglevel > 3))
+        visual_debuglevel = 3;
+
     // Add all passed-in VRR parameters to windowRecord:
     (*windowRecord)->vrrMode = vrrMode;
     (*windowRecord)->vrrStyleHint = vrrStyleHint;
@@ -1140,6 +1166,10 @@ psych_bool PsychOpenOnscreenWindow(PsychScreenSettingsType *screenSettings, Psyc
     // Get final synctest setting after GPU caps detection:
     skip_synctests = PsychPrefStateGet_SkipSyncTests();
 
+    // Headless windows don't have a display, so there is nothing to test or calibrate:
+    if ((*windowRecord)->specialflags & kPsychHeadlessWindow)
+        skip_synctests = 2;
+
     // For external display backends like Vulkan, we rely on that backend to deal with timing
     // and trouble, so only run time-reduced synctests, and skip various warnings if they should
     // fail, as this is strictly non of our business:
@@ -2258,6 +2288,11 @@ void PsychCloseWindow(PsychWindowRecordType *windowRecord)
         return;
     }
 
+    // Command list recording into this window active? Finalize and discard the
+    // incomplete list, so the GL context isn't left in list compile mode:
+    if (windowRecord == commandListRecordingWindow) PsychAbortCommandListRecording();
+    PsychReleaseCommandListSegments(windowRecord);
+
     // If our to-be-destroyed windowRecord is currently bound as drawing target,
     // e.g. as onscreen window or offscreen window, then we need to safe-reset
     // our drawing engine - Unbind its FBO (if any) and reset current target to
@@ -2319,6 +2354,15 @@ void PsychCloseWindow(PsychWindowRecordType *windowRecord)
             windowRecord->gpuRenderTimeQuery = 0;
         }
 
+        // Release frame profiler and its query objects, if any:
+        PsychProfilerShutdown(windowRecord);
+
+        // Release flip scheduler and its query objects, if any:
+        PsychFlipSchedulerShutdown(windowRecord);
+
+        // Release flip log, if any. The flipper thread is already gone:
+        PsychFlipLogShutdown(windowRecord);
+
         // Sync and idle the pipeline again:
         glFinish();
 
@@ -2749,6 +2793,13 @@ void PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord)
 
         // A value of 2 would mean its basically done, so nothing to do here.
         if (flipRequest->asyncstate == 1) {
+            // Drop all not yet started frames of a running deep flip queue, so we only wait for the current one:
+            if (flipRequest->queueActive) {
+                PsychLockMutex(&(flipRequest->performFlipLock));
+                flipRequest->queueWrite = flipRequest->queueDone;
+                PsychUnlockMutex(&(flipRequest->performFlipLock));
+            }
+
             // If no recursion and flipper thread not in error state it might be safe to try a normal shutdown:
             if (recursionlevel == 0 && flipRequest->flipperState < 4) {
                 // Operation in progress: Try to stop it the normal way...
@@ -2837,7 +2888,8 @@ void PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord)
         // At this point, the thread and all other async flip resources have been terminated and released.
     }
 
-    // Release struct:
+    // Release deep flip queue and struct:
+    free(flipRequest->queue);
     free(flipRequest);
     windowRecord->flipInfo = NULL;
 
@@ -2845,6 +2897,51 @@ void PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord)
     return;
 }
 
+/* PsychFlipperThreadPresentQueue() - Present the frames of the deep flip queue.
+ *
+ * Called by the flipper thread for an opmode 4 flip request, with the performFlipLock held.
+ * Draws the queued frames one after another into the system backbuffer and flips each at
+ * its requested flipwhen, until no more frames are pending. The lock is released while a
+ * frame is presented, so the masterthread can append frames or collect results meanwhile.
+ * Returns with the lock held and the results of the last presented frame in flipRequest.
+ */
+static void PsychFlipperThreadPresentQueue(PsychWindowRecordType *windowRecord, PsychFlipInfoStruct *flipRequest)
+{
+    PsychFlipQueueEntry *entry = NULL;
+    PsychFBO *frame;
+    char blitParams[] = "";
+
+    while ((int) (flipRequest->queueWrite - flipRequest->queueDone) > 0) {
+        // Masterthread won't touch this entry until we mark it done:
+        entry = &(flipRequest->queue[flipRequest->queueDone % kPsychMaxFlipQueueLength]);
+        PsychUnlockMutex(&(flipRequest->performFlipLock));
+
+        // Draw frame 1:1 to the top-left corner of the cleared backbuffer:
+        frame = &(entry->frame);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glEnable(frame->textarget);
+        glBindTexture(frame->textarget, frame->coltexid);
+        PsychBlitterIdentity(windowRecord, NULL, (void*) blitParams, TRUE, FALSE, &frame, NULL, NULL, NULL);
+        glBindTexture(frame->textarget, 0);
+        glDisable(frame->textarget);
+
+        // Execute synchronous flip of the frame:
+        entry->vbl_timestamp = PsychFlipWindowBuffers(windowRecord, 0, 0, 2, entry->flipwhen, &(entry->beamPosAtFlip), &(entry->miss_estimate), &(entry->time_at_flipend), &(entry->time_at_onset));
+
+        PsychLockMutex(&(flipRequest->performFlipLock));
+        flipRequest->queueDone++;
+    }
+
+    // Results of the last frame are the results of the whole async flip:
+    if (entry) {
+        flipRequest->vbl_timestamp = entry->vbl_timestamp;
+        flipRequest->time_at_onset = entry->time_at_onset;
+        flipRequest->time_at_flipend = entry->time_at_flipend;
+        flipRequest->miss_estimate = entry->miss_estimate;
+        flipRequest->beamPosAtFlip = entry->beamPosAtFlip;
+    }
+}
+
 /* PsychFlipperThreadMain() the "main()" routine of the asynchronous flip worker thread:
 *
 * This routine implements an infinite loop (well, infinite until cancellation at Screen('Close')
@@ -3019,8 +3116,14 @@ void* PsychFlipperThreadMain(void* windowRecordToCast)
 
             // Nothing more to do, the system backbuffer is bound, no FBO's are set at this point.
 
-            // Unpack struct and execute synchronous flip: Synchronous in our thread, asynchronous from Matlabs/Octaves perspective!
-            flipRequest->vbl_timestamp = PsychFlipWindowBuffers(windowRecord, flipRequest->multiflip, flipRequest->vbl_synclevel, flipRequest->dont_clear, flipRequest->flipwhen, &(flipRequest->beamPosAtFlip), &(flipRequest->miss_estimate), &(flipRequest->time_at_flipend), &(flipRequest->time_at_onset));
+            if (flipRequest->opmode == 4) {
+                // Deep flip queue: Present all queued frames back to back:
+                PsychFlipperThreadPresentQueue(windowRecord, flipRequest);
+            }
+            else {
+                // Unpack struct and execute synchronous flip: Synchronous in our thread, asynchronous from Matlabs/Octaves perspective!
+                flipRequest->vbl_timestamp = PsychFlipWindowBuffers(windowRecord, flipRequest->multiflip, flipRequest->vbl_synclevel, flipRequest->dont_clear, flipRequest->flipwhen, &(flipRequest->beamPosAtFlip), &(flipRequest->miss_estimate), &(flipRequest->time_at_flipend), &(flipRequest->time_at_onset));
+            }
 
             // Flip finished and struct filled with return arguments.
             // Set our state to 3 aka "flip operation finished, ready for new commands":
@@ -3415,7 +3518,8 @@ void* PsychFlipperThreadMain(void* windowRecordToCast)
  *    shall be returned, as well as the datastructures for thread/mutex/cond locking etc...
  *
  *    flipRequest->opmode can be one of:
- *    0 = Execute Synchronous flip, 1 = Start async flip, 2 = Finish async flip, 3 = Poll for finish of async flip.
+ *    0 = Execute Synchronous flip, 1 = Start async flip, 2 = Finish async flip, 3 = Poll for finish of async flip,
+ *    4 = Start async flip of all frames in the deep flip queue, see PsychFlipQueueFrames().
  *
  *    *   Synchronous flips are performed without changing the mutex lock flipRequest->performFlipLock. We check if
  *        there are not flip ops scheduled or executing for the window, then simply execute the flip and return its
@@ -3483,7 +3587,7 @@ psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord)
     }
 
     // Asynchronous flip mode, either request to trigger one or request to finalize one:
-    if ((flipRequest->opmode == 1) || ((flipRequest->opmode == 0) && ((windowRecord->stereomode == kPsychFrameSequentialStereo) || (windowRecord->vrrMode == kPsychVRROwnScheduled)))) {
+    if ((flipRequest->opmode == 1) || (flipRequest->opmode == 4) || ((flipRequest->opmode == 0) && ((windowRecord->stereomode == kPsychFrameSequentialStereo) || (windowRecord->vrrMode == kPsychVRROwnScheduled)))) {
         // Async flip start request, or a sync flip turned into an async flip due to kPsychFrameSequentialStereo or VRR with our own scheduler:
         if (flipRequest->asyncstate != 0) PsychErrorExitMsg(PsychError_internal, "Tried to invoke asynchronous flip while flip still in progress!");
 
@@ -3702,7 +3806,7 @@ psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord)
 
         // Done, unless this wasn't a real async flip. If this was a pseudo-sync-flip,
         // we fall through to finalization stage:
-        if (flipRequest->opmode == 1) {
+        if ((flipRequest->opmode == 1) || (flipRequest->opmode == 4)) {
             // Was an async-flip begin: We´re done:
             return(TRUE);
         }
@@ -3782,6 +3886,7 @@ psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord)
 
         // Set flip state to finished:
         flipRequest->asyncstate = 2;
+        flipRequest->queueActive = FALSE;
 
         // Decrement the asyncFlipOpsActive count:
         asyncFlipOpsActive--;
@@ -3817,6 +3922,14 @@ psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord)
         windowRecord->PipelineFlushDone = false;
         windowRecord->backBufferBackupDone = false;
 
+        // Finish this frame for the frame profiler, start user drawing phase of next frame. The flipper
+        // thread doesn't record profiling markers, so the swap phase of async flips ends here:
+        if (windowRecord->frameProfiler) {
+            PsychSetGLContext(windowRecord);
+            PsychProfilerPhaseEnd(windowRecord, kPsychProfilePhaseSwap);
+            PsychProfilerFrameBoundary(windowRecord);
+        }
+
         // Call hookchain with callbacks to be performed after successfull flip completion:
         PsychPipelineExecuteHook(windowRecord, kPsychScreenFlipImpliedOperations, NULL, NULL, FALSE, FALSE, NULL, NULL, NULL, NULL);
 
@@ -3830,6 +3943,212 @@ psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord)
     return(TRUE);
 }
 
+/* PsychFlipQueuePrepareFrame() - Setup deep flip queue entry 'frame' for texture 'textureRecord'.
+ *
+ * The flipper thread draws queued frames with a plain identity blit, so the texture must be in
+ * upright orientation, pixel-interleaved and exempt from residency management. If 'canNormalize'
+ * is TRUE, the texture gets converted into that format if needed, otherwise it gets rejected.
+ */
+static void PsychFlipQueuePrepareFrame(PsychWindowRecordType *textureRecord, psych_bool canNormalize, PsychFBO *frame)
+{
+    if (!PsychIsTexture(textureRecord))
+        PsychErrorExitMsg(PsychError_user, "Only textures or offscreen windows can be queued as frames in a deep flip queue.");
+
+    if (textureRecord->multiSample > 0)
+        PsychErrorExitMsg(PsychError_user, "Multisampled offscreen windows can not be queued as frames in a deep flip queue.");
+
+    if ((textureRecord->textureOrientation != 2) || (textureRecord->specialflags & (kPsychPlanarTexture | kPsychTextureResidencyManaged)) ||
+        (textureRecord->textureNumber == 0)) {
+        if (!canNormalize)
+            PsychErrorExitMsg(PsychError_user, "Textures appended to a running deep flip queue must already have been queued once before, or been "
+                              "created in upright orientation, e.g., via Screen('MakeTexture', ..., textureOrientation=1).");
+
+        // Convert into upright orientation and pin it in VRAM:
+        PsychNormalizeTextureOrientation(textureRecord);
+    }
+
+    memset(frame, 0, sizeof(PsychFBO));
+    frame->coltexid = textureRecord->textureNumber;
+    frame->textarget = PsychGetTextureTarget(textureRecord);
+    frame->width = (int) PsychGetWidthFromRect(textureRecord->rect);
+    frame->height = (int) PsychGetHeightFromRect(textureRecord->rect);
+}
+
+/* PsychFlipQueueFinalizeAsyncFlip() - Wait for a pending async flip or deep flip queue to finish and finalize it.
+ *
+ * Does the same post-flip work as Screen('AsyncFlipEnd') on the masterthread, ie. prepares the window
+ * for userspace drawing and resets the flipwhen of the finished flip.
+ */
+static void PsychFlipQueueFinalizeAsyncFlip(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipInfoStruct* flipRequest = windowRecord->flipInfo;
+
+    // Blocking wait until the flip or all queued frames are presented, then finalize:
+    flipRequest->opmode = 2;
+    if (PsychFlipWindowBuffersIndirect(windowRecord)) flipRequest->asyncstate = 0;
+
+    // Execute hook chain for preparation of user space drawing ops:
+    PsychPipelineExecuteHook(windowRecord, kPsychUserspaceBufferDrawingPrepare, NULL, NULL, FALSE, FALSE, NULL, NULL, NULL, NULL);
+
+    // Reset flipwhen to "not assigned":
+    flipRequest->flipwhen = -DBL_MAX;
+}
+
+/* PsychFlipQueueFrames() - Append frames to the deep flip queue of an onscreen window.
+ *
+ * Appends 'count' textures 'textures', to be presented at times 'whens', to the deep flip queue
+ * of onscreen window 'windowRecord', and starts presentation by the flipper thread, unless it is
+ * already running. 'whens' has the same meaning as 'flipwhen' for PsychFlipWindowBuffers().
+ *
+ * Presentation of the whole queue is one opmode 4 async flip, which ends when the queue runs
+ * empty. While it runs, the masterthread can append frames or collect results. A regular async
+ * flip in progress is finalized first.
+ *
+ * Returns the number of queued frames which are not yet presented.
+ */
+int PsychFlipQueueFrames(PsychWindowRecordType *windowRecord, int count, PsychWindowRecordType **textures, double *whens)
+{
+    PsychFlipInfoStruct* flipRequest = windowRecord->flipInfo;
+    PsychFlipQueueEntry* entry;
+    psych_bool running = FALSE;
+    int i, pending;
+
+    if (windowRecord->windowType != kPsychDoubleBufferOnscreen)
+        PsychErrorExitMsg(PsychError_user, "Deep flip queue requested for a window without backbuffers. Specify numberOfBuffers=2 in Screen('OpenWindow').");
+
+    if ((windowRecord->stereomode == kPsychFrameSequentialStereo) || (windowRecord->vrrMode == kPsychVRROwnScheduled) ||
+        (windowRecord->specialflags & (kPsychExternalDisplayMethod | kPsychDontUseFlipperThread)) ||
+        (PsychPrefStateGet_ConserveVRAM() & kPsychUseOldStyleAsyncFlips))
+        PsychErrorExitMsg(PsychError_user, "Deep flip queues are not supported with frame-sequential stereo, our own VRR scheduler, external display backends, old-style async flips, or if use of the flipper thread is forbidden.");
+
+    // Queued frames are blitted directly into the system backbuffer, bypassing the imaging pipeline, so
+    // they would neither end up in the virtual framebuffer, nor get converted for the output device:
+    if ((windowRecord->imagingMode & kPsychNeedFastBackingStore) || PsychIsHookChainOperational(windowRecord, kPsychFinalOutputFormattingBlit) ||
+        PsychIsHookChainOperational(windowRecord, kPsychFinalOutputFormattingBlit0) || PsychIsHookChainOperational(windowRecord, kPsychFinalOutputFormattingBlit1))
+        PsychErrorExitMsg(PsychError_user, "Deep flip queues are not supported on windows which use the imaging pipeline, e.g., via PsychImaging, or output formatting for special display devices.");
+
+    // Space left in queue for frames, even if none of the pending ones were presented yet?
+    if (flipRequest->queueWrite - flipRequest->queueRead + (unsigned int) count > kPsychMaxFlipQueueLength) {
+        printf("PTB-ERROR: Tried to queue %i frames, but only %i of %i slots in the deep flip queue are free.\n", count,
+               kPsychMaxFlipQueueLength - (int) (flipRequest->queueWrite - flipRequest->queueRead), kPsychMaxFlipQueueLength);
+        PsychErrorExitMsg(PsychError_user, "Deep flip queue full. Collect results of presented frames via Screen('AsyncFlipQueueResults') to free slots.");
+    }
+
+    // Lazy allocation of the queue:
+    if (NULL == flipRequest->queue) {
+        flipRequest->queue = (PsychFlipQueueEntry*) calloc(kPsychMaxFlipQueueLength, sizeof(PsychFlipQueueEntry));
+        if (NULL == flipRequest->queue) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory when trying to allocate deep flip queue!");
+    }
+
+    if ((flipRequest->asyncstate == 1) && flipRequest->queueActive) {
+        // Is the flipper thread still presenting frames?
+        PsychLockMutex(&(flipRequest->performFlipLock));
+        running = (flipRequest->flipperState != 3) ? TRUE : FALSE;
+        PsychUnlockMutex(&(flipRequest->performFlipLock));
+
+        if (running) {
+            // We can't touch the OpenGL context while the queue runs, so frames must be ready for use. The
+            // slots after queueWrite are not touched by the flipper thread:
+            for (i = 0; i < count; i++)
+                PsychFlipQueuePrepareFrame(textures[i], FALSE, &(flipRequest->queue[(flipRequest->queueWrite + i) % kPsychMaxFlipQueueLength].frame));
+
+            // Append to the queue, unless it ran empty meanwhile:
+            PsychLockMutex(&(flipRequest->performFlipLock));
+            running = (flipRequest->flipperState != 3) ? TRUE : FALSE;
+            if (running) {
+                for (i = 0; i < count; i++) {
+                    entry = &(flipRequest->queue[flipRequest->queueWrite % kPsychMaxFlipQueueLength]);
+                    entry->flipwhen = whens[i];
+                    flipRequest->queueWrite++;
+                }
+            }
+            pending = (int) (flipRequest->queueWrite - flipRequest->queueDone);
+            PsychUnlockMutex(&(flipRequest->performFlipLock));
+
+            if (running)
+                return(pending);
+        }
+    }
+
+    // Finalize async flip or drained queue, if any. This blocks until it is done:
+    if (flipRequest->asyncstate == 1)
+        PsychFlipQueueFinalizeAsyncFlip(windowRecord);
+
+    // Flipper thread is idle, so we can prepare the frames and fill the queue without locking:
+    for (i = 0; i < count; i++) {
+        entry = &(flipRequest->queue[flipRequest->queueWrite % kPsychMaxFlipQueueLength]);
+        PsychFlipQueuePrepareFrame(textures[i], TRUE, &(entry->frame));
+        entry->flipwhen = whens[i];
+        flipRequest->queueWrite++;
+    }
+
+    // Start presentation as one async flip. The framebuffer content is undefined afterwards, as with dontclear = 2:
+    flipRequest->opmode = 4;
+    flipRequest->dont_clear = 2;
+    flipRequest->flipwhen = whens[0];
+    flipRequest->multiflip = 0;
+    flipRequest->vbl_synclevel = 0;
+    flipRequest->vbl_timestamp = -1;
+    flipRequest->queueActive = TRUE;
+    PsychFlipWindowBuffersIndirect(windowRecord);
+
+    return(count);
+}
+
+/* PsychFlipQueueGetResults() - Collect results of presented frames of the deep flip queue.
+ *
+ * Copies results of up to 'maxCount' presented frames, which were not yet collected, into the column-major
+ * count x 5 matrix 'results', one row [vbl_timestamp, time_at_onset, time_at_flipend, miss_estimate, beamPosAtFlip]
+ * per frame.
+ * If 'results' is NULL, only returns the number of frames which could be collected. If 'waitForAll' is TRUE,
+ * waits until the queue is drained and finalizes it first. Returns the number of not yet presented frames in
+ * 'pending', and the number of collected frames.
+ */
+int PsychFlipQueueGetResults(PsychWindowRecordType *windowRecord, psych_bool waitForAll, int maxCount, double *results, int *pending)
+{
+    PsychFlipInfoStruct* flipRequest = windowRecord->flipInfo;
+    PsychFlipQueueEntry* entry;
+    psych_bool locked = FALSE;
+    int i, count;
+
+    *pending = 0;
+    if (NULL == flipRequest->queue)
+        return(0);
+
+    if ((flipRequest->asyncstate == 1) && flipRequest->queueActive) {
+        if (waitForAll) {
+            // Blocking wait until all frames are presented, then finalize:
+            PsychFlipQueueFinalizeAsyncFlip(windowRecord);
+        }
+        else {
+            // Flipper thread may be updating queueDone:
+            PsychLockMutex(&(flipRequest->performFlipLock));
+            locked = TRUE;
+        }
+    }
+
+    *pending = (int) (flipRequest->queueWrite - flipRequest->queueDone);
+    count = (int) (flipRequest->queueDone - flipRequest->queueRead);
+    if (locked) PsychUnlockMutex(&(flipRequest->performFlipLock));
+
+    if (count > maxCount) count = maxCount;
+    if (results == NULL)
+        return(count);
+
+    // Entries up to queueDone are not touched anymore by the flipper thread:
+    for (i = 0; i < count; i++) {
+        entry = &(flipRequest->queue[flipRequest->queueRead % kPsychMaxFlipQueueLength]);
+        results[i] = entry->vbl_timestamp;
+        results[i + count] = entry->time_at_onset;
+        results[i + 2 * count] = entry->time_at_flipend;
+        results[i + 3 * count] = entry->miss_estimate;
+        results[i + 4 * count] = (double) entry->beamPosAtFlip;
+        flipRequest->queueRead++;
+    }
+
+    return(count);
+}
+
 #if PSYCH_SYSTEM == PSYCH_WINDOWS
 #undef strerror
 #endif
@@ -3920,6 +4239,7 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
     unsigned int targetSwapFlags;
     double targetWhen;            // Target time for OS-Builtin swap scheduling.
     double tSwapComplete;        // Swap completion timestamp for OS-Builtin timestamping.
+    double requested_flipwhen = flipwhen;   // Original 'flipwhen' before any retargeting, for the flip log.
     psych_int64 swap_msc;        // Swap completion vblank count for OS-Builtin timestamping.
 
     int vbltimestampmode = PsychPrefStateGet_VBLTimestampingMode();
@@ -4000,6 +4320,12 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
         PsychSetDrawingTarget(NULL);
     }
 
+    // Headless window? Then there is no display to present to, no vsync to wait for, and no 'flipwhen' to
+    // wait for either, as we are generating stimuli as fast as possible. Skip all that, so the flip completes
+    // once rendering has finished, see timestamping below:
+    if (windowRecord->specialflags & kPsychHeadlessWindow)
+        windowRecord->specialflags |= (kPsychSkipSwapForFlipOnce | kPsychSkipWaitForFlipOnce);
+
     // Skip actual stimulus presentation to onscreen window this time?
     if (windowRecord->specialflags & kPsychSkipSwapForFlipOnce) {
         // Yes. So not wait-for-swapcompletion, timestamping, messing with vsync either:
@@ -4099,8 +4425,10 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
         must_wait = TRUE;
     }
     else {
-        // Need to sync the pipeline, if this special workaround is active to get good timing:
-        if ((PsychPrefStateGet_ConserveVRAM() & kPsychBusyWaitForVBLBeforeBufferSwapRequest) || (windowRecord->specialflags & kPsychBusyWaitForVBLBeforeBufferSwapRequest)) {
+        // Need to sync the pipeline, if this special workaround is active to get good timing. Not needed if
+        // there won't be any swap or wait, as the busy-wait before swap is skipped then:
+        if (((PsychPrefStateGet_ConserveVRAM() & kPsychBusyWaitForVBLBeforeBufferSwapRequest) || (windowRecord->specialflags & kPsychBusyWaitForVBLBeforeBufferSwapRequest)) &&
+            !(windowRecord->specialflags & (kPsychSkipSwapForFlipOnce | kPsychSkipWaitForFlipOnce))) {
             glFinish();
 
             // Pipeline flush done by glFinish(), avoid redundant pipeline flushes:
@@ -4134,6 +4462,9 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
         targetSwapFlags |= (windowRecord->targetFlipFieldType == 0) ? 1 : 2;
     }
 
+    // Retarget flip to next achievable video refresh if flip scheduler predicts a miss:
+    flipwhen = PsychFlipSchedulerThrottle(windowRecord, flipwhen, vbl_synclevel, multiflip);
+
     // Get reference time:
     PsychGetAdjustedPrecisionTimerSeconds(&tremaining);
     tprescheduleswap = tremaining;
@@ -4460,6 +4791,7 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
     // Store timestamp of swaprequest submission:
     windowRecord->time_at_swaprequest = time_at_swaprequest;
     windowRecord->time_post_swaprequest = time_post_swaprequest;
+    PsychFlipSchedulerSwapRequested(windowRecord, time_at_swaprequest, time_post_swaprequest);
 
     // Protect against multi-threading trouble if needed:
     if (!(windowRecord->specialflags & kPsychSkipSwapForFlipOnce))
@@ -5091,8 +5423,24 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
         *miss_estimate = 0;
         *beamPosAtFlip = -1;  // Ditto for beam position...
 
-        // Was internal timestamping suppressed?
-        if (windowRecord->specialflags & kPsychSkipTimestampingForFlipOnce) {
+        // Headless window, unless internal timestamping is suppressed?
+        if ((windowRecord->specialflags & kPsychHeadlessWindow) && !(windowRecord->specialflags & kPsychSkipTimestampingForFlipOnce)) {
+            // Headless: Wait for the gpu to finish rendering of the frame. The time of render
+            // completion is the best equivalent of a "stimulus onset" we can have:
+            glFinish();
+            PsychGetAdjustedPrecisionTimerSeconds(&time_at_vbl);
+            *time_at_onset = time_at_vbl;
+            windowRecord->time_at_last_vbl = time_at_vbl;
+            windowRecord->osbuiltin_swaptime = time_at_vbl;
+            windowRecord->beamposition_at_flip = -1;
+        }
+        else if (windowRecord->specialflags & kPsychSkipTimestampingForFlipOnce) {
+            // Headless window without timestamping: Don't wait for render completion, only submit the frame for
+            // rendering, so a multi-threaded software renderer like llvmpipe can rasterize it while we prepare
+            // the next frame:
+            if (windowRecord->specialflags & kPsychHeadlessWindow)
+                glFlush();
+
             // Latch potential values injected via Screen Hookfunction 'SetOneshotFlipResults':
             time_at_vbl = windowRecord->time_at_last_vbl;
             *time_at_onset = windowRecord->osbuiltin_swaptime;
@@ -5134,7 +5482,10 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
 
     // The remaining code will run asynchronously on the GPU again and prepares the back-buffer
     // for drawing of next stim.
+    PsychProfilerPhaseEnd(windowRecord, kPsychProfilePhaseSwap);
+    PsychProfilerPhaseBegin(windowRecord, kPsychProfilePhasePostFlip);
     PsychPostFlipOperations(windowRecord, dont_clear);
+    PsychProfilerPhaseEnd(windowRecord, kPsychProfilePhasePostFlip);
 
     // Special imaging mode active? in that case we need to restore drawing engine state to preflip state.
     if (windowRecord->imagingMode > 0) {
@@ -5160,6 +5511,9 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
         // This flags are altered and checked by SCREENDrawingFinished() and PsychPreFlipOperations() as well:
         windowRecord->PipelineFlushDone = false;
         windowRecord->backBufferBackupDone = false;
+
+        // Finish this frame for the frame profiler, start user drawing phase of next frame:
+        PsychProfilerFrameBoundary(windowRecord);
     }
 
     // If we disabled (upon request) VBL syncing, we have to reenable it here:
@@ -5204,6 +5558,9 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
     // We take a second timestamp here to mark the end of the Flip-routine and return it to "userspace"
     PsychGetAdjustedPrecisionTimerSeconds(time_at_flipend);
 
+    // Record results in the flip log, if enabled:
+    PsychFlipLogAppend(windowRecord, requested_flipwhen, time_at_vbl, *time_at_onset, *time_at_flipend, *miss_estimate, *beamPosAtFlip, time_at_swaprequest);
+
     // Done. Return high resolution system time in seconds when VBL happened.
     return(time_at_vbl);
 }
@@ -5793,6 +6150,15 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
     // We also reject any request not coming from the master thread:
     if (!PsychIsMasterThread()) return;
 
+    // Flipping while a command list is recorded would compile the post-processing into the list:
+    if (commandListRecordingWindow)
+        PsychErrorExitMsg(PsychError_user, "Tried to 'Flip' while Screen('CommandList') recording is active. Call Screen('CommandList', ..., 'End') first!");
+
+    // User drawing for this frame is finished, preflip operations start:
+    PsychProfilerPhaseEnd(windowRecord, kPsychProfilePhaseUserDrawing);
+    PsychProfilerPhaseBegin(windowRecord, kPsychProfilePhasePreFlip);
+    PsychFlipSchedulerPreFlipBegin(windowRecord);
+
     // Peform extensive checking for OpenGL errors, unless instructed not to do so:
     if (!(PsychPrefStateGet_ConserveVRAM() & kPsychAvoidCPUGPUSync)) {
         GLenum glerr;
@@ -5828,6 +6194,9 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
     // We stop processing here if window is a texture, aka offscreen window...
     if (windowRecord->windowType==kPsychTexture) return;
 
+    // Start a new frame for the per-frame statistics of the texture residency manager:
+    PsychTextureResidencyNewFrame();
+
     #if PSYCH_SYSTEM == PSYCH_WINDOWS
         // Enforce a one-shot GUI event queue dispatch via this dummy call to PsychGetMouseButtonState() to
         // make MS-Windows GUI event processing happy. Not strictly related to preflip operations, but couldn't
@@ -6329,6 +6698,11 @@ void PsychPreFlipOperations(PsychWindowRecordType *windowRecord, int clearmode)
     // unlucky name. It actually signals that all the preflip processing has been done, the old name is historical.
     windowRecord->backBufferBackupDone = true;
 
+    // Preflip operations done, the remaining time until swap completion is attributed to the swap:
+    PsychFlipSchedulerPreFlipEnd(windowRecord);
+    PsychProfilerPhaseEnd(windowRecord, kPsychProfilePhasePreFlip);
+    PsychProfilerPhaseBegin(windowRecord, kPsychProfilePhaseSwap);
+
     // End time measurement for any previously submitted rendering commands if a
     // GPU rendertime query was requested (See Screen('GetWindowInfo', ..); for infoType 5.
     if (windowRecord->gpuRenderTimeQuery) {
@@ -6678,6 +7052,13 @@ void PsychSetDrawingTarget(PsychWindowRecordType *windowRecord)
         return;
     }
 
+    // Only the window that is recorded into is allowed as drawing target during Screen('CommandList')
+    // recording, as framebuffer binding changes can not be compiled into a command list:
+    if (commandListRecordingWindow && (windowRecord != commandListRecordingWindow)) {
+        recursionLevel--;
+        PsychErrorExitMsg(PsychError_user, "Tried to draw into a different window than the one which is currently recorded into by Screen('CommandList', ..., 'Begin'). Call Screen('CommandList', ..., 'End') first!");
+    }
+
     if ((currentRendertarget == NULL) && (windowRecord == (PsychWindowRecordType *) 0x1)) {
         // Fast exit: No rendertarget set and save reset to "none" requested.
         // Nothing special to do, just revert to NULL case:
@@ -7192,6 +7573,187 @@ psych_bool PsychIsUserspaceRendering(void)
     return(inGLUserspace);
 }
 
+/* Start a new segment of the active Screen('CommandList') recording. Returns FALSE if out of display lists or memory. */
+static psych_bool PsychStartCommandListSegment(void)
+{
+    GLuint listHandle, *newSegments;
+
+    if (commandListNumSegments == commandListMaxSegments) {
+        newSegments = (GLuint*) realloc(commandListSegments, (commandListMaxSegments + 16) * sizeof(GLuint));
+        if (NULL == newSegments) return(FALSE);
+        commandListSegments = newSegments;
+        commandListMaxSegments += 16;
+    }
+
+    listHandle = glGenLists(1);
+    if (listHandle == 0) return(FALSE);
+
+    commandListSegments[commandListNumSegments++] = listHandle;
+
+    // Compile and execute, so the OpenGL state tracked lazily by Screen, e.g., bound shader,
+    // stays in sync with the recorded stream, and the first frame gets drawn as usual:
+    glNewList(listHandle, GL_COMPILE_AND_EXECUTE);
+
+    return(TRUE);
+}
+
+/* Start recording a Screen('CommandList') into onscreen window 'windowRecord', whose OpenGL context must be bound.
+ * Returns FALSE if out of display lists or memory.
+ */
+psych_bool PsychBeginCommandListRecording(PsychWindowRecordType *windowRecord)
+{
+    commandListNumSegments = 0;
+    commandListRecordingSuspended = FALSE;
+
+    if (!PsychStartCommandListSegment()) return(FALSE);
+
+    commandListRecordingWindow = windowRecord;
+
+    return(TRUE);
+}
+
+/* Finish the active Screen('CommandList') recording and return the handle of the recorded command list.
+ * If the recording consists of multiple segments, a new display list which calls all segments in order
+ * is returned, and its segments are registered for deletion by PsychDeleteCommandList().
+ */
+GLuint PsychEndCommandListRecording(void)
+{
+    PsychSegmentedCommandList *entry, *newLists;
+    GLuint listHandle;
+    int i;
+
+    if (commandListRecordingWindow == NULL) return(0);
+
+    PsychSetGLContext(commandListRecordingWindow);
+    if (!commandListRecordingSuspended) glEndList();
+    commandListRecordingSuspended = FALSE;
+
+    listHandle = commandListSegments[0];
+    if (commandListNumSegments > 1) {
+        listHandle = glGenLists(1);
+        newLists = (PsychSegmentedCommandList*) realloc(segmentedCommandLists, (numSegmentedCommandLists + 1) * sizeof(PsychSegmentedCommandList));
+        if (newLists) segmentedCommandLists = newLists;
+
+        if ((listHandle == 0) || (NULL == newLists)) {
+            if (listHandle) glDeleteLists(listHandle, 1);
+            for (i = 0; i < commandListNumSegments; i++) glDeleteLists(commandListSegments[i], 1);
+            commandListNumSegments = 0;
+            commandListRecordingWindow = NULL;
+            PsychErrorExitMsg(PsychError_outofMemory, "Failed to finalize the command list, out of display list handles or out of memory!");
+        }
+
+        glNewList(listHandle, GL_COMPILE);
+        for (i = 0; i < commandListNumSegments; i++) glCallList(commandListSegments[i]);
+        glEndList();
+
+        entry = &segmentedCommandLists[numSegmentedCommandLists++];
+        entry->windowRecord = commandListRecordingWindow;
+        entry->listHandle = listHandle;
+        entry->numSegments = commandListNumSegments;
+        entry->segments = (GLuint*) malloc(commandListNumSegments * sizeof(GLuint));
+        if (entry->segments) memcpy(entry->segments, commandListSegments, commandListNumSegments * sizeof(GLuint));
+    }
+
+    commandListNumSegments = 0;
+    commandListRecordingWindow = NULL;
+
+    return(listHandle);
+}
+
+/* Get window into which Screen('CommandList') currently records, NULL if recording is inactive. */
+PsychWindowRecordType* PsychGetCommandListRecordingWindow(void)
+{
+    return(commandListRecordingWindow);
+}
+
+/* Suspend the active Screen('CommandList') recording, so following OpenGL commands only get executed, but not
+ * recorded. Must be paired with PsychResumeCommandListRecording(). No-op if no recording is active.
+ */
+void PsychSuspendCommandListRecording(void)
+{
+    if ((commandListRecordingWindow == NULL) || commandListRecordingSuspended) return;
+
+    PsychSetGLContext(commandListRecordingWindow);
+    glEndList();
+    commandListRecordingSuspended = TRUE;
+}
+
+/* Resume a suspended Screen('CommandList') recording by starting a new segment. */
+void PsychResumeCommandListRecording(void)
+{
+    if ((commandListRecordingWindow == NULL) || !commandListRecordingSuspended) return;
+
+    PsychSetGLContext(commandListRecordingWindow);
+    commandListRecordingSuspended = FALSE;
+    if (!PsychStartCommandListSegment()) {
+        commandListRecordingSuspended = TRUE;
+        PsychAbortCommandListRecording();
+        PsychErrorExitMsg(PsychError_outofMemory, "Failed to continue the command list recording, out of display list handles or out of memory!");
+    }
+}
+
+/* Delete command list 'listHandle' of onscreen window 'windowRecord', including all its segments. */
+void PsychDeleteCommandList(PsychWindowRecordType *windowRecord, GLuint listHandle)
+{
+    int i, j;
+
+    PsychSetGLContext(windowRecord);
+    glDeleteLists(listHandle, 1);
+
+    for (i = 0; i < numSegmentedCommandLists; i++) {
+        if ((segmentedCommandLists[i].windowRecord == windowRecord) && (segmentedCommandLists[i].listHandle == listHandle)) {
+            if (segmentedCommandLists[i].segments) {
+                for (j = 0; j < segmentedCommandLists[i].numSegments; j++) glDeleteLists(segmentedCommandLists[i].segments[j], 1);
+                free(segmentedCommandLists[i].segments);
+            }
+
+            segmentedCommandLists[i] = segmentedCommandLists[--numSegmentedCommandLists];
+            break;
+        }
+    }
+}
+
+/* Release bookkeeping of the segments of all command lists of a to be closed window 'windowRecord'. The display
+ * lists themselves get destroyed with the OpenGL context of the window.
+ */
+void PsychReleaseCommandListSegments(PsychWindowRecordType *windowRecord)
+{
+    int i;
+
+    for (i = 0; i < numSegmentedCommandLists; i++) {
+        if (segmentedCommandLists[i].windowRecord == windowRecord) {
+            free(segmentedCommandLists[i].segments);
+            segmentedCommandLists[i--] = segmentedCommandLists[--numSegmentedCommandLists];
+        }
+    }
+
+    if (numSegmentedCommandLists == 0) {
+        free(segmentedCommandLists);
+        segmentedCommandLists = NULL;
+    }
+}
+
+/* Abort an active Screen('CommandList') recording, e.g., on window close or error cleanup.
+ * Ends list compile mode and deletes the incomplete list. No-op if no recording is active.
+ */
+void PsychAbortCommandListRecording(void)
+{
+    int i;
+
+    if (commandListRecordingWindow == NULL) return;
+
+    PsychSetGLContext(commandListRecordingWindow);
+    if (!commandListRecordingSuspended) glEndList();
+    for (i = 0; i < commandListNumSegments; i++) glDeleteLists(commandListSegments[i], 1);
+
+    if (PsychPrefStateGet_Verbosity() > 1)
+        printf("PTB-WARNING: Screen('CommandList') recording into window %i aborted. Discarded the incomplete command list.\n", commandListRecordingWindow->windowIndex);
+
+    commandListNumSegments = 0;
+    commandListRecordingSuspended = FALSE;
+    commandListRecordingWindow = NULL;
+}
+
 int PsychRessourceCheckAndReminder(psych_bool displayMessage) {
     int i,j = 0;
 
@@ -46,11 +46,21 @@ void    PsychSetupView(PsychWindowRecordType *windowRecord, psych_bool useRawFra
 void    PsychSetupClientRect(PsychWindowRecordType *windowRecord);
 void    PsychSetUserspaceGLFlag(psych_bool inuserspace);
 psych_bool PsychIsUserspaceRendering(void);
+psych_bool PsychBeginCommandListRecording(PsychWindowRecordType *windowRecord);
+GLuint  PsychEndCommandListRecording(void);
+PsychWindowRecordType* PsychGetCommandListRecordingWindow(void);
+void    PsychSuspendCommandListRecording(void);
+void    PsychResumeCommandListRecording(void);
+void    PsychDeleteCommandList(PsychWindowRecordType *windowRecord, GLuint listHandle);
+void    PsychReleaseCommandListSegments(PsychWindowRecordType *windowRecord);
+void    PsychAbortCommandListRecording(void);
 double  PsychGetWhiteValueFromWindow(PsychWindowRecordType *windowRecord);
 void    PsychSwitchFixedFunctionStereoDrawbuffer(PsychWindowRecordType *windowRecord);
 int     PsychRessourceCheckAndReminder(psych_bool displayMessage);
 psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord);
 void    PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord);
+int     PsychFlipQueueFrames(PsychWindowRecordType *windowRecord, int count, PsychWindowRecordType **textures, double *whens);
+int     PsychFlipQueueGetResults(PsychWindowRecordType *windowRecord, psych_bool waitForAll, int maxCount, double *results, int *pending);
 int     PsychSetShader(PsychWindowRecordType *windowRecord, int shader);
 void    PsychDetectAndAssignGfxCapabilities(PsychWindowRecordType *windowRecord);
 void    PsychExecuteBufferSwapPrefix(PsychWindowRecordType *windowRecord);
@@ -198,6 +198,8 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("AsyncFlipEnd", &SCREENFlip));
     PsychErrorExit(PsychRegister("AsyncFlipCheckEnd", &SCREENFlip));
     PsychErrorExit(PsychRegister("WaitUntilAsyncFlipCertain" , &SCREENWaitUntilAsyncFlipCertain));
+    PsychErrorExit(PsychRegister("AsyncFlipQueue", &SCREENAsyncFlipQueue));
+    PsychErrorExit(PsychRegister("AsyncFlipQueueResults", &SCREENAsyncFlipQueue));
     PsychErrorExit(PsychRegister("FillRect", &SCREENFillRect));
     PsychErrorExit(PsychRegister("GetImage", &SCREENGetImage));
     PsychErrorExit(PsychRegister("PutImage", &SCREENPutImage));
@@ -224,6 +226,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("TextFont", &SCREENTextFont));
     PsychErrorExit(PsychRegister("TextBounds", &SCREENTextBounds));
     PsychErrorExit(PsychRegister("DrawText", &SCREENDrawText));
+    PsychErrorExit(PsychRegister("DrawTexts", &SCREENDrawTexts));
     PsychErrorExit(PsychRegister("TextColor", &SCREENTextColor));
     PsychErrorExit(PsychRegister("Preference", &SCREENPreference));
     PsychErrorExit(PsychRegister("MakeTexture", &SCREENMakeTexture));
@@ -231,6 +234,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("FrameRect", &SCREENFrameRect));
     PsychErrorExit(PsychRegister("DrawLine", &SCREENDrawLine));
     PsychErrorExit(PsychRegister("FillPoly", &SCREENFillPoly));
+    PsychErrorExit(PsychRegister("FillPolys", &SCREENFillPolys));
     PsychErrorExit(PsychRegister("FramePoly", &SCREENFramePoly));
     PsychErrorExit(PsychRegister("GlobalRect", &SCREENGlobalRect));
     PsychErrorExit(PsychRegister("DrawDots", &SCREENDrawDots));
@@ -248,6 +252,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("CloseMovie", &SCREENCloseMovie));
     PsychErrorExit(PsychRegister("OpenMovie", &SCREENOpenMovie));
     PsychErrorExit(PsychRegister("PlayMovie", &SCREENPlayMovie));
+    PsychErrorExit(PsychRegister("PlayMovieGroup", &SCREENPlayMovieGroup));
     PsychErrorExit(PsychRegister("SetMovieTimeIndex", &SCREENSetMovieTimeIndex));
     PsychErrorExit(PsychRegister("GetMovieTimeIndex", &SCREENGetMovieTimeIndex));
     PsychErrorExit(PsychRegister("GetMovieImage", &SCREENGetMovieImage));
@@ -258,6 +263,8 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("glScale", &SCREENglScale));
     PsychErrorExit(PsychRegister("glRotate", &SCREENglRotate));
     PsychErrorExit(PsychRegister("PreloadTextures", &SCREENPreloadTextures));
+    PsychErrorExit(PsychRegister("TextureUploadStatus", &SCREENTextureUploadStatus));
+    PsychErrorExit(PsychRegister("CommandList", &SCREENCommandList));
     PsychErrorExit(PsychRegister("FillArc", &SCREENFillArc));
     PsychErrorExit(PsychRegister("DrawArc", &SCREENDrawArc));
     PsychErrorExit(PsychRegister("FrameArc", &SCREENFrameArc));
@@ -272,6 +279,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("StartVideoCapture", &SCREENStartVideoCapture));
     PsychErrorExit(PsychRegister("StopVideoCapture", &SCREENStopVideoCapture));
     PsychErrorExit(PsychRegister("GetCapturedImage", &SCREENGetCapturedImage));
+    PsychErrorExit(PsychRegister("GetCapturedImageSet", &SCREENGetCapturedImageSet));
     PsychErrorExit(PsychRegister("SetVideoCaptureParameter", &SCREENSetVideoCaptureParameter));
     PsychErrorExit(PsychRegister("VideoCaptureDevices", &SCREENVideoCaptureDevices));
     PsychErrorExit(PsychRegister("LoadCLUT", &SCREENLoadCLUT));
@@ -292,10 +300,13 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("AddFrameToMovie", &SCREENGetImage));
     PsychErrorExit(PsychRegister("AddAudioBufferToMovie", &SCREENAddAudioBufferToMovie));
     PsychErrorExit(PsychRegister("GetFlipInfo", &SCREENGetFlipInfo));
+    PsychErrorExit(PsychRegister("GetFlipDeadline", &SCREENGetFlipDeadline));
+    PsychErrorExit(PsychRegister("FlipLog", &SCREENFlipLog));
     PsychErrorExit(PsychRegister("PanelFitter", &SCREENPanelFitter));
     PsychErrorExit(PsychRegister("TextTransform", &SCREENTextTransform));
     PsychErrorExit(PsychRegister("ConstrainCursor", &SCREENConstrainCursor));
     PsychErrorExit(PsychRegister("ReadHDRImage", &SCREENReadHDRImage));
+    PsychErrorExit(PsychRegister("LinkGLSLProgram", &SCREENLinkGLSLProgram));
 
     PsychSetModuleAuthorByInitials("awi");
     PsychSetModuleAuthorByInitials("dhb");
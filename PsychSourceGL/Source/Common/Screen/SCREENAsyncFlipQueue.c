@@ -0,0 +1,153 @@
+/*
+ *    SCREENAsyncFlipQueue.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Implements Screen('AsyncFlipQueue') and Screen('AsyncFlipQueueResults'): Queue many
+ *    pre-rendered frames for back to back presentation by the async flipper thread, and
+ *    collect the flip timestamps of presented frames in bulk.
+ */
+
+#include "Screen.h"
+
+// If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
+static char useString1[] = "pending = Screen('AsyncFlipQueue', windowPtr, texturePtrs [, when=0]);";
+//                          1                                  1          2              3
+static char synopsisString1[] =
+"Queue pre-rendered frames for asynchronous presentation on onscreen window 'windowPtr'.\n\n"
+"'texturePtrs' is a vector of handles of textures or offscreen windows. Each one is presented as one frame, "
+"in the given order, by the background flipper thread which also executes Screen('AsyncFlipBegin'). "
+"'when' is either a single value or a vector with one value per texture, with the same meaning as the 'when' "
+"argument of Screen('Flip'): The default of zero presents each frame at the video refresh after the previous frame, "
+"a value > 0 presents the frame at the first video refresh after that time.\n"
+"Frames are drawn 1:1 to the top-left corner of the window, without any post-processing by the imaging pipeline. "
+"Therefore deep flip queues are not supported on windows which use the imaging pipeline, e.g., via PsychImaging, or "
+"output formatting for special display devices. The rest of the window is cleared to black. Textures are converted to upright orientation when queued and must not be "
+"closed before they have been presented. Textures appended while the queue is still presenting frames must already be "
+"upright, e.g., created via Screen('MakeTexture', ..., textureOrientation=1), offscreen windows, or have been queued "
+"before.\n"
+"Presenting the whole queue acts like one Screen('AsyncFlipBegin'), which finishes when the queue runs empty. While it "
+"runs, you can't draw into the onscreen window, but you can append more frames, up to a total of 4096 frames which are "
+"not yet presented or whose results were not yet collected. Screen('AsyncFlipEnd') waits until all frames are "
+"presented and returns the timestamps of the last frame. A regular async flip in progress is finished before the frames "
+"are queued. After the queue finished, the content of the framebuffer is undefined, as with a 'dontclear' setting of 2 "
+"for Screen('Flip').\n"
+"Returns the number of queued frames which are not yet presented.\n";
+
+static char useString2[] = "[timestamps, pending] = Screen('AsyncFlipQueueResults', windowPtr [, waitForAll=0] [, maxCount]);";
+//                          1           2                                          1             2                 3
+static char synopsisString2[] =
+"Collect the results of frames presented by the deep flip queue of onscreen window 'windowPtr'.\n\n"
+"Returns the results of all presented frames which were not yet collected, at most 'maxCount' frames, in the "
+"n-by-5 matrix 'timestamps'. Row i contains the results of the i'th collected frame, in the same order and with the "
+"same meaning as the return values of Screen('Flip'): [VBLTimestamp StimulusOnsetTime FlipTimestamp Missed Beampos]. "
+"Results are returned in the order in which frames were queued. "
+"'pending' is the number of queued frames which are not yet presented.\n"
+"'waitForAll' If set to 1, wait until all queued frames are presented and finish the queue as Screen('AsyncFlipEnd') "
+"would, before collecting results. The default of zero returns immediately with results of the frames presented so far.\n";
+
+static char seeAlsoString[] = "AsyncFlipBegin AsyncFlipEnd AsyncFlipCheckEnd Flip MakeTexture";
+
+PsychError SCREENAsyncFlipQueue(void)
+{
+    PsychWindowRecordType   *windowRecord;
+    PsychWindowRecordType   **textures;
+    int                     *texids;
+    int                     i, count, numWhens, m, n, p;
+    int                     pending, waitForAll, maxCount;
+    double                  *whens, *results;
+    double                  defaultWhen = 0;
+    double                  tNow;
+
+    if (PsychMatch(PsychGetFunctionName(), "AsyncFlipQueueResults")) {
+        // Collect results of presented frames:
+        PsychPushHelp(useString2, synopsisString2, seeAlsoString);
+        if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+        PsychErrorExit(PsychCapNumInputArgs(3));
+        PsychErrorExit(PsychRequireNumInputArgs(1));
+        PsychErrorExit(PsychCapNumOutputArgs(2));
+
+        PsychAllocInWindowRecordArg(kPsychUseDefaultArgPosition, TRUE, &windowRecord);
+        if (!PsychIsOnscreenWindow(windowRecord))
+            PsychErrorExitMsg(PsychError_user, "AsyncFlipQueueResults called on something else than an onscreen window.");
+
+        waitForAll = 0;
+        PsychCopyInIntegerArg(2, FALSE, &waitForAll);
+
+        maxCount = kPsychMaxFlipQueueLength;
+        PsychCopyInIntegerArg(3, FALSE, &maxCount);
+        if (maxCount < 0)
+            PsychErrorExitMsg(PsychError_user, "Invalid negative 'maxCount' specified.");
+
+        count = PsychFlipQueueGetResults(windowRecord, (waitForAll > 0) ? TRUE : FALSE, maxCount, NULL, &pending);
+        PsychAllocOutDoubleMatArg(1, FALSE, count, 5, 1, &results);
+        PsychFlipQueueGetResults(windowRecord, FALSE, count, results, &pending);
+        PsychCopyOutDoubleArg(2, FALSE, (double) pending);
+
+        return(PsychError_none);
+    }
+
+    // Queue frames:
+    PsychPushHelp(useString1, synopsisString1, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(3));
+    PsychErrorExit(PsychRequireNumInputArgs(2));
+    PsychErrorExit(PsychCapNumOutputArgs(1));
+
+    PsychAllocInWindowRecordArg(kPsychUseDefaultArgPosition, TRUE, &windowRecord);
+    if (!PsychIsOnscreenWindow(windowRecord))
+        PsychErrorExitMsg(PsychError_user, "AsyncFlipQueue called on something else than an onscreen window. You can only flip onscreen windows.");
+
+    PsychAllocInIntegerListArg(2, TRUE, &count, &texids);
+    if (count < 1)
+        PsychErrorExitMsg(PsychError_user, "AsyncFlipQueue called without any texture handles.");
+
+    whens = &defaultWhen;
+    numWhens = 1;
+    if (PsychAllocInDoubleMatArg(3, FALSE, &m, &n, &p, &whens)) {
+        numWhens = m * n * p;
+        if ((numWhens != 1) && (numWhens != count))
+            PsychErrorExitMsg(PsychError_user, "'when' must be a single value or a vector with one value per texture handle.");
+    }
+
+    // Validate inputs, as in Screen('Flip'):
+    PsychGetAdjustedPrecisionTimerSeconds(&tNow);
+    for (i = 0; i < numWhens; i++) {
+        if (whens[i] < 0)
+            PsychErrorExitMsg(PsychError_user, "Only 'when' values greater or equal to 0 are supported.");
+
+        if (whens[i] - tNow > 1000)
+            PsychErrorExitMsg(PsychError_user, "You specified a 'when' value that's over 1000 seconds in the future?!? Aborting, assuming that's an error.");
+    }
+
+    textures = (PsychWindowRecordType**) PsychMallocTemp(count * sizeof(PsychWindowRecordType*));
+    for (i = 0; i < count; i++) {
+        if (!IsWindowIndex((PsychWindowIndexType) texids[i]) || (PsychError_none != FindWindowRecord((PsychWindowIndexType) texids[i], &(textures[i])))) {
+            printf("PTB-ERROR: %i th entry in texture handle vector is not a valid handle!\n", i + 1);
+            PsychErrorExitMsg(PsychError_user, "Invalid texture handle provided to Screen('AsyncFlipQueue').");
+        }
+    }
+
+    // Expand single 'when' to all frames:
+    if (numWhens != count) {
+        defaultWhen = whens[0];
+        whens = (double*) PsychMallocTemp(count * sizeof(double));
+        for (i = 0; i < count; i++)
+            whens[i] = defaultWhen;
+    }
+
+    pending = PsychFlipQueueFrames(windowRecord, count, textures, whens);
+    PsychCopyOutDoubleArg(1, FALSE, (double) pending);
+
+    return(PsychError_none);
+}
@@ -77,6 +77,9 @@ void ScreenCloseAllWindows(void)
     // due to Screen('BeginOpenGL') command.
     PsychSetUserspaceGLFlag(FALSE);
 
+    // Abort a pending Screen('CommandList') recording:
+    PsychAbortCommandListRecording();
+
     // Check for stale texture ressources:
     PsychRessourceCheckAndReminder(TRUE);
 
@@ -0,0 +1,224 @@
+/*
+ *    SCREENCommandList.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Record the OpenGL command stream generated by a sequence of Screen drawing
+ *    commands into a command list (an OpenGL display list) and replay it later
+ *    with a single call, optionally with a different offset, scaling and GLSL
+ *    uniform values. This extends the internal display list blitter of the
+ *    imaging pipeline, see PsychBlitterDisplayList(), to regular Screen drawing.
+ */
+
+#include "Screen.h"
+
+// If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
+static char useString[] = "[ret1] = Screen('CommandList', windowPtr, 'Subcommand' [, arg1][, arg2] ...);";
+//                          1                             1          2             3       4
+static char synopsisString[] =
+"Record a sequence of Screen drawing commands into a command list and replay it later with a single call.\n\n"
+"Static, but complex frame content which consists of many 'FillRect', 'FrameOval', 'DrawTexture(s)', "
+"'DrawDots' etc. calls causes a significant cpu overhead for parsing all the arguments and setting up "
+"OpenGL state on each redraw. Recording the sequence once and replaying it on each frame avoids this "
+"overhead. The recorded list only stores the OpenGL commands generated by the drawing commands, so "
+"later changes of drawing parameters, e.g., color or position arguments, require a new recording.\n"
+"Command lists are only supported on the classic desktop OpenGL rendering api, not on OpenGL-ES or "
+"OpenGL core profile contexts.\n\n"
+"Subcommands:\n\n"
+"Screen('CommandList', windowPtr, 'Begin');\n"
+"Start recording into a new command list for onscreen window 'windowPtr'. All following Screen drawing "
+"commands into 'windowPtr' get executed as usual, but also recorded into the list. While recording is "
+"active, drawing into other windows, creating textures or calling Screen('Flip') is not allowed. Text "
+"drawing via 'DrawText(s)' can be recorded with the default high quality text renderer, as long as each "
+"drawn string fits into the glyph texture of its font. New glyphs get uploaded into that texture before "
+"they are recorded, and the recorded drawing commands only reference them. The legacy OS specific text "
+"renderers can't be used while recording. 'FillRect', 'FrameRect' and 'FillOval' draw many shapes via "
+"instanced drawing for speed, which can't be recorded, so they use their slower regular drawing path "
+"while recording. "
+"Textures used while recording must remain open until the list is deleted. If you use automatic texture "
+"memory management via Screen('Preference', 'TextureMemoryBudget'), make sure all textures are resident, "
+"e.g., via Screen('PreloadTextures'), before 'Begin'.\n\n"
+"listHandle = Screen('CommandList', windowPtr, 'End');\n"
+"Stop the recording and return a handle 'listHandle' to the new command list.\n\n"
+"Screen('CommandList', windowPtr, 'Execute', listHandle(s) [, offset=[0 0]][, scale=[1 1]][, glslProgram][, uniformName1, values1][, uniformName2, values2] ...);\n"
+"Replay the command list(s) 'listHandle(s)' into window 'windowPtr'. If 'listHandle(s)' is a vector of "
+"handles, all lists are replayed in the given order. 'offset' is an optional [x, y] pixel offset by which "
+"all drawing is translated, 'scale' an optional [sx, sy] scaling factor applied before the translation. "
+"If the handle of a GLSL program object 'glslProgram' is given, then the following optional pairs of "
+"'uniformName' strings and 'values' vectors with 1 to 4 components assign new values to the uniforms of "
+"that program before replaying, e.g., to change parameters of shaders used by the recorded drawing "
+"commands without the need for a new recording. OpenGL state changed by the replayed drawing commands, "
+"e.g., alpha blending settings, gets restored after replay.\n\n"
+"Screen('CommandList', windowPtr, 'Delete', listHandle(s));\n"
+"Delete the command list(s) 'listHandle(s)' and release their resources.\n";
+
+static char seeAlsoString[] = "BeginOpenGL EndOpenGL PreloadTextures";
+
+PsychError SCREENCommandList(void)
+{
+    PsychWindowRecordType   *windowRecord;
+    char                    *cmdString, *uniformName;
+    int                     cmd, i, n, m, p, arg, *listHandles;
+    double                  *offset, *scale, *values;
+    double                  glslProgram;
+    GLint                   listHandle, uniformLoc;
+
+    // All subfunctions should have these two lines.
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(20));
+    PsychErrorExit(PsychRequireNumInputArgs(2));
+    PsychErrorExit(PsychCapNumOutputArgs(1));
+
+    // Get the window record:
+    PsychAllocInWindowRecordArg(1, TRUE, &windowRecord);
+    if (!PsychIsOnscreenWindow(windowRecord))
+        PsychErrorExitMsg(PsychError_user, "Command lists can only be used with onscreen windows.");
+
+    if (!PsychIsGLClassic(windowRecord))
+        PsychErrorExitMsg(PsychError_user, "Command lists are not supported on this OpenGL rendering api. Only classic desktop OpenGL is supported.");
+
+    // Get the subcommand string:
+    PsychAllocInCharArg(2, kPsychArgRequired, &cmdString);
+
+    // Subcommand dispatcher:
+    cmd = 0;
+    if (strcmp(cmdString, "Begin") == 0)   cmd = 1;
+    if (strcmp(cmdString, "End") == 0)     cmd = 2;
+    if (strcmp(cmdString, "Execute") == 0) cmd = 3;
+    if (strcmp(cmdString, "Delete") == 0)  cmd = 4;
+
+    if (cmd == 0) PsychErrorExitMsg(PsychError_user, "Unknown subcommand specified to 'CommandList'.");
+
+    switch (cmd) {
+        case 1: // Begin:
+            if (PsychGetCommandListRecordingWindow())
+                PsychErrorExitMsg(PsychError_user, "Tried to 'Begin' a new command list while recording of another list is still active. Call 'End' first!");
+
+            if (PsychIsUserspaceRendering())
+                PsychErrorExitMsg(PsychError_user, "Tried to 'Begin' a command list after Screen('BeginOpenGL'), but without calling Screen('EndOpenGL') beforehand!");
+
+            // Setup a well defined initial state: Window is drawing target, standard fixed function
+            // pipeline active. 'Execute' restores the same state before replaying the list:
+            PsychSetDrawingTarget(windowRecord);
+            PsychSetShader(windowRecord, 0);
+
+            if (!PsychBeginCommandListRecording(windowRecord))
+                PsychErrorExitMsg(PsychError_outofMemory, "Failed to create a new command list, out of display list handles or out of memory!");
+            break;
+
+        case 2: // End:
+            if (PsychGetCommandListRecordingWindow() != windowRecord)
+                PsychErrorExitMsg(PsychError_user, "Tried to 'End' a command list recording, but no recording is active for this window!");
+
+            listHandle = (GLint) PsychEndCommandListRecording();
+            PsychTestForGLErrors();
+
+            PsychCopyOutDoubleArg(1, FALSE, (double) listHandle);
+            break;
+
+        case 3: // Execute:
+            if (PsychGetCommandListRecordingWindow())
+                PsychErrorExitMsg(PsychError_user, "Tried to 'Execute' a command list while recording is active. Nested command lists are not supported!");
+
+            PsychAllocInIntegerListArg(3, TRUE, &n, &listHandles);
+
+            PsychSetDrawingTarget(windowRecord);
+            for (i = 0; i < n; i++) {
+                if ((listHandles[i] <= 0) || !glIsList((GLuint) listHandles[i]))
+                    PsychErrorExitMsg(PsychError_user, "Invalid 'listHandle' provided. No such command list!");
+            }
+
+            offset = scale = NULL;
+            if (PsychAllocInDoubleMatArg(4, kPsychArgOptional, &m, &p, &arg, &offset) && (m * p * arg != 2))
+                PsychErrorExitMsg(PsychError_user, "Invalid 'offset' provided. Must be a [x, y] vector!");
+
+            if (PsychAllocInDoubleMatArg(5, kPsychArgOptional, &m, &p, &arg, &scale) && (m * p * arg != 2))
+                PsychErrorExitMsg(PsychError_user, "Invalid 'scale' provided. Must be a [sx, sy] vector!");
+
+            // Optional uniform overrides for a GLSL program:
+            if (PsychCopyInDoubleArg(6, kPsychArgOptional, &glslProgram)) {
+                if ((glslProgram <= 0) || !glIsProgram((GLuint) glslProgram))
+                    PsychErrorExitMsg(PsychError_user, "Invalid 'glslProgram' provided. Not a GLSL program handle!");
+
+                glUseProgram((GLuint) glslProgram);
+                for (arg = 7; arg <= PsychGetNumInputArgs(); arg += 2) {
+                    PsychAllocInCharArg(arg, kPsychArgRequired, &uniformName);
+                    PsychAllocInDoubleMatArg(arg + 1, kPsychArgRequired, &m, &p, &i, &values);
+
+                    uniformLoc = glGetUniformLocation((GLuint) glslProgram, uniformName);
+                    if (uniformLoc == -1) {
+                        if (PsychPrefStateGet_Verbosity() > 1)
+                            printf("PTB-WARNING: Screen('CommandList'): No active uniform '%s' in GLSL program %i. Ignored.\n", uniformName, (int) glslProgram);
+                        continue;
+                    }
+
+                    switch (m * p * i) {
+                        case 1:
+                            glUniform1f(uniformLoc, (GLfloat) values[0]);
+                            break;
+                        case 2:
+                            glUniform2f(uniformLoc, (GLfloat) values[0], (GLfloat) values[1]);
+                            break;
+                        case 3:
+                            glUniform3f(uniformLoc, (GLfloat) values[0], (GLfloat) values[1], (GLfloat) values[2]);
+                            break;
+                        case 4:
+                            glUniform4f(uniformLoc, (GLfloat) values[0], (GLfloat) values[1], (GLfloat) values[2], (GLfloat) values[3]);
+                            break;
+                        default:
+                            glUseProgram(0);
+                            PsychErrorExitMsg(PsychError_user, "Invalid uniform 'values' provided. Must be a vector with 1 to 4 components!");
+                    }
+                }
+            }
+
+            // Restore the state at start of recording, then replay with the requested transformation:
+            PsychSetShader(windowRecord, 0);
+
+            glPushAttrib(GL_ALL_ATTRIB_BITS);
+            glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
+            glPushMatrix();
+            if (offset) glTranslatef((float) offset[0], (float) offset[1], 0);
+            if (scale) glScalef((float) scale[0], (float) scale[1], 1);
+
+            for (i = 0; i < n; i++) glCallList((GLuint) listHandles[i]);
+
+            glPopMatrix();
+            glPopClientAttrib();
+            glPopAttrib();
+
+            // The lists leave the OpenGL state as it was at the end of their recording, not as Screen
+            // tracks it for this window. The attribute stacks undo most of it, but not the bound GLSL
+            // program, so reassign the tracked shader and blending state:
+            PsychSetShader(windowRecord, 0);
+            PsychUpdateAlphaBlendingFactorLazily(windowRecord);
+
+            // Mark end of drawing op. This is needed for single buffered drawing:
+            PsychFlushGL(windowRecord);
+            break;
+
+        case 4: // Delete:
+            PsychAllocInIntegerListArg(3, TRUE, &n, &listHandles);
+
+            PsychSetGLContext(windowRecord);
+            for (i = 0; i < n; i++) {
+                if ((listHandles[i] <= 0) || !glIsList((GLuint) listHandles[i]))
+                    PsychErrorExitMsg(PsychError_user, "Invalid 'listHandle' provided. No such command list!");
+
+                PsychDeleteCommandList(windowRecord, (GLuint) listHandles[i]);
+            }
+            break;
+    }
+
+    return(PsychError_none);
+}
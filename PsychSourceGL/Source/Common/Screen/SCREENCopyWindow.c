@@ -265,6 +265,10 @@ PsychError SCREENCopyWindow(void)
             PsychErrorExitMsg(PsychError_user, "Size mismatch of sourceRect and targetRect. Matching size is required for Onscreen to Offscreen copies. Sorry.");
         }
 
+        // Target texture gets modified by the copy, so it must be resident and can't be evicted anymore,
+        // as eviction would restore stale content:
+        PsychTextureResidencyPin(targetWin);
+
         // Update selected textures content:
         // Looks weird but we need the framebuffer of sourceWin:
         PsychSetDrawingTarget(sourceWin);
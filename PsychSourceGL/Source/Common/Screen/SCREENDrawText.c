@@ -59,11 +59,13 @@ void (*PsychPluginSetTextBGColor)(int context, double* color) = NULL;
 void (*PsychPluginSetTextUseFontmapper)(unsigned int useMapper, unsigned int mapperFlags) = NULL;
 void (*PsychPluginSetTextViewPort)(int context, double xs, double ys, double w, double h) = NULL;
 int (*PsychPluginDrawText)(int context, double xStart, double yStart, int textLen, double* text) = NULL;
+int (*PsychPluginDrawTexts)(int context, int numStrings, int* textLens, double** texts, double* xStarts, double* yStarts, int yPositionIsBaseline, double* fgColors, float* bboxes) = NULL;
 int (*PsychPluginMeasureText)(int context, int textLen, double* text, float* xmin, float* ymin, float* xmax, float* ymax, float* xadvance) = NULL;
 void (*PsychPluginSetTextVerbosity)(unsigned int verbosity) = NULL;
 void (*PsychPluginSetTextAntiAliasing)(int context, int antiAliasing) = NULL;
 void (*PsychPluginSetAffineTransformMatrix)(int context, double matrix[2][3]) = NULL;
 void (*PsychPluginGetTextCursor)(int context, double* xp, double* yp, double* height) = NULL;
+int (*PsychPluginLockGlyphAtlas)(int context, int numStrings, int* textLens, double** texts) = NULL;
 
 // External renderplugins not yet supported on MS-Windows:
 #if PSYCH_SYSTEM != PSYCH_WINDOWS
@@ -1470,6 +1472,214 @@ drawtext_noop:
 // End of non-OS/X (= Linux & Windows) specific part...
 #endif
 
+// Text layout cache: Caches text bounding box measurements of the text renderer plugin, so
+// repeated Screen('TextBounds') or Screen('DrawText') calls for the same strings, e.g., for
+// centering text on each frame, don't need to layout the text again. Entries are keyed by
+// the unicode text and all font settings which affect the layout, and recycled in LRU order:
+#define PSYCH_TEXTLAYOUTCACHE_DEFAULTSIZE 512
+
+typedef struct PsychTextLayoutCacheEntry {
+    psych_uint64    hash;               // Hash of key, for fast rejection of mismatches.
+    psych_uint64    lastUse;            // Timestamp of last use, for LRU replacement.
+    int             next;               // Index of next entry in same hash bucket, -1 if none.
+    int             textLength;         // Key: Unicode text string.
+    double          *text;
+    char            fontName[256];      // Key: Font settings.
+    int             textSize;
+    int             textStyle;
+    int             antiAliasing;
+    int             textRenderer;
+    double          text2DMatrix[2][3];
+    float           xmin, ymin, xmax, ymax, xadvance;   // Cached measurement.
+} PsychTextLayoutCacheEntry;
+
+static PsychTextLayoutCacheEntry *layoutCache = NULL;
+static int *layoutCacheBuckets = NULL;
+static int layoutCacheCapacity = PSYCH_TEXTLAYOUTCACHE_DEFAULTSIZE;
+static int layoutCacheNumBuckets = 0;
+static int layoutCacheNumEntries = 0;
+static psych_uint64 layoutCacheClock = 0;
+static double layoutCacheHits = 0;
+static double layoutCacheMisses = 0;
+
+static void PsychTextLayoutCacheFlush(void)
+{
+    int i;
+
+    if (layoutCache) {
+        for (i = 0; i < layoutCacheNumEntries; i++) free(layoutCache[i].text);
+        free(layoutCache);
+        free(layoutCacheBuckets);
+    }
+
+    layoutCache = NULL;
+    layoutCacheBuckets = NULL;
+    layoutCacheNumEntries = 0;
+}
+
+// Set maximum number of cached text layouts, zero disables the cache. Returns old capacity.
+int PsychTextLayoutCacheSetCapacity(int capacity)
+{
+    int oldCapacity = layoutCacheCapacity;
+
+    if (capacity >= 0) {
+        PsychTextLayoutCacheFlush();
+        layoutCacheCapacity = capacity;
+    }
+
+    return(oldCapacity);
+}
+
+void PsychTextLayoutCacheGetStats(int *capacity, int *numEntries, double *hits, double *misses)
+{
+    *capacity = layoutCacheCapacity;
+    *numEntries = layoutCacheNumEntries;
+    *hits = layoutCacheHits;
+    *misses = layoutCacheMisses;
+}
+
+// FNV-1a hash over the bytes of a memory block:
+static psych_uint64 PsychTextLayoutHash(psych_uint64 hash, const void* data, size_t size)
+{
+    const unsigned char *p = (const unsigned char*) data;
+
+    while (size--) {
+        hash ^= (psych_uint64) *(p++);
+        hash *= 1099511628211ULL;
+    }
+
+    return(hash);
+}
+
+static psych_uint64 PsychTextLayoutCacheKey(PsychWindowRecordType* winRec, int textLength, double* text)
+{
+    psych_uint64 hash = 14695981039346656037ULL;
+    int settings[4];
+
+    settings[0] = winRec->textAttributes.textSize;
+    settings[1] = winRec->textAttributes.textStyle;
+    settings[2] = PsychPrefStateGet_TextAntiAliasing();
+    settings[3] = PsychPrefStateGet_TextRenderer();
+
+    hash = PsychTextLayoutHash(hash, text, textLength * sizeof(double));
+    hash = PsychTextLayoutHash(hash, winRec->textAttributes.textFontName, strlen((char*) winRec->textAttributes.textFontName));
+    hash = PsychTextLayoutHash(hash, settings, sizeof(settings));
+    hash = PsychTextLayoutHash(hash, winRec->text2DMatrix, sizeof(winRec->text2DMatrix));
+
+    return(hash);
+}
+
+static psych_bool PsychTextLayoutCacheMatch(PsychTextLayoutCacheEntry *e, psych_uint64 hash, PsychWindowRecordType* winRec, int textLength, double* text)
+{
+    return((e->hash == hash) && (e->textLength == textLength) && (e->textSize == winRec->textAttributes.textSize) &&
+           (e->textStyle == winRec->textAttributes.textStyle) && (e->antiAliasing == PsychPrefStateGet_TextAntiAliasing()) &&
+           (e->textRenderer == PsychPrefStateGet_TextRenderer()) && !memcmp(e->text2DMatrix, winRec->text2DMatrix, sizeof(e->text2DMatrix)) &&
+           !strcmp(e->fontName, (char*) winRec->textAttributes.textFontName) && !memcmp(e->text, text, textLength * sizeof(double)));
+}
+
+// Lookup cached bounding box of 'text' with the current font settings of 'winRec'. Returns TRUE on hit:
+static psych_bool PsychTextLayoutCacheLookup(PsychWindowRecordType* winRec, int textLength, double* text, float* xmin, float* ymin, float* xmax, float* ymax, float* xadvance)
+{
+    psych_uint64 hash;
+    PsychTextLayoutCacheEntry *e;
+    int i;
+
+    if (layoutCacheCapacity <= 0) return(FALSE);
+
+    if (!layoutCache) {
+        layoutCacheMisses++;
+        return(FALSE);
+    }
+
+    hash = PsychTextLayoutCacheKey(winRec, textLength, text);
+    for (i = layoutCacheBuckets[hash % layoutCacheNumBuckets]; i >= 0; i = layoutCache[i].next) {
+        e = &layoutCache[i];
+        if (PsychTextLayoutCacheMatch(e, hash, winRec, textLength, text)) {
+            e->lastUse = ++layoutCacheClock;
+            *xmin = e->xmin;
+            *ymin = e->ymin;
+            *xmax = e->xmax;
+            *ymax = e->ymax;
+            *xadvance = e->xadvance;
+            layoutCacheHits++;
+
+            return(TRUE);
+        }
+    }
+
+    layoutCacheMisses++;
+
+    return(FALSE);
+}
+
+// Store bounding box of 'text' with the current font settings of 'winRec', replacing the least recently used entry if full:
+static void PsychTextLayoutCacheInsert(PsychWindowRecordType* winRec, int textLength, double* text, float xmin, float ymin, float xmax, float ymax, float xadvance)
+{
+    PsychTextLayoutCacheEntry *e;
+    psych_uint64 hash;
+    int i, slot, *link;
+
+    if (layoutCacheCapacity <= 0) return;
+
+    // First time init:
+    if (!layoutCache) {
+        layoutCache = (PsychTextLayoutCacheEntry*) calloc(layoutCacheCapacity, sizeof(PsychTextLayoutCacheEntry));
+        layoutCacheNumBuckets = 2 * layoutCacheCapacity;
+        layoutCacheBuckets = (int*) malloc(layoutCacheNumBuckets * sizeof(int));
+        if (!layoutCache || !layoutCacheBuckets) {
+            PsychTextLayoutCacheFlush();
+            return;
+        }
+
+        for (i = 0; i < layoutCacheNumBuckets; i++) layoutCacheBuckets[i] = -1;
+        layoutCacheNumEntries = 0;
+    }
+
+    if (layoutCacheNumEntries < layoutCacheCapacity) {
+        // Free slot available:
+        slot = layoutCacheNumEntries++;
+    }
+    else {
+        // Cache full: Recycle least recently used entry, unlink it from its hash bucket:
+        slot = 0;
+        for (i = 1; i < layoutCacheNumEntries; i++) if (layoutCache[i].lastUse < layoutCache[slot].lastUse) slot = i;
+
+        for (link = &layoutCacheBuckets[layoutCache[slot].hash % layoutCacheNumBuckets]; *link != slot; link = &layoutCache[*link].next);
+        *link = layoutCache[slot].next;
+
+        free(layoutCache[slot].text);
+        layoutCache[slot].text = NULL;
+    }
+
+    e = &layoutCache[slot];
+    e->text = (double*) malloc(textLength * sizeof(double));
+    if (!e->text) {
+        // Out of memory: Start over with an empty cache:
+        PsychTextLayoutCacheFlush();
+        return;
+    }
+
+    hash = PsychTextLayoutCacheKey(winRec, textLength, text);
+    e->hash = hash;
+    e->lastUse = ++layoutCacheClock;
+    e->textLength = textLength;
+    memcpy(e->text, text, textLength * sizeof(double));
+    snprintf(e->fontName, sizeof(e->fontName), "%s", (char*) winRec->textAttributes.textFontName);
+    e->textSize = winRec->textAttributes.textSize;
+    e->textStyle = winRec->textAttributes.textStyle;
+    e->antiAliasing = PsychPrefStateGet_TextAntiAliasing();
+    e->textRenderer = PsychPrefStateGet_TextRenderer();
+    memcpy(e->text2DMatrix, winRec->text2DMatrix, sizeof(e->text2DMatrix));
+    e->xmin = xmin;
+    e->ymin = ymin;
+    e->xmax = xmax;
+    e->ymax = ymax;
+    e->xadvance = xadvance;
+
+    e->next = layoutCacheBuckets[hash % layoutCacheNumBuckets];
+    layoutCacheBuckets[hash % layoutCacheNumBuckets] = slot;
+}
+
 // Load and initialize an external text renderer plugin: Called while OpenGL
 // context from 'windowRecord' is bound and active. Returns true on success,
 // false on error. Reverts to builtin text renderer on error:
@@ -1624,11 +1834,13 @@ psych_bool PsychLoadTextRendererPlugin(PsychWindowRecordType* windowRecord)
             PsychPluginSetTextUseFontmapper = dlsym(drawtext_plugin, "PsychSetTextUseFontmapper");
             PsychPluginSetTextViewPort = dlsym(drawtext_plugin, "PsychSetTextViewPort");
             PsychPluginDrawText = dlsym(drawtext_plugin, "PsychDrawText");
+            PsychPluginDrawTexts = dlsym(drawtext_plugin, "PsychDrawTexts");
             PsychPluginMeasureText = dlsym(drawtext_plugin, "PsychMeasureText");
             PsychPluginSetTextVerbosity = dlsym(drawtext_plugin, "PsychSetTextVerbosity");
             PsychPluginSetTextAntiAliasing = dlsym(drawtext_plugin, "PsychSetTextAntiAliasing");
             PsychPluginSetAffineTransformMatrix = dlsym(drawtext_plugin, "PsychSetAffineTransformMatrix");
             PsychPluginGetTextCursor = dlsym(drawtext_plugin, "PsychGetTextCursor");
+            PsychPluginLockGlyphAtlas = dlsym(drawtext_plugin, "PsychLockGlyphAtlas");
         #else
             PsychPluginInitText = (void*) GetProcAddress(drawtext_plugin, "PsychInitText");
             PsychPluginShutdownText = (void*) GetProcAddress(drawtext_plugin, "PsychShutdownText");
@@ -1641,11 +1853,13 @@ psych_bool PsychLoadTextRendererPlugin(PsychWindowRecordType* windowRecord)
             PsychPluginSetTextUseFontmapper = (void*) GetProcAddress(drawtext_plugin, "PsychSetTextUseFontmapper");
             PsychPluginSetTextViewPort = (void*) GetProcAddress(drawtext_plugin, "PsychSetTextViewPort");
             PsychPluginDrawText = (void*) GetProcAddress(drawtext_plugin, "PsychDrawText");
+            PsychPluginDrawTexts = (void*) GetProcAddress(drawtext_plugin, "PsychDrawTexts");
             PsychPluginMeasureText = (void*) GetProcAddress(drawtext_plugin, "PsychMeasureText");
             PsychPluginSetTextVerbosity = (void*) GetProcAddress(drawtext_plugin, "PsychSetTextVerbosity");
             PsychPluginSetTextAntiAliasing = (void*) GetProcAddress(drawtext_plugin, "PsychSetTextAntiAliasing");
             PsychPluginSetAffineTransformMatrix = (void*) GetProcAddress(drawtext_plugin, "PsychSetAffineTransformMatrix");
             PsychPluginGetTextCursor = (void*) GetProcAddress(drawtext_plugin, "PsychGetTextCursor");
+            PsychPluginLockGlyphAtlas = (void*) GetProcAddress(drawtext_plugin, "PsychLockGlyphAtlas");
         #endif
 
         // Assign current level of verbosity:
@@ -1706,6 +1920,9 @@ void PsychCleanupTextRenderer(PsychWindowRecordType* windowRecord)
             // Call master shutdown:
             PsychPluginShutdownText(-1);
 
+            // Release cached text layouts:
+            PsychTextLayoutCacheFlush();
+
             #if PSYCH_SYSTEM != PSYCH_WINDOWS
             // Jettison plugin:
             dlclose(drawtext_plugin);
@@ -1914,6 +2131,91 @@ const char* PsychGetUnicodeTextConversionLocale(void)
 
 #endif
 
+// Convert null-terminated multibyte string 'textCString' in the current character encoding into a
+// unicode double vector in 'unicodeText' of length 'textLength', allocated in temporary memory.
+// Returns FALSE if the string is empty after conversion, TRUE otherwise:
+static psych_bool PsychConvertCStringToUnicode(const char *textCString, int *textLength, double **unicodeText)
+{
+    wchar_t             *textUniString = NULL;
+    int                 stringLengthBytes, i;
+
+    // Get length in bytes, derived from location of null-terminator character:
+    stringLengthBytes = (int) strlen(textCString);
+
+    // Empty string? If so, we skip processing:
+    if (stringLengthBytes < 1) return(FALSE);
+
+    #if PSYCH_SYSTEM == PSYCH_WINDOWS
+        // Windows:
+        // Compute number of Unicode wchar_t chars after conversion of multibyte C-String:
+        if (drawtext_codepage) {
+            // Codepage-based text conversion:
+            *textLength = MultiByteToWideChar(drawtext_codepage, 0, textCString, -1, NULL, 0) - 1;
+            if (*textLength <= 0) {
+                printf("PTB-ERROR: MultiByteToWideChar() returned conversion error code %i.", (int) GetLastError());
+                PsychErrorExitMsg(PsychError_user, "Invalid multibyte character sequence detected! Can't convert given char() string to Unicode for DrawText!");
+            }
+        }
+        else {
+            // Locale-based text conversion:
+
+            // Create backup copy of currently set process global locale:
+            sprintf(oldmswinlocale, "%s", setlocale(LC_CTYPE, NULL));
+
+            // Set process global locale to wanted locale:
+            setlocale(LC_CTYPE, drawtext_localestring);
+
+            // Perform text conversion:
+            *textLength = (int) mbstowcs(NULL, textCString, 0);
+
+            // Reset process global locale to old setting:
+            setlocale(LC_CTYPE, oldmswinlocale);
+        }
+    #else
+        // Unix: OS/X, Linux:
+        *textLength = mbstowcs_l(NULL, textCString, 0, drawtext_locale);
+    #endif
+
+    if (*textLength < 0) PsychErrorExitMsg(PsychError_user, "Invalid multibyte character sequence detected! Can't convert given char() string to Unicode for DrawText!");
+
+    // Empty string provided? Skip, if so.
+    if (*textLength < 1) return(FALSE);
+
+    // Allocate wchar_t buffer of sufficient size to hold converted unicode string:
+    textUniString = (wchar_t*) PsychMallocTemp((*textLength + 1) * sizeof(wchar_t));
+
+    // Perform conversion of multibyte character sequence to Unicode wchar_t:
+    #if PSYCH_SYSTEM == PSYCH_WINDOWS
+        // Windows:
+        if (drawtext_codepage) {
+            // Codepage-based text conversion:
+            if (MultiByteToWideChar(drawtext_codepage, 0, textCString, -1, textUniString, (*textLength + 1)) <= 0) {
+                printf("PTB-ERROR: MultiByteToWideChar() II returned conversion error code %i.", (int) GetLastError());
+                PsychErrorExitMsg(PsychError_user, "Invalid multibyte character sequence detected! Can't convert given char() string to Unicode for DrawText!");
+            }
+        }
+        else {
+            // Set process global locale to wanted locale:
+            setlocale(LC_CTYPE, drawtext_localestring);
+
+            // Locale-based text conversion:
+            mbstowcs(textUniString, textCString, (*textLength + 1));
+
+            // Reset process global locale to old setting:
+            setlocale(LC_CTYPE, oldmswinlocale);
+        }
+    #else
+        // Unix:
+        mbstowcs_l(textUniString, textCString, (*textLength + 1), drawtext_locale);
+    #endif
+
+    // Allocate temporary output vector of doubles and copy unicode string into it:
+    *unicodeText = (double*) PsychMallocTemp((*textLength + 1) * sizeof(double));
+    for (i = 0; i < (*textLength + 1); i++) (*unicodeText)[i] = (double) textUniString[i];
+
+    return(TRUE);
+}
+
 // Allocate in a text string argument, either in some string or bytestring format or as double-vector.
 // Return the strings representation as a double vector in Unicode encoding.
 //
@@ -1931,7 +2233,6 @@ psych_bool PsychAllocInTextAsUnicode(int position, PsychArgRequirementType isReq
     int                 dummy1, dummy2;
     unsigned char       *textByteString = NULL;
     char                *textCString = NULL;
-    wchar_t             *textUniString = NULL;
     int                 stringLengthBytes = 0;
 
     // Anything provided as argument? This checks for presence of the required arg. If an arg
@@ -1972,79 +2273,8 @@ psych_bool PsychAllocInTextAsUnicode(int position, PsychArgRequirementType isReq
             PsychAllocInCharArg(position, TRUE, &textCString);
         }
 
-        // Get length in bytes, derived from location of null-terminator character:
-        stringLengthBytes = (int) strlen(textCString);
-
-        // Empty string? If so, we skip processing:
-        if (stringLengthBytes < 1) goto allocintext_skipped;
-
-        #if PSYCH_SYSTEM == PSYCH_WINDOWS
-            // Windows:
-            // Compute number of Unicode wchar_t chars after conversion of multibyte C-String:
-            if (drawtext_codepage) {
-                // Codepage-based text conversion:
-                *textLength = MultiByteToWideChar(drawtext_codepage, 0, textCString, -1, NULL, 0) - 1;
-                if (*textLength <= 0) {
-                    printf("PTB-ERROR: MultiByteToWideChar() returned conversion error code %i.", (int) GetLastError());
-                    PsychErrorExitMsg(PsychError_user, "Invalid multibyte character sequence detected! Can't convert given char() string to Unicode for DrawText!");
-                }
-            }
-            else {
-                // Locale-based text conversion:
-
-                // Create backup copy of currently set process global locale:
-                sprintf(oldmswinlocale, "%s", setlocale(LC_CTYPE, NULL));
-
-                // Set process global locale to wanted locale:
-                setlocale(LC_CTYPE, drawtext_localestring);
-
-                // Perform text conversion:
-                *textLength = (int) mbstowcs(NULL, textCString, 0);
-
-                // Reset process global locale to old setting:
-                setlocale(LC_CTYPE, oldmswinlocale);
-            }
-        #else
-            // Unix: OS/X, Linux:
-            *textLength = mbstowcs_l(NULL, textCString, 0, drawtext_locale);
-        #endif
-
-        if (*textLength < 0) PsychErrorExitMsg(PsychError_user, "Invalid multibyte character sequence detected! Can't convert given char() string to Unicode for DrawText!");
-
-        // Empty string provided? Skip, if so.
-        if (*textLength < 1) goto allocintext_skipped;
-
-        // Allocate wchar_t buffer of sufficient size to hold converted unicode string:
-        textUniString = (wchar_t*) PsychMallocTemp((*textLength + 1) * sizeof(wchar_t));
-
-        // Perform conversion of multibyte character sequence to Unicode wchar_t:
-        #if PSYCH_SYSTEM == PSYCH_WINDOWS
-            // Windows:
-            if (drawtext_codepage) {
-                // Codepage-based text conversion:
-                if (MultiByteToWideChar(drawtext_codepage, 0, textCString, -1, textUniString, (*textLength + 1)) <= 0) {
-                    printf("PTB-ERROR: MultiByteToWideChar() II returned conversion error code %i.", (int) GetLastError());
-                    PsychErrorExitMsg(PsychError_user, "Invalid multibyte character sequence detected! Can't convert given char() string to Unicode for DrawText!");
-                }
-            }
-            else {
-                // Set process global locale to wanted locale:
-                setlocale(LC_CTYPE, drawtext_localestring);
-
-                // Locale-based text conversion:
-                mbstowcs(textUniString, textCString, (*textLength + 1));
-
-                // Reset process global locale to old setting:
-                setlocale(LC_CTYPE, oldmswinlocale);
-            }
-        #else
-            // Unix:
-            mbstowcs_l(textUniString, textCString, (*textLength + 1), drawtext_locale);
-        #endif
-
-        // Allocate temporary output vector of doubles and copy unicode string into it:
-        *unicodeText = (double*) PsychMallocTemp((*textLength + 1) * sizeof(double));
-        for (dummy1 = 0; dummy1 < (*textLength + 1); dummy1++) (*unicodeText)[dummy1] = (double) textUniString[dummy1];
+        // Convert it into unicode, nothing to do on an empty string:
+        if (!PsychConvertCStringToUnicode(textCString, textLength, unicodeText)) goto allocintext_skipped;
     }
     else {
         // Not a character string: Check if it is a double matrix which directly encodes Unicode text:
@@ -2093,10 +2323,132 @@ void PsychDrawCharText(PsychWindowRecordType* winRec, const char* textString, do
     return;
 }
 
-PsychError PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* boundingbox, unsigned int stringLengthChars, double* textUniDoubleString, double* xp, double* yp, double* theight, double* xAdvance, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor, int swapTextDirection)
+// Assign all text settings of window 'winRec' to the text renderer plugin. Returns the plugin context id for 'winRec':
+static int PsychSetPluginTextSettings(PsychWindowRecordType* winRec, PsychColorType *textColor, PsychColorType *backgroundColor)
 {
     GLdouble backgroundColorVector[4];
     GLdouble colorVector[4];
+    int ctx;
+
+    // Get ctx context id for this window:
+    ctx = (int) (PsychGetParentWindow(winRec))->windowIndex;
+
+    // Assign current level of verbosity:
+    PsychPluginSetTextVerbosity((unsigned int) PsychPrefStateGet_Verbosity());
+
+    // Assign current anti-aliasing settings:
+    PsychPluginSetTextAntiAliasing(ctx, PsychPrefStateGet_TextAntiAliasing());
+
+    // Assign font family name of requested font:
+    PsychPluginSetTextFont(ctx, (const char*) winRec->textAttributes.textFontName);
+
+    // Assign style settings, e.g., bold, italic etc.:
+    PsychPluginSetTextStyle(ctx, winRec->textAttributes.textStyle);
+
+    // Assign text size in pixels:
+    PsychPluginSetTextSize(ctx, (double) winRec->textAttributes.textSize);
+
+    // Retrieve true text font family name:
+    sprintf((char*) &(winRec->textAttributes.textFontName[0]), "%s", PsychPluginGetTextFont(ctx));
+
+    // Assign viewport settings for rendering:
+    PsychPluginSetTextViewPort(ctx, winRec->clientrect[kPsychLeft], winRec->clientrect[kPsychTop], PsychGetWidthFromRect(winRec->clientrect), PsychGetHeightFromRect(winRec->clientrect));
+
+    // Compute and assign text background color:
+    PsychCoerceColorMode(backgroundColor);
+    PsychConvertColorToDoubleVector(backgroundColor, winRec, backgroundColorVector);
+    PsychPluginSetTextBGColor(ctx, backgroundColorVector);
+
+    // Compute and assign text foreground color - the actual color of the glyphs:
+    PsychCoerceColorMode(textColor);
+    PsychConvertColorToDoubleVector(textColor, winRec, colorVector);
+    PsychPluginSetTextFGColor(ctx, colorVector);
+
+    // Apply affine 2D transformation matrix if the plugin supports this:
+    if (PsychPluginSetAffineTransformMatrix)
+        PsychPluginSetAffineTransformMatrix(ctx, winRec->text2DMatrix);
+
+    return(ctx);
+}
+
+// Assign all text settings of window 'winRec' to the text renderer plugin, and setup
+// OpenGL state for drawing text with it. Returns the plugin context id for 'winRec'.
+// Must be paired with a call to PsychEndPluginTextDrawing():
+static int PsychBeginPluginTextDrawing(PsychWindowRecordType* winRec, PsychColorType *textColor, PsychColorType *backgroundColor, GLenum *normalSourceBlendFactor, GLenum *normalDestinationBlendFactor)
+{
+    int ctx;
+
+    ctx = PsychSetPluginTextSettings(winRec, textColor, backgroundColor);
+
+    // Enable this windowRecords framebuffer as current drawingtarget:
+    PsychSetDrawingTarget(winRec);
+
+    // Save all state:
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+
+    // Disable draw shader:
+    PsychSetShader(winRec, 0);
+
+    // Override current alpha blending settings to GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA unless
+    // usercode explicitely requested to use the regular Screen('Blendfunction') settings.
+    // This is needed to perform proper text anti-aliasing via alpha-blending:
+    if (!PsychPrefStateGet_TextAlphaBlending()) {
+        PsychGetAlphaBlendingFactorsFromWindow(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
+        PsychStoreAlphaBlendingFactorsForWindow(winRec, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    // Apply blending settings:
+    PsychUpdateAlphaBlendingFactorLazily(winRec);
+
+    // Disable apple client storage - it could interfere:
+    #if PSYCH_SYSTEM == PSYCH_OSX
+        glPixelStorei(GL_UNPACK_CLIENT_STORAGE_APPLE, GL_FALSE);
+    #endif
+
+    return(ctx);
+}
+
+// Prepare drawing of text strings via the plugin while Screen('CommandList') recording is active: The plugin
+// uploads new glyphs into its glyph textures on demand. These uploads must not get recorded, as the recorded
+// commands would replay stale glyph data later on. Therefore upload all glyphs of the strings with recording
+// suspended, then lock the glyph textures, so the recorded drawing commands only reference resident glyphs.
+// No-op if no recording is active. Must be followed by PsychUnlockPluginGlyphAtlas() after drawing:
+static void PsychLockPluginGlyphAtlas(PsychWindowRecordType* winRec, int numStrings, int* textLens, double** texts, PsychColorType *textColor, PsychColorType *backgroundColor)
+{
+    int ctx, rc;
+
+    if (!PsychGetCommandListRecordingWindow()) return;
+
+    if (!PsychPluginLockGlyphAtlas)
+        PsychErrorExitMsg(PsychError_user, "Text drawing while Screen('CommandList') recording is active is not supported by the selected text renderer plugin.");
+
+    PsychSuspendCommandListRecording();
+    ctx = PsychSetPluginTextSettings(winRec, textColor, backgroundColor);
+    rc = PsychPluginLockGlyphAtlas(ctx, numStrings, textLens, texts);
+    PsychResumeCommandListRecording();
+
+    if (rc) PsychErrorExitMsg(PsychError_user, "Tried to draw text while Screen('CommandList') recording is active, but the text doesn't fit into the glyph texture of the font. Draw less text per call, or use a smaller font.");
+}
+
+static void PsychUnlockPluginGlyphAtlas(int ctx)
+{
+    if (PsychPluginLockGlyphAtlas) PsychPluginLockGlyphAtlas(ctx, 0, NULL, NULL);
+}
+
+static void PsychEndPluginTextDrawing(PsychWindowRecordType* winRec, GLenum normalSourceBlendFactor, GLenum normalDestinationBlendFactor)
+{
+    // Restore alpha-blending settings if needed:
+    if (!PsychPrefStateGet_TextAlphaBlending()) PsychStoreAlphaBlendingFactorsForWindow(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
+
+    // Restore GL state:
+    glPopAttrib();
+
+    // Mark end of drawing op. This is needed for single buffered drawing:
+    PsychFlushGL(winRec);
+}
+
+PsychError PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* boundingbox, unsigned int stringLengthChars, double* textUniDoubleString, double* xp, double* yp, double* theight, double* xAdvance, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor, int swapTextDirection)
+{
     GLenum normalSourceBlendFactor, normalDestinationBlendFactor;
     float xmin, ymin, xmax, ymax, _xadvance;
     double myyp;
@@ -2120,74 +2472,18 @@ PsychError PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* bo
     // If so, load it if not already loaded:
     if ((PsychPrefStateGet_TextRenderer() > 0) && PsychLoadTextRendererPlugin(winRec)) {
 
-        // Use external dynamically loaded plugin:
-
-        // Get ctx context id for this window:
-        ctx = (int) (PsychGetParentWindow(winRec))->windowIndex;
-
-        // Assign current level of verbosity:
-        PsychPluginSetTextVerbosity((unsigned int) PsychPrefStateGet_Verbosity());
-
-        // Assign current anti-aliasing settings:
-        PsychPluginSetTextAntiAliasing(ctx, PsychPrefStateGet_TextAntiAliasing());
-
-        // Assign font family name of requested font:
-        PsychPluginSetTextFont(ctx, (const char*) winRec->textAttributes.textFontName);
-
-        // Assign style settings, e.g., bold, italic etc.:
-        PsychPluginSetTextStyle(ctx, winRec->textAttributes.textStyle);
-
-        // Assign text size in pixels:
-        PsychPluginSetTextSize(ctx, (double) winRec->textAttributes.textSize);
-
-        // Retrieve true text font family name:
-        sprintf((char*) &(winRec->textAttributes.textFontName[0]), "%s", PsychPluginGetTextFont(ctx));
+        // Make all glyphs resident if a command list gets recorded:
+        if (!boundingbox) PsychLockPluginGlyphAtlas(winRec, 1, (int*) &stringLengthChars, &textUniDoubleString, textColor, backgroundColor);
 
-        // Assign viewport settings for rendering:
-        PsychPluginSetTextViewPort(ctx, winRec->clientrect[kPsychLeft], winRec->clientrect[kPsychTop], PsychGetWidthFromRect(winRec->clientrect), PsychGetHeightFromRect(winRec->clientrect));
+        // Use external dynamically loaded plugin: Setup its state and OpenGL state for drawing:
+        ctx = PsychBeginPluginTextDrawing(winRec, textColor, backgroundColor, &normalSourceBlendFactor, &normalDestinationBlendFactor);
 
-        // Compute and assign text background color:
-        PsychCoerceColorMode(backgroundColor);
-        PsychConvertColorToDoubleVector(backgroundColor, winRec, backgroundColorVector);
-        PsychPluginSetTextBGColor(ctx, backgroundColorVector);
-
-        // Compute and assign text foreground color - the actual color of the glyphs:
-        PsychCoerceColorMode(textColor);
-        PsychConvertColorToDoubleVector(textColor, winRec, colorVector);
-        PsychPluginSetTextFGColor(ctx, colorVector);
-
-        // Apply affine 2D transformation matrix if the plugin supports this:
-        if (PsychPluginSetAffineTransformMatrix)
-            PsychPluginSetAffineTransformMatrix(ctx, winRec->text2DMatrix);
-
-        // Enable this windowRecords framebuffer as current drawingtarget:
-        PsychSetDrawingTarget(winRec);
-
-        // Save all state:
-        glPushAttrib(GL_ALL_ATTRIB_BITS);
-
-        // Disable draw shader:
-        PsychSetShader(winRec, 0);
-
-        // Override current alpha blending settings to GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA unless
-        // usercode explicitely requested to use the regular Screen('Blendfunction') settings.
-        // This is needed to perform proper text anti-aliasing via alpha-blending:
-        if (!PsychPrefStateGet_TextAlphaBlending()) {
-            PsychGetAlphaBlendingFactorsFromWindow(winRec, &normalSourceBlendFactor, &normalDestinationBlendFactor);
-            PsychStoreAlphaBlendingFactorsForWindow(winRec, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        // Compute bounding box of drawn string, unless it is cached from a previous call:
+        if (!PsychTextLayoutCacheLookup(winRec, stringLengthChars, textUniDoubleString, &xmin, &ymin, &xmax, &ymax, &_xadvance)) {
+            rc = PsychPluginMeasureText(ctx, stringLengthChars, textUniDoubleString, &xmin, &ymin, &xmax, &ymax, &_xadvance);
+            if (0 == rc) PsychTextLayoutCacheInsert(winRec, stringLengthChars, textUniDoubleString, xmin, ymin, xmax, ymax, _xadvance);
         }
 
-        // Apply blending settings:
-        PsychUpdateAlphaBlendingFactorLazily(winRec);
-
-        // Disable apple client storage - it could interfere:
-        #if PSYCH_SYSTEM == PSYCH_OSX
-            glPixelStorei(GL_UNPACK_CLIENT_STORAGE_APPLE, GL_FALSE);
-        #endif
-
-        // Compute bounding box of drawn string:
-        rc = PsychPluginMeasureText(ctx, stringLengthChars, textUniDoubleString, &xmin, &ymin, &xmax, &ymax, &_xadvance);
-
         // Handle definition of yp properly: Is it the text baseline, or the top of the text bounding box?
         if (yPositionIsBaseline) {
             myyp = *yp;
@@ -2205,16 +2501,11 @@ PsychError PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* bo
         else {
             // Draw text by calling into the plugin:
             rc += PsychPluginDrawText(ctx, *xp, myyp, stringLengthChars, textUniDoubleString);
+            PsychUnlockPluginGlyphAtlas(ctx);
         }
 
-        // Restore alpha-blending settings if needed:
-        if (!PsychPrefStateGet_TextAlphaBlending()) PsychStoreAlphaBlendingFactorsForWindow(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
-
-        // Restore GL state:
-        glPopAttrib();
-
-        // Mark end of drawing op. This is needed for single buffered drawing:
-        PsychFlushGL(winRec);
+        // Restore state:
+        PsychEndPluginTextDrawing(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
 
         // Plugin rendering successfull?
         if (0 == rc) {
@@ -2247,6 +2538,10 @@ PsychError PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* bo
 
     // If we reach this point then either text rendering via OS specific legacy renderer is requested, or
     // the external rendering plugin failed to load and we use the OS specific legacy renderer as fallback.
+    // The legacy renderers create glyph textures or display lists on demand, which can't be recorded:
+    if (PsychGetCommandListRecordingWindow())
+        PsychErrorExitMsg(PsychError_user, "Tried to draw or measure text with a legacy OS specific text renderer while Screen('CommandList') recording is active. Only the default text renderer is supported.");
+
     return(PsychOSDrawUnicodeText(winRec, boundingbox, stringLengthChars, textUniDoubleString, xp, yp, yPositionIsBaseline, textColor, backgroundColor));
 }
 
@@ -2318,6 +2613,222 @@ drawtext_skipped:
     return(PsychError_none);
 }
 
+// Batched 'DrawText' routine, as called by Screen('DrawTexts', ...);
+PsychError SCREENDrawTexts(void)
+{
+    // If you change useString then also change the corresponding synopsis string in ScreenSynopsis.
+    static char useString[] = "[newX, newY] = Screen('DrawTexts', windowPtr, texts, x, y [, colors] [, backgroundColor] [, yPositionIsBaseline]);";
+    //                          1     2                           1          2      3  4    5           6                    7
+
+    static char synopsisString[] =
+    "Draw many text strings with one call. This is much more efficient than calling Screen('DrawText') "
+    "once for each string, e.g., for drawing a large number of labels in each frame.\n"
+    "\"texts\" is either a cell array of char() strings, with one string per cell, or one text string "
+    "which contains all strings to draw, each string separated from the next one by a newline character "
+    "char(10). A trailing newline at the end of the last string is ignored. A single text string is "
+    "interpreted the same way as the text argument of Screen('DrawText'), ie. it can be a char() string "
+    "in the current character encoding, a uint8() byte string or a double() vector of unicode code points, "
+    "and is converted to unicode in one pass for all strings. Strings in a cell array are char() strings "
+    "in the current character encoding.\n"
+    "\"x\" and \"y\" are vectors with one text pen start location per string, or scalars if all "
+    "strings should be drawn at the same location along that axis.\n"
+    "\"colors\" is an optional matrix of colors, with one column of 1 (luminance), 3 (rgb) or 4 (rgba) "
+    "components for each string. Alternatively a single color can be given for all strings, which "
+    "then also becomes the new default text color, just as with Screen('DrawText'). A row vector "
+    "with one luminance value per string is accepted as well, except if it could also be a single "
+    "color, ie. if it has 1, 3 or 4 components: Such a row vector is always a single color, even if "
+    "the number of strings is 3 or 4. Use a 3 row matrix of rgb colors, e.g., repmat(lum, 3, 1), "
+    "to specify per-string luminance values for 3 or 4 strings.\n"
+    "\"backgroundColor\" and \"yPositionIsBaseline\" have the same meaning as for Screen('DrawText') "
+    "and apply to all strings.\n"
+    "\"newX, newY\" optionally return the final pen location after drawing the last string.\n"
+    "With the default high quality text renderer, all strings get submitted to the text renderer "
+    "plugin as one batch, and all text in the same font, size and style is drawn with one OpenGL "
+    "draw call. With other text renderers, the strings are drawn one by one.\n";
+
+    static char seeAlsoString[] = "DrawText TextBounds TextSize TextFont TextStyle TextColor TextBackgroundColor Preference";
+
+    PsychWindowRecordType       *winRec;
+    PsychColorType              colorArg, backgroundColorArg;
+    PsychColorType              *textColors = NULL;
+    GLenum                      normalSourceBlendFactor, normalDestinationBlendFactor;
+    int                         textLength, numStrings, i, m, n, p, nx, ny, ctx, rc, yPositionIsBaseline;
+    int                         *textLens;
+    double                      *text, **texts, *xIn, *yIn, *x, *y, *colors, *colorVectors = NULL;
+    double                      backgroundColorVector[4];
+    char                        **cellStrings;
+    double                      theight = 0;
+    double                      xAdvance = 0;
+    float                       *bboxes = NULL;
+    float                       _xadvance;
+
+    // All subfunctions should have these two lines.
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(7));
+    PsychErrorExit(PsychRequireNumInputArgs(4));
+    PsychErrorExit(PsychCapNumOutputArgs(2));
+
+    //Get the window structure for the onscreen window.
+    PsychAllocInWindowRecordArg(1, TRUE, &winRec);
+
+    if (PsychGetArgType(2) == PsychArgType_cellArray) {
+        // Cell array with one char() string per cell. Convert each string to unicode:
+        PsychAllocInCellVectorStringElements(2, kPsychArgRequired, &numStrings, &cellStrings);
+        if (numStrings < 1) goto drawtexts_skipped;
+
+        textLens = (int*) PsychMallocTemp(numStrings * sizeof(int));
+        texts = (double**) PsychMallocTemp(numStrings * sizeof(double*));
+        for (i = 0; i < numStrings; i++) {
+            if (!PsychConvertCStringToUnicode(cellStrings[i], &textLens[i], &texts[i])) {
+                textLens[i] = 0;
+                texts[i] = (double*) PsychCallocTemp(1, sizeof(double));
+            }
+        }
+    }
+    else {
+        // Get all strings as one double vector of unicode characters: If this returns false
+        // then there ain't any work for us to do:
+        if (!PsychAllocInTextAsUnicode(2, kPsychArgRequired, &textLength, &text)) goto drawtexts_skipped;
+
+        // Split into individual strings at newline characters:
+        textLens = (int*) PsychMallocTemp((textLength + 1) * sizeof(int));
+        texts = (double**) PsychMallocTemp((textLength + 1) * sizeof(double*));
+        numStrings = 0;
+        texts[0] = text;
+        textLens[0] = 0;
+        for (i = 0; i < textLength; i++) {
+            if (text[i] == 10) {
+                numStrings++;
+                texts[numStrings] = &text[i + 1];
+                textLens[numStrings] = 0;
+            }
+            else {
+                textLens[numStrings]++;
+            }
+        }
+
+        // A trailing newline terminates the last string, instead of starting a new empty one:
+        if (text[textLength - 1] != 10) numStrings++;
+    }
+
+    // Get the X and Y positions:
+    PsychAllocInDoubleMatArg(3, kPsychArgRequired, &m, &n, &p, &xIn);
+    nx = m * n * p;
+    PsychAllocInDoubleMatArg(4, kPsychArgRequired, &m, &n, &p, &yIn);
+    ny = m * n * p;
+
+    if ((nx != 1 && nx != numStrings) || (ny != 1 && ny != numStrings))
+        PsychErrorExitMsg(PsychError_user, "Number of 'x' or 'y' positions does not match number of text strings in 'texts' and is not 1 either!");
+
+    x = (double*) PsychMallocTemp(numStrings * sizeof(double));
+    y = (double*) PsychMallocTemp(numStrings * sizeof(double));
+    for (i = 0; i < numStrings; i++) {
+        x[i] = xIn[(nx > 1) ? i : 0];
+        y[i] = yIn[(ny > 1) ? i : 0];
+    }
+
+    // Get optional colors: Either one column per string, or a single color. A row vector which is a valid
+    // single color, ie. with 1, 3 or 4 components, is always a single color, even if it has one component
+    // per string:
+    if (PsychAllocInDoubleMatArg(5, kPsychArgOptional, &m, &n, &p, &colors)) {
+        if ((p == 1) && (n == numStrings) && (numStrings > 1) && ((m == 3) || (m == 4) || ((m == 1) && (n != 3) && (n != 4)))) {
+            textColors = (PsychColorType*) PsychMallocTemp(numStrings * sizeof(PsychColorType));
+            for (i = 0; i < numStrings; i++) {
+                switch (m) {
+                    case 1:
+                        PsychLoadColorStruct(&textColors[i], kPsychIndexColor, colors[i]);
+                        break;
+                    case 3:
+                        PsychLoadColorStruct(&textColors[i], kPsychRGBColor, colors[i * 3], colors[i * 3 + 1], colors[i * 3 + 2]);
+                        break;
+                    case 4:
+                        PsychLoadColorStruct(&textColors[i], kPsychRGBAColor, colors[i * 4], colors[i * 4 + 1], colors[i * 4 + 2], colors[i * 4 + 3]);
+                        break;
+                }
+                PsychCoerceColorMode(&textColors[i]);
+            }
+        }
+        else {
+            // Single color: Becomes the new default text color:
+            PsychCopyInColorArg(5, kPsychArgRequired, &colorArg);
+            PsychSetTextColorInWindowRecord(&colorArg, winRec);
+        }
+    }
+
+    // Same for background color:
+    if (PsychCopyInColorArg(6, kPsychArgOptional, &backgroundColorArg)) {
+        PsychSetTextBackgroundColorInWindowRecord(&backgroundColorArg, winRec);
+    } else {
+        // This just to coerce background color into proper format in case it hasn't been done already:
+        PsychSetTextBackgroundColorInWindowRecord(&(winRec->textAttributes.textBackgroundColor),  winRec);
+    }
+
+    // Special handling of offset for y position correction:
+    yPositionIsBaseline = PsychPrefStateGet_TextYPositionIsBaseline();
+    PsychCopyInIntegerArg(7, kPsychArgOptional, &yPositionIsBaseline);
+
+    // Does the text renderer plugin support batched drawing?
+    if ((PsychPrefStateGet_TextRenderer() > 0) && PsychLoadTextRendererPlugin(winRec) && PsychPluginDrawTexts && PsychPluginGetTextCursor) {
+        // Yes. Convert per-string colors into RGBA vectors for the plugin:
+        if (textColors) {
+            colorVectors = (double*) PsychMallocTemp(numStrings * 4 * sizeof(double));
+            for (i = 0; i < numStrings; i++) PsychConvertColorToDoubleVector(&textColors[i], winRec, &colorVectors[i * 4]);
+        }
+
+        // Submit all strings as one batch:
+        PsychLockPluginGlyphAtlas(winRec, numStrings, textLens, texts, &(winRec->textAttributes.textColor), &(winRec->textAttributes.textBackgroundColor));
+        ctx = PsychBeginPluginTextDrawing(winRec, &(winRec->textAttributes.textColor), &(winRec->textAttributes.textBackgroundColor), &normalSourceBlendFactor, &normalDestinationBlendFactor);
+
+        // Bounding boxes are needed for positioning relative to the top of the text, or for drawing
+        // background quads. Compute them, unless they are cached from previous calls:
+        PsychConvertColorToDoubleVector(&(winRec->textAttributes.textBackgroundColor), winRec, backgroundColorVector);
+        rc = 0;
+        if (!yPositionIsBaseline || (backgroundColorVector[3] > 0)) {
+            bboxes = (float*) PsychMallocTemp(numStrings * 4 * sizeof(float));
+            for (i = 0; (i < numStrings) && (0 == rc); i++) {
+                if (!PsychTextLayoutCacheLookup(winRec, textLens[i], texts[i], &bboxes[i * 4], &bboxes[i * 4 + 1], &bboxes[i * 4 + 2], &bboxes[i * 4 + 3], &_xadvance)) {
+                    rc = PsychPluginMeasureText(ctx, textLens[i], texts[i], &bboxes[i * 4], &bboxes[i * 4 + 1], &bboxes[i * 4 + 2], &bboxes[i * 4 + 3], &_xadvance);
+                    if (0 == rc) PsychTextLayoutCacheInsert(winRec, textLens[i], texts[i], bboxes[i * 4], bboxes[i * 4 + 1], bboxes[i * 4 + 2], bboxes[i * 4 + 3], _xadvance);
+                }
+            }
+        }
+
+        if (0 == rc) rc = PsychPluginDrawTexts(ctx, numStrings, textLens, texts, x, y, yPositionIsBaseline, colorVectors, bboxes);
+        PsychUnlockPluginGlyphAtlas(ctx);
+
+        PsychEndPluginTextDrawing(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
+
+        if (rc) PsychErrorExitMsg(PsychError_user, "The external text renderer plugin failed to render the text strings for some reason! See 'help DrawTextPlugin' for troubleshooting.");
+
+        // Update text cursor to end of last string:
+        PsychPluginGetTextCursor(ctx, &(winRec->textAttributes.textPositionX), &(winRec->textAttributes.textPositionY), &theight);
+        if (!yPositionIsBaseline) winRec->textAttributes.textPositionY -= bboxes[(numStrings - 1) * 4 + 3];
+    }
+    else {
+        // No. Draw one string after the other:
+        for (i = 0; i < numStrings; i++) {
+            winRec->textAttributes.textPositionX = x[i];
+            winRec->textAttributes.textPositionY = y[i];
+            if (textLens[i] < 1) continue;
+
+            PsychDrawUnicodeText(winRec, NULL, textLens[i], texts[i], &(winRec->textAttributes.textPositionX), &(winRec->textAttributes.textPositionY), &theight, &xAdvance, yPositionIsBaseline,
+                                 (textColors) ? &textColors[i] : &(winRec->textAttributes.textColor), &(winRec->textAttributes.textBackgroundColor), 0);
+        }
+    }
+
+    // We jump directly to this position in the code if the textstring is empty --> No op.
+drawtexts_skipped:
+
+    // Copy out new, potentially updated, "cursor position":
+    PsychCopyOutDoubleArg(1, FALSE, winRec->textAttributes.textPositionX);
+    PsychCopyOutDoubleArg(2, FALSE, winRec->textAttributes.textPositionY);
+
+    // Done.
+    return(PsychError_none);
+}
+
 PsychError SCREENTextTransform(void)
 {
     // If you change useString then also change the corresponding synopsis string in ScreenSynopsis.
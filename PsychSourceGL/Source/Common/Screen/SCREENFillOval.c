@@ -27,7 +27,7 @@
 #include "Screen.h"
 
 // If you change useString then also change the corresponding synopsis string in ScreenSynopsis.c
-static char useString[] = "Screen('FillOval', windowPtr [,color] [,rect] [,perfectUpToMaxDiameter]);";
+static char useString[] = "Screen('FillOval', windowPtr [,color] [,rect] [,perfectUpToMaxDiameter] [,antiAliased=0]);";
 static char synopsisString[] = 
         "Fills an ellipse with the given color, inscribed within \"rect\".\"color\" is the "
         "clut index (scalar or [r g b] triplet) that you want to poke into each pixel; "
@@ -45,7 +45,12 @@ static char synopsisString[] =
 		"is chosen to be the full display size, so all ovals will look perfect, at a possible "
 		"speed penalty. If you know your ovals will never be bigger than a certain diameter, "
 		"you can provide that diameter as a hint via 'perfectUpToMaxDiameter' to allow for "
-		"some potential speedup when drawing filled ovals. ";
+		"some potential speedup when drawing filled ovals.\n"
+		"On graphics hardware with support for instanced drawing, multiple ovals are computed exactly "
+		"per pixel and all drawn at once, so 'perfectUpToMaxDiameter' is ignored for them. In this "
+		"case, the optional parameter 'antiAliased' allows to request anti-aliased oval borders by "
+		"setting it to 1. This only has an effect if alpha blending is enabled via Screen('BlendFunction'), "
+		"e.g., with GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA. By default, ovals are not anti-aliased. ";
 
 static char seeAlsoString[] = "FrameOval";	
 
@@ -54,10 +59,10 @@ PsychError SCREENFillOval(void)
 	PsychRectType			rect;
 	double					numSlices, radius, xScale, yScale, xTranslate, yTranslate, rectY, rectX;
 	PsychWindowRecordType	*windowRecord;
-	psych_bool				isArgThere, isclassic;
+	psych_bool				isArgThere, isclassic, antiAliased;
     double					*xy, *colors;
 	unsigned char			*bytecolors;
-	int						numRects, i, nc, mc, nrsize;
+	int						numRects, i, nc, mc, nrsize, antiAliasing;
 	GLUquadricObj			*diskQuadric;
 	double					perfectUpToMaxDiameter;
 	static double			perfectUpToMaxDiameterOld = 0;
@@ -67,7 +72,7 @@ PsychError SCREENFillOval(void)
 	if(PsychIsGiveHelp()){PsychGiveHelp();return(PsychError_none);}
 	
 	//check for superfluous arguments
-	PsychErrorExit(PsychCapNumInputArgs(4));   //The maximum number of inputs
+	PsychErrorExit(PsychCapNumInputArgs(5));   //The maximum number of inputs
 	PsychErrorExit(PsychCapNumOutputArgs(0));  //The maximum number of outputs
 
 	//get the window record from the window record argument and get info from the window record
@@ -78,6 +83,11 @@ PsychError SCREENFillOval(void)
 	if (PsychGetHeightFromRect(windowRecord->clientrect) < perfectUpToMaxDiameter) perfectUpToMaxDiameter = PsychGetHeightFromRect(windowRecord->clientrect);
 	PsychCopyInDoubleArg(4, kPsychArgOptional, &perfectUpToMaxDiameter);
 
+	// Anti-aliasing of instanced ovals is opt-in:
+	antiAliasing = 0;
+	PsychCopyInIntegerArg(5, kPsychArgOptional, &antiAliasing);
+	antiAliased = (antiAliasing > 0) ? TRUE : FALSE;
+
     // Compute number of subdivisions (slices) to provide a perfect oval, i.e., one subdivision for each
     // distance unit on the circumference of the oval.
     numSlices = 3.14159265358979323846 * perfectUpToMaxDiameter;
@@ -129,6 +139,12 @@ PsychError SCREENFillOval(void)
 		PsychCopyRect(rect, &xy[0]);
 	}
 
+	// Multiple ovals? Try to draw them analytically with one instanced draw call:
+	if ((numRects > 1) && PsychDrawInstancedShapes(windowRecord, kPsychInstancedFillOval, numRects, xy, nc, mc, colors, bytecolors, 0, NULL, antiAliased)) {
+		PsychFlushGL(windowRecord);
+		return(PsychError_none);
+	}
+
 	// Draw all ovals (one or multiple):
 	for (i = 0; i < numRects;) {
 		// Per oval color provided? If so then set it up. If only one common color
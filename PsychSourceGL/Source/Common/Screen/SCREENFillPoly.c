@@ -17,6 +17,9 @@
 	01/12/05     mk     Added a slow-path that draws concave and self-intersecting polygons correctly.
 	02/25/05	awi		Added call to PsychUpdateAlphaBlendingFactorLazily().  Drawing now obeys settings by Screen('BlendFunction').
 	11/01/08	 mk		Improved speed of slow-path. Still pretty slow -> Most time spent inside gluTesselator(), nothing we could do.
+	10/19/26	 ag		Slow-path now triangulates simple concave polygons with few vertices via ear clipping, all others via gluTesselator(),
+						and caches the triangulation of each polygon, so redrawing the same polygon only costs one glDrawArrays() call.
+						Added 'FillPolys' for drawing many polygons with one call.
  
 	TO DO:
  
@@ -49,21 +52,66 @@ static unsigned int			combinerCacheSlot = 0;
 static double*				tempv = NULL;
 static int					tempvsize = 0;
 
-// Callback-Routines for the GLU-Tesselator functions used on the FillPoly - Slow - path:
+// Triangles emitted by the GLU-Tesselator, as (x,y) vertex pairs:
+static float*				tessTriangles = NULL;
+static int					tessTrianglesSize = 0;
+static int					tessTrianglesCount = 0;
+
+// Cache of triangulated polygons, indexed by a hash of their vertex data. Shared by all windows,
+// as it only contains plain vertex data:
+#define kPsychPolyCacheSlots 1024
+
+// Polygons with more vertices, or whose vertex and triangle data would need more bytes, are not cached,
+// so the cache can not grow beyond kPsychPolyCacheSlots * kPsychPolyCacheMaxEntryBytes:
+#define kPsychPolyCacheMaxVertices 4096
+#define kPsychPolyCacheMaxEntryBytes (512 * 1024)
+
+// Maximum number of vertices of polygons triangulated via ear clipping instead of the GLU tesselator:
+#define kPsychPolyEarClipMaxVertices 64
+
+typedef struct PsychPolyCacheEntry {
+    psych_uint64    hash;                   // Hash of the vertex data of the polygon.
+    int             numVertices;            // Number of polygon vertices.
+    int             numTriangleVertices;    // Number of triangle vertices, three per triangle.
+    double*         vertices;               // numVertices x-coordinates, followed by numVertices y-coordinates. NULL if slot unused.
+    float*          triangles;              // numTriangleVertices (x,y) pairs, allocated in one block with vertices.
+    size_t          allocSize;              // Size of the allocated block in bytes.
+} PsychPolyCacheEntry;
+
+static PsychPolyCacheEntry	polyCache[kPsychPolyCacheSlots];
+
+// Callback-Routines for the GLU-Tesselator functions used on the FillPoly - Slow - path. They collect
+// the generated triangles in tessTriangles. The edge flag callback makes the tesselator emit only
+// GL_TRIANGLES, no strips or fans, so we can concatenate all of them:
 void APIENTRY PsychtcbBegin(GLenum prim)
 {
-    PsychGLBegin(NULL, prim);
+    (void) prim;
+}
+
+void APIENTRY PsychtcbEdgeFlag(GLboolean flag)
+{
+    (void) flag;
 }
 
 void APIENTRY PsychtcbVertex(void *data)
 {
     GLdouble *v = (GLdouble*) data;
-    PsychGLVertex4f(NULL, (float) v[0], (float) v[1], (float) v[2], (float) 1);
+    float *newTriangles;
+
+    if (tessTrianglesCount >= tessTrianglesSize) {
+        newTriangles = (float*) realloc((void*) tessTriangles, sizeof(float) * 2 * (tessTrianglesSize + 3000));
+        if (NULL == newTriangles) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory condition in Screen('FillPoly')! Not enough space.");
+        tessTriangles = newTriangles;
+        tessTrianglesSize += 3000;
+    }
+
+    tessTriangles[tessTrianglesCount * 2] = (float) v[0];
+    tessTriangles[tessTrianglesCount * 2 + 1] = (float) v[1];
+    tessTrianglesCount++;
 }
 
 void APIENTRY PsychtcbEnd(void)
 {
-    PsychGLEnd(NULL);
 }
 
 void APIENTRY PsychtcbCombine(GLdouble c[3], void *d[4], GLfloat w[4], void **out)
@@ -95,6 +143,8 @@ void APIENTRY PsychtcbCombine(GLdouble c[3], void *d[4], GLfloat w[4], void **ou
 // use any GL calls here, just plain C-level operations!!
 void PsychCleanupSCREENFillPoly(void)
 {
+	int i;
+
 	// Release tesselator object and associated data structures, if any:
 	if (tess) {
 		gluDeleteTess(tess);
@@ -106,10 +156,344 @@ void PsychCleanupSCREENFillPoly(void)
 		tempv = NULL;
 		tempvsize = 0;
 	}
-	
+
+	if (tessTriangles) {
+		free(tessTriangles);
+		tessTriangles = NULL;
+		tessTrianglesSize = 0;
+	}
+
+	// Flush triangulation cache:
+	for (i = 0; i < kPsychPolyCacheSlots; i++) {
+		free(polyCache[i].vertices);
+		polyCache[i].vertices = NULL;
+		polyCache[i].triangles = NULL;
+		polyCache[i].allocSize = 0;
+	}
+
 	return;
 }
 
+// Test if polygon with n vertices (x[i], y[i]) is definitely convex. Returns FALSE if the
+// polygon is concave or we can't prove that it is convex:
+//
+// Algorithm adapted from: http://astronomy.swin.edu.au/~pbourke/geometry/clockwise/
+// Which was written by Paul Bourke, 1998.
+//
+// -> This webpage explains the mathematical principle behind the test and provides
+// a C-Source file which has been adapted for use here.
+static psych_bool PsychIsConvexPolygon(int n, const double *x, const double *y)
+{
+    int     i, j, k, flag;
+    double  z;
+
+    flag = 0;
+    for (i = 0; i < n; i++) {
+        j = (i + 1) % n;
+        k = (i + 2) % n;
+        z  = (x[j] - x[i]) * (y[k] - y[j]);
+        z -= (y[j] - y[i]) * (x[k] - x[j]);
+
+        if (z < 0) {
+            flag |= 1;
+        }
+        else if (z > 0) {
+            flag |= 2;
+        }
+
+        if (flag == 3) {
+            // This is definitely a CONCAVE polygon.
+            return(FALSE);
+        }
+    }
+
+    // Convex if all turns have the same direction. Otherwise it is a complex polygon -> can't determine if it is convex or not.
+    return((flag != 0) ? TRUE : FALSE);
+}
+
+// Cross product of (b - a) and (c - a): Positive if a,b,c is a counter-clockwise turn in a y-up coordinate system:
+static double PsychPolyCross(double ax, double ay, double bx, double by, double cx, double cy)
+{
+    return((bx - ax) * (cy - ay) - (by - ay) * (cx - ax));
+}
+
+// Do the closed line segments a-b and c-d touch or intersect?
+static psych_bool PsychPolySegmentsIntersect(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy)
+{
+    double d1, d2, d3, d4;
+
+    // Bounding boxes disjoint?
+    if ((((ax > bx) ? ax : bx) < ((cx < dx) ? cx : dx)) || (((cx > dx) ? cx : dx) < ((ax < bx) ? ax : bx)) ||
+        (((ay > by) ? ay : by) < ((cy < dy) ? cy : dy)) || (((cy > dy) ? cy : dy) < ((ay < by) ? ay : by)))
+        return(FALSE);
+
+    d1 = PsychPolyCross(cx, cy, dx, dy, ax, ay);
+    d2 = PsychPolyCross(cx, cy, dx, dy, bx, by);
+    d3 = PsychPolyCross(ax, ay, bx, by, cx, cy);
+    d4 = PsychPolyCross(ax, ay, bx, by, dx, dy);
+
+    // Proper crossing, or touching / collinear overlap, which the bounding box test above confirms:
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
+        return(TRUE);
+
+    return((d1 == 0 || d2 == 0 || d3 == 0 || d4 == 0) ? TRUE : FALSE);
+}
+
+// Triangulate the polygon with n vertices (x[i], y[i]) via ear clipping. Writes up to n - 2 triangles as
+// (x,y) vertex pairs into 'triangles' and returns the number of written vertices, or -1 if the polygon is
+// self-intersecting or touching itself, so the GLU tesselator must handle it.
+static int PsychEarClipPolygon(int n, const double *x, const double *y, float *triangles)
+{
+    int     *idx, *prev, *next;
+    int     i, j, m, p, q, v, count, remaining, stall;
+    double  area, orient, c;
+    psych_bool isEar;
+
+    idx = (int*) PsychMallocTemp(sizeof(int) * 3 * n);
+    prev = idx + n;
+    next = prev + n;
+
+    // Drop consecutive duplicate vertices, including a closing vertex equal to the first one:
+    for (i = 0, m = 0; i < n; i++) {
+        if ((m > 0) && (x[i] == x[idx[m - 1]]) && (y[i] == y[idx[m - 1]])) continue;
+        idx[m++] = i;
+    }
+
+    while ((m > 1) && (x[idx[m - 1]] == x[idx[0]]) && (y[idx[m - 1]] == y[idx[0]])) m--;
+
+    // Less than 3 distinct vertices: Nothing to draw.
+    if (m < 3)
+        return(0);
+
+    // Ear clipping only works for simple polygons. Self-intersecting ones need the winding rules of the tesselator:
+    for (i = 0; i < m; i++) {
+        for (j = i + 2; j < m; j++) {
+            // Skip adjacent edges, which share a vertex:
+            if ((i == 0) && (j == m - 1)) continue;
+
+            if (PsychPolySegmentsIntersect(x[idx[i]], y[idx[i]], x[idx[i + 1]], y[idx[i + 1]],
+                                           x[idx[j]], y[idx[j]], x[idx[(j + 1) % m]], y[idx[(j + 1) % m]]))
+                return(-1);
+        }
+    }
+
+    // Orientation of the polygon from its signed area. Zero area means all vertices are collinear: Nothing to draw.
+    for (i = 0, area = 0; i < m; i++)
+        area += x[idx[i]] * y[idx[(i + 1) % m]] - x[idx[(i + 1) % m]] * y[idx[i]];
+
+    if (area == 0)
+        return(0);
+
+    orient = (area > 0) ? 1 : -1;
+
+    for (i = 0; i < m; i++) {
+        prev[i] = (i + m - 1) % m;
+        next[i] = (i + 1) % m;
+    }
+
+    count = 0;
+    remaining = m;
+    stall = 0;
+    i = 0;
+
+    while (remaining > 3) {
+        p = prev[i];
+        q = next[i];
+        c = orient * PsychPolyCross(x[idx[p]], y[idx[p]], x[idx[i]], y[idx[i]], x[idx[q]], y[idx[q]]);
+
+        // Convex vertex is an ear if no other vertex lies inside or on the border of triangle p,i,q:
+        isEar = (c > 0) ? TRUE : FALSE;
+        for (v = next[q]; isEar && (v != p); v = next[v]) {
+            if ((orient * PsychPolyCross(x[idx[p]], y[idx[p]], x[idx[i]], y[idx[i]], x[idx[v]], y[idx[v]]) >= 0) &&
+                (orient * PsychPolyCross(x[idx[i]], y[idx[i]], x[idx[q]], y[idx[q]], x[idx[v]], y[idx[v]]) >= 0) &&
+                (orient * PsychPolyCross(x[idx[q]], y[idx[q]], x[idx[p]], y[idx[p]], x[idx[v]], y[idx[v]]) >= 0))
+                isEar = FALSE;
+        }
+
+        if (isEar) {
+            // Emit ear triangle:
+            triangles[count * 2 + 0] = (float) x[idx[p]];
+            triangles[count * 2 + 1] = (float) y[idx[p]];
+            triangles[count * 2 + 2] = (float) x[idx[i]];
+            triangles[count * 2 + 3] = (float) y[idx[i]];
+            triangles[count * 2 + 4] = (float) x[idx[q]];
+            triangles[count * 2 + 5] = (float) y[idx[q]];
+            count += 3;
+        }
+
+        if (isEar || (c == 0)) {
+            // Clip ear, or drop collinear vertex without area, and continue with its predecessor:
+            next[p] = q;
+            prev[q] = p;
+            remaining--;
+            stall = 0;
+            i = p;
+        }
+        else {
+            // No ear. Give up if we didn't find any ear after a full round, e.g., due to numeric trouble:
+            if (++stall > remaining)
+                return(-1);
+
+            i = q;
+        }
+    }
+
+    // Emit final triangle, unless it is degenerate:
+    p = prev[i];
+    q = next[i];
+    if (PsychPolyCross(x[idx[p]], y[idx[p]], x[idx[i]], y[idx[i]], x[idx[q]], y[idx[q]]) != 0) {
+        triangles[count * 2 + 0] = (float) x[idx[p]];
+        triangles[count * 2 + 1] = (float) y[idx[p]];
+        triangles[count * 2 + 2] = (float) x[idx[i]];
+        triangles[count * 2 + 3] = (float) y[idx[i]];
+        triangles[count * 2 + 4] = (float) x[idx[q]];
+        triangles[count * 2 + 5] = (float) y[idx[q]];
+        count += 3;
+    }
+
+    return(count);
+}
+
+// Triangulate a possibly self-intersecting polygon via the GLU tesselator. Returns the number of
+// triangle vertices, which are stored in tessTriangles:
+static int PsychTesselatePolygon(int n, const double *x, const double *y)
+{
+    int i;
+
+    // Create and initialize a new GLU-Tesselator object, if needed:
+    if (NULL == tess) {
+        // Create tesselator:
+        tess = gluNewTess();
+        if (NULL == tess) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory condition in Screen('FillPoly')! Not enough space.");
+
+        // Assign our callback-functions:
+        gluTessCallback(tess, GLU_TESS_BEGIN, GLUTESSCBCASTER PsychtcbBegin);
+        gluTessCallback(tess, GLU_TESS_EDGE_FLAG, GLUTESSCBCASTER PsychtcbEdgeFlag);
+        gluTessCallback(tess, GLU_TESS_VERTEX, GLUTESSCBCASTER PsychtcbVertex);
+        gluTessCallback(tess, GLU_TESS_END, GLUTESSCBCASTER PsychtcbEnd);
+        gluTessCallback(tess, GLU_TESS_COMBINE, GLUTESSCBCASTER PsychtcbCombine);
+
+        // Define all tesselated polygons to lie in the x-y plane:
+        gluTessNormal(tess, 0, 0, 1);
+    }
+
+    // We need to hold the values in a temporary array:
+    if (tempvsize < n) {
+        tempvsize = ((n / 1000) + 1) * 1000;
+        tempv = (double*) realloc((void*) tempv, sizeof(double) * 3 * tempvsize);
+        if (NULL == tempv) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory condition in Screen('FillPoly')! Not enough space.");
+    }
+
+    // Now submit our Polygon for tesselation:
+    tessTrianglesCount = 0;
+    gluTessBeginPolygon(tess, NULL);
+    gluTessBeginContour(tess);
+
+    for (i = 0; i < n; i++) {
+        tempv[i*3] = (GLdouble) x[i];
+        tempv[i*3+1] = (GLdouble) y[i];
+        tempv[i*3+2] = 0;
+        gluTessVertex(tess, (GLdouble*) &(tempv[i*3]), (void*) &(tempv[i*3]));
+    }
+
+    // Process and finalize it by calling our callback-functions:
+    gluTessEndContour(tess);
+    gluTessEndPolygon(tess);
+
+    return(tessTrianglesCount);
+}
+
+// Return triangulation of the possibly concave polygon with n vertices (x[i], y[i]) in 'triangles',
+// and the number of triangle vertices as return value. The triangles are fetched from the cache if
+// the same polygon was triangulated before, otherwise computed and stored in the cache. The returned
+// array is only valid until the next call:
+static int PsychGetPolygonTriangles(int n, const double *x, const double *y, float **triangles)
+{
+    PsychPolyCacheEntry *entry;
+    psych_uint64        hash;
+    unsigned char       *bytes;
+    float               *newTriangles;
+    size_t              i, entrySize;
+    int                 count;
+
+    // FNV-1a hash of the vertex data:
+    hash = 14695981039346656037ULL;
+    bytes = (unsigned char*) x;
+    for (i = 0; i < n * sizeof(double); i++) hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    bytes = (unsigned char*) y;
+    for (i = 0; i < n * sizeof(double); i++) hash = (hash ^ bytes[i]) * 1099511628211ULL;
+
+    // Cache hit?
+    entry = &polyCache[hash % kPsychPolyCacheSlots];
+    if (entry->vertices && (entry->hash == hash) && (entry->numVertices == n) &&
+        !memcmp(entry->vertices, x, n * sizeof(double)) && !memcmp(entry->vertices + n, y, n * sizeof(double))) {
+        *triangles = entry->triangles;
+        return(entry->numTriangleVertices);
+    }
+
+    // No. Triangulate small simple polygons via ear clipping. Ear clipping and its test for self-intersection
+    // are O(n^2), so use the GLU tesselator for self-intersecting polygons and polygons with many vertices:
+    count = -1;
+    if (n <= kPsychPolyEarClipMaxVertices) {
+        newTriangles = (float*) PsychMallocTemp(sizeof(float) * 2 * 3 * n);
+        count = PsychEarClipPolygon(n, x, y, newTriangles);
+    }
+
+    if (count < 0) {
+        count = PsychTesselatePolygon(n, x, y);
+        newTriangles = tessTriangles;
+    }
+
+    // Too big to cache? Then just return the triangulation and leave the cache slot alone:
+    entrySize = sizeof(double) * 2 * n + sizeof(float) * 2 * count;
+    if ((n > kPsychPolyCacheMaxVertices) || (entrySize > kPsychPolyCacheMaxEntryBytes)) {
+        *triangles = newTriangles;
+        return(count);
+    }
+
+    // Replace cache slot content with new triangulation, reusing the memory block of the slot if it is big enough:
+    if (entry->allocSize < entrySize) {
+        free(entry->vertices);
+        entry->allocSize = 0;
+        entry->vertices = (double*) malloc(entrySize);
+        if (NULL == entry->vertices) {
+            // Out of memory: Just don't cache it.
+            entry->triangles = NULL;
+            *triangles = newTriangles;
+            return(count);
+        }
+        entry->allocSize = entrySize;
+    }
+
+    entry->triangles = (float*) (entry->vertices + 2 * n);
+    memcpy(entry->vertices, x, n * sizeof(double));
+    memcpy(entry->vertices + n, y, n * sizeof(double));
+    if (count > 0) memcpy(entry->triangles, newTriangles, sizeof(float) * 2 * count);
+    entry->hash = hash;
+    entry->numVertices = n;
+    entry->numTriangleVertices = count;
+
+    *triangles = entry->triangles;
+    return(count);
+}
+
+// Draw 'count' triangle vertices from (x,y) pairs in 'triangles' with one draw call, with optional
+// per vertex colors as in PsychSetupVertexColorArrays():
+static void PsychDrawPolyTriangles(PsychWindowRecordType *windowRecord, int count, float *triangles, int mc, double *colors, unsigned char *bytecolors)
+{
+    if (count <= 0) return;
+
+    if (colors || bytecolors) PsychSetupVertexColorArrays(windowRecord, TRUE, mc, colors, bytecolors);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, triangles);
+    glDrawArrays(GL_TRIANGLES, 0, count);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, NULL);
+
+    if (colors || bytecolors) PsychSetupVertexColorArrays(windowRecord, FALSE, 0, NULL, NULL);
+}
+
 // If you change useString then also change the corresponding synopsis string in ScreenSynopsis.c
 static char useString[] = "Screen('FillPoly', windowPtr [,color], pointList [, isConvex]);";
 //                                            1           2       3			4
@@ -120,45 +504,43 @@ static char synopsisString[] =
 "The optional flag 'isConvex' allows you to tell the routine if the polygon is convex, (value of 1) "
 "or if it is concave (value of 0), allowing the routine to skip the test for convexity, thereby "
 "saving a bit of computation time in timing sensitive scripts.\n"
-"Drawing filled polygons is a rather compute intense and slow operation. In general, drawing "
-"convex polygons is pretty fast, drawing concave, but not self-intersecting polygons is much "
-"slower (> 30x slower), and drawing concave self-intersecting polygons is extremely slow, "
-"e.g. > 2000 times slower. If you have to draw very irregular polygons with may points, "
-"it might be a good idea to preprocess them in some way and maybe break them up into "
-"a sequence of more convex/regular polygons before submitting them to 'FillPoly'. Or "
-"you may want to use some custom written drawing function for your purpose which is "
-"optimized for drawing your type of polygons. ";
-
-static char seeAlsoString[] = "FramePoly";	
-
-PsychError SCREENFillPoly(void)  
-{	
+"Drawing filled polygons is a rather compute intense operation. In general, drawing "
+"convex polygons is pretty fast. Concave polygons must be broken up into triangles first, "
+"which is slower for non-self-intersecting polygons, and extremely slow for self-intersecting "
+"polygons. The triangles of each concave polygon are cached, so drawing the same polygon again, "
+"e.g., in the next frame, is fast. If you need to draw many polygons, use Screen('FillPolys') "
+"to draw all of them with one call.";
+
+static char seeAlsoString[] = "FramePoly FillPolys";	
+
+
+
+PsychError SCREENFillPoly(void)
+{
 	PsychColorType				color;
 	PsychWindowRecordType		*windowRecord;
 	double						whiteValue;
-	int							i, mSize, nSize, pSize;
+	int							i, mSize, nSize, pSize, count;
 	psych_bool					isArgThere;
 	double						*pointList;
 	double						isConvex;
-	int							j,k;
-	int							flag;
-	double						z;
-	
+	float						*triangles;
+
 	combinerCacheSlot = 0;
 	combinerCacheSize = 0;
 	combinerCache = NULL;
-	
+
 	//all sub functions should have these two lines
 	PsychPushHelp(useString, synopsisString,seeAlsoString);
 	if(PsychIsGiveHelp()){PsychGiveHelp();return(PsychError_none);};
-	
+
 	//check for superfluous arguments
 	PsychErrorExit(PsychCapNumInputArgs(4));   //The maximum number of inputs
 	PsychErrorExit(PsychCapNumOutputArgs(0));  //The maximum number of outputs
-	
+
 	//get the window record from the window record argument and get info from the window record
 	PsychAllocInWindowRecordArg(1, kPsychArgRequired, &windowRecord);
-	
+
 	//Get the color argument or use the default, then coerce to the form determened by the window depth.  
 	isArgThere=PsychCopyInColorArg(2, FALSE, &color);
 	if(!isArgThere){
@@ -166,73 +548,37 @@ PsychError SCREENFillPoly(void)
 		PsychLoadColorStruct(&color, kPsychIndexColor, whiteValue ); //index mode will coerce to any other.
 	}
  	PsychCoerceColorMode( &color);
-	
+
 	//get the list of pairs and validate.  
 	PsychAllocInDoubleMatArg(3, kPsychArgRequired, &mSize, &nSize, &pSize, &pointList);
 	if(nSize!=2) PsychErrorExitMsg(PsychError_user, "Width of pointList must be 2");
 	if(mSize<3)  PsychErrorExitMsg(PsychError_user, "Polygons must consist of at least 3 points; M dimension of pointList was < 3!");
 	if(pSize>1)  PsychErrorExitMsg(PsychError_user, "pointList must be a 2D matrix, not a 3D matrix!");
-	
+
 	isConvex = -1;
 	PsychCopyInDoubleArg(4, kPsychArgOptional, &isConvex);
-	
-    // On non-OpenGL1/2 we always force isConvex to zero, so the GLU tesselator is
-    // always used. This because the tesselator only emits GL_TRIANGLES and GL_TRIANGLE_STRIP
-    // and GL_TRIANGLE_FANS primitives which are supported on all current OpenGL API's, whereas
-    // or "classic" fast-path needs GL_POLYGONS, which are only supported on classic OpenGL1/2:
+
+    // On non-OpenGL1/2 we always force isConvex to zero, so the polygon is always triangulated.
+    // This because the triangulation only emits GL_TRIANGLES primitives which are supported on
+    // all current OpenGL API's, whereas or "classic" fast-path needs GL_POLYGONS, which are only
+    // supported on classic OpenGL1/2:
     if (!PsychIsGLClassic(windowRecord)) isConvex = 0;
 
 	// Enable this windowRecords framebuffer as current drawingtarget:
 	PsychSetDrawingTarget(windowRecord);
-	
+
 	// Set default drawshader:
 	PsychSetShader(windowRecord, -1);
-	
-	PsychUpdateAlphaBlendingFactorLazily(windowRecord);		 
+
+	PsychUpdateAlphaBlendingFactorLazily(windowRecord);
 	PsychSetGLColor(&color, windowRecord);
-	
+
 	///////// Test for convexity ////////
 	// This algorithm checks, if the polygon is definitely convex, or not.
 	// We take the slow-path, if polygon is non-convex or if we can't prove
 	// that it is convex.
-	//
-	// Algorithm adapted from: http://astronomy.swin.edu.au/~pbourke/geometry/clockwise/
-	// Which was written by Paul Bourke, 1998.
-	//
-	// -> This webpage explains the mathematical principle behind the test and provides
-	// a C-Source file which has been adapted for use here.
-	//	
-	if (isConvex == -1) {
-		flag = 0;
-		for (i=0; i < mSize; i++) {
-			j = (i + 1) % mSize;
-			k = (i + 2) % mSize;
-			z  = (pointList[j] - pointList[i]) * (pointList[k+mSize] - pointList[j+mSize]);
-			z -= (pointList[j+mSize] - pointList[i+mSize]) * (pointList[k] - pointList[j]);
-			
-			if (z < 0) {
-				flag |= 1;
-			}
-			else if (z > 0) {
-				flag |= 2;
-			}
-			
-			if (flag == 3) {
-				// This is definitely a CONCAVE polygon --> not Convex --> Take slow but safe path.
-				break;
-			}
-		}
-		
-		if (flag!=0 && flag!=3) {
-			// This is a convex polygon --> Take fast path.
-			isConvex = 1;
-		}
-		else {
-			// This is a complex polygon --> can't determine if it is convex or not --> Take slow but safe path.
-			isConvex = 0;
-		}
-	}
-			
+	if (isConvex == -1) isConvex = (PsychIsConvexPolygon(mSize, pointList, pointList + mSize)) ? 1 : 0;
+
 	////// Switch between fast path and slow path, depending on convexity of polygon:
 	if (isConvex > 0) {
 		// Convex, non-self-intersecting polygon - Take the fast-path:
@@ -242,54 +588,193 @@ PsychError SCREENFillPoly(void)
 	}
 	else {
 		// Possibly concave and/or self-intersecting polygon - At least we couldn't prove it is convex.
-		// Take the slow, but safe, path using GLU-Tesselators to break it up into a couple of convex, simple
-		// polygons:
-		
-		// Create and initialize a new GLU-Tesselator object, if needed:
-		if (NULL == tess) {
-			// Create tesselator:
-			tess = gluNewTess();
-			if (NULL == tess) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory condition in Screen('FillPoly')! Not enough space.");
-
-			// Assign our callback-functions:
-			gluTessCallback(tess, GLU_TESS_BEGIN, GLUTESSCBCASTER PsychtcbBegin);
-			gluTessCallback(tess, GLU_TESS_VERTEX, GLUTESSCBCASTER PsychtcbVertex);
-			gluTessCallback(tess, GLU_TESS_END, GLUTESSCBCASTER PsychtcbEnd);
-			gluTessCallback(tess, GLU_TESS_COMBINE, GLUTESSCBCASTER PsychtcbCombine);
-
-			// Define all tesselated polygons to lie in the x-y plane:
-			gluTessNormal(tess, 0, 0, 1);
-		}
-
-		// We need to hold the values in a temporary array:
-		if (tempvsize < mSize) {
-			tempvsize = ((mSize / 1000) + 1) * 1000;
-			tempv = (double*) realloc((void*) tempv, sizeof(double) * 3 * tempvsize);
-			if (NULL == tempv) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory condition in Screen('FillPoly')! Not enough space.");
-		}
-
-		// Now submit our Polygon for tesselation:
-		gluTessBeginPolygon(tess, NULL);
-		gluTessBeginContour(tess);
-
-		for(i=0; i < mSize; i++) {
-			tempv[i*3]=(GLdouble) pointList[i];
-			tempv[i*3+1]=(GLdouble) pointList[i+mSize];
-			tempv[i*3+2]=0;
-			gluTessVertex(tess, (GLdouble*) &(tempv[i*3]), (void*) &(tempv[i*3]));
-		}
-		
-		// Process, finalize and render it by calling our callback-functions:
-		gluTessEndContour(tess);
-		gluTessEndPolygon (tess);
-		
+		// Take the slow, but safe, path: Break it up into triangles, via fast ear clipping for simple
+		// polygons with few vertices, or GLU-Tesselators otherwise. Or reuse the cached triangles, if
+		// this polygon was drawn before. Then draw all triangles at once:
+		count = PsychGetPolygonTriangles(mSize, pointList, pointList + mSize, &triangles);
+		PsychDrawPolyTriangles(windowRecord, count, triangles, 0, NULL, NULL);
+
 		// Done with drawing the filled polygon. (Slow-Path)
 	}
-	
+
 	// Mark end of drawing op. This is needed for single buffered drawing:
 	PsychFlushGL(windowRecord);
-	
+
 	// printf("CombinerCalls %i out of %i allocated.\n", combinerCacheSlot, combinerCacheSize);
 
 	return(PsychError_none);
 }
+
+// If you change useString2 then also change the corresponding synopsis string in ScreenSynopsis.c
+static char useString2[] = "Screen('FillPolys', windowPtr [,colors], pointList, vertexCounts [, isConvex]);";
+//                                              1           2        3          4               5
+static char synopsisString2[] =
+    "Fill many polygons with one call.\n"
+    "\"pointList\" is a matrix with the vertices of all polygons, one after the other: each row specifies "
+    "the (x,y) coordinates of a vertex, as for Screen('FillPoly'). \"vertexCounts\" is a vector with the number "
+    "of vertices of each polygon, e.g., [3, 5] for a triangle defined by the first 3 rows of \"pointList\", "
+    "followed by a pentagon defined by the next 5 rows.\n"
+    "\"colors\" is either a single color for all polygons, or a 3 or 4 row by n column matrix, the i'th column "
+    "specifying the color of the i'th polygon. Default is white.\n"
+    "The optional flag 'isConvex' tells if all polygons are convex (value of 1) or may be concave (value of 0). By "
+    "default each polygon is tested for convexity.\n"
+    "All polygons are broken up into triangles, which are drawn at once, so this is much faster than drawing "
+    "each polygon via Screen('FillPoly'). The triangles of concave polygons are cached, as in Screen('FillPoly').";
+static char seeAlsoString2[] = "FillPoly FramePoly";
+
+PsychError SCREENFillPolys(void)
+{
+    PsychColorType              color;
+    PsychWindowRecordType       *windowRecord;
+    double                      whiteValue, convfactor, value, isConvex;
+    int                         i, j, k, m, n, p, mc, nc, pc;
+    int                         numVertices, numPolys, offset, count, total, capacity;
+    int                         *vertexCounts, *triStart;
+    psych_bool                  isdoublecolors, isuint8colors, usecolorvector, usefloat;
+    double                      *pointList, *colors, *vcolors;
+    unsigned char               *bytecolors, *vbytecolors;
+    float                       *triangles, *polyTriangles, *newTriangles, *vcolorsf;
+
+    combinerCacheSlot = 0;
+    combinerCacheSize = 0;
+    combinerCache = NULL;
+
+    // All sub functions should have these two lines
+    PsychPushHelp(useString2, synopsisString2, seeAlsoString2);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(5));
+    PsychErrorExit(PsychRequireNumInputArgs(4));
+    PsychErrorExit(PsychCapNumOutputArgs(0));
+
+    PsychAllocInWindowRecordArg(1, kPsychArgRequired, &windowRecord);
+
+    // Get and validate all vertices and vertex counts:
+    PsychAllocInDoubleMatArg(3, kPsychArgRequired, &numVertices, &n, &p, &pointList);
+    if (n != 2) PsychErrorExitMsg(PsychError_user, "Width of pointList must be 2");
+    if (p > 1) PsychErrorExitMsg(PsychError_user, "pointList must be a 2D matrix, not a 3D matrix!");
+
+    PsychAllocInIntegerListArg(4, kPsychArgRequired, &numPolys, &vertexCounts);
+    for (i = 0, total = 0; i < numPolys; i++) {
+        if (vertexCounts[i] < 3) PsychErrorExitMsg(PsychError_user, "Polygons must consist of at least 3 points, but an entry in vertexCounts is < 3!");
+        total += vertexCounts[i];
+    }
+
+    if (total != numVertices) PsychErrorExitMsg(PsychError_user, "Sum of vertexCounts does not match the number of rows of pointList!");
+
+    isConvex = -1;
+    PsychCopyInDoubleArg(5, kPsychArgOptional, &isConvex);
+
+    // Per polygon colors provided? Otherwise get the single color argument or use the default:
+    usecolorvector = FALSE;
+    colors = NULL;
+    bytecolors = NULL;
+    if (PsychIsArgPresent(PsychArgIn, 2)) {
+        isdoublecolors = PsychAllocInDoubleMatArg(2, kPsychArgAnything, &mc, &nc, &pc, &colors);
+        isuint8colors = PsychAllocInUnsignedByteMatArg(2, kPsychArgAnything, &mc, &nc, &pc, &bytecolors);
+        if ((isdoublecolors || isuint8colors) && (pc == 1) && (mc != 1) && (nc == numPolys) && (numPolys > 1)) {
+            if (mc != 3 && mc != 4) PsychErrorExitMsg(PsychError_user, "Color matrix must be a 3 or 4 row matrix");
+            usecolorvector = TRUE;
+            if (!isdoublecolors) colors = NULL;
+            if (!isuint8colors) bytecolors = NULL;
+        }
+    }
+
+    if (!usecolorvector) {
+        if (!PsychCopyInColorArg(2, FALSE, &color)) {
+            whiteValue = PsychGetWhiteValueFromWindow(windowRecord);
+            PsychLoadColorStruct(&color, kPsychIndexColor, whiteValue); //index mode will coerce to any other.
+        }
+        PsychCoerceColorMode(&color);
+    }
+
+    // Break up all polygons into triangles, concatenated into one array. triStart[i] is the first
+    // triangle vertex of polygon i:
+    capacity = 3 * numVertices;
+    triangles = (float*) PsychMallocTemp(sizeof(float) * 2 * capacity);
+    triStart = (int*) PsychMallocTemp(sizeof(int) * (numPolys + 1));
+
+    for (i = 0, offset = 0, total = 0; i < numPolys; offset += vertexCounts[i], i++) {
+        triStart[i] = total;
+        n = vertexCounts[i];
+
+        if ((isConvex > 0) || ((isConvex == -1) && PsychIsConvexPolygon(n, &pointList[offset], &pointList[numVertices + offset]))) {
+            // Convex polygon: Triangle fan around the first vertex.
+            for (j = 1; j < n - 1; j++) {
+                for (k = 0; k < 3; k++) {
+                    m = offset + ((k == 0) ? 0 : j + k - 1);
+                    triangles[(total + k) * 2] = (float) pointList[m];
+                    triangles[(total + k) * 2 + 1] = (float) pointList[numVertices + m];
+                }
+                total += 3;
+            }
+        }
+        else {
+            // Concave polygon: Get its triangulation from the cache, or compute it:
+            count = PsychGetPolygonTriangles(n, &pointList[offset], &pointList[numVertices + offset], &polyTriangles);
+
+            // The tesselator can create more triangles than vertices for self-intersecting polygons:
+            if (total + count > capacity) {
+                capacity = 2 * (total + count);
+                newTriangles = (float*) PsychMallocTemp(sizeof(float) * 2 * capacity);
+                memcpy(newTriangles, triangles, sizeof(float) * 2 * total);
+                triangles = newTriangles;
+            }
+
+            if (count > 0) memcpy(&triangles[total * 2], polyTriangles, sizeof(float) * 2 * count);
+            total += count;
+        }
+    }
+    triStart[numPolys] = total;
+
+    // Assign the color of each polygon to all its triangle vertices, as RGBA colors in the format expected
+    // by PsychSetupVertexColorArrays():
+    vcolors = NULL;
+    vbytecolors = NULL;
+    if (usecolorvector && (total > 0)) {
+        usefloat = (GL_FLOAT == PsychGLFloatType(windowRecord)) ? TRUE : FALSE;
+        convfactor = 1.0 / fabs(windowRecord->colorRange);
+
+        if (colors) {
+            vcolors = (double*) PsychMallocTemp(((usefloat) ? sizeof(float) : sizeof(double)) * 4 * total);
+            vcolorsf = (float*) vcolors;
+        }
+        else {
+            vbytecolors = (unsigned char*) PsychMallocTemp(sizeof(unsigned char) * 4 * total);
+        }
+
+        for (i = 0; i < numPolys; i++) {
+            for (j = triStart[i]; j < triStart[i + 1]; j++) {
+                for (k = 0; k < 4; k++) {
+                    if (colors) {
+                        value = (k < mc) ? colors[i * mc + k] * convfactor : 1.0;
+                        if (usefloat)
+                            vcolorsf[j * 4 + k] = (float) value;
+                        else
+                            vcolors[j * 4 + k] = value;
+                    }
+                    else {
+                        vbytecolors[j * 4 + k] = (k < mc) ? bytecolors[i * mc + k] : 255;
+                    }
+                }
+            }
+        }
+    }
+
+    // Enable this windowRecords framebuffer as current drawingtarget:
+    PsychSetDrawingTarget(windowRecord);
+
+    // Set default drawshader:
+    PsychSetShader(windowRecord, -1);
+
+    PsychUpdateAlphaBlendingFactorLazily(windowRecord);
+    if (!usecolorvector) PsychSetGLColor(&color, windowRecord);
+
+    // Draw all triangles at once:
+    PsychDrawPolyTriangles(windowRecord, total, triangles, 4, vcolors, vbytecolors);
+
+    // Mark end of drawing op. This is needed for single buffered drawing:
+    PsychFlushGL(windowRecord);
+
+    return(PsychError_none);
+}
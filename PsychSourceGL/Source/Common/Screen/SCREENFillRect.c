@@ -153,8 +153,8 @@ PsychError SCREENFillRect(void)
 	  } else {
 	    // Partial fill: Draw provided rects:
 		if (numRects>1) {
-			// Multiple rects provided: Draw the whole batch:
-			for (i=0; i<numRects; i++) {
+			// Multiple rects provided: Draw the whole batch, with one instanced draw call if possible:
+			if (!PsychDrawInstancedShapes(windowRecord, kPsychInstancedFillRect, numRects, xy, nc, mc, colors, bytecolors, 0, NULL, FALSE)) for (i=0; i<numRects; i++) {
 				// Per rect color provided?
 				if (nc>1) {
 					// Yes. Set color for this specific rect:
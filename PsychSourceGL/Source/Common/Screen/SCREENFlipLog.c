@@ -0,0 +1,121 @@
+/*
+ *    SCREENFlipLog.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Control the frame-level stimulus timing log of an onscreen window, and export
+ *    its flip records in bulk as a matrix or to a binary file.
+ */
+
+#include "Screen.h"
+#include <errno.h>
+
+// If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
+static char useString[] = "[log, dropped] = Screen('FlipLog', windowPtr, command [, arg]);";
+//                          1    2                             1          2          3
+static char synopsisString[] =
+"Control the flip timing log of onscreen window 'windowPtr', and export its records in bulk.\n\n"
+"The flip log is a preallocated ring buffer, which receives one record with the timestamps of each completed flip, "
+"as executed via Screen('Flip'), Screen('AsyncFlipBegin'), Screen('AsyncFlipQueue') etc. This is more efficient for "
+"long sessions than collecting the return values of each flip in your script. Each record consists of the "
+"following values:\n"
+"[FlipCount When VBLTimestamp StimulusOnsetTime FlipTimestamp Missed Beampos SwapRequestTime Async]\n"
+"'FlipCount' is the serial number of the flip. 'When' is the requested 'when' time of the flip. 'VBLTimestamp' to "
+"'Beampos' have the same meaning as the return values of Screen('Flip'). 'SwapRequestTime' is the time when the "
+"bufferswap was requested from the system. 'Async' is 1 for flips executed asynchronously by the background flipper "
+"thread, 0 for synchronous flips.\n"
+"If the ring buffer runs full, the oldest records are overwritten and counted as dropped.\n\n"
+"'command' selects the operation:\n"
+"'Start' starts or resumes logging. The optional 'arg' is the capacity of the ring buffer in records, 100000 by "
+"default. Changing the capacity of a running log discards all records not yet exported.\n"
+"'Stop' stops logging. Records not yet exported are kept.\n"
+"'Get' returns the oldest records not yet exported as n-by-9 matrix 'log', one row per record, and removes them from "
+"the ring buffer. The optional 'arg' is the maximum number of records to return, all by default.\n"
+"'Save' appends the records not yet exported to the binary file with the name given by 'arg', and removes them from "
+"the ring buffer. The file contains 9 double precision values in native byte order per record. Repeated calls "
+"stream a whole session into one file. Read it back in Octave or Matlab via fid = fopen(name); "
+"log = fread(fid, [9, inf], 'double')'; fclose(fid); Returns the number of saved records in 'log'.\n"
+"'Count' returns the number of records available for export in 'log', without removing any.\n\n"
+"'dropped' is returned by all commands and is the total number of records dropped since the log was started.\n";
+
+static char seeAlsoString[] = "Flip AsyncFlipBegin AsyncFlipQueue GetFlipInfo";
+
+PsychError SCREENFlipLog(void)
+{
+    PsychWindowRecordType   *windowRecord;
+    char                    *command, *filename;
+    int                     arg, count;
+    double                  dropped = 0;
+    double                  *log;
+    FILE                    *file;
+
+    // All sub functions should have these two lines
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(3));
+    PsychErrorExit(PsychRequireNumInputArgs(2));
+    PsychErrorExit(PsychCapNumOutputArgs(2));
+
+    PsychAllocInWindowRecordArg(kPsychUseDefaultArgPosition, TRUE, &windowRecord);
+    if (!PsychIsOnscreenWindow(windowRecord))
+        PsychErrorExitMsg(PsychError_user, "Invalid 'windowPtr' specified. Not an onscreen window!");
+
+    PsychAllocInCharArg(2, kPsychArgRequired, &command);
+
+    if (PsychMatch(command, "Start")) {
+        arg = 0;
+        PsychCopyInIntegerArg(3, FALSE, &arg);
+        PsychFlipLogStart(windowRecord, arg);
+        PsychFlipLogExport(windowRecord, 0, NULL, NULL, &dropped);
+    }
+    else if (PsychMatch(command, "Stop")) {
+        PsychFlipLogStop(windowRecord);
+        PsychFlipLogExport(windowRecord, 0, NULL, NULL, &dropped);
+    }
+    else if (PsychMatch(command, "Count")) {
+        count = PsychFlipLogExport(windowRecord, INT_MAX, NULL, NULL, &dropped);
+        PsychCopyOutDoubleArg(1, FALSE, (double) count);
+    }
+    else if (PsychMatch(command, "Get")) {
+        arg = INT_MAX;
+        if (PsychCopyInIntegerArg(3, FALSE, &arg) && (arg < 0))
+            PsychErrorExitMsg(PsychError_user, "Invalid negative maximum number of records specified.");
+
+        count = PsychFlipLogExport(windowRecord, arg, NULL, NULL, &dropped);
+        PsychAllocOutDoubleMatArg(1, FALSE, count, kPsychFlipLogColumns, 1, &log);
+        PsychFlipLogExport(windowRecord, count, log, NULL, &dropped);
+    }
+    else if (PsychMatch(command, "Save")) {
+        PsychAllocInCharArg(3, kPsychArgRequired, &filename);
+
+        file = fopen(filename, "ab");
+        if (!file) {
+            printf("PTB-ERROR: Could not open flip log file '%s': %s\n", filename, strerror(errno));
+            PsychErrorExitMsg(PsychError_user, "Failed to open file for saving of flip log.");
+        }
+
+        count = PsychFlipLogExport(windowRecord, INT_MAX, NULL, file, &dropped);
+        if ((fclose(file) != 0) || (count < 0)) {
+            printf("PTB-ERROR: Could not write flip log file '%s': %s\n", filename, strerror(errno));
+            PsychErrorExitMsg(PsychError_system, "Failed to write flip log to file. Some records are lost.");
+        }
+
+        PsychCopyOutDoubleArg(1, FALSE, (double) count);
+    }
+    else {
+        PsychErrorExitMsg(PsychError_user, "Unknown 'command' specified. Valid are 'Start', 'Stop', 'Get', 'Save' and 'Count'.");
+    }
+
+    PsychCopyOutDoubleArg(2, FALSE, dropped);
+
+    return(PsychError_none);
+}
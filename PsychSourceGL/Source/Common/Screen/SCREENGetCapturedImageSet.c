@@ -0,0 +1,123 @@
+/*
+ *    SCREENGetCapturedImageSet.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Fetch a set of simultaneously captured images from a group of synchronized
+ *    video capture devices and return them as textures.
+ */
+
+#include "Screen.h"
+
+// If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
+static char useString[] = "[texturePtrs, capturetimestamps, droppedcount] = Screen('GetCapturedImageSet', windowPtr, capturePtrs [, waitForImage=1][, tolerance=0.005]);";
+//                          1            2                  3                                             1          2              3                 4
+static char synopsisString[] =
+"Fetch a set of simultaneously captured images from a group of synchronized video capture devices.\n\n"
+"'capturePtrs' is a vector of handles of video capture devices which were opened via Screen('OpenVideoCapture') "
+"and assigned to a capture group via the 'SyncMode' setting of Screen('SetVideoCaptureParameter'): One device "
+"must be the sync master, the others sync slaves. All devices of the group timestamp their frames with one "
+"shared clock. The function pairs the oldest pending frames of all devices by their capture timestamps: Frames "
+"which are older than 'tolerance' seconds (default 0.005 seconds) compared to the oldest frame of any other device "
+"are dropped, so the returned frames were captured within 'tolerance' seconds of each other. Choose a 'tolerance' "
+"smaller than half the frame duration of the cameras.\n"
+"'waitForImage' If set to 1 (default), the function will wait until a frame set becomes available. If set to zero, "
+"the function will just poll, and return an empty 'texturePtrs' vector if no frame set is ready yet.\n"
+"Returns a vector 'texturePtrs' with one texture handle per device, in the order of 'capturePtrs', a vector "
+"'capturetimestamps' with the capture timestamps of the frames, and the number 'droppedcount' of frames which "
+"were dropped to align the frame set. If capture has been stopped on any of the devices, 'texturePtrs' is a "
+"single -1 handle.\n";
+
+static char seeAlsoString[] = "GetCapturedImage OpenVideoCapture SetVideoCaptureParameter StartVideoCapture StopVideoCapture";
+
+PsychError SCREENGetCapturedImageSet(void)
+{
+    PsychWindowRecordType       *windowRecord;
+    PsychWindowRecordType       *textureRecord;
+    PsychRectType               rect;
+    int                         numDevices, i, rc;
+    int                         *capturehandles;
+    int                         waitForImage = 1;
+    double                      tolerance = 0.005;
+    double                      *texturePtrs, *timestamps;
+
+    // All sub functions should have these two lines
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(4));
+    PsychErrorExit(PsychRequireNumInputArgs(2));
+    PsychErrorExit(PsychCapNumOutputArgs(3));
+
+    // Get the window record from the window record argument and get info from the window record
+    PsychAllocInWindowRecordArg(kPsychUseDefaultArgPosition, TRUE, &windowRecord);
+    if (!PsychIsOnscreenWindow(windowRecord) && !PsychIsOffscreenWindow(windowRecord)) {
+        PsychErrorExitMsg(PsychError_user, "GetCapturedImageSet called on something else than an onscreen window or offscreen window.");
+    }
+
+    // Get the handles:
+    PsychAllocInIntegerListArg(2, TRUE, &numDevices, &capturehandles);
+    if (numDevices < 1)
+        PsychErrorExitMsg(PsychError_user, "GetCapturedImageSet called without any handles to capture objects.");
+
+    PsychCopyInIntegerArg(3, FALSE, &waitForImage);
+
+    PsychCopyInDoubleArg(4, FALSE, &tolerance);
+    if (tolerance < 0)
+        PsychErrorExitMsg(PsychError_user, "GetCapturedImageSet called with a negative 'tolerance'.");
+
+    // Align the pending frames of all devices to a frame set:
+    rc = PsychAlignCaptureGroup(numDevices, capturehandles, (waitForImage > 0) ? 1 : 0, tolerance);
+    if (rc < 0) {
+        // No frame set available, now (-1) or ever, because capture has been stopped (-2):
+        if (rc == -2)
+            PsychCopyOutDoubleArg(1, TRUE, -1);
+        else
+            PsychAllocOutDoubleMatArg(1, TRUE, 1, 0, 1, &texturePtrs);
+
+        PsychAllocOutDoubleMatArg(2, FALSE, 1, 0, 1, &timestamps);
+        PsychCopyOutDoubleArg(3, FALSE, 0);
+
+        return(PsychError_none);
+    }
+
+    PsychAllocOutDoubleMatArg(1, TRUE, 1, numDevices, 1, &texturePtrs);
+    PsychAllocOutDoubleMatArg(2, FALSE, 1, numDevices, 1, &timestamps);
+
+    // Fetch the frame of each device as texture:
+    for (i = 0; i < numDevices; i++) {
+        // Create a new texture record, as in Screen('GetCapturedImage'):
+        PsychCreateWindowRecord(&textureRecord);
+        textureRecord->windowType = kPsychTexture;
+        textureRecord->screenNumber = windowRecord->screenNumber;
+        textureRecord->depth = 32;
+        textureRecord->nrchannels = 4;
+        PsychMakeRect(rect, 0, 0, 10, 10);
+        PsychCopyRect(textureRecord->rect, rect);
+        textureRecord->textureMemorySizeBytes = 0;
+        textureRecord->textureMemory = NULL;
+        PsychAssignParentWindow(textureRecord, windowRecord);
+        textureRecord->textureNumber = 0;
+
+        PsychGetTextureFromCapture(windowRecord, capturehandles[i], 0, 0.0, textureRecord, &timestamps[i], NULL, NULL);
+
+        // Texture ready for consumption:
+        PsychAssignHighPrecisionTextureShaders(textureRecord, windowRecord, 0, 0);
+        PsychSetWindowRecordValid(textureRecord);
+        texturePtrs[i] = textureRecord->windowIndex;
+    }
+
+    // Return count of frames dropped for alignment:
+    PsychCopyOutDoubleArg(3, FALSE, (double) rc);
+
+    // Ready!
+    return(PsychError_none);
+}
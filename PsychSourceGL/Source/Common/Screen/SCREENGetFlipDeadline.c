@@ -0,0 +1,88 @@
+/*
+ *    SCREENGetFlipDeadline.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Return the latest time at which rendering of a frame must be submitted via
+ *    Screen('Flip') to hit a given target stimulus onset, as predicted by the
+ *    flip scheduler of an onscreen window.
+ */
+
+#include "Screen.h"
+
+// If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
+static char useString[] = "[deadline, predictedOnset, costs, throttledFlips] = Screen('GetFlipDeadline', windowPtr [, when=0][, autoThrottle][, safetyMargin]);";
+//                          1         2               3      4                                       1            2         3               4
+static char synopsisString[] =
+"Return the latest time 'deadline' at which Screen('Flip', windowPtr, when) must be called to present the "
+"stimulus at the video refresh targeted by 'when'.\n\n"
+"The first call to this function enables a flip scheduler for the onscreen window 'windowPtr'. It measures for "
+"each following flip the time spent on preflip operations, e.g., post-processing by the imaging pipeline, the time "
+"until the gpu has finished rendering the frame, and the time needed to submit the swap request. It keeps running "
+"averages of these costs and their variability, and predicts from them how much time must be reserved before a "
+"video refresh. Gpu rendering time is only measured if the gpu supports timestamp queries, ie. GL_ARB_timer_query. "
+"Timing of async flips is only partially measured. The estimates settle after a few dozen flips.\n\n"
+"'when' The target time for stimulus onset, as you would pass it to Screen('Flip'). The default of zero means the "
+"next video refresh whose deadline has not yet passed.\n"
+"'autoThrottle' If set to 1, flips for which the scheduler predicts, after preflip operations are done, that they will "
+"miss the video refresh targeted by their 'when' are retargeted to the next achievable video refresh, instead of "
+"completing at some unpredictable time. Such flips are not reported as deadline misses. Only applies to standard "
+"synchronous flips of fixed refresh rate displays. 0 disables throttling, which is the default.\n"
+"'safetyMargin' Additional safety margin in seconds, which is added to the predicted cost. Defaults to 0.001 seconds.\n\n"
+"Returns the 'deadline' in GetSecs time, the 'predictedOnset' time of the targeted video refresh, a vector 'costs' with "
+"the current estimates of [preflip, gpu, swap] cost in seconds, and the number 'throttledFlips' of flips retargeted by "
+"'autoThrottle'. 'deadline' and 'predictedOnset' are zero if video refresh timing is not yet known, e.g., before the "
+"first vsynced flip.\n";
+
+static char seeAlsoString[] = "Flip AsyncFlipBegin GetFlipInfo";
+
+PsychError SCREENGetFlipDeadline(void)
+{
+    PsychWindowRecordType   *windowRecord;
+    double                  when = 0;
+    double                  safetyMargin = -1;
+    int                     autoThrottle = -1;
+    int                     throttledFlips;
+    double                  deadline, onset;
+    double                  *costs;
+
+    // All sub functions should have these two lines
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(4));
+    PsychErrorExit(PsychRequireNumInputArgs(1));
+    PsychErrorExit(PsychCapNumOutputArgs(4));
+
+    PsychAllocInWindowRecordArg(kPsychUseDefaultArgPosition, TRUE, &windowRecord);
+    if (!PsychIsOnscreenWindow(windowRecord))
+        PsychErrorExitMsg(PsychError_user, "Invalid 'windowPtr' specified. Not an onscreen window!");
+
+    PsychCopyInDoubleArg(2, FALSE, &when);
+
+    PsychCopyInIntegerArg(3, FALSE, &autoThrottle);
+
+    if (PsychCopyInDoubleArg(4, FALSE, &safetyMargin) && (safetyMargin < 0))
+        PsychErrorExitMsg(PsychError_user, "Invalid negative 'safetyMargin' specified.");
+
+    // Enable scheduler on first use and apply new settings:
+    PsychFlipSchedulerEnable(windowRecord);
+    PsychFlipSchedulerSetParameters(windowRecord, autoThrottle, safetyMargin);
+
+    PsychAllocOutDoubleMatArg(3, FALSE, 1, 3, 1, &costs);
+    deadline = PsychFlipSchedulerGetDeadline(windowRecord, when, &onset, costs, &throttledFlips);
+
+    PsychCopyOutDoubleArg(1, FALSE, deadline);
+    PsychCopyOutDoubleArg(2, FALSE, onset);
+    PsychCopyOutDoubleArg(4, FALSE, (double) throttledFlips);
+
+    return(PsychError_none);
+}
@@ -46,6 +46,9 @@ static char synopsisString[] =
 "vary, depending on many factors.\n"
 "A setting of 2 will skip creation and return of an actual video texture, instead a texture handle of 1 will be returned and no texture "
 "gets created. This is useful for fast fine-grained forward seeking in the movie by skipping single frames, and for benchmarking.\n"
+"A setting of 4 means that 'fortimeindex' is not a time in seconds, but the number of the requested video frame, starting with 0 for the first "
+"frame. This is exact and efficient if the movie was opened with the 'FrameIndex=1' option in 'movieOptions' of Screen('OpenMovie'), "
+"otherwise the frame number is converted into a time based on the nominal framerate of the movie.\n"
 ;
 
 static char seeAlsoString[] = "CloseMovie PlayMovie GetMovieImage GetMovieTimeIndex SetMovieTimeIndex";
@@ -100,6 +103,11 @@ PsychError SCREENGetMovieImage(void)
     // Get the optional specialFlags2 flag:
     PsychCopyInIntegerArg(6, FALSE, &specialFlags2);
 
+    // Is 'fortimeindex' a frame number instead of a time in seconds? Then convert it to the frames presentation time:
+    if ((specialFlags2 & 4) && (requestedTimeIndex >= 0)) {
+        requestedTimeIndex = PsychGetMovieFrameTimeIndex(moviehandle, (int) (requestedTimeIndex + 0.5));
+    }
+
     PsychGetAdjustedPrecisionTimerSeconds(&deadline);
     deadline += 5;
 
@@ -22,8 +22,14 @@
 
 #include "Screen.h"
 
-static char useString[] = "timeindex = Screen('GetMovieTimeIndex', moviePtr);";
-static char synopsisString[] = "Return current time index for movie object 'moviePtr'.";
+static char useString[] = "[timeindex, stats] = Screen('GetMovieTimeIndex', moviePtr);";
+static char synopsisString[] = "Return current time index for movie object 'moviePtr'.\n"
+                               "The optional struct 'stats' returns playback statistics of the movie: 'DroppedFrames' is the "
+                               "number of frames dropped during the current or last playback to stay in sync with the clock. "
+                               "'UploadRingFrames' is the number of frames uploaded to textures via the ring of pixel buffers, "
+                               "'UploadRingStalls' the number of times the upload had to wait for a free buffer in the ring, "
+                               "'UploadCopyTimeAvg' and 'UploadCopyTimeMax' are the average and maximum time in seconds for "
+                               "copying a frame into the ring. The upload statistics accumulate over the lifetime of the movie.";
 static char seeAlsoString[] = "CloseMovie PlayMovie GetMovieImage GetMovieTimeIndex SetMovieTimeIndex";
 
 PsychError SCREENGetMovieTimeIndex(void) 
@@ -36,7 +42,7 @@ PsychError SCREENGetMovieTimeIndex(void)
     
     PsychErrorExit(PsychCapNumInputArgs(1));            // Max. 1 input args.
     PsychErrorExit(PsychRequireNumInputArgs(1));        // Min. 1 input args required.
-    PsychErrorExit(PsychCapNumOutputArgs(1));           // One output arg.
+    PsychErrorExit(PsychCapNumOutputArgs(2));           // Two output args.
     
     // Get the movie handle:
     PsychCopyInIntegerArg(1, TRUE, &moviehandle);
@@ -46,6 +52,9 @@ PsychError SCREENGetMovieTimeIndex(void)
     
     // Retrieve and return current movie time index:
     PsychCopyOutDoubleArg(1, TRUE, PsychGetMovieTimeIndex(moviehandle));
+
+    // Return optional playback statistics:
+    PsychCopyOutMovieStats(moviehandle, 2);
     
     return(PsychError_none);
 }
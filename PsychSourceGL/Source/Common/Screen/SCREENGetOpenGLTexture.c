@@ -65,6 +65,13 @@ PsychError SCREENGetOpenGLTexture(void)
     // Query optional y-pos:
     PsychCopyInDoubleArg(4, FALSE, &y);
 
+    // External code may access the texture from a different OpenGL context, so make sure
+    // any asynchronous upload of its content has completed before handing it out:
+    PsychCheckAsyncTextureUpload(textureRecord, TRUE);
+
+    // External code needs a stable texture handle, so exclude the texture from eviction by the residency manager:
+    PsychTextureResidencyPin(textureRecord);
+
     // Return the OpenGL texture handle:
     PsychCopyOutDoubleArg(1, FALSE, (double) textureRecord->textureNumber);
     
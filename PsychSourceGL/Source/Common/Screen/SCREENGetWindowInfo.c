@@ -177,6 +177,37 @@ static char synopsisString[] =
     "An 'infoType' of 8 returns 1 if the X-Screens primary gpu uses the modesetting-ddx under Linux.\n\n"
     "An 'infoType' of 9 returns a struct with interop info needed for interop with certain clients, "
     "currently tailored to the needs of OpenGL interop with the OpenXR api on Linux and Windows.\n\n"
+    "An 'infoType' of 10 returns a struct with statistics of the texture residency manager, see "
+    "Screen('PreloadTextures?') and Screen('Preference', 'TextureMemoryBudget'). These are global "
+    "for all windows: 'Budget' and 'ResidentBytes' are the budget and current VRAM consumption of "
+    "managed textures in bytes, 'EvictedBytes' the system memory consumption of evicted textures. "
+    "'NumResident' and 'NumEvicted' count resident and evicted textures. 'Hits' and 'Misses' count "
+    "draws of textures which were resident or needed a re-upload, 'Evictions' counts evictions. "
+    "'BytesUploadedTotal', 'BytesUploadedThisFrame' and 'BytesUploadedLastFrame' report upload "
+    "traffic into managed textures in total, since the last flip, and between the last two flips. As the manager "
+    "is shared by all windows, a flip of any onscreen window starts a new frame for these statistics. Eviction "
+    "picks the least recently drawn texture across all windows.\n\n"
+    "An 'infoType' of 11 controls the per-frame profiler of onscreen window 'windowPtr' and returns its results. "
+    "Call with 'auxArg1' set to the number of frames to buffer to enable the profiler, with 'auxArg1' zero to "
+    "disable it. Without 'auxArg1', returns a struct array with one element for each frame completed since the "
+    "last query, oldest first, up to the number of buffered frames. All durations are in seconds: 'FrameCount' is "
+    "the flip count at the end of the frame, 'FrameStartTime' the system time when the frame started. "
+    "'UserDrawingCPU/GPU' is the time spent for user drawing between the end of the previous flip and the start "
+    "of preflip operations at 'Flip' or 'DrawingFinished'. 'PreFlipCPU/GPU' is the time spent in preflip "
+    "operations, e.g., imaging pipeline post-processing. 'SwapCPU' is the time from the end of preflip "
+    "operations until swap completion, 'PostFlipCPU/GPU' the time spent in postflip operations, e.g., clearing "
+    "the backbuffer. 'HookChainCPU' and 'HookChainGPU' are vectors with the time spent executing each imaging "
+    "pipeline hook chain, in the order listed by Screen('HookFunction', windowPtr, 'ListAll'). Hook chains "
+    "executed within preflip operations are also included in 'PreFlipCPU/GPU'. GPU times are measured via "
+    "OpenGL timestamp queries, so they are only available a few frames later, and are -1 on GPUs without "
+    "support for timestamp queries. For asynchronous flips, a frame is finished "
+    "by Screen('AsyncFlipEnd') or a successfull Screen('AsyncFlipCheckEnd'), so 'SwapCPU' includes all time until then, "
+    "and no postflip timing is reported.\n\n"
+    "An 'infoType' of 12 returns a struct with statistics of the text layout cache, which caches text bounding "
+    "boxes for Screen('TextBounds') and Screen('DrawText') with the default text renderer, see "
+    "Screen('Preference', 'TextLayoutCacheSize'). These are global for all windows: 'Capacity' is the maximum "
+    "number of cached layouts, 'NumEntries' the current number, 'Hits' and 'Misses' count lookups which could "
+    "or could not be served from the cache.\n\n"
     "\n"
     "The default info struct for 'infoType' 7 and the default 'infoType' 0 contains all kinds of information. "
     "Just check its output to see what is returned. Most of this info is not interesting for normal users, "
@@ -205,6 +236,8 @@ static char synopsisString[] =
     "MissedDeadlines: Number of missed Screen('Flip') stimulus onset deadlines, according to internal skip detector.\n"
     "FlipCount: Total number of flip command executions, ie., of stimulus updates.\n"
     "GuesstimatedMemoryUsageMB: Estimated memory usage of window or texture in Megabytes. Can be very inaccurate or unavailable!\n"
+    "PipelineMemoryBytes: Graphics memory in bytes allocated for the framebuffers of the window, e.g., of its imaging pipeline.\n"
+    "PipelinePooledBytes: Graphics memory in bytes saved by sharing framebuffers between imaging pipeline stages which are never in use at the same time.\n"
     "VBLStartLine, VBLEndline: Start/Endline of vertical blanking interval. The VBLEndline value is not available/valid on all GPU's.\n"
     "SwapGroup: Swap group id of the swap group to which this window is assigned. Zero for none.\n"
     "SwapBarrier: Swap barrier id of the swap barrier to which this windows swap group is assigned. Zero for none.\n"
@@ -242,14 +275,16 @@ PsychError SCREENGetWindowInfo(void)
                                 "GuesstimatedMemoryUsageMB", "VBLStartline", "VBLEndline", "VideoRefreshFromBeamposition", "GLVendor", "GLRenderer", "GLVersion", "GPUCoreId", "GPUMinorType",
                                 "DisplayCoreId", "GLSupportsFBOUpToBpc", "GLSupportsBlendingUpToBpc", "GLSupportsTexturesUpToBpc", "GLSupportsFilteringUpToBpc", "GLSupportsPrecisionColors",
                                 "GLSupportsFP32Shading", "BitsPerColorComponent", "IsFullscreen", "SpecialFlags", "SwapGroup", "SwapBarrier", "SysWindowHandle", "ExternalMouseMultFactor", "VRRMode",
-                                "VRRStyleHint", "VRRLatencyCompensation", "GLDeviceUUID", "SysWindowInteropHandle" };
-    const int fieldCount = 44;
+                                "VRRStyleHint", "VRRLatencyCompensation", "GLDeviceUUID", "SysWindowInteropHandle",
+                                "PipelineMemoryBytes", "PipelinePooledBytes" };
+    const int fieldCount = 46;
     PsychGenericScriptType *s;
 
     PsychWindowRecordType *windowRecord;
     double beamposition, lastvbl;
     int infoType = 0;
     double auxArg1, auxArg2, auxArg3;
+    double pipelineBytes, pooledBytes;
     CGDirectDisplayID displayId;
     psych_uint64 postflip_vblcount;
     psych_bool onscreen;
@@ -267,7 +302,7 @@ PsychError SCREENGetWindowInfo(void)
 
     // Query infoType flag: Defaults to zero.
     PsychCopyInIntegerArg(2, FALSE, &infoType);
-    if (infoType < -1 || infoType > 9) PsychErrorExitMsg(PsychError_user, "Invalid 'infoType' argument specified! Valid are -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9.");
+    if (infoType < -1 || infoType > 12) PsychErrorExitMsg(PsychError_user, "Invalid 'infoType' argument specified! Valid are -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12.");
 
     // Windowserver info requested?
     if (infoType == 2 || infoType == 3) {
@@ -468,6 +503,57 @@ PsychError SCREENGetWindowInfo(void)
             PsychSetStructArrayUnsignedInt64Element("OpenGLVisualId", 0, (psych_uint64) (size_t) 0, s);
         #endif
     }
+    else if (infoType == 10) {
+        // Statistics of the texture residency manager:
+        const char* FieldNamesResidency[] = { "Budget", "ResidentBytes", "EvictedBytes", "NumResident", "NumEvicted", "Hits", "Misses", "Evictions",
+                                              "BytesUploadedTotal", "BytesUploadedThisFrame", "BytesUploadedLastFrame" };
+        const int fieldCountResidency = 11;
+        PsychTextureResidencyStatsType stats;
+
+        PsychTextureResidencyGetStats(&stats);
+
+        PsychAllocOutStructArray(1, FALSE, -1, fieldCountResidency, FieldNamesResidency, &s);
+        PsychSetStructArrayDoubleElement("Budget", 0, (double) stats.budget, s);
+        PsychSetStructArrayDoubleElement("ResidentBytes", 0, (double) stats.residentBytes, s);
+        PsychSetStructArrayDoubleElement("EvictedBytes", 0, (double) stats.evictedBytes, s);
+        PsychSetStructArrayDoubleElement("NumResident", 0, (double) stats.numResident, s);
+        PsychSetStructArrayDoubleElement("NumEvicted", 0, (double) stats.numEvicted, s);
+        PsychSetStructArrayDoubleElement("Hits", 0, (double) stats.hits, s);
+        PsychSetStructArrayDoubleElement("Misses", 0, (double) stats.misses, s);
+        PsychSetStructArrayDoubleElement("Evictions", 0, (double) stats.evictions, s);
+        PsychSetStructArrayDoubleElement("BytesUploadedTotal", 0, (double) stats.bytesUploadedTotal, s);
+        PsychSetStructArrayDoubleElement("BytesUploadedThisFrame", 0, (double) stats.bytesUploadedThisFrame, s);
+        PsychSetStructArrayDoubleElement("BytesUploadedLastFrame", 0, (double) stats.bytesUploadedLastFrame, s);
+    }
+    else if (infoType == 11) {
+        if (!onscreen) {
+            PsychErrorExitMsg(PsychError_user, "Tried to use the frame profiler on a texture or offscreen window. Only supported on onscreen windows!");
+        }
+
+        // (Re-)Configure or disable profiler if requested:
+        if (PsychCopyInDoubleArg(3, FALSE, &auxArg1)) {
+            if (auxArg1 < 0) PsychErrorExitMsg(PsychError_user, "Invalid number of frames for frame profiler specified. Must be zero or greater.");
+            PsychProfilerEnable(windowRecord, (int) auxArg1);
+        }
+
+        // Return profiling results of all frames completed since last query:
+        PsychProfilerCopyOutResults(windowRecord, 1);
+    }
+    else if (infoType == 12) {
+        // Statistics of the text layout cache:
+        const char* FieldNamesLayoutCache[] = { "Capacity", "NumEntries", "Hits", "Misses" };
+        const int fieldCountLayoutCache = 4;
+        int capacity, numEntries;
+        double hits, misses;
+
+        PsychTextLayoutCacheGetStats(&capacity, &numEntries, &hits, &misses);
+
+        PsychAllocOutStructArray(1, FALSE, -1, fieldCountLayoutCache, FieldNamesLayoutCache, &s);
+        PsychSetStructArrayDoubleElement("Capacity", 0, (double) capacity, s);
+        PsychSetStructArrayDoubleElement("NumEntries", 0, (double) numEntries, s);
+        PsychSetStructArrayDoubleElement("Hits", 0, (double) hits, s);
+        PsychSetStructArrayDoubleElement("Misses", 0, (double) misses, s);
+    }
     else {
         // Set OpenGL context (always needed) and drawing target, as setting
         // our windowRecord as a drawingtarget is an expected side-effect of
@@ -571,6 +657,9 @@ PsychError SCREENGetWindowInfo(void)
         PsychSetStructArrayDoubleElement("FlipCount", 0, windowRecord->flipCount, s);
         PsychSetStructArrayDoubleElement("StereoDrawBuffer", 0, windowRecord->stereodrawbuffer, s);
         PsychSetStructArrayDoubleElement("GuesstimatedMemoryUsageMB", 0, (double) windowRecord->surfaceSizeBytes / 1024 / 1024, s);
+        pipelineBytes = PsychPipelineGetMemoryFootprint(windowRecord, &pooledBytes);
+        PsychSetStructArrayDoubleElement("PipelineMemoryBytes", 0, pipelineBytes, s);
+        PsychSetStructArrayDoubleElement("PipelinePooledBytes", 0, pooledBytes, s);
         PsychSetStructArrayDoubleElement("BitsPerColorComponent", 0, (double) windowRecord->bpc, s);
 
         // Return VBL startline:
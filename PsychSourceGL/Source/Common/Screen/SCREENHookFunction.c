@@ -119,6 +119,18 @@ static char synopsisString[] =
     "Screen('HookFunction', windowPtr, 'DumpAll'); \n"
     "Print out all chains for the given onscreen window 'windowPtr' to the Matlab console in a human readable format - Useful for debugging."
     "\n\n"
+    "passes = Screen('HookFunction', windowPtr, 'FuseShaders', hookname [, enable=1]); \n"
+    "Enable (default) or disable shader fusion for hook chain 'hookname' of onscreen window 'windowPtr'. With fusion enabled, "
+    "runs of consecutive GLSL shader slots, separated by 'Builtin:FlipFBOs' slots, are combined into a single GLSL program "
+    "which is executed in one pass, instead of one render pass per slot with a full read and write of the framebuffer each. "
+    "Only shaders which compute the output color of a pixel from the input color of the same pixel can be fused, e.g., color "
+    "space conversions, gamma correction or gain adjustments. Shaders with a vertex shader, shaders which sample the input "
+    "image at other locations, e.g., filter kernels, and slots with other blitters than the default identity blitter stay "
+    "separate passes. Uniform values of the original shaders are copied into the fused program each time it is executed, "
+    "so changes to the original shaders uniforms take effect as usual. The fused programs are rebuilt automatically after "
+    "the hook chain got modified. Returns the number of render passes needed to execute the hook chain with the new "
+    "setting. Use the 'Dump' subcommand to find out which slots got fused."
+    "\n\n"
     "oldImagingMode = Screen('HookFunction', proxyPtr, 'ImagingMode' [, imagingMode]); \n"
     "Change or query imagingMode flags of provided proxy window 'proxyPtr' to 'imagingMode'. Proxy windows are used to define "
     "image processing operations, mostly for Screen('TransformTexture'). Returns old imaging mode."
@@ -308,6 +320,7 @@ PsychError SCREENHookFunction(void)
     if (strcmp(cmdString, "ImportDisplayBufferInteropMemory")==0) cmd=19;
     if (strcmp(cmdString, "SetHDRScalingFactors")==0) cmd=20;
     if (strcmp(cmdString, "WindowColorGamut")==0) cmd=21;
+    if (strcmp(cmdString, "FuseShaders")==0) cmd=22;
 
     if (cmd == 0) PsychErrorExitMsg(PsychError_user, "Unknown subcommand specified to 'HookFunction'.");
     if (whereloc < 0) PsychErrorExitMsg(PsychError_user, "Unknown/Invalid/Unparseable insert location specified to 'HookFunction' 'InsertAtXXX'.");
@@ -664,6 +677,13 @@ PsychError SCREENHookFunction(void)
                 memcpy(&windowRecord->colorGamut[0], dblmat, sizeof(windowRecord->colorGamut));
             }
         break;
+
+        case 22: // FuseShaders
+            // Enable or disable fusion of shader slots, return resulting number of render passes:
+            flag1 = 1;
+            PsychCopyInIntegerArg(4, FALSE, &flag1);
+            PsychCopyOutDoubleArg(1, FALSE, (double) PsychPipelineFuseHook(windowRecord, hookString, (flag1 > 0) ? TRUE : FALSE));
+        break;
     }
 
     // Done.
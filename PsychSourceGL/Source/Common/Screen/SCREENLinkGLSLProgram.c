@@ -0,0 +1,81 @@
+/*
+ *    SCREENLinkGLSLProgram.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Link a GLSL program object created by M-File code, using the GLSL program
+ *    binary cache of the imaging pipeline.
+ */
+
+#include "Screen.h"
+
+// If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
+static char useString[] = "[linked, cacheHit] = Screen('LinkGLSLProgram', windowPtr, glslProgram [, preLinkState]);";
+//                          1       2                                       1          2              3
+static char synopsisString[] =
+"Link the GLSL program object 'glslProgram' with its attached and already compiled shaders, like "
+"glLinkProgram(glslProgram) would do, but use the on-disk GLSL program binary cache of Screen.\n"
+"If a linked program binary for the same shader source code, graphics driver and Screen version is found "
+"in the cache, it is loaded instead of linking the program. Otherwise the program is linked and the result "
+"stored in the cache. This avoids the often substantial link time of complex shaders on repeated runs of "
+"a script, e.g., for the shaders used by PsychImaging for color correction, HDR or display devices like "
+"Bits++. LoadGLSLProgramFromFiles() uses this function to link its programs.\n"
+"The program is linked in the OpenGL context of window 'windowPtr', or in the current userspace OpenGL "
+"context between Screen('BeginOpenGL') and Screen('EndOpenGL'). If the graphics driver does not support "
+"program binaries, or the cache is disabled via the environment variable PSYCH_DISABLE_GLSL_PROGRAM_CACHE, "
+"the program is simply linked.\n"
+"OpenGL can't report state which was assigned to the program before linking, e.g., via glBindAttribLocation(), "
+"glBindFragDataLocation() or glTransformFeedbackVaryings(). If you assigned such state, pass a string which "
+"describes it uniquely as 'preLinkState', e.g., the names and assigned locations of all attributes. It becomes "
+"part of the cache key, so programs with the same shaders, but different state don't share a cache entry.\n"
+"Returns 'linked' = 1 if the program was successfully linked or loaded, 0 if linking failed, in which case "
+"glGetProgramInfoLog() provides the reason. 'cacheHit' is 1 if the program was loaded from the cache.\n";
+
+static char seeAlsoString[] = "BeginOpenGL EndOpenGL";
+
+PsychError SCREENLinkGLSLProgram(void)
+{
+    PsychWindowRecordType *windowRecord;
+    int glslProgram;
+    char *preLinkState = NULL;
+    psych_bool cacheHit;
+    GLint status = GL_FALSE;
+
+    // All sub functions should have these two lines
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(3));
+    PsychErrorExit(PsychRequireNumInputArgs(2));
+    PsychErrorExit(PsychCapNumOutputArgs(2));
+
+    PsychAllocInWindowRecordArg(1, TRUE, &windowRecord);
+
+    // Bind the windows OpenGL context, unless usercode has its own context bound for userspace rendering:
+    if (!PsychIsUserspaceRendering()) PsychSetGLContext(windowRecord);
+
+    PsychCopyInIntegerArg(2, TRUE, &glslProgram);
+    if ((glslProgram <= 0) || !glIsProgram((GLuint) glslProgram))
+        PsychErrorExitMsg(PsychError_user, "Invalid 'glslProgram' specified. Not a GLSL program object!");
+
+    PsychAllocInCharArg(3, FALSE, &preLinkState);
+
+    cacheHit = PsychLinkGLSLProgramCached((GLuint) glslProgram, preLinkState);
+    glGetProgramiv((GLuint) glslProgram, GL_LINK_STATUS, &status);
+
+    if (cacheHit && (PsychPrefStateGet_Verbosity() > 4))
+        printf("PTB-DEBUG: Screen('LinkGLSLProgram'): Loaded GLSL program %i from the program binary cache.\n", glslProgram);
+
+    PsychCopyOutDoubleArg(1, FALSE, (status == GL_TRUE) ? 1 : 0);
+    PsychCopyOutDoubleArg(2, FALSE, (cacheHit) ? 1 : 0);
+
+    return(PsychError_none);
+}
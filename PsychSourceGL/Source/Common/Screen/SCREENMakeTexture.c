@@ -65,6 +65,22 @@ static char synopsisString[] =
 "A 'specialFlags' == 8 will prevent automatic mipmap-generation for GL_TEXTURE_2D textures.\n"
 "A 'specialFlags' == 32 setting will prevent automatic closing of the texture if Screen('Close'); is called. Only "
 "Screen('Close', textureIndex); would close the texture.\n"
+"A 'specialFlags' == 64 setting will upload the texture content asynchronously via an OpenGL pixel buffer object, if "
+"the graphics driver supports this. The function then returns the texture handle as soon as the image data has been "
+"handed over to the driver, without waiting for the upload into video memory to finish. You can use the texture "
+"immediately, e.g., in 'DrawTexture', as the graphics card will finish the upload before it draws the texture. Use "
+"Screen('TextureUploadStatus', textureIndex) to find out if an upload has completed, e.g., when creating large numbers "
+"of textures between trials. Planar textures, as selected via 'specialFlags' == 4, are always uploaded synchronously.\n"
+"If a texture memory budget is set via Screen('Preference', 'TextureMemoryBudget', bytes), the least recently drawn "
+"textures get evicted from video memory into a compressed copy in system memory whenever the budget is exceeded, and "
+"get uploaded again on their next use. See Screen('PreloadTextures?') for more info.\n"
+"A 'specialFlags' == 128 setting will store 8 bpc RGB or RGBA textures in a compressed format, if the graphics "
+"driver supports S3TC texture compression: RGB images are compressed into BC1 format, needing only 1/8th of the memory "
+"of an uncompressed RGBA8 texture, RGBA images into BC3 format, needing 1/4th of the memory. Compression happens on the "
+"cpu at texture creation time and reduces both video memory consumption and upload time at the expense of some image "
+"quality, so it is meant for large banks of natural images, not for precise stimuli like gratings. The flag also implies "
+"creation of a GL_TEXTURE_2D texture, as with 'specialFlags' == 1. If compression is unsupported for a texture, a normal "
+"uncompressed texture is created instead.\n"
 "'floatprecision' defines the precision with which the texture should be stored and processed. If omitted, the default value "
 "in normal display mode is zero, which asks to store textures with 8 bit per color component precision in unsigned normalized "
 "(unorm) color range, a suitable format for standard images read via imread() and displayed on normal display devices. If the "
@@ -774,6 +790,15 @@ PsychError SCREENMakeTexture(void)
         textureRecord->specialflags = kPsychPlanarTexture;
     }
     else {
+        // specialFlags setting 64? Request asynchronous upload via a pixel buffer object:
+        if (usepoweroftwo & 64) textureRecord->specialflags |= kPsychAsyncTextureUpload;
+
+        // specialFlags setting 128? Request compressed texture storage. Compressed formats require GL_TEXTURE_2D textures:
+        if (usepoweroftwo & 128) {
+            textureRecord->specialflags |= kPsychCompressedTexture;
+            if (windowRecord->gfxcaps & kPsychGfxCapNPOTTex) textureRecord->texturetarget = GL_TEXTURE_2D;
+        }
+
         // Let's create and bind a new texture object and fill it with our new texture data.
         PsychCreateTexture(textureRecord);
 
@@ -817,6 +842,10 @@ PsychError SCREENMakeTexture(void)
     // A specialFlags setting of 32? Protect texture against deletion via Screen('Close') without providing a explicit handle:
     if (usepoweroftwo & 32) textureRecord->specialflags |= kPsychDontDeleteOnClose;
 
+    // Register texture with the texture residency manager, so it can get evicted from VRAM if
+    // a texture memory budget is set via Screen('Preference', 'TextureMemoryBudget'):
+    PsychTextureResidencyRegister(textureRecord);
+
     if (PsychPrefStateGet_DebugMakeTexture())     //MARK #4
         StoreNowTime();
 
@@ -102,6 +102,10 @@ static char synopsisString[] =
         "set the 'pixelFormat' parameter to 1 for this to work. You can choose the Bayer filtering method via 'DebayerMethod' "
         "setting and the color sensor filter pattern via 'OverrideBayerPattern' setting in Screen('SetVideoCaptureParameter', -1, ...). "
         "By default, fast nearest neighbour debayering with an assumed sensor image layout of RGGB is performed.\n"
+        "By default, video frames are uploaded into textures asynchronously from a small ring of persistently mapped OpenGL "
+        "pixel buffer objects on desktop OpenGL, which reduces the time spent in Screen('GetMovieImage'). A 'specialFlags1' "
+        "setting of 2048 disables this and uses standard synchronous texture upload. At a Verbosity level of 4 or higher, "
+        "statistics about frame copy times are printed when the movie is closed.\n"
         "'pixelFormat' optional argument specifying the pixel format of decoded video frames. Not all possible valid "
         "values are supported by all video codecs, graphics cards and operating systems. If an unsupported format is "
         "requested, Screen() will try to choose the closest matching format that meets or exceeds the specified format, "
@@ -152,7 +156,21 @@ static char synopsisString[] =
         "Linux pulsesink plugin to send sound data to the output named 'MyCardsOutput1' via the PulseAudio sound server commonly "
         "used on Linux desktop systems.\n"
         "If you set a Screen() verbosity level of 4 or higher, Screen() will print out the actually used audio output at the end "
-        "of movie playback on operating systems which support this. This can help debugging issues with audio routing if you don't hear sound.\n";
+        "of movie playback on operating systems which support this. This can help debugging issues with audio routing if you don't hear sound.\n"
+        "FrameIndex=1 -- Use a frame index for frame accurate random access to the movie. The index contains the exact presentation "
+        "timestamps of all video frames and the location of keyframes. It is built by parsing, but not decoding, the movie when it is "
+        "opened for the first time, and then stored next to the movie file in a file with the same name and the extension .ptbindex, "
+        "so later sessions can load it quickly. The index is rebuilt if the movie file changes. With an index, Screen('SetMovieTimeIndex') "
+        "with 'indexIsFrames' = 1 and Screen('GetMovieImage') with 'specialFlags2' = 4 seek exactly to a given frame number, and short "
+        "forward jumps in stopped movies are done by decoding the frames in between instead of a full seek. The returned 'count' of "
+        "frames is exact as well. Only local movie files with a video stream are indexed, not network or live streams.\n"
+        "FrameCache=budgetMB -- Keep the decoded video frames of the first complete forward playback pass of the movie in system "
+        "memory, using at most budgetMB Megabytes of memory. Once all frames are cached, all following playback, looped playback and "
+        "seeking is served from the cache, timed by the system clock, without any video decoding and without startup delays. This "
+        "is meant for short clips which are played many times per session. If the decoded frames exceed the budget, caching is "
+        "disabled and playback proceeds as usual. If frames get dropped during the first pass, caching is retried during the next "
+        "pass. Cached playback can't play sound, so the frame cache is only supported for movies without sound, or if sound playback "
+        "is disabled via 'specialFlags1' setting 2.\n";
 
 static char seeAlsoString[] = "CloseMovie PlayMovie GetMovieImage GetMovieTimeIndex SetMovieTimeIndex";
 
@@ -117,6 +117,13 @@ static char synopsisString[] =
 "By default, if the flag is omitted, some performance loss will be present, but capture will be more robust "
 "with problematic cameras. "
 "A setting of 8192 requests to avoid any use of videorate converters, not even for recording (see above).\n"
+"A setting of 16384 hands captured frames from the video engine to Screen('GetCapturedImage') via a lock-free "
+"queue of 'numbuffers' frames if specified, otherwise of up to 4 frames, but less if the video source has fewer "
+"capture buffers, instead of the default locked queue. Frames "
+"are already mapped for access when they are fetched, which reduces cpu overhead and latency at high capture "
+"framerates. New frames are dropped if the queue is full. See Screen('SetVideoCaptureParameter', ..., 'GetQueueStats').\n"
+"A setting of 32768 uploads captured frames into textures via OpenGL pixel buffer objects. This may reduce "
+"the time Screen('GetCapturedImage') takes on some systems.\n"
 "\n"
 "'captureEngineType' This optional parameter allows selection of the video capture engine to use for this "
 "video source. Allowable values are currently 1 and 3. "
@@ -85,7 +85,10 @@ static char synopsisString[] =
     "e.g., Vulkan or some VR compositor or such. This tells Screen() to suppress certain warnings or checks "
     "which would be prudent if the window were the primary and critical means of visual stimulation. "
     "The flag kPsychDontUseFlipperThread prevents use of the internal background flipper thread, and thereby "
-    "of any functionality depending on it, e.g., frame-sequential stereomode 11 and async flips.\n\n"
+    "of any functionality depending on it, e.g., frame-sequential stereomode 11 and async flips. "
+    "The flag kPsychHeadlessWindow opens a headless window without any connection to a display, for batch "
+    "generation of stimulus images or movies, e.g., on compute nodes without a display server. See 'help "
+    "kPsychHeadlessWindow' for more info.\n\n"
     "\"clientRect\" This optional parameter allows to define a size of the onscreen windows drawing area "
     "that is different from the actual size of the windows framebuffer. If set, then the imaging pipeline "
     "is started and a virtual framebuffer of the size of \"clientRect\" is created. Your code will draw "
@@ -319,9 +322,20 @@ PsychError SCREENOpenWindow(void)
     PsychCopyInIntegerArg64(9,FALSE, &specialflags);
     if (specialflags < 0 || (specialflags > 0 &&
         !(specialflags & (kPsychGUIWindow | kPsychGUIWindowWMPositioned | kPsychBackendDecisionMade | kPsychExternalDisplayMethod | kPsychDontUseFlipperThread |
-          kPsychSkipSecondaryVsyncForFlip))))
+          kPsychSkipSecondaryVsyncForFlip | kPsychHeadlessWindow))))
         PsychErrorExitMsg(PsychError_user, "Invalid 'specialflags' provided.");
 
+    if (specialflags & kPsychHeadlessWindow) {
+        // Headless windows are only supported via the EGL surfaceless platform of the Waffle display backend:
+        #if !((PSYCH_SYSTEM == PSYCH_LINUX) && defined(PTB_USE_WAFFLE))
+            PsychErrorExitMsg(PsychError_user, "Headless windows via 'specialflags' kPsychHeadlessWindow are only supported on Linux with the Waffle display backend.");
+        #endif
+
+        // A headless window is never used for visual stimulation, so skip all checks and warnings which only
+        // matter for a real display, just as for external display methods:
+        specialflags |= kPsychExternalDisplayMethod;
+    }
+
     // Check if this is macOS on a Apple Silicon ARM M1+ SoC with Apple proprietary gpu:
     #if PSYCH_SYSTEM == PSYCH_OSX
     {
@@ -0,0 +1,92 @@
+/*
+ *    SCREENPlayMovieGroup.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Start/Stop synchronized playback of a group of movies which share one common
+ *    playback clock and start time.
+ */
+
+#include "Screen.h"
+
+// If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
+static char useString[] = "[droppedframes, meanLag, maxLag] = Screen('PlayMovieGroup', moviePtrs, rate [, loop=0][, soundvolume=1][, when=0]);";
+//                          1              2        3                                 1          2       3         4                5
+static char synopsisString[] =
+"Start or stop synchronized playback of a group of movies.\n\n"
+"'moviePtrs' is a vector of handles of movies opened via Screen('OpenMovie'). All movies in the group get "
+"driven by one common playback clock with a common start time, so they start at the same time and stay in "
+"lockstep during playback without drifting apart, e.g., for multi-display setups or for stimuli composed "
+"of multiple video streams. 'rate', 'loop' and 'soundvolume' have the same meaning as in Screen('PlayMovie') "
+"and apply to all movies of the group. A 'rate' of 0 stops playback of all movies of the group.\n"
+"'when' is the requested start time of playback in GetSecs time, e.g., the predicted onset time of a future "
+"Screen('Flip'). If 'when' is omitted or already too close or in the past, playback starts as soon as possible, "
+"which is 50 msecs after the call, to allow all movies to get ready for playback.\n"
+"The function returns vectors with one element per movie: 'droppedframes' is the number of dropped frames, "
+"'meanLag' and 'maxLag' are the mean and maximum lag in seconds of the frames fetched via Screen('GetMovieImage') "
+"behind the presentation time expected from the shared group clock. The values refer to the playback which was "
+"active before this call, so call the function with a 'rate' of 0 after playback to get final statistics.\n"
+"Fetch new frames of all movies as usual via Screen('GetMovieImage').\n";
+
+static char seeAlsoString[] = "PlayMovie OpenMovie GetMovieImage CloseMovie";
+
+PsychError SCREENPlayMovieGroup(void)
+{
+    int         numMovies, i, loop = 0;
+    int         *moviehandles;
+    double      rate = 0;
+    double      sndvolume = 1;
+    double      when = 0;
+    double      *dropped, *meanLag, *maxLag;
+
+    // All sub functions should have these two lines
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(5));
+    PsychErrorExit(PsychRequireNumInputArgs(2));
+    PsychErrorExit(PsychCapNumOutputArgs(3));
+
+    // Get the movie handles:
+    PsychAllocInIntegerListArg(1, TRUE, &numMovies, &moviehandles);
+    if (numMovies < 1)
+        PsychErrorExitMsg(PsychError_user, "PlayMovieGroup called without any handles to movie objects.");
+
+    for (i = 0; i < numMovies; i++) {
+        if (moviehandles[i] < 0)
+            PsychErrorExitMsg(PsychError_user, "PlayMovieGroup called with an invalid handle to a movie object.");
+    }
+
+    // Get the requested playback rate:
+    PsychCopyInDoubleArg(2, TRUE, &rate);
+
+    // Get the optional 'loop' flag:
+    PsychCopyInIntegerArg(3, FALSE, &loop);
+
+    // Get the requested sound volume. Defaults to 1 == Full blast!
+    PsychCopyInDoubleArg(4, FALSE, &sndvolume);
+    if (sndvolume < 0) sndvolume = 0;
+    if (sndvolume > 1) sndvolume = 1;
+
+    // Get the optional start time:
+    PsychCopyInDoubleArg(5, FALSE, &when);
+
+    // Per movie statistics:
+    PsychAllocOutDoubleMatArg(1, FALSE, 1, numMovies, 1, &dropped);
+    PsychAllocOutDoubleMatArg(2, FALSE, 1, numMovies, 1, &meanLag);
+    PsychAllocOutDoubleMatArg(3, FALSE, 1, numMovies, 1, &maxLag);
+
+    // Start or stop playback via low-level routines:
+    PsychPlaybackGroup(numMovies, moviehandles, rate, loop, sndvolume, when, dropped, meanLag, maxLag);
+
+    // Ready!
+    return(PsychError_none);
+}
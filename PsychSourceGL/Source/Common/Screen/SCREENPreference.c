@@ -128,6 +128,8 @@ static char synopsisString[] =
     "\noldMode = Screen('Preference', 'DefaultVideocaptureEngine', [newmode (0=Quicktime - unsupported, 1=LibDC1394-Firewire, 2=LibARVideo - unsupported, 3=GStreamer)]);"
     "\noldMode = Screen('Preference', 'OverrideMultimediaEngine', [newmode (0=Legacy-Quicktime - unsupported, 1=GStreamer)]);"
     "\noldLevel = Screen('Preference', 'WindowShieldingLevel', [newLevel (0 = Behind all other windows - 2000 = In front of all other windows, the default)]);"
+    "\noldBudget = Screen('Preference', 'TextureMemoryBudget', [newBudget (Maximum bytes of VRAM for textures, 0 = Unlimited, the default)]);"
+    "\noldSize = Screen('Preference', 'TextLayoutCacheSize', [newSize (Maximum number of cached text layouts, 0 = Disable cache, 512 = Default)]);"
     "\nresiduals = Screen('Preference', 'SynchronizeDisplays', syncMethod [, screenId]);"
     "\noldMappings = Screen('Preference', 'ScreenToHead', screenId [, newHeadId, newCrtcId][, rank=0]);"
 
@@ -174,6 +176,7 @@ PsychError SCREENPreference(void)
     double              maxStddev, maxDeviation, maxDuration;
     int                 minSamples;
     double              *dheads = NULL;
+    PsychTextureResidencyStatsType residencyStats;
 
     //all sub functions should have these two lines
     PsychPushHelp(useString, synopsisString,seeAlsoString);
@@ -387,6 +390,25 @@ PsychError SCREENPreference(void)
                     PsychPrefStateSet_WindowShieldingLevel(tempInt);
                 }
             preferenceNameArgumentValid=TRUE;
+        }else
+            if(PsychMatch(preferenceName, "TextureMemoryBudget")){
+                PsychTextureResidencyGetStats(&residencyStats);
+                PsychCopyOutDoubleArg(1, kPsychArgOptional, (double) residencyStats.budget);
+                if(numInputArgs==2){
+                    PsychCopyInDoubleArg(2, kPsychArgRequired, &inputDoubleValue);
+                    if (inputDoubleValue < 0) PsychErrorExitMsg(PsychError_user, "Invalid negative 'TextureMemoryBudget' provided!");
+                    PsychTextureResidencySetBudget((size_t) inputDoubleValue);
+                }
+            preferenceNameArgumentValid=TRUE;
+        }else
+            if(PsychMatch(preferenceName, "TextLayoutCacheSize")){
+                PsychCopyOutDoubleArg(1, kPsychArgOptional, (double) PsychTextLayoutCacheSetCapacity(-1));
+                if(numInputArgs==2){
+                    PsychCopyInIntegerArg(2, kPsychArgRequired, &tempInt);
+                    if (tempInt < 0) PsychErrorExitMsg(PsychError_user, "Invalid negative 'TextLayoutCacheSize' provided!");
+                    PsychTextLayoutCacheSetCapacity(tempInt);
+                }
+            preferenceNameArgumentValid=TRUE;
         }else
             if(PsychMatch(preferenceName, "ConserveVRAM") || PsychMatch(preferenceName, "Workarounds1")){
                     PsychCopyOutDoubleArg(1, kPsychArgOptional, PsychPrefStateGet_ConserveVRAM());
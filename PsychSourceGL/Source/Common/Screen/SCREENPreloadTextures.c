@@ -39,7 +39,16 @@ static char synopsisString[] =
 "The return value 'resident' tells you, if all requested textures could be preloaded. A value of 1 "
 "means full success. The 'texidresident' vector tells you for each texture, if that "
 "specific texture could be preloaded. Preloading requested textures can fail if your gfx-hardware "
-"has an insufficient amount of free VRAM memory. ";
+"has an insufficient amount of free VRAM memory.\n"
+"If a texture memory budget is set via Screen('Preference', 'TextureMemoryBudget', bytes), then "
+"Psychtoolbox manages residency of textures created via Screen('MakeTexture') itself: It tracks "
+"which textures were drawn most recently. Whenever the textures in VRAM exceed the budget, the least "
+"recently used textures get evicted from VRAM into a compressed copy in system memory. Evicted textures "
+"get automatically uploaded again when they are drawn the next time, which takes extra time. Use this "
+"function with an explicit list of 'texids' before a trial to upload evicted textures ahead of time. "
+"If no 'texids' are given, only textures which are currently not evicted are preloaded. A budget of "
+"zero, the default, disables eviction. Statistics about residency management, e.g., hits, misses and "
+"bytes uploaded per frame, can be queried via Screen('GetWindowInfo', windowPtr, 10).";
 
 static char seeAlsoString[] = "MakeTexture DrawTexture GetMovieImage";	 
 
@@ -55,6 +64,7 @@ PsychError SCREENPreloadTextures(void)
         GLuint*                                 texids;
         GLboolean*                              texresident;
         psych_bool                                 failed = false;
+        int                                     numevicted = 0;
         GLclampf                                maxprio = 1.0f;
         GLenum                                  target;
 
@@ -102,7 +112,7 @@ PsychError SCREENPreloadTextures(void)
             // No handles provided: In this case, we preload all textures:
             n=0;
             for(i=0; i<numWindows; i++) {                
-                if (windowRecordArray[i]->windowType==kPsychTexture) {
+                if (windowRecordArray[i]->windowType==kPsychTexture && !windowRecordArray[i]->textureEvictedData) {
                     n++;
                     // Prioritize this texture:
                     glPrioritizeTextures(1, (GLuint*) &(windowRecordArray[i]->textureNumber), &maxprio);
@@ -123,7 +133,7 @@ PsychError SCREENPreloadTextures(void)
 
             n=0;
             for(i=0; i<numWindows; i++) {                
-                if (windowRecordArray[i]->windowType==kPsychTexture) {
+                if (windowRecordArray[i]->windowType==kPsychTexture && !windowRecordArray[i]->textureEvictedData) {
                     texids[n] = (GLuint) windowRecordArray[i]->textureNumber;
                     n++;
                 }
@@ -139,6 +149,9 @@ PsychError SCREENPreloadTextures(void)
                 texwin = NULL;
                 if (IsWindowIndex(myhandle)) FindWindowRecord(myhandle, &texwin);
                 if (texwin && texwin->windowType==kPsychTexture) {
+                    // Reupload texture if it got evicted by the residency manager:
+                    PsychTextureResidencyTouch(texwin);
+
                     // Prioritize this texture:
                     glPrioritizeTextures(1, (GLuint*) &(texwin->textureNumber), &maxprio);
                     // Bind this texture:
@@ -177,10 +190,31 @@ PsychError SCREENPreloadTextures(void)
             PsychErrorExitMsg(PsychError_user, "At least one texture handle in texids-vector was invalid! Aborted.");
         }
         
+        // If the requested textures exceed the texture memory budget, then preloading later textures
+        // may have evicted earlier ones again. Those are not resident for sure:
+        if (isArgThere) {
+            for (i=0; i<n; i++) {
+                FindWindowRecord(texhandles[i], &texwin);
+                if (texwin->textureEvictedData) {
+                    texids[i] = 0;
+                    numevicted++;
+                }
+            }
+        }
+
         // Query residency state of all preloaded textures:
         success = NULL;
         PsychAllocOutDoubleArg(1, FALSE, &success);
-        *success = (double) glAreTexturesResident(n, texids, texresident);
+        if (numevicted == 0) {
+            *success = (double) glAreTexturesResident(n, texids, texresident);
+        }
+        else {
+            // Query textures individually, as zero texids are invalid for the query:
+            *success = 0;
+            for (i=0; i<n; i++) {
+                texresident[i] = (texids[i]) ? glAreTexturesResident(1, &texids[i], &texresident[i]) : GL_FALSE;
+            }
+        }
         
         // Sync pipe again, just to be safe...
         glFinish();
@@ -32,7 +32,9 @@ static char synopsisString[] =	"Set current time index for movie object with han
 								"as a frameindex in frames since start of movie, starting with frame 0 as the "
 								"first frame in the movie.\n\n"
 								"Specifying a new timeindex in seconds is usually faster than specifying a "
-								"timeindex in frames.\n\n"
+								"timeindex in frames, unless the movie was opened with the 'FrameIndex=1' "
+								"option in Screen('OpenMovie'). Then both kinds of timeindex are mapped "
+								"to exact video frames via the movies frame index.\n\n"
 								"The function optionally returns the old position in seconds in the return "
 								"argument 'oldtimeindex'.\n";
 
@@ -43,8 +43,15 @@ static char synopsisString[] =
 "to provide all of them. In that case, PTB will create an OpenGL texture with exactly the specified internal "
 "format, assuming input data that is of type 'gltype' and in numeric data format 'extdataformat'. You are "
 "completely responsible for passing properly formatted data. This is mostly useful for injecting high dynamic "
-"range texture images and other exotic texture formats.\n"
-"'specialFlags' Special optional texture flags, see help for Screen('MakeTexture').\n"
+"range texture images and other exotic texture formats. If 'glinternalformat' is one of the supported block "
+"compressed formats, i.e., S3TC BC1 (GL_COMPRESSED_RGB(A)_S3TC_DXT1_EXT), BC2/BC3 (GL_COMPRESSED_RGBA_S3TC_DXT3/5_EXT), "
+"BC7 (GL_COMPRESSED_(SRGB_ALPHA/RGBA)_BPTC_UNORM) or ETC2 (GL_COMPRESSED_(S)RGB8(_ALPHA8)_ETC2(_EAC), "
+"GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2), then 'imagePtr' must point to image data which is already compressed in that "
+"format, e.g., the payload of a DDS or KTX file, and 'gltype' and 'extdataformat' are ignored. Such textures are always "
+"created as GL_TEXTURE_2D textures and need graphics driver support for the format.\n"
+"'specialFlags' Special optional texture flags, see help for Screen('MakeTexture'). The 'specialFlags' == 128 setting "
+"for compression of 8 bpc RGB or RGBA textures at creation time is supported if 'depth' is 3 or 4, no 'glinternalformat' "
+"is specified, and the data is in the byte order expected for such textures.\n"
 "The function returns the textureHandle of the PTB texture and its defining rectangle. "
 "This routine allows external C-Code (Mex- or Oct-Files) to inject raw image data as a texture into PTB. ";
 
@@ -100,6 +107,10 @@ PsychError SCREENSetOpenGLTextureFromMemPointer(void)
     if (!PsychIsTexture(textureRecord)) {
         PsychErrorExitMsg(PsychError_user, "You tried to set texture information on something else than a texture!");
     }
+
+    // Recycled texture gets new content, so it must be resident and can't be evicted anymore,
+    // as eviction would restore stale content:
+    PsychTextureResidencyPin(textureRecord);
     
     // Query double-encoded memory pointer:
     PsychCopyInDoubleArg(3, TRUE, &doubleMemPtr);
@@ -172,6 +183,14 @@ PsychError SCREENSetOpenGLTextureFromMemPointer(void)
     // Override texture target, if one was provided:
     if (target!=0) textureRecord->texturetarget = target;
 
+    // Compressed textures require a GL_TEXTURE_2D target:
+    if ((specialFlags & 128) || (PsychGetCompressedTextureBlockSize(glinternalformat) > 0)) {
+        textureRecord->texturetarget = GL_TEXTURE_2D;
+    }
+
+    // specialFlags setting 128? Request compression of the image data at texture creation time:
+    if (specialFlags & 128) textureRecord->specialflags |= kPsychCompressedTexture;
+
     // Orientation is normally set to 2 - like an upright Offscreen window texture.
     // If upsidedown flag is set, then we do 3 - an upside down Offscreen window texture.
     textureRecord->textureOrientation = (upsidedown>0) ? 3 : 2;
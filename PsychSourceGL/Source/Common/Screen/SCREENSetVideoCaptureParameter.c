@@ -52,6 +52,23 @@ static char synopsisString[] =  "Set video capture parameter 'parameterName' on
                                 "may need to be made while a capture device is not yet opened, so no valid 'capturePtr' exists. "
                                 "This setting is only honored on the GStreamer video capture engine.\n"
                                 "'GetFramerate' Returns the nominal capture rate of the capture device.\n"
+                                "'GetQueueStats' Returns a vector [depth, maxdepth, drops, avglatency, maxlatency] with the current "
+                                "number of queued frames, the maximum number of queued frames and the number of frames dropped due to "
+                                "a full queue, if the lock-free frame queue is enabled via 'recordingflags' 16384 in Screen('OpenVideoCapture'), "
+                                "and the average and maximum latency in seconds from capture of a frame to its texture being ready. "
+                                "Statistics are reset at start of capture. Only supported on the GStreamer capture engine.\n"
+                                "'SetPreprocessing=x,y,w,h[,binning][,luminance]' Enables a preprocessing stage for captured 8 bpc "
+                                "video frames on the GStreamer capture engine. Only the w x h pixels region of interest at offset (x,y) "
+                                "within the video frame is used, optionally reduced by averaging blocks of 'binning' x 'binning' pixels, "
+                                "with 'binning' 1, 2 or 4, and optionally converted to luminance if 'luminance' is 1. YCbCr frames always "
+                                "get reduced to luminance. For raw Bayer sensor data captured as luminance images, 2 x 2 binning yields a "
+                                "luminance image of half resolution. Screen('GetCapturedImage') then returns textures and images of the "
+                                "smaller size, which reduces upload bandwidth and latency, e.g., if only a small part of a high resolution "
+                                "camera image is needed. 'SetPreprocessing=' without a spec disables preprocessing. Settings can only be "
+                                "changed while capture is stopped.\n"
+                                "'GetPreprocessingStats' Returns a vector [bytes, avgtime, count] with the number of bytes uploaded or "
+                                "returned per frame, the average time in seconds spent in preprocessing per frame and the number of "
+                                "preprocessed frames.\n"
                                 "'GetBandwidthUsage' Returns firewire bandwidth used by camera at current settings in "
                                 "so called bandwidth units. "
                                 "The 1394 bus has 4915 bandwidth units available per cycle. Each unit corresponds to "
@@ -124,10 +141,11 @@ static char synopsisString[] =  "Set video capture parameter 'parameterName' on
                                 "to use with the 'OverrideBayerPattern' setting: 0 = RGGB, 1 = GBRG, 2 = GRBG, 3 = BGGR. This can be "
                                 "also used with a 'capturePtr' of -1 to set the method used during movie playback.\n"
                                 "'SyncMode' Query or set mode flags for synchronization of the video capture "
-                                "operation of multiple cameras. This setting is currently only supported with "
-                                "the dedicated libdc1394 video capture engine (engine id 1), and only for some "
-                                "types of cameras on some operating systems, specifically as of Nov 2013 it only "
-                                "works on Linux with firewire cameras. The default setting for 'SyncMode' is zero, "
+                                "operation of multiple cameras. This setting is supported with the dedicated "
+                                "libdc1394 video capture engine (engine id 1) for some types of cameras, specifically "
+                                "as of Nov 2013 it only works on Linux with firewire cameras, and with the GStreamer "
+                                "engine (engine id 3) for all video sources, but only as soft-sync, see below. "
+                                "The default setting for 'SyncMode' is zero, "
                                 "which means the camera is free-running, independent of any other camera. Non-zero "
                                 "values allow to synchronize the capture operation of the camera with other cameras. "
                                 "Each camera can be either a sync-master, which means it controls all capture operations "
@@ -156,6 +174,15 @@ static char synopsisString[] =  "Set video capture parameter 'parameterName' on
                                 "but you don't need them to stop in exact synchrony, you can add the flag 32 = No lock-step. This allows for "
                                 "some slack and inaccuracy in stopping capture and recording, but may allow for reduced latency for realtime "
                                 "applications of video capture.\n"
+                                "With the GStreamer engine, all cameras of a group capture with one shared clock, which is assigned "
+                                "when capture is started on the master, and each camera records into its own movie file, if recording "
+                                "is enabled. Bus-sync and hw-sync settings fall back to soft-sync, the No lock-step flag is ignored. "
+                                "Fetch frame sets of frames which were captured at the same time by all cameras of the group via "
+                                "Screen('GetCapturedImageSet'). 'SyncMode' can only be changed while capture is stopped.\n"
+                                "'SyncGroup' Query or set the id of the capture group of a camera for synchronized capture with the "
+                                "GStreamer engine. The default id is zero. Starting capture on a sync master only starts the sync slaves "
+                                "with the same 'SyncGroup' id, so multiple independent groups, each with its own master, can be used. "
+                                "'SyncGroup' can only be changed while capture is stopped.\n"
                                 "The way trigger signals are used if 'SyncMode' is selected as mode 16 aka hardware sync, can be controlled "
                                 "via the following settings:\n"
                                 "'TriggerMode' The way a trigger signal controls camera capture operation: 0 = Start of exposure is triggered "
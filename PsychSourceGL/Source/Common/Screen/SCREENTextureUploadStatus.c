@@ -0,0 +1,73 @@
+/*
+ *    SCREENTextureUploadStatus.c
+ *
+ *    AUTHORS:
+ *
+ *    mario.kleiner.de@gmail.com      mk
+ *
+ *    PLATFORMS:
+ *
+ *    All.
+ *
+ *    DESCRIPTION:
+ *
+ *    Query or wait for completion of asynchronous texture uploads, as started by
+ *    Screen('MakeTexture', ..., specialFlags = 64).
+ */
+
+#include "Screen.h"
+
+// If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
+static char useString[] = "isReady = Screen('TextureUploadStatus', textureIndex(s) [, waitForCompletion=0]);";
+//                         1                                       1                  2
+static char synopsisString[] =
+"Query if the asynchronous upload of image content into textures has completed.\n\n"
+"Textures created via Screen('MakeTexture', ...) with 'specialFlags' setting 64 get their "
+"image content uploaded asynchronously into video memory, ie., 'MakeTexture' returns before "
+"the upload is complete. This function allows to check if the upload has completed.\n"
+"'textureIndex(s)' is a single texture handle or a vector of texture handles to check.\n"
+"'waitForCompletion' if set to 1, wait until all uploads have completed before returning. "
+"The default is 0 - Do not wait, just poll the current status.\n"
+"'isReady' is a vector of the same length as 'textureIndex(s)'. Each element is 1 if the "
+"corresponding texture is ready, 0 if the upload is still in progress. Textures which were "
+"not created with asynchronous upload are always ready.\n"
+"Note that you can draw a texture at any time, even if its upload is not yet complete. The "
+"graphics card will finish the upload before drawing the texture, so the only effect of "
+"drawing a not yet ready texture is a potentially longer execution time of the drawing on the "
+"gpu.\n";
+
+static char seeAlsoString[] = "MakeTexture PreloadTextures";
+
+PsychError SCREENTextureUploadStatus(void)
+{
+    PsychWindowRecordType   *textureRecord;
+    int                     i, n, *texhandles;
+    int                     waitForCompletion = 0;
+    double                  *isReady;
+
+    // All sub functions should have these two lines
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(2));        // The maximum number of inputs
+    PsychErrorExit(PsychRequireNumInputArgs(1));    // The minimum number of inputs
+    PsychErrorExit(PsychCapNumOutputArgs(1));       // The maximum number of outputs
+
+    PsychAllocInIntegerListArg(1, TRUE, &n, &texhandles);
+    PsychCopyInIntegerArg(2, FALSE, &waitForCompletion);
+
+    PsychAllocOutDoubleMatArg(1, FALSE, 1, n, 0, &isReady);
+
+    for (i = 0; i < n; i++) {
+        textureRecord = NULL;
+        if (IsWindowIndex(texhandles[i])) FindWindowRecord(texhandles[i], &textureRecord);
+        if (!textureRecord || !PsychIsTexture(textureRecord)) {
+            printf("PTB-ERROR: Screen('TextureUploadStatus'): Entry %i of texture handle vector (handle %i) is not a texture handle!\n", i + 1, texhandles[i]);
+            PsychErrorExitMsg(PsychError_user, "At least one texture handle in 'textureIndex(s)' was invalid! Aborted.");
+        }
+
+        isReady[i] = (PsychCheckAsyncTextureUpload(textureRecord, (waitForCompletion > 0) ? TRUE : FALSE)) ? 1 : 0;
+    }
+
+    return(PsychError_none);
+}
@@ -80,6 +80,10 @@
 #include "PsychAlphaBlending.h"
 #include "PsychVideoCaptureSupport.h"
 #include "PsychImagingPipelineSupport.h"
+#include "PsychFrameProfiler.h"
+#include "PsychFlipScheduler.h"
+#include "PsychFlipLog.h"
+#include "PsychInstancedShapes.h"
 #include "PsychMovieWritingSupport.h"
 #include "ScreenArguments.h"
 #include "RegisterProject.h"
@@ -147,6 +151,8 @@ PsychError      PsychOSDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectT
 psych_bool      PsychAllocInTextAsUnicode(int position, PsychArgRequirementType isRequired, int *textLength, double **unicodeText);
 psych_bool      PsychSetUnicodeTextConversionLocale(char* mnewlocale);
 const char*     PsychGetUnicodeTextConversionLocale(void);
+int             PsychTextLayoutCacheSetCapacity(int capacity);
+void            PsychTextLayoutCacheGetStats(int *capacity, int *numEntries, double *hits, double *misses);
 
 //functions implementing Screen subcommands.
 PsychError SCREENNull(void);
@@ -189,6 +195,7 @@ PsychError SCREENTextFont(void);
 PsychError SCREENTextBounds(void);
 PsychError SCREENTextTransform(void);
 PsychError SCREENDrawText(void);
+PsychError SCREENDrawTexts(void);
 PsychError SCREENTextColor(void);
 PsychError SCREENPreference(void);
 PsychError SCREENDrawTexture(void);
@@ -196,6 +203,7 @@ PsychError SCREENMakeTexture(void);
 PsychError SCREENFrameRect(void);
 PsychError SCREENDrawLine(void);
 PsychError SCREENFillPoly(void);
+PsychError SCREENFillPolys(void);
 PsychError SCREENFramePoly(void);
 PsychError SCREENGlobalRect(void);
 PsychError SCREENDrawDots(void);
@@ -212,6 +220,7 @@ PsychError SCREENGetFlipInterval(void);
 PsychError SCREENCloseMovie(void);
 PsychError SCREENOpenMovie(void);
 PsychError SCREENPlayMovie(void);
+PsychError SCREENPlayMovieGroup(void);
 PsychError SCREENSetMovieTimeIndex(void);
 PsychError SCREENGetMovieTimeIndex(void);
 PsychError SCREENGetMovieImage(void);
@@ -222,6 +231,8 @@ PsychError SCREENglTranslate(void);
 PsychError SCREENglScale(void);
 PsychError SCREENglRotate(void);
 PsychError SCREENPreloadTextures(void);
+PsychError SCREENTextureUploadStatus(void);
+PsychError SCREENCommandList(void);
 PsychError SCREENFillArc(void);
 PsychError SCREENDrawArc(void);
 PsychError SCREENFrameArc(void);
@@ -234,6 +245,7 @@ PsychError SCREENCloseVideoCapture(void);
 PsychError SCREENStartVideoCapture(void);
 PsychError SCREENStopVideoCapture(void);
 PsychError SCREENGetCapturedImage(void);
+PsychError SCREENGetCapturedImageSet(void);
 PsychError SCREENSetVideoCaptureParameter(void);
 PsychError SCREENBeginOpenGL(void);
 PsychError SCREENEndOpenGL(void);
@@ -251,10 +263,14 @@ PsychError SCREENGetMouseHelper(void);
 PsychError SCREENResolution(void);
 PsychError SCREENResolutions(void);
 PsychError SCREENWaitUntilAsyncFlipCertain(void);
+PsychError SCREENAsyncFlipQueue(void);
 PsychError SCREENCreateMovie(void);
 PsychError SCREENFinalizeMovie(void);
 PsychError SCREENAddAudioBufferToMovie(void);
 PsychError SCREENGetFlipInfo(void);
+PsychError SCREENGetFlipDeadline(void);
+PsychError SCREENFlipLog(void);
+PsychError SCREENLinkGLSLProgram(void);
 PsychError SCREENConfigureDisplay(void);
 PsychError SCREENPanelFitter(void);
 PsychError SCREENReadHDRImage(void);
@@ -90,10 +90,11 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "Screen('FillArc',windowPtr,[color],[rect],startAngle,arcAngle)";
     synopsis[i++] = "Screen('FillRect', windowPtr [,color] [,rect] );";
     synopsis[i++] = "Screen('FrameRect', windowPtr [,color] [,rect] [,penWidth]);";
-    synopsis[i++] = "Screen('FillOval', windowPtr [,color] [,rect] [,perfectUpToMaxDiameter]);";
+    synopsis[i++] = "Screen('FillOval', windowPtr [,color] [,rect] [,perfectUpToMaxDiameter] [,antiAliased=0]);";
     synopsis[i++] = "Screen('FrameOval', windowPtr [,color] [,rect] [,penWidth] [,penHeight] [,penMode]);";
     synopsis[i++] = "Screen('FramePoly', windowPtr [,color], pointList [,penWidth]);";
     synopsis[i++] = "Screen('FillPoly', windowPtr [,color], pointList [, isConvex]);";
+    synopsis[i++] = "Screen('FillPolys', windowPtr [,colors], pointList, vertexCounts [, isConvex]);";
 
     // New OpenGL-based functions for OS X
     synopsis[i++] = "\n% New OpenGL functions for OS X:";
@@ -102,6 +103,7 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[minSmoothPointSize, maxSmoothPointSize, minAliasedPointSize, maxAliasedPointSize] = Screen('DrawDots', windowPtr, xy [,size] [,color] [,center] [,dot_type] [,lenient]);";
     synopsis[i++] = "[minSmoothLineWidth, maxSmoothLineWidth, minAliasedLineWidth, maxAliasedLineWidth] = Screen('DrawLines', windowPtr, xy [,width] [,colors] [,center] [,smooth] [,lenient]);";
     synopsis[i++] = "[sourceFactorOld, destinationFactorOld, colorMaskOld]=Screen('BlendFunction', windowIndex, [sourceFactorNew], [destinationFactorNew], [colorMaskNew]);";
+    synopsis[i++] = "[ret1] = Screen('CommandList', windowPtr, 'Subcommand' [, arg1][, arg2] ...);";
 
     // Draw Text in windows
     synopsis[i++] = "\n% Draw Text in windows";
@@ -111,6 +113,7 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "oldStyle=Screen('TextStyle', windowPtr [,style]);";
     synopsis[i++] = "[oldFontName,oldFontNumber,oldTextStyle]=Screen('TextFont', windowPtr [,fontNameOrNumber][,textStyle]);";
     synopsis[i++] = "[normBoundsRect, offsetBoundsRect, textHeight, xAdvance] = Screen('TextBounds', windowPtr, text [,x] [,y] [,yPositionIsBaseline] [,swapTextDirection]);";
+    synopsis[i++] = "[newX, newY] = Screen('DrawTexts', windowPtr, texts, x, y [, colors] [, backgroundColor] [, yPositionIsBaseline]);";
     synopsis[i++] = "[newX, newY, textHeight]=Screen('DrawText', windowPtr, text [,x] [,y] [,color] [,backgroundColor] [,yPositionIsBaseline] [,swapTextDirection]);";
     synopsis[i++] = "oldTextColor=Screen('TextColor', windowPtr [,colorVector]);";
     synopsis[i++] = "oldTextBackgroundColor=Screen('TextBackgroundColor', windowPtr [,colorVector]);";
@@ -119,6 +122,7 @@ const char** InitializeSynopsis(void)
     // Copy an image, very quickly, between textures and onscreen windows
     synopsis[i++] = "\n% Copy an image, very quickly, between textures, offscreen windows and onscreen windows.";
     synopsis[i++] = "[resident [texidresident]] = Screen('PreloadTextures', windowPtr [, texids]);";
+    synopsis[i++] = "isReady = Screen('TextureUploadStatus', textureIndex(s) [, waitForCompletion=0]);";
     synopsis[i++] = "Screen('DrawTexture', windowPointer, texturePointer [,sourceRect] [,destinationRect] [,rotationAngle] [, filterMode] [, globalAlpha] [, modulateColor] [, textureShader] [, specialFlags] [, auxParameters]);";
     synopsis[i++] = "Screen('DrawTextures', windowPointer, texturePointer(s) [, sourceRect(s)] [, destinationRect(s)] [, rotationAngle(s)] [, filterMode(s)] [, globalAlpha(s)] [, modulateColor(s)] [, textureShader] [, specialFlags] [, auxParameters]);";
     synopsis[i++] = "Screen('CopyWindow', srcWindowPtr, dstWindowPtr, [srcRect], [dstRect], [copyMode])";
@@ -135,7 +139,11 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[VBLTimestamp StimulusOnsetTime FlipTimestamp Missed Beampos] = Screen('AsyncFlipEnd', windowPtr);";
     synopsis[i++] = "[VBLTimestamp StimulusOnsetTime FlipTimestamp Missed Beampos] = Screen('AsyncFlipCheckEnd', windowPtr);";
     synopsis[i++] = "[VBLTimestamp StimulusOnsetTime swapCertainTime] = Screen('WaitUntilAsyncFlipCertain', windowPtr);";
+    synopsis[i++] = "pending = Screen('AsyncFlipQueue', windowPtr, texturePtrs [, when=0]);";
+    synopsis[i++] = "[timestamps, pending] = Screen('AsyncFlipQueueResults', windowPtr [, waitForAll=0] [, maxCount]);";
     synopsis[i++] = "[info] = Screen('GetFlipInfo', windowPtr [, infoType=0] [, auxArg1]);";
+    synopsis[i++] = "[deadline, predictedOnset, costs, throttledFlips] = Screen('GetFlipDeadline', windowPtr [, when=0][, autoThrottle][, safetyMargin]);";
+    synopsis[i++] = "[log, dropped] = Screen('FlipLog', windowPtr, command [, arg]);";
     synopsis[i++] = "[telapsed] = Screen('DrawingFinished', windowPtr [, dontclear] [, sync]);";
     synopsis[i++] = "framesSinceLastWait = Screen('WaitBlanking', windowPtr [, waitFrames]);";
 
@@ -204,7 +212,8 @@ const char** InitializeSynopsis(void)
     synopsis[i++] =  "Screen('CloseMovie' [, moviePtr=all]);";
     synopsis[i++] =  "[ texturePtr [timeindex]]=Screen('GetMovieImage', windowPtr, moviePtr, [waitForImage], [fortimeindex], [specialFlags = 0] [, specialFlags2 = 0]);";
     synopsis[i++] =  "[droppedframes] = Screen('PlayMovie', moviePtr, rate, [loop], [soundvolume]);";
-    synopsis[i++] =  "timeindex = Screen('GetMovieTimeIndex', moviePtr);";
+    synopsis[i++] =  "[droppedframes, meanLag, maxLag] = Screen('PlayMovieGroup', moviePtrs, rate [, loop=0][, soundvolume=1][, when=0]);";
+    synopsis[i++] =  "[timeindex, stats] = Screen('GetMovieTimeIndex', moviePtr);";
     synopsis[i++] =  "[oldtimeindex] = Screen('SetMovieTimeIndex', moviePtr, timeindex [, indexIsFrames=0]);";
     synopsis[i++] =  "moviePtr = Screen('CreateMovie', windowPtr, movieFile [, width][, height][, frameRate=30][, movieOptions][, numChannels=4][, bitdepth=8]);";
     synopsis[i++] =  "Screen('FinalizeMovie', moviePtr);";
@@ -220,6 +229,7 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[fps starttime] = Screen('StartVideoCapture', capturePtr [, captureRateFPS] [, dropframes=0] [, startAt]);";
     synopsis[i++] = "droppedframes = Screen('StopVideoCapture', capturePtr [, discardFrames=1]);";
     synopsis[i++] = "[ texturePtr [capturetimestamp] [droppedcount] [average_intensityOrRawImageMatrix]]=Screen('GetCapturedImage', windowPtr, capturePtr [, waitForImage=1] [,oldTexture] [,specialmode] [,targetmemptr]);";
+    synopsis[i++] = "[texturePtrs, capturetimestamps, droppedcount] = Screen('GetCapturedImageSet', windowPtr, capturePtrs [, waitForImage=1][, tolerance=0.005]);";
     synopsis[i++] = "oldvalue = Screen('SetVideoCaptureParameter', capturePtr, 'parameterName' [, value]);";
 
     // Low level OpenGL calls - directly translated to C via very thin wrapper functions:
@@ -247,6 +257,7 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[ret1, ret2, ...] = Screen('HookFunction', windowPtr, 'Subcommand', 'HookName', arg1, arg2, ...);";
     synopsis[i++] = "proxyPtr = Screen('OpenProxy', windowPtr [, imagingmode]);";
     synopsis[i++] = "transtexid = Screen('TransformTexture', sourceTexture, transformProxyPtr [, sourceTexture2][, targetTexture][, specialFlags]);";
+    synopsis[i++] = "[linked, cacheHit] = Screen('LinkGLSLProgram', windowPtr, glslProgram [, preLinkState]);";
 
     synopsis[i++] = NULL;  //this tells PsychDisplayScreenSynopsis where to stop
 
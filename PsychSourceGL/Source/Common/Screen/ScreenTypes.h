@@ -266,6 +266,9 @@ typedef struct {
 // Skip wait until scanout out-of-vblank before issuing swaprequest:
 #define kPsychSkipOutOfVblankWait (1 << 29)
 
+// Don't use instanced drawing for batches of rects and ovals, but draw them one by one:
+#define kPsychDontUseInstancedShapes (1 << 30)
+
 //function protoptypes
 
 //Accessors for PsychDepthType
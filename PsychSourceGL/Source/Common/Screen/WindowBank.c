@@ -294,6 +294,11 @@ void PsychCreateWindowRecord(PsychWindowRecordType **winRec)
     (*winRec)->fillOvalDisplayList = 0;
     (*winRec)->frameOvalDisplayList = 0;
 
+    // No shader or vertex buffer for instanced shape drawing yet:
+    (*winRec)->instancedShapesShader = 0;
+    (*winRec)->instancedShapesVBO = 0;
+    (*winRec)->instancedShapesVBOSize = 0;
+
     // No special flags set by default:
     (*winRec)->specialflags = 0;
     // No capabilities setup yet:
@@ -335,6 +340,9 @@ void PsychCreateWindowRecord(PsychWindowRecordType **winRec)
     (*winRec)->gpuCoreId[0] = 0;
     (*winRec)->gpuRenderTimeQuery = 0;
     (*winRec)->gpuRenderTime = 0.0;
+    (*winRec)->frameProfiler = NULL;
+    (*winRec)->flipScheduler = NULL;
+    (*winRec)->flipLog = NULL;
 
     // No swap group or barrier assigned:
     (*winRec)->swapGroup = 0;
@@ -173,13 +173,17 @@
 #define kPsychSkipSecondaryVsyncForFlip     (1ULL << 35) // 'specialflags': Perform flips on this windows associated secondary/slavewindow without VSYNC, e.g., for mirror mode.
 #define kPsychBackendDecisionMade           (1ULL << 36) // 'specialflags': Decision wrt. use of display backend has been intentionally made by high-level 'OpenWindow' caller.
 #define kPsychNeedPostSwapLockedFlush       (1ULL << 37) // 'specialflags': Window needs display lock protected pixelwrite+flush on framebuffer immediately after bufferswap.
+#define kPsychAsyncTextureUpload            (1ULL << 38) // 'specialflags': Upload this textures content asynchronously via a pixel unpack buffer object, track completion via a fence.
+#define kPsychTextureResidencyManaged       (1ULL << 39) // 'specialflags': Texture is managed by the texture residency manager, ie. can get evicted from VRAM if over budget.
+#define kPsychCompressedTexture             (1ULL << 40) // 'specialflags': Texture uses or should use a block compressed internal format, e.g., BC1/BC3 (S3TC), BC7 or ETC2.
+#define kPsychHeadlessWindow                (1ULL << 41) // 'specialflags': Onscreen window is rendered headless without any display, e.g., via EGL surfaceless platform. No vsync, flip completes when rendering is finished.
 
 // The following numbers are allocated to imagingMode flag above: A (S) means, shared with specialFlags:
 // 1,2,4,8,16,32,64,128,256,512,1024,S-2048,4096,S-8192,16384,32768,S-65536,2^17,2^18(S),2^19,2^20,2^21,2^22,2^23,2^24,S-2^25. --> Flags of 2^26 and higher are available...
 
 // The following numbers are allocated to specialFlags flag above: A (S) means, shared with imagingMode:
 // 1,2,4,8,16,32,64,128,256,512,1024,S-2048,4096,S-8192, 16384, 32768, S-65536,2^17,2^18(S),2^19,2^20,2^21,2^22,2^23,2^24,S-2^25,2^26,2^27,2^28,2^29,2^30,
-// 2^31,2^32,2^33,2^34,2^35,2^36,2^37. --> Flags of 2^38 and higher are available...
+// 2^31,2^32,2^33,2^34,2^35,2^36,2^37,2^38,2^39,2^40,2^41. --> Flags of 2^42 and higher are available...
 
 // Definition of a single hook function spec:
 typedef struct PsychHookFunction*   PtrPsychHookFunction;
@@ -191,8 +195,27 @@ typedef struct PsychHookFunction {
     void*                   cprocfunc;
     unsigned int            shaderid;
     unsigned int            luttexid1;
+    struct PsychFusedShader* fused;         // Non-NULL if this slot starts a group of slots which executes as one fused shader pass.
 } PsychHookFunction;
 
+// A uniform of an original hook slot shader, which gets copied into the fused shader before execution:
+typedef struct PsychFusedUniform {
+    GLuint                  srcProgram;     // Original GLSL program of the hook slot.
+    GLint                   srcLocation;    // Location of the uniform in the original program.
+    GLint                   dstLocation;    // Location of the renamed uniform in the fused program.
+    GLenum                  type;           // GL type of the uniform.
+} PsychFusedUniform;
+
+// A group of consecutive per-pixel shader slots of a hook chain, merged into one generated fragment program:
+typedef struct PsychFusedShader {
+    PsychHookFunction       slot;           // Shader slot which executes the fused program instead of the group.
+    PtrPsychHookFunction    last;           // Last slot of the chain which is part of the group.
+    int                     numSlots;       // Number of chain slots in the group, including Builtin:FlipFBOs slots.
+    int                     flips;          // Number of Builtin:FlipFBOs ping-pong passes saved by the group.
+    int                     numUniforms;
+    PsychFusedUniform*      uniforms;
+} PsychFusedShader;
+
 // Definition of an OpenGL Framebuffer object (FBO) for internal use.
 typedef struct PsychFBO {
     GLuint                  fboid;          // Handle to FBO.
@@ -210,6 +233,20 @@ typedef struct PsychFBO {
 
 // Typedefs for WindowRecord in WindowBank.h
 
+// Maximum number of frames in the deep flip queue of a window, see Screen('AsyncFlipQueue'):
+#define kPsychMaxFlipQueueLength 4096
+
+// One pre-rendered frame in the deep flip queue of a window, and the results of its presentation:
+typedef struct PsychFlipQueueEntry {
+    PsychFBO                frame;              // Color texture of the frame. Only the texture fields are used.
+    double                  flipwhen;           // Requested presentation time, as for Screen('Flip').
+    int                     beamPosAtFlip;      // Results of presentation, as returned by PsychFlipWindowBuffers():
+    double                  miss_estimate;
+    double                  time_at_flipend;
+    double                  time_at_onset;
+    double                  vbl_timestamp;
+} PsychFlipQueueEntry;
+
 // This support structure for async flips is supported on all non-Windows platforms, aka all Unix platforms:
 // It gets attached to the asyncFlipInfo* of a windowRecord whenever async flips are used.
 typedef struct PsychFlipInfoStruct {
@@ -231,6 +268,14 @@ typedef struct PsychFlipInfoStruct {
     psych_thread            flipperThread;      // Thread handle for background flipping thread.
     psych_mutex             performFlipLock;    // Primary lock.
     psych_condition         flipperGoGoGo;      // Signalling condition variable to trigger execution of a flip request by the flipper thread.
+
+    // Deep flip queue for opmode 4. Counters only increase, entry i is stored at queue[i % kPsychMaxFlipQueueLength].
+    // queueWrite and queueRead are only changed by the masterthread, queueDone only by the flipper thread with performFlipLock held:
+    PsychFlipQueueEntry*    queue;              // Ring buffer of queued frames, or NULL if the queue was never used.
+    unsigned int            queueWrite;         // Count of frames queued.
+    unsigned int            queueDone;          // Count of frames presented.
+    unsigned int            queueRead;          // Count of frames whose results were collected by usercode.
+    psych_bool              queueActive;        // Async flip in progress is an opmode 4 deep flip queue operation.
 } PsychFlipInfoStruct;
 
 
@@ -389,6 +434,10 @@ typedef struct _PsychWindowRecordType_{
     GLint                       textureI420PlanarShader; // Optional GLSL program handle for shader to convert a YUV-I420 planar texture into a standard RGBA8 texture.
     GLint                       textureI800PlanarShader; // Optional GLSL program handle for shader to convert a Y8-I800 planar texture into a standard RGBA8 texture.
     GLint                       multiSampleFetchShader;  // Optional GLSL program handler for shader to fetch from multisample texture.
+    GLsync                      textureUploadFence;     // Fence object to track completion of an asynchronous texture upload, or NULL if none pending.
+    psych_uint64                textureLastUsed;        // Residency manager: Value of the global texture use counter at last use of this texture.
+    size_t                      textureResidentBytes;   // Residency manager: VRAM consumption of this texture if it is managed, zero otherwise.
+    void                        *textureEvictedData;    // Residency manager: CPU side compressed copy of the content of an evicted texture, NULL if resident.
 
     psych_bool                  needsViewportSetup;     // Set on userspace OpenGL contexts of onscreen windows to signal need for glViewport setup and other one-time
                                                         // stuff on first Screen('BeginOpenGL'). Also (ab)used for textures and offscreen windows to track "dirty" state.
@@ -430,6 +479,9 @@ typedef struct _PsychWindowRecordType_{
     double                      osbuiltin_swaptime;     // Optional timestamp of swap completion computed via PsychOSGetSwapCompletionTimestamp();
     double                      gpuRenderTime;          // GPU time spent on rendering. Only returned if a query object is successfully generated.
     GLuint                      gpuRenderTimeQuery;     // Handle to the GPU time query object. 0 if none assigned.
+    struct PsychFrameProfilerType* frameProfiler;       // State of per-frame GPU/CPU phase profiler, see PsychFrameProfiler.c. NULL if disabled.
+    struct PsychFlipSchedulerType* flipScheduler;       // State of predictive flip scheduler, see PsychFlipScheduler.c. NULL if disabled.
+    struct PsychFlipLogType*    flipLog;                // Ring buffer of flip timing records, see PsychFlipLog.c. NULL if never enabled.
     psych_int64                 reference_ust;          // UST reference timestamp of vblank with count reference_msc from OpenML. (Optional)
     psych_int64                 reference_msc;          // MSC reference vblank count from OpenML. (Optional)
     psych_int64                 reference_sbc;          // SBC reference swapbuffers count from OpenML. (Optional)
@@ -457,11 +509,15 @@ typedef struct _PsychWindowRecordType_{
     GLuint                      unclampedDrawShader;                        // Handle of GLSL shader object for drawing of non-texture stims without vertex color clamping. Zero by default.
     GLuint                      defaultDrawShader;                          // Default GLSL shader object for drawing of non-texture stims. Zero by default.
     GLuint                      smoothPointShader;                          // GLSL shader to implement point smoothing via point sprites.
+    GLuint                      instancedShapesShader;                      // GLSL shader for instanced drawing of rects and ovals, see PsychInstancedShapes.c.
+    GLuint                      instancedShapesVBO;                         // Vertex buffer for instance data of instanced shape drawing. Only used in parent onscreen window.
+    size_t                      instancedShapesVBOSize;                     // Size of instancedShapesVBO in bytes.
     double                      currentColor[4];                            // Current unclamped but colorrange remapped RGBA drawcolor for whatever drawop, as spec'd by PsychSetGLColor().
     double                      clearColor[4];                              // Window clear color (as GL double vector) to use in PsychGLClear();
     int                         imagingMode;                                // Master mode switch for imaging and callback hook pipeline.
     PtrPsychHookFunction        HookChain[MAX_SCREEN_HOOKS];                // Array of pointers to the hook-chains for different hooks.
     psych_bool                  HookChainEnabled[MAX_SCREEN_HOOKS];         // Array of Booleans to en-/disable single chains temporarily.
+    int                         HookChainFusion[MAX_SCREEN_HOOKS];          // Shader fusion per chain: 0 = Off, 1 = On but fused shaders need (re)build, 2 = On and built.
 
     // Indices into our FBO table: The special value -1 means: Don't use.
     int                         drawBufferFBO[2];                   // Storage for drawing FBOs: These are the targets of all drawing operations before
@@ -484,6 +540,7 @@ typedef struct _PsychWindowRecordType_{
 
     PsychFBO*                   fboTable[MAX_FBOTABLE_SLOTS];       // This array contains pointers to the FBO structs which are referenced by the indices above.
     int                         fboCount;                           // This contains the number of FBO's in fboTable.
+    double                      fboPooledBytes;                     // Bytes of graphics memory saved by sharing pooled FBO's between pipeline stages.
 
     void*                       interopMemObjectHandle;             // Handle to an external interop memory object, e.g., for OpenGL-Vulkan interop.
     void*                       interopSemaphoreHandle;             // Handle to an external interop semaphore, e.g., for OpenGL-Vulkan interop handshake.
@@ -43,6 +43,14 @@
 #include <waffle_gbm.h>
 #include <waffle_wayland.h>
 
+// Waffle 1.6 and later support the EGL surfaceless platform for headless rendering without any display:
+#if defined(WAFFLE_MAJOR_VERSION) && ((WAFFLE_MAJOR_VERSION > 1) || (WAFFLE_MINOR_VERSION >= 6))
+#define PTB_WAFFLE_HAS_SURFACELESS 1
+#include <waffle_surfaceless_egl.h>
+#else
+#define PTB_WAFFLE_HAS_SURFACELESS 0
+#endif
+
 // First time init?
 static psych_bool firstTime = TRUE;
 
@@ -505,6 +513,9 @@ psych_bool PsychOSOpenOnscreenWindow(PsychScreenSettingsType * screenSettings, P
             if (!strcmp(getenv("PSYCH_USE_DISPLAY_BACKEND"), "wayland")) windowRecord->winsysType = (int) WAFFLE_PLATFORM_WAYLAND;
             if (!strcmp(getenv("PSYCH_USE_DISPLAY_BACKEND"), "gbm")) windowRecord->winsysType = (int) WAFFLE_PLATFORM_GBM;
             if (!strcmp(getenv("PSYCH_USE_DISPLAY_BACKEND"), "android")) windowRecord->winsysType = (int) WAFFLE_PLATFORM_ANDROID;
+            #if PTB_WAFFLE_HAS_SURFACELESS
+            if (!strcmp(getenv("PSYCH_USE_DISPLAY_BACKEND"), "surfaceless")) windowRecord->winsysType = (int) WAFFLE_PLATFORM_SURFACELESS_EGL;
+            #endif
         }
         else if (getenv("WAYLAND_DISPLAY")) {
             // Seems we are running on a Wayland server, so default to the
@@ -512,6 +523,17 @@ psych_bool PsychOSOpenOnscreenWindow(PsychScreenSettingsType * screenSettings, P
             windowRecord->winsysType = (int) WAFFLE_PLATFORM_WAYLAND;
         }
 
+        // Headless window requested? This always needs the EGL surfaceless platform, as there isn't any display:
+        if (windowRecord->specialflags & kPsychHeadlessWindow) {
+            #if PTB_WAFFLE_HAS_SURFACELESS
+            windowRecord->winsysType = (int) WAFFLE_PLATFORM_SURFACELESS_EGL;
+            #else
+            if (PsychPrefStateGet_Verbosity() > 0)
+                printf("PTB-ERROR: Headless window requested, but this Screen() was built against a Waffle library without support for the EGL surfaceless platform.\n");
+            return(FALSE);
+            #endif
+        }
+
         // If any backend chosen from calling code or by env-variable, assign it as new requested choice,
         // but backup current setting for possible later restore:
         oldBackend = init_attrs[1];
@@ -573,6 +595,18 @@ psych_bool PsychOSOpenOnscreenWindow(PsychScreenSettingsType * screenSettings, P
     // Set windowing system backend type to truly selected type:
     windowRecord->winsysType = (int) init_attrs[1];
 
+    // Headless windows can only work with the surfaceless platform, which may not be what we got, e.g., due to
+    // a fallback, or because another backend was chosen earlier in this session:
+    #if PTB_WAFFLE_HAS_SURFACELESS
+    if ((windowRecord->specialflags & kPsychHeadlessWindow) && (windowRecord->winsysType != WAFFLE_PLATFORM_SURFACELESS_EGL)) {
+        if (PsychPrefStateGet_Verbosity() > 0) {
+            printf("PTB-ERROR: Headless window requested, but the EGL surfaceless display backend is not available or not in use.\n");
+            printf("PTB-ERROR: This needs EGL_MESA_platform_surfaceless support, and the backend can only be chosen once per session. Restart Octave/Matlab, then retry.\n");
+        }
+        return(FALSE);
+    }
+    #endif
+
     // Translate spec to human readable name and spec string:
     switch (init_attrs[1]) {
     case WAFFLE_PLATFORM_GLX:
@@ -599,6 +633,13 @@ psych_bool PsychOSOpenOnscreenWindow(PsychScreenSettingsType * screenSettings, P
         sprintf(backendname, "Android/EGL");
         sprintf(backendname2, "android");
         break;
+
+    #if PTB_WAFFLE_HAS_SURFACELESS
+    case WAFFLE_PLATFORM_SURFACELESS_EGL:
+        sprintf(backendname, "Surfaceless/EGL");
+        sprintf(backendname2, "surfaceless");
+        break;
+    #endif
     }
 
     // Announce actual choice of backend to runtime environment. This is a marker
@@ -662,6 +703,12 @@ psych_bool PsychOSOpenOnscreenWindow(PsychScreenSettingsType * screenSettings, P
                 egl_display = NULL;
                 break;
 
+            #if PTB_WAFFLE_HAS_SURFACELESS
+            case WAFFLE_PLATFORM_SURFACELESS_EGL:
+                egl_display = wafflenatdis->surfaceless_egl->egl_display;
+                break;
+            #endif
+
             default:
                 egl_display = NULL;
         }
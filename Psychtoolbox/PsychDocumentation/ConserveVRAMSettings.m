@@ -338,6 +338,14 @@
 % drivers and advice the user to use this flag in such situations.
 %
 %
+% 2^30 == kPsychDontUseInstancedShapes
+% Don't draw batches of multiple rectangles or ovals in Screen('FillRect'),
+% Screen('FrameRect') and Screen('FillOval') with one instanced draw call and
+% a shader, but draw them one by one, as on hardware without support for
+% instanced drawing. This is slower, but may help with graphics drivers
+% which have bugs in their instancing support.
+%
+%
 % --> It's always better to update your graphics drivers with fixed
 % versions or buy proper hardware than using these workarounds. They are
 % meant as a last ressort, e.g., if you need to get something going quickly
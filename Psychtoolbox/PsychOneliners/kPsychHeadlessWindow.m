@@ -0,0 +1,45 @@
+function rc = kPsychHeadlessWindow
+% kPsychHeadlessWindow -- Create headless onscreen window without any display.
+%
+% This flag can be passed to the optional 'specialFlags' parameter of
+% Screen('OpenWindow', ...) or PsychImaging('OpenWindow', ...).
+%
+% It will cause the onscreen window to be created without any connection
+% to a display or display server, e.g., for batch generation of stimulus
+% images or movies on compute cluster nodes or in continuous integration
+% test setups. The window is rendered to via the EGL surfaceless platform,
+% so this needs Linux with the Waffle display backend and a Mesa OpenGL
+% implementation which supports EGL_MESA_platform_surfaceless, e.g., the
+% software rasterizer llvmpipe, or any gpu driver. As the display backend
+% can only be selected once per session, the headless window should be
+% opened before any other onscreen window.
+%
+% All display timing tests and calibrations are skipped, and no vsync is
+% used. Screen('Flip') does not wait for any video refresh or for a given
+% 'when' time, but completes as soon as the gpu has finished rendering the
+% frame. The returned timestamps are the time of render completion. Async
+% flips are performed as regular synchronous flips.
+%
+% If you don't need these timestamps, you can suppress the wait for render
+% completion, so Flip only submits the frame for rendering and the gpu, or
+% the threads of a software renderer like llvmpipe, can work on it while
+% your script prepares the next frame:
+%
+% Screen('HookFunction', window, 'SetOneshotFlipFlags', '', ...
+%        kPsychSkipTimestampingForFlipOnce + kPsychDontAutoResetOneshotFlags);
+%
+% Flip then returns zero timestamps. Readback of a frame still waits for its
+% rendering to finish.
+%
+% The imaging pipeline works as usual. You can read back stimulus images
+% before calling Screen('Flip'), e.g., via Screen('GetImage', window, [],
+% 'backBuffer') or Screen('AddFrameToMovie', window, [], 'backBuffer'), or
+% with the imaging pipeline enabled via 'drawBuffer'.
+%
+% The flag implies kPsychExternalDisplayMethod.
+%
+
+% This is the numeric constant for this mode:
+rc = 2^41;
+
+return;
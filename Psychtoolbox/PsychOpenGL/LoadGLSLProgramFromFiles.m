@@ -34,6 +34,10 @@ function handle = LoadGLSLProgramFromFiles(filenames, debug, extraShaders)
 % or by your self-compiled shaders via glCompileShader(). All precompiled
 % shaders referenced by those handles get also linked into the final GLSL
 % program.
+%
+% If a Screen window is open, linked programs are stored in the on-disk
+% GLSL program binary cache of Screen, and loaded from it on later runs
+% instead of linking them again. See "Screen LinkGLSLProgram?" for details.
 
 % 29-Mar-2006 written by MK
 
@@ -157,8 +161,18 @@ if debug > 1
     % Restore old debuglevel for moglcore:
     moglcore('DEBUGLEVEL', oldDebug);
 else
-    % Link the program without raised debug level for moglcore:
-    glLinkProgram(handle);
+    % Link the program without raised debug level for moglcore. Use the GLSL
+    % program binary cache of Screen to skip linking on repeated runs, if a
+    % window is open. Retry with glLinkProgram if this fails:
+    win = Screen('GetOpenGLDrawMode');
+    if win == 0
+        win = [Screen('Windows'), 0];
+        win = win(1);
+    end
+
+    if win == 0 || ~Screen('LinkGLSLProgram', win, handle)
+        glLinkProgram(handle);
+    end
 end
 
 % Ready to use it? Hopefully.
@@ -0,0 +1,173 @@
+function results = HookChainShaderFusionBenchmark(numShaders, nFrames, winRect)
+% results = HookChainShaderFusionBenchmark([numShaders=[1 2 4 8]][, nFrames=300][, winRect=[0 0 1024 768]])
+%
+% Benchmark shader fusion of imaging pipeline hook chains, as enabled via
+% Screen('HookFunction', win, 'FuseShaders', hookname).
+%
+% For each requested number of shaders, a chain of that many simple per-pixel
+% color processing shaders, separated by 'Builtin:FlipFBOs' slots, is set up
+% in the 'FinalOutputFormattingBlit' hook chain of a window. Then a gradient
+% texture is drawn into each of 'nFrames' frames, once with each shader
+% executed in its own render pass, once with all shaders fused into a single
+% pass. The gpu time for each frame, including all imaging pipeline
+% post-processing, is measured via Screen('GetWindowInfo', win, 5), or via
+% the time Screen('DrawingFinished') takes to finish rendering if the gpu
+% doesn't support timer queries. The final image of the last frame is read
+% back for both variants, to verify that fusion does not change the result.
+%
+% The number of render passes, the median time per frame and the maximum
+% difference between the final images are printed and returned in the
+% matrix 'results', one row per number of shaders:
+%
+% [numShaders, passesUnfused, msecsUnfused, passesFused, msecsFused, maxDiff]
+%
+% Without fusion, the result of each pass is stored in an 8 bpc framebuffer,
+% so a 'maxDiff' of a few units per fused shader is expected due to rounding.
+%
+% The benchmark does not need a display: On Linux it renders into a headless
+% window, see 'help kPsychHeadlessWindow', otherwise into a regular window
+% with all sync tests skipped. 'winRect' selects the size of the window. The
+% benefit of fusion grows with the number of pixels, as each saved pass
+% saves one read and write of the whole framebuffer.
+%
+% History:
+% 10/19/2026 ag Written.
+
+global GL;
+
+AssertOpenGL;
+
+if nargin < 1 || isempty(numShaders)
+    numShaders = [1 2 4 8];
+end
+
+if nargin < 2 || isempty(nFrames)
+    nFrames = 300;
+end
+
+if nargin < 3 || isempty(winRect)
+    winRect = [0 0 1024 768];
+end
+
+% Per-pixel shader: Output color is a function of the input color at the same pixel only:
+shaderSrc = [ 'uniform sampler2DRect Image;\n' ...
+              'uniform float gain;\n' ...
+              'void main()\n' ...
+              '{\n' ...
+              '    vec4 incolor = texture2DRect(Image, gl_TexCoord[0].st);\n' ...
+              '    gl_FragColor = vec4(clamp(incolor.rgb * gain, 0.0, 1.0), incolor.a);\n' ...
+              '}\n' ];
+shaderSrc = sprintf(shaderSrc);
+
+InitializeMatlabOpenGL([], [], 1);
+screen = max(Screen('Screens'));
+oldSkip = Screen('Preference', 'SkipSyncTests', 2);
+oldVerbosity = Screen('Preference', 'Verbosity', 1);
+results = [];
+
+try
+    imagingMode = mor(kPsychNeedFastBackingStore, kPsychNeedOutputConversion, kPsychNeedMultiPass);
+
+    % Render headless if possible, otherwise into a regular window:
+    win = [];
+    if IsLinux
+        try
+            win = Screen('OpenWindow', screen, 0, winRect, [], [], [], [], imagingMode, kPsychHeadlessWindow);
+        catch %#ok<CTCH>
+            win = [];
+        end
+    end
+
+    if isempty(win)
+        win = Screen('OpenWindow', screen, 0, winRect, [], [], [], [], imagingMode, kPsychGUIWindow);
+    end
+
+    tex = Screen('MakeTexture', win, repmat(uint8(0:255), 256, 1));
+
+    for n = numShaders
+        % Build chain of n shaders:
+        Screen('HookFunction', win, 'Reset', 'FinalOutputFormattingBlit');
+        shaders = zeros(1, n);
+        for i = 1:n
+            Screen('BeginOpenGL', win);
+            fragShader = glCreateShader(GL.FRAGMENT_SHADER);
+            glShaderSource(fragShader, shaderSrc);
+            glCompileShader(fragShader);
+            shaders(i) = glCreateProgram;
+            glAttachShader(shaders(i), fragShader);
+            glLinkProgram(shaders(i));
+            glUseProgram(shaders(i));
+            glUniform1i(glGetUniformLocation(shaders(i), 'Image'), 0);
+            glUniform1f(glGetUniformLocation(shaders(i), 'gain'), 1 + 0.01 * i);
+            glUseProgram(0);
+            Screen('EndOpenGL', win);
+
+            if i > 1
+                Screen('HookFunction', win, 'AppendBuiltin', 'FinalOutputFormattingBlit', 'Builtin:FlipFBOs', '');
+            end
+            Screen('HookFunction', win, 'AppendShader', 'FinalOutputFormattingBlit', sprintf('Gain shader %i', i), shaders(i));
+        end
+        Screen('HookFunction', win, 'Enable', 'FinalOutputFormattingBlit');
+
+        row = n;
+        images = cell(1, 2);
+        for fuse = [0 1]
+            passes = Screen('HookFunction', win, 'FuseShaders', 'FinalOutputFormattingBlit', fuse);
+
+            frameTimes = zeros(1, nFrames);
+            for i = 1:nFrames
+                gpumeasure = Screen('GetWindowInfo', win, 5);
+
+                t = GetSecs;
+                Screen('DrawTexture', win, tex, [], Screen('Rect', win));
+
+                % Execute the imaging pipeline and wait for it to finish:
+                Screen('DrawingFinished', win, 2, 1);
+                frameTimes(i) = GetSecs - t;
+
+                if gpumeasure
+                    % Timer query results arrive asynchronously, so poll for them:
+                    winfo = Screen('GetWindowInfo', win);
+                    while winfo.GPULastFrameRenderTime == 0
+                        winfo = Screen('GetWindowInfo', win);
+                    end
+                    frameTimes(i) = winfo.GPULastFrameRenderTime;
+                end
+
+                if i == nFrames
+                    images{fuse + 1} = Screen('GetImage', win, [], 'backBuffer');
+                end
+
+                Screen('Flip', win, [], 2, 2);
+            end
+
+            row = [row, passes, median(frameTimes) * 1000]; %#ok<AGROW>
+        end
+
+        maxDiff = max(abs(double(images{1}(:)) - double(images{2}(:))));
+        results(end+1, :) = [row, maxDiff]; %#ok<AGROW>
+
+        Screen('HookFunction', win, 'Reset', 'FinalOutputFormattingBlit');
+        Screen('BeginOpenGL', win);
+        for i = 1:n
+            glDeleteProgram(shaders(i));
+        end
+        Screen('EndOpenGL', win);
+    end
+
+    sca;
+    Screen('Preference', 'SkipSyncTests', oldSkip);
+    Screen('Preference', 'Verbosity', oldVerbosity);
+catch %#ok<CTCH>
+    sca;
+    Screen('Preference', 'SkipSyncTests', oldSkip);
+    Screen('Preference', 'Verbosity', oldVerbosity);
+    psychrethrow(psychlasterror);
+end
+
+fprintf('\nShaders | Passes unfused | Unfused [ms/frame] | Passes fused | Fused [ms/frame] | Max diff\n');
+for i = 1:size(results, 1)
+    fprintf('%7i | %14i | %18.3f | %12i | %16.3f | %8i\n', results(i, :));
+end
+
+return;
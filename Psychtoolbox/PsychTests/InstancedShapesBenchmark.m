@@ -0,0 +1,121 @@
+function results = InstancedShapesBenchmark(numShapes, nFrames, winRect)
+% results = InstancedShapesBenchmark([numShapes=[10 100 1000 10000]][, nFrames=300][, winRect=[]])
+%
+% Benchmark instanced drawing of batches of rectangles and ovals.
+%
+% On graphics hardware with support for instanced drawing, Screen('FillRect'),
+% Screen('FrameRect') and Screen('FillOval') draw a batch of multiple shapes
+% with one draw call and a shader, instead of one by one. This benchmark draws
+% batches of 'numShapes' randomly placed and colored shapes into each of
+% 'nFrames' frames, once with instanced drawing, once with instanced drawing
+% disabled via the ConserveVRAM setting kPsychDontUseInstancedShapes, see
+% 'help ConserveVRAMSettings'. Drawing is timed without flipping, so only
+% the cost of drawing is measured.
+%
+% Instancing mostly saves cpu time for submitting the shapes to the gpu, so
+% two times are measured for each batch: The time until the drawing command
+% returns, and the time until the gpu has finished drawing the batch. The
+% median times per batch in msecs are printed and returned in the matrix
+% 'results', one row per batch size and shape type:
+%
+% [numShapes, shapeType, submitPerItem, submitInstanced, finishPerItem, finishInstanced]
+%
+% shapeType is 1 for FillRect, 2 for FrameRect, 3 for FillOval.
+%
+% 'winRect' selects the size of the window, default is fullscreen.
+%
+% History:
+% 10/19/2026 ag Written.
+
+global GL;
+
+AssertOpenGL;
+
+if nargin < 1 || isempty(numShapes)
+    numShapes = [10 100 1000 10000];
+end
+
+if nargin < 2 || isempty(nFrames)
+    nFrames = 300;
+end
+
+if nargin < 3
+    winRect = [];
+end
+
+% kPsychDontUseInstancedShapes:
+noInstancing = 2^30;
+shapeNames = {'FillRect', 'FrameRect', 'FillOval'};
+
+InitializeMatlabOpenGL([], [], 1);
+screen = max(Screen('Screens'));
+oldConserve = Screen('Preference', 'ConserveVRAM');
+results = [];
+
+try
+    win = Screen('OpenWindow', screen, 0, winRect);
+    Screen('BlendFunction', win, 'GL_SRC_ALPHA', 'GL_ONE_MINUS_SRC_ALPHA');
+    [w, h] = Screen('WindowSize', win);
+
+    for n = numShapes
+        centers = [rand(1, n) * w; rand(1, n) * h];
+        sizes = 5 + rand(1, n) * 45;
+        rects = [centers - [sizes; sizes]; centers + [sizes; sizes]];
+        colors = rand(3, n) * 255;
+        penWidths = 1 + round(rand(1, n) * 4);
+
+        for shape = 1:3
+            submit = zeros(1, 2);
+            finish = zeros(1, 2);
+            for instanced = [0 1]
+                if instanced
+                    Screen('Preference', 'ConserveVRAM', oldConserve);
+                else
+                    Screen('Preference', 'ConserveVRAM', bitor(oldConserve, noInstancing));
+                end
+
+                submitTimes = zeros(1, nFrames);
+                finishTimes = zeros(1, nFrames);
+                for i = 1:nFrames
+                    t = GetSecs;
+                    switch shape
+                        case 1
+                            Screen('FillRect', win, colors, rects);
+                        case 2
+                            Screen('FrameRect', win, colors, rects, penWidths);
+                        case 3
+                            Screen('FillOval', win, colors, rects);
+                    end
+                    submitTimes(i) = GetSecs - t;
+
+                    Screen('BeginOpenGL', win);
+                    glFinish;
+                    Screen('EndOpenGL', win);
+                    finishTimes(i) = GetSecs - t;
+                end
+
+                % Medians, so the first batches, which also compile shaders and allocate buffers, don't count:
+                submit(instanced + 1) = median(submitTimes) * 1000;
+                finish(instanced + 1) = median(finishTimes) * 1000;
+            end
+
+            results(end+1, :) = [n, shape, submit, finish]; %#ok<AGROW>
+            Screen('FillRect', win, 0);
+            Screen('Flip', win);
+        end
+    end
+
+    Screen('Preference', 'ConserveVRAM', oldConserve);
+    sca;
+catch %#ok<CTCH>
+    Screen('Preference', 'ConserveVRAM', oldConserve);
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+fprintf('\nShapes | Type      | Submit per item | Submit instanced | Finish per item | Finish instanced | Speedup\n');
+for i = 1:size(results, 1)
+    fprintf('%6i | %-9s | %15.3f | %16.3f | %15.3f | %16.3f | %7.2f\n', results(i, 1), shapeNames{results(i, 2)}, results(i, 3:6), results(i, 5) / results(i, 6));
+end
+
+return;
@@ -0,0 +1,171 @@
+function results = LlvmpipePipelineBenchmark(numThreads, nFrames, winRect, noTimestamps)
+% results = LlvmpipePipelineBenchmark([numThreads=[1 2 4 8]][, nFrames=300][, winRect=[0 0 1920 1080]][, noTimestamps=0])
+%
+% Benchmark the imaging pipeline on a headless window with the Mesa llvmpipe
+% software renderer, using different numbers of llvmpipe render threads.
+%
+% This is meant for render farms and compute nodes without a gpu, where
+% stimulus images or movies are generated in batch mode via a headless
+% onscreen window, see 'help kPsychHeadlessWindow'. Only works on Linux
+% with the Waffle display backend and Mesa.
+%
+% The number of llvmpipe threads is set via the environment variable
+% LP_NUM_THREADS, which is only evaluated when Mesa is loaded. Therefore
+% each measurement runs in a new instance of Octave or Matlab, which must
+% find Psychtoolbox on its default path.
+%
+% Each measurement opens a headless window of size 'winRect' with a
+% standard imaging pipeline configuration: A 32 bpc floating point
+% framebuffer and a simple gamma correction in the final formatting chain.
+% Then it draws a fixed set of filled rectangles, ovals and a rotated texture
+% into each of 'nFrames' frames and flips them as fast as possible. The
+% throughput is measured from the start of the second frame, so shader
+% compilation and texture upload for the first frame are not counted, until
+% the last frame has been read back.
+%
+% llvmpipe splits each frame into tiles rendered by the different threads,
+% which must not change the result. Therefore the final frame is read back
+% and compared between all thread counts.
+%
+% If 'noTimestamps' is set to 1, Flip does not wait for render completion
+% of each frame to timestamp it, so rendering of a frame can overlap with
+% submission of the next one.
+%
+% The frames per second, average time per frame and if the final frame is
+% identical to the one rendered with the first thread count are printed and
+% returned in the matrix 'results', one row per thread count:
+%
+% [numThreads, fps, msecsPerFrame, sameImage]
+%
+% History:
+% 10/19/2026 ag Written.
+
+if nargin < 1 || isempty(numThreads)
+    numThreads = [1 2 4 8];
+end
+
+if nargin < 2 || isempty(nFrames)
+    nFrames = 300;
+end
+
+if nargin < 3 || isempty(winRect)
+    winRect = [0 0 1920 1080];
+end
+
+if nargin < 4 || isempty(noTimestamps)
+    noTimestamps = 0;
+end
+
+% Worker instance, launched by the code below? Then run one measurement and print result:
+if ~isempty(getenv('PTB_LLVMPIPE_BENCHMARK_WORKER'))
+    [fps, checksum] = runBenchmark(nFrames, winRect, noTimestamps);
+    fprintf('LLVMPIPE-BENCHMARK-RESULT: %f %f\n', fps, checksum);
+    results = [fps, checksum];
+    return;
+end
+
+if ~IsLinux
+    error('This benchmark only works on Linux.');
+end
+
+if IsOctave
+    interpreter = sprintf('"%s" --no-gui --no-window-system --eval', fullfile(OCTAVE_HOME, 'bin', 'octave-cli'));
+else
+    interpreter = sprintf('"%s" -batch', fullfile(matlabroot, 'bin', 'matlab'));
+end
+
+cmd = sprintf('LlvmpipePipelineBenchmark([], %i, [%s], %i); exit;', nFrames, num2str(winRect), noTimestamps);
+
+results = [];
+refChecksum = [];
+for n = numThreads
+    fprintf('Running with LP_NUM_THREADS=%i...\n', n);
+    [rc, out] = system(sprintf('PTB_LLVMPIPE_BENCHMARK_WORKER=1 LIBGL_ALWAYS_SOFTWARE=1 GALLIUM_DRIVER=llvmpipe LP_NUM_THREADS=%i %s ''%s''', n, interpreter, cmd));
+    res = sscanf(out(strfind(out, 'LLVMPIPE-BENCHMARK-RESULT:'):end), 'LLVMPIPE-BENCHMARK-RESULT: %f %f');
+    if rc ~= 0 || numel(res) ~= 2
+        fprintf('%s\n', out);
+        warning('Benchmark run with LP_NUM_THREADS=%i failed.', n);
+        res = [NaN, NaN];
+    end
+
+    if isempty(refChecksum) && ~isnan(res(2))
+        refChecksum = res(2);
+    end
+
+    sameImage = ~isnan(res(2)) && (res(2) == refChecksum);
+    if ~sameImage && ~isnan(res(2))
+        warning('Final frame rendered with LP_NUM_THREADS=%i differs from the one rendered with the first thread count.', n);
+    end
+
+    results(end+1, :) = [n, res(1), 1000 / res(1), sameImage]; %#ok<AGROW>
+end
+
+fprintf('\nThreads |     fps | [ms/frame] | Same image\n');
+for i = 1:size(results, 1)
+    fprintf('%7i | %7.2f | %10.3f | %10i\n', results(i, :));
+end
+
+return;
+
+function [fps, checksum] = runBenchmark(nFrames, winRect, noTimestamps)
+
+PsychDefaultSetup(2);
+Screen('Preference', 'Verbosity', 2);
+screen = max(Screen('Screens'));
+
+try
+    PsychImaging('PrepareConfiguration');
+    PsychImaging('AddTask', 'General', 'FloatingPoint32BitIfPossible');
+    PsychImaging('AddTask', 'FinalFormatting', 'DisplayColorCorrection', 'SimpleGamma');
+    win = PsychImaging('OpenWindow', screen, 0.5, winRect, [], [], [], [], [], kPsychHeadlessWindow);
+    PsychColorCorrection('SetEncodingGamma', win, 1 / 2.2);
+
+    if noTimestamps
+        Screen('HookFunction', win, 'SetOneshotFlipFlags', '', kPsychSkipTimestampingForFlipOnce + kPsychDontAutoResetOneshotFlags);
+    end
+
+    % Same stimulus for all thread counts, so the final frames can be compared:
+    [w, h] = Screen('WindowSize', win);
+    [tx, ty] = meshgrid(1:256);
+    tex = Screen('MakeTexture', win, mod(tx .* ty, 256) / 255, [], [], 2);
+    k = 0:99;
+    centers = [mod(k * 37, 100) / 100 * w; mod(k * 61, 100) / 100 * h];
+    sizes = 10 + mod(k * 13, 50) / 50 * min(w, h) / 4;
+    rects = [centers - [sizes; sizes]; centers + [sizes; sizes]];
+    colors = [mod(k * 7, 100); mod(k * 11, 100); mod(k * 17, 100)] / 100;
+
+    % First frame compiles shaders and uploads the texture, so start timing after it:
+    drawFrame(win, tex, rects, colors, w, h, 0);
+    Screen('Flip', win);
+    Screen('GetImage', win, [0 0 1 1], 'backBuffer');
+
+    t = GetSecs;
+    for i = 1:nFrames
+        drawFrame(win, tex, rects, colors, w, h, i);
+
+        if i == nFrames
+            % Read back the final frame, which also waits for all frames to be rendered:
+            Screen('DrawingFinished', win);
+            img = Screen('GetImage', win, [], 'backBuffer');
+            fps = nFrames / (GetSecs - t);
+            checksum = sum(double(img(:)));
+        end
+
+        Screen('Flip', win);
+    end
+
+    sca;
+catch %#ok<CTCH>
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+return;
+
+function drawFrame(win, tex, rects, colors, w, h, i)
+
+Screen('FillRect', win, colors, rects);
+Screen('FillOval', win, colors(:, end:-1:1), rects);
+Screen('DrawTexture', win, tex, [], CenterRect([0 0 512 512], [0 0 w h]), mod(i, 360));
+
+return;
@@ -0,0 +1,95 @@
+function results = VideoCapturePreprocessingBenchmark(deviceIndex, roiSizes, binning, nFrames)
+% results = VideoCapturePreprocessingBenchmark([deviceIndex][, roiSizes=[0 64 128 256 512]][, binning=1][, nFrames=300])
+%
+% Benchmark the preprocessing stage of the GStreamer video capture engine,
+% as enabled via Screen('SetVideoCaptureParameter', ..., 'SetPreprocessing=...').
+%
+% For each requested region of interest size, a centered square ROI of that
+% size is cropped out of the captured video frames, optionally binned, and
+% 'nFrames' frames are fetched as textures. The number of bytes uploaded
+% per frame, the average time spent in preprocessing and the average and
+% maximum latency from capture of a frame to its texture being ready are
+% printed and returned in the matrix 'results', one row per ROI size:
+%
+% [roiSize, bytesPerFrame, preprocMsecs, avgLatencyMsecs, maxLatencyMsecs]
+%
+% A 'roiSizes' value of 0 means the full video frame without preprocessing.
+% 'deviceIndex' selects the video capture device, default is the default
+% camera. To test without a camera, you can use a GStreamer test source via
+% Screen('SetVideoCaptureParameter', -1, 'SetNextCaptureBinSpec=videotestsrc is-live=1');
+% and a 'deviceIndex' of -9.
+%
+% History:
+% 10/19/2026 ag Written.
+
+AssertOpenGL;
+
+if nargin < 1
+    deviceIndex = [];
+end
+
+if nargin < 2 || isempty(roiSizes)
+    roiSizes = [0 64 128 256 512];
+end
+
+if nargin < 3 || isempty(binning)
+    binning = 1;
+end
+
+if nargin < 4 || isempty(nFrames)
+    nFrames = 300;
+end
+
+screen = max(Screen('Screens'));
+results = [];
+
+try
+    win = Screen('OpenWindow', screen, 0, [0 0 800 600]);
+    grabber = Screen('OpenVideoCapture', win, deviceIndex);
+    roi = Screen('SetVideoCaptureParameter', grabber, 'GetROI');
+    fw = RectWidth(roi);
+    fh = RectHeight(roi);
+
+    for roiSize = roiSizes
+        if roiSize == 0
+            Screen('SetVideoCaptureParameter', grabber, 'SetPreprocessing=');
+        else
+            if roiSize > min(fw, fh)
+                fprintf('Skipping ROI size %i, larger than video frame of %i x %i pixels.\n', roiSize, fw, fh);
+                continue;
+            end
+            x = floor((fw - roiSize) / 2);
+            y = floor((fh - roiSize) / 2);
+            Screen('SetVideoCaptureParameter', grabber, sprintf('SetPreprocessing=%i,%i,%i,%i,%i', x, y, roiSize, roiSize, binning));
+        end
+
+        Screen('StartVideoCapture', grabber, realmax, 1);
+        for i = 1:nFrames
+            tex = Screen('GetCapturedImage', win, grabber, 1);
+            if tex > 0
+                Screen('DrawTexture', win, tex);
+                Screen('Close', tex);
+            end
+            Screen('Flip', win, [], [], 2);
+        end
+
+        latency = Screen('SetVideoCaptureParameter', grabber, 'GetQueueStats');
+        preproc = Screen('SetVideoCaptureParameter', grabber, 'GetPreprocessingStats');
+        Screen('StopVideoCapture', grabber);
+
+        results(end+1, :) = [roiSize, preproc(1), preproc(2) * 1000, latency(4) * 1000, latency(5) * 1000]; %#ok<AGROW>
+    end
+
+    Screen('CloseVideoCapture', grabber);
+    sca;
+catch %#ok<CTCH>
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+fprintf('\nROI size | Bytes per frame | Preprocessing [ms] | Avg latency [ms] | Max latency [ms]\n');
+for i = 1:size(results, 1)
+    fprintf('%8i | %15i | %18.3f | %16.3f | %16.3f\n', results(i, :));
+end
+
+return;
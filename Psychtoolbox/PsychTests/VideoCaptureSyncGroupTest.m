@@ -0,0 +1,114 @@
+function [success, timestamps] = VideoCaptureSyncGroupTest(nSets, captureRate, tolerance)
+% [success, timestamps] = VideoCaptureSyncGroupTest([nSets=100][, captureRate=30][, tolerance=0.005])
+%
+% Test synchronized video capture of a capture group with the GStreamer
+% video capture engine, as set up via the 'SyncMode' and 'SyncGroup'
+% settings of Screen('SetVideoCaptureParameter').
+%
+% Two GStreamer videotestsrc test sources are opened as video capture
+% devices, assigned to the same capture group as sync master and sync
+% slave, and capture is started at 'captureRate' fps. Then 'nSets' frame
+% sets are fetched via Screen('GetCapturedImageSet') with the given
+% 'tolerance' in seconds. The test checks that the capture timestamps of
+% the frames of each set are within 'tolerance' of each other, and that
+% the timestamps of consecutive sets increase.
+%
+% Returns 'success' = 1 if all checks passed, 0 otherwise, and the
+% capture timestamps of all fetched frame sets in the matrix 'timestamps',
+% one row per set, one column per device.
+%
+% History:
+% 10/19/2026 ag Written.
+
+AssertOpenGL;
+
+if nargin < 1 || isempty(nSets)
+    nSets = 100;
+end
+
+if nargin < 2 || isempty(captureRate)
+    captureRate = 30;
+end
+
+if nargin < 3 || isempty(tolerance)
+    tolerance = 0.005;
+end
+
+screen = max(Screen('Screens'));
+timestamps = zeros(0, 2);
+totalDropped = 0;
+
+try
+    win = Screen('OpenWindow', screen, 0, [0 0 800 600]);
+
+    % Open two live test sources as capture devices via user-defined bins:
+    grabbers = zeros(1, 2);
+    for i = 1:2
+        Screen('SetVideoCaptureParameter', -1, sprintf('SetNextCaptureBinSpec=videotestsrc is-live=1 pattern=%i', i - 1));
+        grabbers(i) = Screen('OpenVideoCapture', win, -9, [0 0 640 480]);
+    end
+
+    % First device is the soft-sync master, the second one a soft-sync slave,
+    % both in capture group 1:
+    Screen('SetVideoCaptureParameter', grabbers(1), 'SyncMode', 1 + 4);
+    Screen('SetVideoCaptureParameter', grabbers(2), 'SyncMode', 2 + 4);
+    Screen('SetVideoCaptureParameter', grabbers(1), 'SyncGroup', 1);
+    Screen('SetVideoCaptureParameter', grabbers(2), 'SyncGroup', 1);
+
+    % Start slave first, then the master, which starts the whole group:
+    Screen('StartVideoCapture', grabbers(2), captureRate, 1);
+    Screen('StartVideoCapture', grabbers(1), captureRate, 1);
+
+    while size(timestamps, 1) < nSets
+        [texs, ts, dropped] = Screen('GetCapturedImageSet', win, grabbers, 1, tolerance);
+        if isempty(texs) || texs(1) == -1
+            break;
+        end
+
+        timestamps(end+1, :) = ts; %#ok<AGROW>
+        totalDropped = totalDropped + dropped;
+
+        Screen('DrawTextures', win, texs, [], [0 0 400 300; 400 0 800 300]');
+        Screen('Close', texs);
+        Screen('Flip', win);
+    end
+
+    % Stop master first, which stops the group, then the slave:
+    Screen('StopVideoCapture', grabbers(1));
+    Screen('StopVideoCapture', grabbers(2));
+    Screen('CloseVideoCapture', grabbers(1));
+    Screen('CloseVideoCapture', grabbers(2));
+    sca;
+catch %#ok<CTCH>
+    sca;
+    psychrethrow(psychlasterror);
+end
+
+success = 1;
+
+if size(timestamps, 1) < nSets
+    fprintf('FAILED: Only got %i of %i frame sets before capture stopped.\n', size(timestamps, 1), nSets);
+    success = 0;
+end
+
+skew = abs(timestamps(:, 1) - timestamps(:, 2));
+fprintf('Got %i frame sets, %i frames dropped for alignment.\n', size(timestamps, 1), totalDropped);
+if ~isempty(skew)
+    fprintf('Timestamp difference between devices: avg %f msecs, max %f msecs.\n', mean(skew) * 1000, max(skew) * 1000);
+end
+
+if any(skew > tolerance)
+    fprintf('FAILED: %i frame sets have timestamps which differ by more than the tolerance of %f msecs.\n', sum(skew > tolerance), tolerance * 1000);
+    success = 0;
+end
+
+if any(diff(timestamps(:, 1)) <= 0)
+    fprintf('FAILED: Timestamps of consecutive frame sets do not increase.\n');
+    success = 0;
+end
+
+if success
+    fprintf('PASSED: All frame sets are aligned within %f msecs.\n', tolerance * 1000);
+end
+
+return;